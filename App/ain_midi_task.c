@@ -60,6 +60,12 @@ static void send_note_ch(uint8_t ch, uint8_t note, uint8_t on, uint8_t vel,
 }
 
 
+// A MIDI channel holds 128 notes: keys 0..127 (modules 0-1) play notes
+// 0..127 and keys 128..255 (modules 2-3) the same notes one channel up,
+// unless a zone maps them
+static inline uint8_t key_note(uint8_t key) { return (uint8_t)(key & 0x7Fu); }
+static inline uint8_t key_channel(uint8_t key) { return (uint8_t)(key >> 7); }
+
 // Helper: apply zones mapping (channels / transposition / split-layers) then queue MIDI
 static void send_note(uint8_t phys_key, uint8_t note, uint8_t on, uint8_t vel, uint16_t delay_ms, uint8_t apply_flag) {
   uint8_t ch[ZONE_LAYERS_MAX] = {0};
@@ -67,8 +73,8 @@ static void send_note(uint8_t phys_key, uint8_t note, uint8_t on, uint8_t vel, u
   uint8_t vv[ZONE_LAYERS_MAX] = {0};
   uint8_t n = zones_map_note(phys_key, note, vel, ch, nn, vv);
   if (n == 0) {
-    // fallback: ch0, no transpose
-    send_note_ch(0, note, on, vel, delay_ms, apply_flag);
+    // fallback: channel from the key bank, no transpose
+    send_note_ch(key_channel(phys_key), note, on, vel, delay_ms, apply_flag);
     return;
   }
   for (uint8_t i=0;i<n;i++) {
@@ -94,10 +100,10 @@ void ain_midi_process_events(void) {
       uint8_t chord_on = (chord_ui && chord_cond_active(vel));
 
       if (!chord_on) {
-        send_note(e.key, e.key, 1, vel, 0, HUMAN_APPLY_KEYS);
+        send_note(e.key, key_note(e.key), 1, vel, 0, HUMAN_APPLY_KEYS);
       } else {
         uint8_t notes[4]; uint8_t preset=0;
-        uint8_t n = chord_bank_expand(ui_get_chord_bank(), e.key, notes, &preset);
+        uint8_t n = chord_bank_expand(ui_get_chord_bank(), key_note(e.key), notes, &preset);
         /* order for strum */
         uint8_t order[4]={0,1,2,3};
         if (c->strum_dir == STRUM_DOWN && n>1) {
@@ -118,10 +124,10 @@ void ain_midi_process_events(void) {
       const instrument_cfg_t* c = instrument_cfg_get();
       uint8_t chord_ui = ui_get_chord_mode();
       if (!chord_ui) {
-        send_note(e.key, e.key, 0, 0, 0, HUMAN_APPLY_KEYS);
+        send_note(e.key, key_note(e.key), 0, 0, 0, HUMAN_APPLY_KEYS);
       } else {
         uint8_t notes[4]; uint8_t preset=0;
-        uint8_t n = chord_bank_expand(ui_get_chord_bank(), e.key, notes, &preset);
+        uint8_t n = chord_bank_expand(ui_get_chord_bank(), key_note(e.key), notes, &preset);
         for (uint8_t i=0;i<n;i++) send_note(e.key, notes[i], 0, 0, 0, HUMAN_APPLY_CHORD);
       }
     }
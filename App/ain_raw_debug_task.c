@@ -52,7 +52,9 @@ static void debug_write(const char* s) {
 static void AinRawDebugTask(void* argument) {
   (void)argument;
 
-  uint16_t raw[AIN_NUM_KEYS];
+  // Static: up to 256 keys with AINSER64_NUM_MODULES = 4
+  static uint16_t raw[AIN_NUM_KEYS];
+  static uint16_t rate[AIN_NUM_KEYS];
   char line[240];
 
   debug_write("AIN raw debug: ON\r\n");
@@ -60,18 +62,31 @@ static void AinRawDebugTask(void* argument) {
   for (;;) {
     ain_debug_get_raw(raw, AIN_NUM_KEYS);
 
-    // Print 8 ports x 8 channels in MIOS32-style order (J6..J13, A0..A7)
-    for (uint8_t port = 0; port < 8; ++port) {
-      int len = snprintf(line, sizeof(line), "J%u:", (unsigned)(port + 6));
+    // Print 8 ports x 8 channels per module in MIOS32-style order (J6..J13, A0..A7)
+    for (uint16_t row = 0; row < AIN_NUM_KEYS / 8u; ++row) {
+      const uint8_t port = (uint8_t)(row & 7u);
+      int len = (AINSER64_NUM_MODULES > 1)
+                  ? snprintf(line, sizeof(line), "M%u J%u:", (unsigned)(row / 8u), (unsigned)(port + 6))
+                  : snprintf(line, sizeof(line), "J%u:", (unsigned)(port + 6));
       for (uint8_t a = 0; a < 8; ++a) {
         // In MidiCore mapping, the channel order is reversed inside a port.
-        const uint8_t key = (uint8_t)(port * 8 + (7 - a));
+        const uint8_t key = (uint8_t)(row * 8u + (7u - a));
         len = buf_append(line, sizeof(line), len, " A%u=%4u", (unsigned)a, (unsigned)raw[key]);
       }
       len = buf_append(line, sizeof(line), len, "\r\n");
       debug_write(line);
     }
 
+    // Effective sample rate per port (all 8 keys of a port, on every module,
+    // share a mux step)
+    ain_debug_get_rate_hz(rate, AIN_NUM_KEYS);
+    int len = snprintf(line, sizeof(line), "Hz:");
+    for (uint8_t port = 0; port < 8; ++port) {
+      len = buf_append(line, sizeof(line), len, " J%u=%u", (unsigned)(port + 6), (unsigned)rate[port * 8]);
+    }
+    len = buf_append(line, sizeof(line), len, "\r\n");
+    debug_write(line);
+
     debug_write("\r\n");
     osDelay(DEBUG_AIN_RAW_DUMP_PERIOD_MS);
   }
@@ -41,6 +41,14 @@
 #include "Services/ui/ui.h"
 #endif
 
+#if MODULE_ENABLE_UI_TASK
+#include "App/ui_task.h"
+#endif
+
+#if MODULE_ENABLE_PATCH_TASK
+#include "App/patch_task.h"
+#endif
+
 #if MODULE_ENABLE_SAFE_MODE
 #include "Services/safe/safe_mode.h"
 #endif
@@ -241,6 +249,13 @@ void app_init_and_start(void)
     expression_cfg_defaults(&s_ecfg);
     if (sd_ok) { (void)expression_cfg_load_sd(&s_ecfg, "0:/cfg/expression.ngc"); }
     expression_set_cfg(&s_ecfg);
+    if (sd_ok) { (void)expression_load_user_curve(EXPR_USER_CURVE_PATH); }
+#endif
+
+#if MODULE_ENABLE_AIN
+    // Saved per-key calibration switches AIN to the frozen fast path
+    // (no file: stays in learn mode)
+    (void)ain_cal_load(AIN_CAL_DEFAULT_PATH);
 #endif
 
 #if MODULE_ENABLE_PRESSURE
@@ -363,6 +378,16 @@ void app_init_and_start(void)
   
   /* Start the single MidiCore main task */
   (void)midicore_main_task_start();
+
+  /* UI rendering below the main task, so it never delays MIDI processing */
+#if MODULE_ENABLE_UI_TASK
+  app_start_ui_task();
+#endif
+
+  /* Patch/bank loads from SD off the input path */
+#if MODULE_ENABLE_PATCH_TASK
+  app_start_patch_task();
+#endif
   
   /* Optional debug stream - still allowed as separate task (rare) */
 #if MODULE_ENABLE_AIN_RAW_DEBUG
@@ -10,12 +10,38 @@
 
 #include "App/calibration_task.h"
 #include "cmsis_os2.h"
+#include "Config/module_config.h"
 #include "Services/pressure/pressure_i2c.h"
+#if PRESSURE_ASYNC
+#include "Services/pressure/pressure_async.h"
+#endif
 #include "Services/expression/expression.h"
 #include <string.h>
 #include <stdlib.h>  // strtol
 #include <math.h>    // llround
 
+#if PRESSURE_ASYNC
+/* The main task owns the sensor (pressure_async.c): take its new samples
+ * instead of blocking reads that would collide with its transfers. */
+static uint32_t s_cal_seq;
+static int cal_read_pa(int32_t* pa){
+  pressure_sample_t s;
+  if(pressure_async_get(&s)!=0 || s.seq==s_cal_seq) return -1;
+  s_cal_seq = s.seq;
+  *pa = s.value;
+  return 0;
+}
+static int cal_read_pa_abs(int32_t* pa_abs){
+  int32_t pa=0;
+  if(cal_read_pa(&pa)!=0) return -1;
+  *pa_abs = pa + pressure_get_cfg()->atm0_pa;
+  return 0;
+}
+#else
+static int cal_read_pa(int32_t* pa){ return pressure_read_pa(pa); }
+static int cal_read_pa_abs(int32_t* pa_abs){ return pressure_read_pa_abs(pa_abs); }
+#endif
+
 /* Global calibration status for debugger (no printf!) */
 volatile uint8_t g_cal_state = 0;       /* 0=idle, 1=atm, 2=extremes, 3=done, 255=error */
 volatile int32_t g_cal_atm0 = 0;
@@ -272,7 +298,7 @@ static void CalibrationTask(void* argument){
   uint32_t t=0;
   while(t < cc.atm_ms){
     int32_t pa_abs=0;
-    if(pressure_read_pa_abs(&pa_abs)==0){
+    if(cal_read_pa_abs(&pa_abs)==0){
       acc += (int64_t)pa_abs;
       n++;
     }
@@ -300,7 +326,7 @@ static void CalibrationTask(void* argument){
   t=0;
   while(t < cc.ext_ms){
     int32_t pa=0;
-    if(pressure_read_pa(&pa)==0){
+    if(cal_read_pa(&pa)==0){
       if(pa < pmin) pmin = pa;
       if(pa > pmax) pmax = pa;
     }
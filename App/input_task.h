@@ -1,2 +0,0 @@
-#pragma once
-void InputTask(void *argument);
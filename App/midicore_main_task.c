@@ -31,6 +31,14 @@
 
 #if MODULE_ENABLE_PRESSURE
 #include "Services/pressure/pressure_i2c.h"
+#if PRESSURE_ASYNC
+#include "Services/pressure/pressure_async.h"
+#endif
+#if PRESSURE_ASYNC && PRESSURE_PIPE
+#include "Services/pressure/pressure_pipe.h"
+#include "Services/bellows_shake/bellows_shake.h"
+#include "Services/router/router.h"
+#endif
 #include "Services/expression/expression.h"
 #endif
 
@@ -66,12 +74,29 @@
 #include "Services/watchdog/watchdog.h"
 #endif
 
+#if MODULE_ENABLE_PATCH
+#include "Services/patch/patch_nav.h"
+#endif
+
 #if MODULE_ENABLE_ROUTER
 #include "Services/router/router.h"
 #endif
 
 #include "Services/midi/midi_delayq.h"
 
+/* Timed services, dispatched by tick_sched */
+#include "Services/tick_sched/tick_sched.h"
+#include "Services/cc_smoother/cc_smoother.h"
+#include "Services/midi_delay/midi_delay.h"
+#include "Services/note_repeat/note_repeat.h"
+#include "Services/envelope_cc/envelope_cc.h"
+#include "Services/gate_time/gate_time.h"
+#include "Services/bellows_expression/bellows_expression.h"
+#include "Services/register_coupling/register_coupling.h"
+#if MODULE_ENABLE_LFO
+#include "Services/lfo/lfo.h"
+#endif
+
 #if MODULE_ENABLE_USB_MIDI
 #include "Services/midicore_query/midicore_query.h"
 #endif
@@ -79,10 +104,13 @@
 #if MODULE_ENABLE_SRIO
 #include "Services/srio/srio.h"
 #include "Services/srio/srio_user_config.h"
+#include "Services/dout/dout_bcm.h"
 #endif
 
 #if MODULE_ENABLE_INPUT
 #include "Services/input/input.h"
+#include "Services/input/input_enc.h"
+#include "Services/ui/ui_encoders.h"
 #endif
 
 /* ============================================================================
@@ -93,13 +121,27 @@
 /* Service tick functions - called from main loop */
 static void ain_service_tick(uint32_t tick);
 static void pressure_service_tick(uint32_t tick);
+#if MODULE_ENABLE_PRESSURE && PRESSURE_ASYNC && PRESSURE_PIPE
+static void pressure_expr_cb(int32_t pa, uint32_t t_us);
+static void pressure_shake_cb(int32_t pa, uint32_t t_us);
+static void shake_cc_out(uint8_t track, uint8_t cc_num, uint8_t value, uint8_t channel);
+static void shake_pb_out(uint8_t track, int16_t pitchbend, uint8_t channel);
+#endif
 static void midi_io_service_tick(uint32_t tick);
+static void timed_services_init(uint32_t tick);
 static void ui_service_tick(uint32_t tick);
 static void cli_service_tick(uint32_t tick);
+static void patch_service_tick(uint32_t tick);
 static void watchdog_service_tick(uint32_t tick);
 static void expression_service_tick(uint32_t tick);
 static void srio_service_tick(uint32_t tick);
 static void input_service_tick(uint32_t tick);
+#if MODULE_ENABLE_SRIO && defined(SRIO_ENABLE) && MODULE_ENABLE_INPUT
+static void encoders_take(void);
+#if SRIO_SCAN_DMA
+static void srio_scan_done_isr(void);
+#endif
+#endif
 
 /* AIN MIDI processing - converts AIN events to MIDI */
 static void ain_midi_service_tick(uint32_t tick);
@@ -115,10 +157,20 @@ static volatile uint8_t s_running = 0;
 
 /* SRIO state for cooperative mode */
 #if MODULE_ENABLE_SRIO && defined(SRIO_ENABLE)
-static uint8_t s_din_prev[SRIO_DIN_BYTES];
 static uint8_t s_din_cur[SRIO_DIN_BYTES];
 static uint8_t s_dout_buf[SRIO_DOUT_BYTES];
 static uint8_t s_srio_initialized = 0;
+static uint8_t s_srio_fast = 0;  /* DMA scan running: encoders decoded in its interrupt */
+static uint8_t s_dout_bcm = 0;   /* DOUT driven by dout_bcm bitplanes, one per scan */
+#endif
+
+/* Pressure front end: latest sensor sample, held between conversions, and
+ * the time of the next push (from the sample's read completion, then one
+ * pipe period per tick) */
+#if MODULE_ENABLE_PRESSURE && PRESSURE_ASYNC && PRESSURE_PIPE
+static int32_t s_press_held = 0;
+static uint8_t s_press_valid = 0;
+static uint32_t s_press_t_us = 0;
 #endif
 
 /* Input service configuration defaults */
@@ -130,6 +182,7 @@ static uint8_t s_srio_initialized = 0;
 #if MODULE_ENABLE_INPUT
 static uint32_t s_input_ms = 0;
 static uint8_t s_input_initialized = 0;
+static ui_encoders_cfg_t s_enc_cfg;
 #endif
 
 /* ============================================================================
@@ -167,6 +220,44 @@ static void MidiCore_MainTask(void *argument)
   expression_init();
 #endif
 
+#if MODULE_ENABLE_PRESSURE && PRESSURE_ASYNC
+  pressure_async_init();
+#if PRESSURE_PIPE
+  pressure_pipe_init();
+  pressure_pipe_set_expr_cb(pressure_expr_cb);
+  bellows_shake_init();
+  bellows_shake_set_cc_callback(shake_cc_out);
+  bellows_shake_set_pb_callback(shake_pb_out);
+  pressure_pipe_set_shake_cb(pressure_shake_cb);
+#endif
+#endif
+
+  timed_services_init(s_tick_count);
+
+  /* Initialize input service for buttons/encoders (before the SRIO scan
+   * starts decoding encoders) */
+#if MODULE_ENABLE_INPUT
+  {
+    input_config_t icfg = {
+      .debounce_ms = INPUT_DEBOUNCE_MS,
+      .shift_hold_ms = INPUT_SHIFT_HOLD_MS,
+      .shift_button_id = INPUT_SHIFT_BUTTON_ID,
+      .din_scan_ms = MIDICORE_TICK_SRIO
+    };
+    input_init(&icfg);
+
+    /* Encoder pins, detent, acceleration and mode: read once, before the loop */
+    ui_encoders_defaults(&s_enc_cfg);
+    (void)ui_encoders_load(&s_enc_cfg, "/cfg/ui_encoders.ngc");
+    input_enc_init();
+    for (uint8_t e = 0; e < UI_MAX_ENCODERS; e++) {
+      (void)input_enc_config(e, s_enc_cfg.enc_a[e], s_enc_cfg.enc_b[e],
+                             s_enc_cfg.enc_detent[e], s_enc_cfg.enc_accel[e]);
+    }
+    s_input_initialized = 1;
+  }
+#endif
+
   /* Initialize SRIO for button/LED handling */
 #if MODULE_ENABLE_SRIO && defined(SRIO_ENABLE)
   {
@@ -183,24 +274,23 @@ static void MidiCore_MainTask(void *argument)
       .dout_bytes = SRIO_DOUT_BYTES,
     };
     srio_init(&scfg);
-    memset(s_din_prev, 0xFF, sizeof(s_din_prev));
     memset(s_din_cur, 0xFF, sizeof(s_din_cur));
     memset(s_dout_buf, 0, sizeof(s_dout_buf));
     srio_write_dout(s_dout_buf);
-    s_srio_initialized = 1;
-  }
-#endif
-
-  /* Initialize input service for buttons/encoders */
+#if SRIO_SCAN_DMA
+    /* From here on the TIM6 tick scans the chains by DMA, and encoders are
+     * decoded as each scan completes */
 #if MODULE_ENABLE_INPUT
-  {
-    input_config_t icfg = {
-      .debounce_ms = INPUT_DEBOUNCE_MS,
-      .shift_hold_ms = INPUT_SHIFT_HOLD_MS,
-      .shift_button_id = INPUT_SHIFT_BUTTON_ID
-    };
-    input_init(&icfg);
-    s_input_initialized = 1;
+    srio_set_scan_callback(srio_scan_done_isr);
+#endif
+    s_srio_fast = (srio_scan_start(SRIO_SCAN_PERIOD_MS) == 0) ? 1u : 0u;
+    /* The scan pulls LED bitplanes for per-output brightness */
+    if (s_srio_fast) {
+      dout_bcm_init();
+      s_dout_bcm = (srio_set_dout_source(dout_bcm_next_frame, DOUT_BCM_BYTES) == 0) ? 1u : 0u;
+    }
+#endif
+    s_srio_initialized = 1;
   }
 #endif
 
@@ -245,7 +335,7 @@ static void MidiCore_MainTask(void *argument)
       pressure_service_tick(tick);
     }
     
-    /* SRIO scan (every 5ms for responsive buttons/LEDs) */
+    /* SRIO scan (every 5ms, or every tick when the DMA scan runs it) */
     if ((tick % MIDICORE_TICK_SRIO) == 0) {
       srio_service_tick(tick);
     }
@@ -254,6 +344,10 @@ static void MidiCore_MainTask(void *argument)
       cli_service_tick(tick);
     }
     
+    if ((tick % MIDICORE_TICK_PATCH) == 0) {
+      patch_service_tick(tick);
+    }
+    
     /* ---- PRIORITY 3: UI services (every 20ms) ---- */
     
     if ((tick % MIDICORE_TICK_UI) == 0) {
@@ -303,13 +397,81 @@ static void ain_service_tick(uint32_t tick)
 #endif
 }
 
+#if MODULE_ENABLE_PRESSURE && PRESSURE_ASYNC && PRESSURE_PIPE
+/* Decimated pressure stream -> expression */
+static void pressure_expr_cb(int32_t pa, uint32_t t_us)
+{
+  (void)t_us;
+  expression_set_raw(pressure_to_12b(pa));
+  expression_set_pressure_pa(pa);
+}
+
+/* Band-passed pressure stream -> shake detector, on the expression channel.
+ * One bellows, one output channel: only track 0 is driven, the outputs
+ * below do not tell tracks apart */
+static void pressure_shake_cb(int32_t pa, uint32_t t_us)
+{
+  bellows_shake_process_pressure_us(0, pa, t_us, expression_get_cfg()->midi_ch);
+}
+
+static void shake_cc_out(uint8_t track, uint8_t cc_num, uint8_t value, uint8_t channel)
+{
+  (void)track;
+  router_msg_t m;
+  m.type = ROUTER_MSG_3B;
+  m.b0 = (uint8_t)(0xB0 | (channel & 0x0F));
+  m.b1 = cc_num & 0x7F;
+  m.b2 = value & 0x7F;
+  router_process(ROUTER_NODE_KEYS, &m);
+}
+
+static void shake_pb_out(uint8_t track, int16_t pitchbend, uint8_t channel)
+{
+  (void)track;
+  uint16_t v = (uint16_t)(pitchbend + 8192);
+  router_msg_t m;
+  m.type = ROUTER_MSG_3B;
+  m.b0 = (uint8_t)(0xE0 | (channel & 0x0F));
+  m.b1 = (uint8_t)(v & 0x7F);
+  m.b2 = (uint8_t)((v >> 7) & 0x7F);
+  router_process(ROUTER_NODE_KEYS, &m);
+}
+#endif
+
 /**
  * @brief Pressure sensor service tick - read I2C sensor
+ *
+ * With PRESSURE_ASYNC this only advances the non-blocking driver. Its
+ * samples feed expression directly, or with PRESSURE_PIPE are held and
+ * clocked into the oversampling front end every tick.
  */
 static void pressure_service_tick(uint32_t tick)
 {
   (void)tick;
-#if MODULE_ENABLE_PRESSURE
+#if MODULE_ENABLE_PRESSURE && PRESSURE_ASYNC
+  uint32_t now = osKernelGetTickCount();
+  if (pressure_async_tick(now) > 0) {
+    pressure_sample_t s;
+    if (pressure_async_get(&s) == 0) {
+#if PRESSURE_PIPE
+      /* Re-anchor on the sample time, keeping the pushed times increasing */
+      uint32_t floor_us = s_press_t_us - PRESSURE_PIPE_PERIOD_US + 1u;
+      s_press_t_us = (!s_press_valid || (int32_t)(s.t_us - floor_us) > 0) ? s.t_us : floor_us;
+      s_press_held = s.value;
+      s_press_valid = 1;
+#else
+      expression_set_raw(pressure_to_12b(s.value));
+      expression_set_pressure_pa(s.value);
+#endif
+    }
+  }
+#if PRESSURE_PIPE
+  if (s_press_valid && pressure_get_cfg()->enable) {
+    pressure_pipe_push(s_press_held, s_press_t_us);
+    s_press_t_us += PRESSURE_PIPE_PERIOD_US;
+  }
+#endif
+#elif MODULE_ENABLE_PRESSURE
   const pressure_cfg_t* c = pressure_get_cfg();
   if (c && c->enable) {
     int32_t raw = 0;
@@ -331,11 +493,11 @@ static void pressure_service_tick(uint32_t tick)
  * - MidiCore query processing
  * - MIDI DIN I/O
  * - Delay queue processing
+ * - Timed services (tick_sched): only the ones with a deadline due run
  */
 static void midi_io_service_tick(uint32_t tick)
 {
-  (void)tick;
-  
+
 #if MODULE_ENABLE_USB_MIDI
   /* Process USB MIDI RX queue in task context */
   usb_midi_process_rx_queue();
@@ -361,6 +523,35 @@ static void midi_io_service_tick(uint32_t tick)
 
   /* Delay queue tick */
   midi_delayq_tick_1ms();
+
+  /* Smoother, LFO, delay FX, repeat, envelope, gate, bellows, registers */
+  tick_sched_run(tick);
+}
+
+/**
+ * @brief Register the 1 ms services with the deadline scheduler
+ *
+ * They start idle; each wakes itself through tick_sched_wake() when work
+ * arrives (CC in, note in, trigger, setting change).
+ */
+static void timed_services_init(uint32_t tick)
+{
+  tick_sched_init(tick);
+  tick_sched_register(TICK_SVC_CC_SMOOTHER, "cc_smoother", cc_smoother_service);
+#if MODULE_ENABLE_LFO
+  tick_sched_register(TICK_SVC_LFO, "lfo", lfo_service);
+#endif
+#if MODULE_ENABLE_MIDI_DELAY_FX
+  tick_sched_register(TICK_SVC_MIDI_DELAY, "midi_delay", midi_delay_service);
+#endif
+  tick_sched_register(TICK_SVC_NOTE_REPEAT, "note_repeat", note_repeat_service);
+  tick_sched_register(TICK_SVC_ENVELOPE_CC, "envelope_cc", envelope_cc_service);
+  tick_sched_register(TICK_SVC_GATE_TIME, "gate_time", gate_time_service);
+  tick_sched_register(TICK_SVC_BELLOWS, "bellows", bellows_service);
+  tick_sched_register(TICK_SVC_REG_COUPLING, "reg_coupling", reg_coupling_service);
+
+  /* A first dispatch hands each service the scheduler clock */
+  for (uint8_t i = 0; i < TICK_SVC_COUNT; i++) tick_sched_wake((tick_svc_t)i, 0);
 }
 
 /**
@@ -376,11 +567,13 @@ static void expression_service_tick(uint32_t tick)
 
 /**
  * @brief UI service tick - update display
+ *
+ * With MODULE_ENABLE_UI_TASK the UI renders in UiTask instead (App/ui_task.c).
  */
 static void ui_service_tick(uint32_t tick)
 {
   (void)tick;
-#if MODULE_ENABLE_UI
+#if MODULE_ENABLE_UI && !MODULE_ENABLE_UI_TASK
   ui_tick_20ms();
 #endif
 }
@@ -396,6 +589,21 @@ static void cli_service_tick(uint32_t tick)
 #endif
 }
 
+/**
+ * @brief Patch service tick - finish navigation done by PatchTask
+ *
+ * PatchTask reads and parses the files; the commit left here only swaps
+ * in the staged patch state, routes and chord bank (router/UI state owned
+ * by this task) and updates the header. PatchTask waits while it runs.
+ */
+static void patch_service_tick(uint32_t tick)
+{
+  (void)tick;
+#if MODULE_ENABLE_PATCH
+  patch_nav_main_service();
+#endif
+}
+
 /**
  * @brief Watchdog service tick - kick the watchdog
  */
@@ -427,6 +635,8 @@ static void ain_midi_service_tick(uint32_t tick)
  * 
  * This handles 74HC165 (DIN) and 74HC595 (DOUT) shift register chains.
  * Scans digital inputs and writes digital outputs for buttons/LEDs.
+ * With SRIO_SCAN_DMA the chains are scanned in the background and this
+ * only picks up the latest DIN state and stages the DOUT buffer.
  */
 static void srio_service_tick(uint32_t tick)
 {
@@ -436,31 +646,65 @@ static void srio_service_tick(uint32_t tick)
   
   /* Read DIN chain */
   if (srio_read_din(s_din_cur) == 0) {
-    /* Check for changes and feed to input service */
+    /* Debounce the whole chain and feed settled changes to the input service.
+     * Active low: bit=0 means pressed, bit=1 means released */
 #if MODULE_ENABLE_INPUT
-    for (uint16_t b = 0; b < SRIO_DIN_BYTES; b++) {
-      uint8_t diff = s_din_cur[b] ^ s_din_prev[b];
-      if (!diff) continue;
-      
-      for (uint8_t bit = 0; bit < 8; bit++) {
-        if (diff & (1u << bit)) {
-          uint16_t phys = (uint16_t)(b * 8u + bit);
-          /* Active low: bit=0 means pressed, bit=1 means released */
-          uint8_t pressed = !(s_din_cur[b] & (1u << bit));
-          input_feed_button(phys, pressed);
-        }
-      }
-    }
+    (void)input_scan_din(s_din_cur, SRIO_DIN_BYTES, 1);
+    /* Without the DMA scan interrupt, decode encoders at the scan rate */
+    if (!s_srio_fast) input_enc_sample(s_din_cur, SRIO_DIN_BYTES, 1, s_input_ms);
 #endif
-    
-    /* Update previous state */
-    memcpy(s_din_prev, s_din_cur, SRIO_DIN_BYTES);
   }
+#if MODULE_ENABLE_INPUT
+  encoders_take();
+#endif
   
-  /* Write DOUT chain - s_dout_buf can be updated by other services */
-  srio_write_dout(s_dout_buf);
+  /* Write DOUT chain - s_dout_buf can be updated by other services. With
+   * BCM the scan takes its bitplanes, so on/off outputs go through them */
+  if (s_dout_bcm) {
+    dout_bcm_load_logical(s_dout_buf, SRIO_DOUT_BYTES);
+  } else {
+    srio_write_dout(s_dout_buf);
+  }
+#endif
+}
+
+#if MODULE_ENABLE_SRIO && defined(SRIO_ENABLE) && MODULE_ENABLE_INPUT
+#if SRIO_SCAN_DMA
+/**
+ * @brief SRIO scan complete (interrupt) - decode encoders at the scan rate
+ *
+ * Fast spins step through Gray-code states quicker than the 5 ms service
+ * tick; the steps accumulate until encoders_take() collects them.
+ */
+static void srio_scan_done_isr(void)
+{
+  uint8_t din[SRIO_DIN_BYTES];
+  for (uint16_t b = 0; b < SRIO_DIN_BYTES; b++) din[b] = srio_din_get(b);
+  input_enc_sample(din, SRIO_DIN_BYTES, 1, osKernelGetTickCount());
+}
 #endif
+
+/**
+ * @brief Hand decoded encoder steps on: UI encoders to the UI, NAV encoders
+ *        to patch navigation (banks with SHIFT)
+ */
+static void encoders_take(void)
+{
+  for (uint8_t e = 0; e < UI_MAX_ENCODERS; e++) {
+    int32_t delta = input_enc_take(e);
+    if (delta == 0) continue;
+    if (delta > 127) delta = 127;
+    if (delta < -127) delta = -127;
+    if (s_enc_cfg.enc_mode[e] == UI_ENC_MODE_UI) {
+      input_feed_encoder(e, (int8_t)delta);
+    } else {
+#if MODULE_ENABLE_PATCH
+      patch_nav_post(input_shift_active() ? PATCH_NAV_BANK : PATCH_NAV_PATCH, (int8_t)delta);
+#endif
+    }
+  }
 }
+#endif
 
 /**
  * @brief Input service tick - process button/encoder debouncing and timing
@@ -477,6 +721,10 @@ static void input_service_tick(uint32_t tick)
   s_input_ms++;
   input_tick(s_input_ms);
 #endif
+#if MODULE_ENABLE_UI && MODULE_ENABLE_UI_TASK
+  /* UI page actions change looper/LiveFX/config state owned by this task */
+  (void)ui_process_input();
+#endif
 }
 
 /* ============================================================================
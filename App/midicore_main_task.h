@@ -17,6 +17,7 @@
 #define MIDICORE_MAIN_TASK_H
 
 #include <stdint.h>
+#include "Config/module_config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +37,7 @@ extern "C" {
  * 
  * OPTIONAL TASKS (only if strictly justified):
  * - IO_Task: USB/MIDI buffering only (if needed for high-bandwidth I/O)
+ * - UiTask: page rendering + OLED flush below main priority (MODULE_ENABLE_UI_TASK)
  * - InitTask: One-time initialization, deletes itself after
  * 
  * REMOVED TASKS (logic moved to services):
@@ -75,10 +77,18 @@ extern "C" {
 #define MIDICORE_TICK_AIN           5     /* Every 5ms */
 
 /** SRIO scanning interval (fast for responsive buttons/LEDs) */
+#if SRIO_SCAN_DMA
+#define MIDICORE_TICK_SRIO          1     /* Every 1ms (DMA scan, non-blocking) */
+#else
 #define MIDICORE_TICK_SRIO          5     /* Every 5ms */
+#endif
 
 /** Pressure sensor reading interval */
+#if PRESSURE_ASYNC
+#define MIDICORE_TICK_PRESSURE      1     /* Every 1ms (state machine poll) */
+#else
 #define MIDICORE_TICK_PRESSURE      5     /* Every 5ms */
+#endif
 
 /** MIDI processing interval (matches USB MIDI frame rate) */
 #define MIDICORE_TICK_MIDI          1     /* Every 1ms */
@@ -92,6 +102,9 @@ extern "C" {
 /** CLI processing interval (lower priority) */
 #define MIDICORE_TICK_CLI           5     /* Every 5ms */
 
+/** Patch apply / chord reload left by PatchTask */
+#define MIDICORE_TICK_PATCH         5     /* Every 5ms */
+
 /** Stack monitor interval (periodic diagnostics) */
 #define MIDICORE_TICK_STACK_MON     5000  /* Every 5 seconds */
 
@@ -0,0 +1,30 @@
+#include "App/patch_task.h"
+#include "Config/module_config.h"
+#include "cmsis_os2.h"
+#include "Services/patch/patch_nav.h"
+
+#if MODULE_ENABLE_PATCH_TASK
+
+static void PatchTask(void* argument) {
+  (void)argument;
+  for (;;) {
+    (void)patch_nav_process(osWaitForever);
+  }
+}
+
+void app_start_patch_task(void) {
+  if (patch_nav_enable_worker() != 0) return;  // intents run in the caller
+
+  const osThreadAttr_t attr = {
+    .name = "PatchTask",
+    .priority = PATCH_TASK_PRIORITY,
+    .stack_size = PATCH_TASK_STACK_SIZE
+  };
+  (void)osThreadNew(PatchTask, NULL, &attr);
+}
+
+#else
+
+void app_start_patch_task(void) {}
+
+#endif
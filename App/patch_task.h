@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @brief PatchTask - patch/bank navigation worker
+ *
+ * Runs the navigation intents posted with patch_nav_post() (bank loads
+ * from SD, patch selection, the file reads of a patch apply), so input
+ * handling never waits on storage. Only the commit of the staged state and
+ * the header update are handed back to the main task
+ * (patch_nav_main_service). Only started when MODULE_ENABLE_PATCH_TASK=1;
+ * otherwise patch_nav_post() runs each intent in the caller.
+ */
+
+#define PATCH_TASK_STACK_SIZE  4096u  // patch_bank_t (~1.7 KB) + FatFS file object + parse lines
+#define PATCH_TASK_PRIORITY    osPriorityBelowNormal
+
+void app_start_patch_task(void);
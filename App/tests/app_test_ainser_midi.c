@@ -59,26 +59,34 @@ void app_test_ainser_midi_run_forever(void)
     (void)ainser_map_load_sd("0:/cfg/ainser_map.ngc");
   }
 
-  // Main loop: scan all 8 mux steps, 8 channels each.
+  // Main loop: scan all 8 mux steps, 8 channels each, on every module.
   for (;;)
   {
     for (uint8_t step = 0; step < 8; ++step)
     {
-      uint16_t vals[8];
-      if (hal_ainser64_read_bank_step(0u, step, vals) != 0)
+      uint16_t vals[AINSER64_NUM_MODULES][8];
+      for (uint8_t m = 0; m < AINSER64_NUM_MODULES; ++m)
+        hal_ainser64_set_next_step(m, (uint8_t)((step + 1u) & 7u));
+      if (hal_ainser64_read_step_all(step, vals) != 0)
       {
         // In case of SPI error, just skip this step and try again later.
         continue;
       }
 
-      for (uint8_t ch = 0; ch < 8; ++ch)
+      for (uint8_t m = 0; m < AINSER64_NUM_MODULES; ++m)
       {
-        uint8_t idx = (uint8_t)(step * 8u + ch); // 0..63
-        uint16_t v = vals[ch];
-        ainser_map_process_channel(idx, v);
+        for (uint8_t ch = 0; ch < 8; ++ch)
+        {
+          uint16_t idx = (uint16_t)(m * 64u + step * 8u + ch); // 64 per module
+          uint16_t v = vals[m][ch];
+          ainser_map_process_channel(idx, v);
+        }
       }
     }
 
+    // Flush values held back by the per-channel rate limit.
+    ainser_map_tick(osKernelGetTickCount());
+
     // Small delay to yield CPU, overall scan rate still high enough.
     osDelay(1);
   }
@@ -0,0 +1,42 @@
+#include "App/ui_task.h"
+#include "Config/module_config.h"
+#include "cmsis_os2.h"
+#include "Services/ui/ui.h"
+
+#if MODULE_ENABLE_UI_TASK
+
+static void UiTask(void* argument) {
+  (void)argument;
+  uint32_t next = osKernelGetTickCount();
+  for (;;) {
+    next += UI_TASK_FRAME_MS;
+
+    // Input is handled on the main task (ui_process_input)
+    (void)osDelayUntil(next);
+
+    ui_tick_20ms();
+
+    // A frame that overran (heavy page, long flush) must not cause a burst
+    // of catch-up frames: restart the cadence from now
+    if ((int32_t)(osKernelGetTickCount() - next) > (int32_t)UI_TASK_FRAME_MS) {
+      next = osKernelGetTickCount();
+    }
+  }
+}
+
+void app_start_ui_task(void) {
+  if (ui_enable_task_mode(UI_TASK_FRAME_MS) != 0) return;  // stay cooperative
+
+  const osThreadAttr_t attr = {
+    .name = "UiTask",
+    .priority = UI_TASK_PRIORITY,
+    .stack_size = UI_TASK_STACK_SIZE
+  };
+  (void)osThreadNew(UiTask, NULL, &attr);
+}
+
+#else
+
+void app_start_ui_task(void) {}
+
+#endif
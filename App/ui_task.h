@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @brief UiTask - UI rendering below the main task's priority
+ *
+ * Renders the current page every UI_TASK_FRAME_MS and flushes the OLED.
+ * Between frames it waits on the UI input queue, so button and encoder
+ * events are handled as soon as they arrive. Only started when
+ * MODULE_ENABLE_UI_TASK=1; otherwise the main task calls ui_tick_20ms().
+ */
+
+#define UI_TASK_FRAME_MS    20u
+#define UI_TASK_STACK_SIZE  3072u
+#define UI_TASK_PRIORITY    osPriorityBelowNormal
+
+void app_start_ui_task(void);
@@ -34,3 +34,51 @@ extern SPI_HandleTypeDef hspi3;
 #ifndef AIN_CS_Pin
 #define AIN_CS_Pin AIN_CS_PIN
 #endif
+
+// -----------------------------------------------------------------------------
+// Additional modules (AINSER64_NUM_MODULES > 1, see Config/module_config.h)
+// -----------------------------------------------------------------------------
+// Each module has its own RC line (MCP3208 CS + 74HC595 RCLK) and sits on one
+// of two SPI buses:
+//   AINSER64_BUS_SPI3 - the AINSER port J19 (SPI3, MIOS32_SPI2)
+//   AINSER64_BUS_SPI1 - the J16 port (SPI1, MIOS32_SPI0), shared with the SD
+//                       card under the "spi1" mutex
+// Modules on different buses are clocked in lockstep by the scan, so the
+// default 4 module layout (two per bus) reads a mux step in the time of two
+// modules.
+#define AINSER64_BUS_SPI3 0
+#define AINSER64_BUS_SPI1 1
+
+extern SPI_HandleTypeDef hspi1;
+
+#ifndef AIN_MOD0_BUS
+#define AIN_MOD0_BUS AINSER64_BUS_SPI3
+#endif
+
+// Module 1: J19 RC2 (MIOS32 default for the second AINSER64)
+#ifndef AIN_CS1_PORT
+#define AIN_CS1_PORT MIOS_SPI2_RC2_GPIO_Port
+#define AIN_CS1_PIN  MIOS_SPI2_RC2_Pin
+#endif
+#ifndef AIN_MOD1_BUS
+#define AIN_MOD1_BUS AINSER64_BUS_SPI3
+#endif
+
+// Module 2: J16 RC2
+#ifndef AIN_CS2_PORT
+#define AIN_CS2_PORT MIOS_SPI0_RC2_GPIO_Port
+#define AIN_CS2_PIN  MIOS_SPI0_RC2_Pin
+#endif
+#ifndef AIN_MOD2_BUS
+#define AIN_MOD2_BUS AINSER64_BUS_SPI1
+#endif
+
+// Module 3: J16 RC1. PB2 is the card detect input on boards that wire it
+// (Config/sd_pins.h); move this CS if yours does.
+#ifndef AIN_CS3_PORT
+#define AIN_CS3_PORT MIOS_SPI0_RC1_GPIO_Port
+#define AIN_CS3_PIN  MIOS_SPI0_RC1_Pin
+#endif
+#ifndef AIN_MOD3_BUS
+#define AIN_MOD3_BUS AINSER64_BUS_SPI1
+#endif
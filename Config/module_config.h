@@ -33,6 +33,11 @@ extern "C" {
 #define AINSER64_LED_MODE_PWM 1
 #endif
 
+/** @brief Number of AINSER64 modules, 1..4 (64 inputs each; CS and SPI bus per module in Config/ainser64_pins.h) */
+#ifndef AINSER64_NUM_MODULES
+#define AINSER64_NUM_MODULES 1
+#endif
+
 /** @brief Enable SRIO module (74HC165/595 shift register I/O) */
 #ifndef MODULE_ENABLE_SRIO
 #define MODULE_ENABLE_SRIO 1
@@ -46,6 +51,21 @@ extern "C" {
 #define SRIO_DOUT_LED_ACTIVE_LOW 1
 #endif
 
+/** @brief Timer driven DMA scan of the SRIO chains
+ * 1 = the TIM6 tick starts a full-duplex DMA transfer (DOUT out, DIN in)
+ *     every SRIO_SCAN_PERIOD_MS; srio_read_din()/srio_write_dout() only
+ *     copy from/to ping-pong buffers once srio_scan_start() has been called
+ * 0 = blocking HAL_SPI transfers from the caller (5 ms main task slot)
+ */
+#ifndef SRIO_SCAN_DMA
+#define SRIO_SCAN_DMA 1
+#endif
+
+/** @brief SRIO DMA scan period in milliseconds (TIM6 ticks) */
+#ifndef SRIO_SCAN_PERIOD_MS
+#define SRIO_SCAN_PERIOD_MS 1
+#endif
+
 /** @brief Enable SPI bus shared resource management */
 #ifndef MODULE_ENABLE_SPI_BUS
 #define MODULE_ENABLE_SPI_BUS 1
@@ -323,6 +343,26 @@ extern "C" {
 #define MODULE_ENABLE_AIN 1
 #endif
 
+/** @brief AIN scan budget: mux steps read per 5 ms tick, each on all modules (hot steps + 1 background, >= 2) */
+#ifndef AIN_SCAN_STEPS_PER_TICK
+#define AIN_SCAN_STEPS_PER_TICK 3
+#endif
+
+/** @brief AIN calibration DRIFT mode: each key's min/max move at most 1 ADC count per period (ms) */
+#ifndef AIN_CAL_DRIFT_PERIOD_MS
+#define AIN_CAL_DRIFT_PERIOD_MS 2000
+#endif
+
+/** @brief AIN calibration DRIFT mode: max distance (ADC counts) from the frozen table */
+#ifndef AIN_CAL_DRIFT_MAX
+#define AIN_CAL_DRIFT_MAX 64
+#endif
+
+/** @brief AIN calibration: smallest learned key travel (ADC counts) used for scaling */
+#ifndef AIN_CAL_MIN_SPAN
+#define AIN_CAL_MIN_SPAN 200
+#endif
+
 /** @brief Enable Looper service (MIDI recording/playback) */
 #ifndef MODULE_ENABLE_LOOPER
 #define MODULE_ENABLE_LOOPER 1
@@ -392,6 +432,24 @@ extern "C" {
 #define MODULE_ENABLE_PRESSURE 1
 #endif
 
+/** @brief Non-blocking pressure sensor driver
+ * 1 = the main task polls pressure_async_tick() every 1 ms: conversion
+ *     start, wait and data read run as interrupt driven I2C transfers
+ * 0 = blocking pressure_read_once() in the 5 ms main task slot
+ */
+#ifndef PRESSURE_ASYNC
+#define PRESSURE_ASYNC 1
+#endif
+
+/** @brief Oversampled pressure front end (needs PRESSURE_ASYNC)
+ * 1 = the latest sensor value is clocked into pressure_pipe at 1 kHz;
+ *     expression gets the CIC decimated stream, shake the band-passed one
+ * 0 = expression gets every sensor sample directly
+ */
+#ifndef PRESSURE_PIPE
+#define PRESSURE_PIPE 1
+#endif
+
 /** @brief Enable Velocity curve processing */
 #ifndef MODULE_ENABLE_VELOCITY
 #define MODULE_ENABLE_VELOCITY 1
@@ -607,6 +665,43 @@ extern "C" {
 #define PRODUCTION_MODE 1  // Default: Production mode (final hex compilation)
 #endif
 
+/** @brief Run the UI in its own low-priority task (UiTask)
+ * 
+ * When enabled (MODULE_ENABLE_UI_TASK=1):
+ * - ui_tick_20ms() and oled_flush() run in UiTask, below MidiCore_MainTask
+ * - Button/encoder events reach the UI through a queue
+ * - Page rendering can never delay MIDI I/O or looper_tick_1ms()
+ * 
+ * When disabled: MidiCore_MainTask calls ui_tick_20ms() every 20 ms.
+ * Test builds keep the cooperative path, module tests drive ui_tick_20ms().
+ */
+#ifndef MODULE_ENABLE_UI_TASK
+#if PRODUCTION_MODE && MODULE_ENABLE_UI
+#define MODULE_ENABLE_UI_TASK 1
+#else
+#define MODULE_ENABLE_UI_TASK 0
+#endif
+#endif
+
+/** @brief Run patch/bank navigation in its own worker task (PatchTask)
+ * 
+ * When enabled (MODULE_ENABLE_PATCH_TASK=1):
+ * - DIN bindings, NAV encoders and UI actions post navigation intents
+ * - PatchTask loads banks from SD and selects patches, merging bursts
+ *   (fast encoder scrolling) into one final load
+ * - The patch apply, chord bank reload and header update then run in the
+ *   main task (patch_nav_main_service), which owns router and UI state
+ * 
+ * When disabled: intents run immediately in the caller.
+ */
+#ifndef MODULE_ENABLE_PATCH_TASK
+#if PRODUCTION_MODE && MODULE_ENABLE_PATCH
+#define MODULE_ENABLE_PATCH_TASK 1
+#else
+#define MODULE_ENABLE_PATCH_TASK 0
+#endif
+#endif
+
 // =============================================================================
 // DEBUG/TEST MODULES (Automatically disabled in PRODUCTION_MODE)
 // =============================================================================
@@ -734,6 +829,10 @@ extern "C" {
 #error "AINSER64 module requires SPI_BUS module. Enable MODULE_ENABLE_SPI_BUS."
 #endif
 
+#if AINSER64_NUM_MODULES < 1 || AINSER64_NUM_MODULES > 4
+#error "AINSER64_NUM_MODULES must be 1..4."
+#endif
+
 #if MODULE_ENABLE_ROUTER && !MODULE_ENABLE_MIDI_DIN && !MODULE_ENABLE_USB_MIDI && !MODULE_ENABLE_USBH_MIDI
 #warning "ROUTER module enabled but no MIDI transport (DIN/USB) is enabled."
 #endif
@@ -31,3 +31,40 @@
 #define OLED_SDA_Pin       GPIO_PIN_11 // LCD_RW = Data
 
 // Note: No RST pin from STM32 (OLED module has on-board RC reset circuit)
+
+// ----------------------------------------------------------------------------
+// Hardware SPI + DMA transport (optional)
+// ----------------------------------------------------------------------------
+// OLED_SPI_HW_DMA=1 drives the panel from a hardware SPI peripheral and sends
+// each flush as a background TX DMA transfer. PC8/PC11 have no SPI function,
+// so this needs the panel's SCL/SDA wired to the SPI's SCK/MOSI pins; DC stays
+// on the GPIO above. The OLED has no CS line, so the SPI must be dedicated to
+// it: the transport sets the baud rate prescaler itself and never goes
+// through spibus. On this board SPI1 carries SD (and AINSER modules), SPI2
+// the SRIO chains and SPI3 AINSER, so there is no default: the board config
+// must define OLED_SPI_HANDLE (and declare its handle extern).
+//
+// The SPI handle must have a TX DMA stream linked (__HAL_LINKDMA) with its
+// IRQ enabled, and HAL_SPI_ErrorCallback must call oled_spi_error_isr() for
+// it (Core/Src/main.c does).
+//
+// Default 0: the bit-bang transport on the pins above (LoopA wiring).
+#ifndef OLED_SPI_HW_DMA
+#define OLED_SPI_HW_DMA 0
+#endif
+
+#if OLED_SPI_HW_DMA
+#ifndef OLED_SPI_HANDLE
+#error "OLED_SPI_HW_DMA needs OLED_SPI_HANDLE: a SPI dedicated to the OLED (SPI1/2/3 are shared here)"
+#endif
+// SSD1322 serial clock max is 10 MHz: 84 MHz / 16 = 5.25 MHz on an APB2 SPI
+// (use SPI_BAUDRATEPRESCALER_8 on APB1)
+#ifndef OLED_SPI_PRESCALER
+#define OLED_SPI_PRESCALER SPI_BAUDRATEPRESCALER_16
+#endif
+// oled_wait_idle() gives up on a flush after this long (a full frame takes
+// ~13 ms at 5.25 MHz)
+#ifndef OLED_DMA_TIMEOUT_MS
+#define OLED_DMA_TIMEOUT_MS 50u
+#endif
+#endif
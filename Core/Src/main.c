@@ -27,6 +27,8 @@
 #include "Config/module_config.h"  // MUST be first to define MODULE_ENABLE_* macros
 #include "App/app_entry.h"
 #include "Config/oled_pins.h"
+#include "Hal/oled_ssd1322/oled_ssd1322.h"
+#include "Services/srio/srio.h"
 
 #include "App/tests/test_debug.h"  // For TEST_DEBUG_UART_BAUD configuration
 #include "App/tests/app_test_din_midi.h"
@@ -950,6 +952,24 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
+/**
+  * @brief  SPI error callback, shared by the DMA users of the SPI buses
+  * @param  hspi : SPI handle
+  * @retval None
+  */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+#if MODULE_ENABLE_SRIO && SRIO_SCAN_DMA
+  srio_spi_error_isr(hspi);
+#endif
+#if MODULE_ENABLE_OLED && OLED_SPI_HW_DMA
+  if (hspi == OLED_SPI_HANDLE)
+  {
+    oled_spi_error_isr();
+  }
+#endif
+}
 
 /* USER CODE END 4 */
 
@@ -1048,7 +1068,12 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+#if MODULE_ENABLE_SRIO && SRIO_SCAN_DMA
+  if (htim->Instance == TIM6)
+  {
+    srio_scan_timer_isr();
+  }
+#endif
   /* USER CODE END Callback 1 */
 }
 
@@ -6,7 +6,8 @@
 #include <string.h>
 
 #include "Hal/spi_bus.h"
-#include "Config/ainser64_pins.h" // AIN_CS_* used by SPIBUS_DEV_AIN
+#include "Config/ainser64_pins.h" // AIN_CS_* used by SPIBUS_DEV_AIN*
+#include "Config/module_config.h"  // AINSER64_NUM_MODULES
 
 // Include main.h for portable STM32 HAL (F4/F7/H7 compatibility)
 #include "main.h"
@@ -25,48 +26,73 @@ static uint8_t g_mux_port_map[8];
 static uint8_t g_link_led_enable = 1;
 static uint16_t g_link_status_ctr = 0;
 
-// This project currently supports a single AINSER64 module on a single CS line.
-// Keeping the "module" parameter in the API allows later extension.
-static inline int module_supported(uint8_t module) { return module == 0; }
+// Per module: mux address latched in the 74HC595 by the last CS rising edge,
+// and the one to load on the last channel of the next read (0xFF = unknown /
+// none). Each conversion samples with the mux latched *before* its transfer.
+static uint8_t g_latched_mux[AINSER64_NUM_MODULES];
+static uint8_t g_next_mux[AINSER64_NUM_MODULES];
+
+// Scan rounds: each round holds at most one module per SPI bus, so its
+// modules are clocked in lockstep (spibus_txrx_lockstep). The SPI1 module
+// comes first: buses are always acquired spi1 -> spi3.
+static uint8_t g_round_mod[AINSER64_NUM_MODULES][2];
+static uint8_t g_round_n[AINSER64_NUM_MODULES];
+static uint8_t g_num_rounds;
+
+static inline int module_supported(uint8_t module) { return module < AINSER64_NUM_MODULES; }
+
+static inline spibus_dev_t module_dev(uint8_t module) {
+  return (spibus_dev_t)(SPIBUS_DEV_AIN + module);
+}
 
 // -----------------------------------------------------------------------------
 // Helpers
 // -----------------------------------------------------------------------------
 
 // MCP3208 transaction (3 bytes) + 74HC595 update byte in the 3rd byte.
-// Returns 12-bit sample in *out.
-static int32_t mcp3208_read_channel_with_sr(uint8_t channel, uint8_t sr_byte, uint16_t *out)
+static inline void mcp3208_cmd(uint8_t channel, uint8_t sr_byte, uint8_t tx[3])
 {
   // MCP3208 command format (single-ended):
   // b0: 0b00000110 | (channel >> 2)
   // b1: (channel << 6)
   // b2: don't care for MCP, but is used as 74HC595 data (via MOSI)
-  uint8_t tx[3];
-  uint8_t rx[3];
-
   tx[0] = (uint8_t)(0x06 | (channel >> 2));
   tx[1] = (uint8_t)(channel << 6);
   tx[2] = sr_byte;
+}
+
+// 12-bit sample: low 4 bits in rx[1], then rx[2]
+static inline uint16_t mcp3208_sample(const uint8_t rx[3])
+{
+  return (uint16_t)(((rx[1] & 0x0Fu) << 8) | rx[2]);
+}
+
+// MCP3208 tCSH: CS high for >= 500 ns between conversions (~84 cycles at
+// 168 MHz). With the bus held for the whole step nothing else fills the gap.
+static inline void cs_high_time(void)
+{
+  for (volatile uint8_t i = 0; i < 16u; ++i) {
+  }
+}
 
+// One conversion on every module of a group (buses already acquired)
+static int32_t group_conversion(const spibus_dev_t* devs, uint8_t n,
+                                const uint8_t* const* tx, uint8_t* const* rx)
+{
   // IMPORTANT (AINSER64 wiring): RC (chip-select) is shared between
   // - MCP3208 CS (pin 10)
   // - 74HC595 RCLK (pin 12)
   // So we MUST assert CS low for the transfer, then deassert it high so that
   // the 74HC595 latches the last shifted byte (sr_byte).
-  if (spibus_begin(SPIBUS_DEV_AIN) != HAL_OK)
-    return -1;
+  for (uint8_t i = 0; i < n; ++i) spibus_select(devs[i], 1);
 
-  HAL_StatusTypeDef st = spibus_txrx(SPIBUS_DEV_AIN, tx, rx, 3, 10);
+  HAL_StatusTypeDef st = spibus_txrx_lockstep(devs, n, tx, rx, 3, 10);
 
   // CS rising edge latches 74HC595 outputs (Link LED + MUX A/B/C)
-  (void)spibus_end(SPIBUS_DEV_AIN);
+  for (uint8_t i = 0; i < n; ++i) spibus_select(devs[i], 0);
+  cs_high_time();
 
-  if (st != HAL_OK)
-    return -1;
-
-  // 12-bit sample: low 4 bits in rx[1], then rx[2]
-  *out = (uint16_t)(((rx[1] & 0x0Fu) << 8) | rx[2]);
-  return 0;
+  return (st == HAL_OK) ? 0 : -1;
 }
 
 static inline uint8_t compute_link_led_bit(void)
@@ -108,6 +134,64 @@ static inline uint8_t compute_link_led_bit(void)
 #endif
 }
 
+// Read one mux step of up to two modules on different buses.
+// MIOS32: mux control value goes in bits 7..5 of the 74HC595 byte.
+// LSB is the LINK LED (link_bit). We keep other bits 0. The bus
+// mutexes are taken once for the whole step (9 conversions), not per
+// conversion.
+static int32_t read_group_step(const uint8_t* mods, uint8_t n, uint8_t step,
+                               uint8_t link_bit, uint16_t* const* out8)
+{
+  spibus_dev_t devs[2];
+  uint8_t tx[2][3], rx[2][3];
+  const uint8_t* txp[2] = { tx[0], tx[1] };
+  uint8_t* rxp[2] = { rx[0], rx[1] };
+  uint8_t next[2];
+  uint8_t settle = 0;
+
+  // If you want strict MIOS32-style port order, the mux control that must be
+  // shifted is the *physical* mux address. The mapping array is used later to
+  // map results to pin numbers. Here we keep it simple: mux_ctr == step.
+  uint8_t mux_ctr = step;
+
+  for (uint8_t i = 0; i < n; ++i) {
+    uint8_t m = mods[i];
+    devs[i] = module_dev(m);
+    next[i] = (g_next_mux[m] != 0xFFu) ? g_next_mux[m] : mux_ctr;
+    g_next_mux[m] = 0xFFu;
+    // Mux not on this step yet: one conversion just to latch the address
+    if (g_latched_mux[m] != mux_ctr) settle = 1;
+  }
+
+  uint8_t acquired = 0;
+  for (; acquired < n; ++acquired) {
+    if (spibus_acquire(devs[acquired]) != HAL_OK) break;
+  }
+
+  int32_t rc = (acquired == n) ? 0 : -1;
+  for (uint8_t c = settle ? 0u : 1u; rc == 0 && c < 9u; ++c) {
+    // c == 0: settle conversion; c = 1..8: channels 0..7. Channel 7
+    // preloads the next step's mux address (MidiCore behaviour).
+    uint8_t ch = c ? (uint8_t)(c - 1u) : 0u;
+    for (uint8_t i = 0; i < n; ++i) {
+      uint8_t mux = (ch == 7u) ? next[i] : mux_ctr;
+      mcp3208_cmd(ch, (uint8_t)((mux << 5) | (link_bit & 1u)), tx[i]);
+    }
+    if (group_conversion(devs, n, txp, rxp) != 0) {
+      rc = -4;
+      break;
+    }
+    if (c) {
+      for (uint8_t i = 0; i < n; ++i) out8[i][ch] = mcp3208_sample(rx[i]);
+    }
+  }
+
+  while (acquired) spibus_release(devs[--acquired]);
+
+  for (uint8_t i = 0; i < n; ++i) g_latched_mux[mods[i]] = (rc == 0) ? next[i] : 0xFFu;
+  return rc;
+}
+
 // -----------------------------------------------------------------------------
 // Public API
 // -----------------------------------------------------------------------------
@@ -117,6 +201,22 @@ int32_t hal_ainser64_init(void)
   memcpy(g_mux_port_map, k_default_mux_port_map, sizeof(g_mux_port_map));
   g_link_led_enable = 1;
   g_link_status_ctr = 0;
+  memset(g_latched_mux, 0xFF, sizeof(g_latched_mux));
+  memset(g_next_mux, 0xFF, sizeof(g_next_mux));
+
+  // Pair modules across the two buses: round r = r-th module of each bus
+  uint8_t spi1[AINSER64_NUM_MODULES], spi3[AINSER64_NUM_MODULES];
+  uint8_t n1 = 0, n3 = 0;
+  for (uint8_t m = 0; m < AINSER64_NUM_MODULES; ++m) {
+    if (spibus_same_bus(module_dev(m), SPIBUS_DEV_SD)) spi1[n1++] = m;
+    else spi3[n3++] = m;
+  }
+  g_num_rounds = (n1 > n3) ? n1 : n3;
+  for (uint8_t r = 0; r < g_num_rounds; ++r) {
+    g_round_n[r] = 0;
+    if (r < n1) g_round_mod[r][g_round_n[r]++] = spi1[r];
+    if (r < n3) g_round_mod[r][g_round_n[r]++] = spi3[r];
+  }
 
   // SPI bus init is handled by the app (see app_init.c).
   return 0;
@@ -127,6 +227,13 @@ void hal_ainser64_set_link_led_enable(uint8_t enable)
   g_link_led_enable = enable ? 1 : 0;
 }
 
+void hal_ainser64_set_next_step(uint8_t module, uint8_t step)
+{
+  if (!module_supported(module))
+    return;
+  g_next_mux[module] = (uint8_t)(step & 0x7u);
+}
+
 void hal_ainser64_set_mux_port_map(const uint8_t map[8])
 {
   if (!map) {
@@ -143,29 +250,23 @@ int32_t hal_ainser64_read_bank_step(uint8_t module, uint8_t step, uint16_t out8[
   if (!module_supported(module))
     return -2;
 
-  step &= 0x7u;
-
-  // MIOS32: mux control value goes in bits 7..5 of the 74HC595 byte.
-  // LSB is the LINK LED.
-  // We keep other bits 0.
-  uint8_t link_bit = compute_link_led_bit();
-
-  // If you want strict MIOS32-style port order, the mux control that must be
-  // shifted is the *physical* mux address. The mapping array is used later to
-  // map results to pin numbers. Here we keep it simple: mux_ctr == step.
-  uint8_t mux_ctr = step;
+  uint16_t* out[1] = { out8 };
+  return read_group_step(&module, 1, (uint8_t)(step & 0x7u), compute_link_led_bit(), out);
+}
 
-  for (uint8_t ch = 0; ch < 8; ++ch) {
-    // For best behaviour we can preload the next mux ctr at the end of the scan
-    // (MidiCore does this on channel 7). Here we keep mux constant for this call.
-    uint8_t sr_byte = (uint8_t)((mux_ctr << 5) | (link_bit & 1u));
+int32_t hal_ainser64_read_step_all(uint8_t step, uint16_t (*out)[8])
+{
+  if (!out)
+    return -1;
 
-    uint16_t sample = 0;
-    if (mcp3208_read_channel_with_sr(ch, sr_byte, &sample) != 0) {
-      return -4;
-    }
-    out8[ch] = sample;
+  step &= 0x7u;
+  uint8_t link_bit = compute_link_led_bit();
+  int32_t rc = 0;
+  for (uint8_t r = 0; r < g_num_rounds; ++r) {
+    uint16_t* dst[2];
+    for (uint8_t i = 0; i < g_round_n[r]; ++i) dst[i] = out[g_round_mod[r][i]];
+    // Keep going on error: the other rounds' modules are still valid
+    if (read_group_step(g_round_mod[r], g_round_n[r], step, link_bit, dst) != 0) rc = -4;
   }
-  
-  return 0;
+  return rc;
 }
@@ -23,7 +23,8 @@ extern "C" {
 int32_t hal_ainser64_init(void);
 
 // Read one mux step (0..7) for the given module/bank.
-// - module/bank: currently only 0 is supported in this project (single CS line).
+// - module/bank: 0..AINSER64_NUM_MODULES-1 (Config/module_config.h); each
+//   module has its own CS line and SPI bus (Config/ainser64_pins.h).
 // - step: 0..7 (mux address)
 // - out8: receives 8 raw 12-bit values (0..4095), one per MCP3208 channel.
 // 
@@ -35,6 +36,24 @@ int32_t hal_ainser64_init(void);
 // Returns 0 on success.
 int32_t hal_ainser64_read_bank_step(uint8_t module, uint8_t step, uint16_t out8[8]);
 
+// Read one mux step (0..7) of every module: out[m] receives module m's 8
+// samples, so out needs AINSER64_NUM_MODULES rows. Modules on different SPI
+// buses are converted in lockstep, modules sharing a bus one after the
+// other; the bus mutex is held once per module step, not per conversion.
+// Bus time per call is ceil(modules / buses used) single-module steps (8
+// conversions, +1 settle if the mux was not preloaded): 4 modules on two
+// buses take 2x one module.
+// Returns 0 on success, -4 if a transfer failed (other modules still read).
+int32_t hal_ainser64_read_step_all(uint8_t step, uint16_t (*out)[8]);
+
+// Optional: tell the next read of this module (read_bank_step() or
+// read_step_all()) which step follows this one.
+// The last conversion of the current read then loads that mux address (as
+// MidiCore does on channel 7), so the next read needs no settle conversion.
+// Without a hint, or if the hint is wrong, read_bank_step() first performs
+// one extra conversion to switch the mux. One-shot: cleared by each read.
+void hal_ainser64_set_next_step(uint8_t module, uint8_t step);
+
 // Optional: enable/disable LINK LED modulation (default: enabled).
 // The LED uses MIOS32-style PWM breathing effect that requires continuous scanning.
 void hal_ainser64_set_link_led_enable(uint8_t enable);
@@ -38,3 +38,136 @@ int i2c_hal_probe(uint8_t bus, uint8_t addr7, uint32_t timeout_ms){
   if (HAL_I2C_IsDeviceReady(h, (uint16_t)(addr7<<1), 2, timeout_ms) != HAL_OK) return -2;
   return 0;
 }
+
+/////////////////////////////////////////////////////////////////////////////
+// Interrupt driven transfers
+/////////////////////////////////////////////////////////////////////////////
+
+enum { IT_IDLE = 0, IT_BUSY, IT_ERROR };
+
+static volatile uint8_t s_it_state[2];
+static volatile uint32_t s_done_cyc[2];
+static uint8_t s_irq_on[2];
+
+static int bus_index(I2C_HandleTypeDef* h){ return (h == &hi2c1) ? 0 : 1; }
+
+static void enable_irq(int i){
+  if (s_irq_on[i]) return;
+  IRQn_Type ev = i ? I2C2_EV_IRQn : I2C1_EV_IRQn;
+  IRQn_Type er = i ? I2C2_ER_IRQn : I2C1_ER_IRQn;
+  HAL_NVIC_SetPriority(ev, 5, 0);
+  HAL_NVIC_EnableIRQ(ev);
+  HAL_NVIC_SetPriority(er, 5, 0);
+  HAL_NVIC_EnableIRQ(er);
+  s_irq_on[i] = 1;
+}
+
+int i2c_hal_read_it(uint8_t bus, uint8_t addr7, uint8_t reg, uint8_t* data, uint16_t len){
+  I2C_HandleTypeDef* h = pick(bus);
+  if(!h || !data || len==0) return -1;
+  int i = bus_index(h);
+  enable_irq(i);
+  s_it_state[i] = IT_BUSY;
+  if (HAL_I2C_Mem_Read_IT(h, (uint16_t)(addr7<<1), reg, I2C_MEMADD_SIZE_8BIT, data, len) != HAL_OK) {
+    s_it_state[i] = IT_IDLE;
+    return -2;
+  }
+  return 0;
+}
+
+int i2c_hal_write_it(uint8_t bus, uint8_t addr7, uint8_t reg, const uint8_t* data, uint16_t len){
+  I2C_HandleTypeDef* h = pick(bus);
+  if(!h || !data || len==0) return -1;
+  int i = bus_index(h);
+  enable_irq(i);
+  s_it_state[i] = IT_BUSY;
+  if (HAL_I2C_Mem_Write_IT(h, (uint16_t)(addr7<<1), reg, I2C_MEMADD_SIZE_8BIT, (uint8_t*)data, len) != HAL_OK) {
+    s_it_state[i] = IT_IDLE;
+    return -2;
+  }
+  return 0;
+}
+
+int i2c_hal_poll(uint8_t bus){
+  I2C_HandleTypeDef* h = pick(bus);
+  if(!h) return -1;
+  switch (s_it_state[bus_index(h)]) {
+    case IT_BUSY:  return 1;
+    case IT_ERROR: return -2;
+    default:       return 0;
+  }
+}
+
+uint32_t i2c_hal_done_cycles(uint8_t bus){
+  I2C_HandleTypeDef* h = pick(bus);
+  return h ? s_done_cyc[bus_index(h)] : 0;
+}
+
+static void it_done(I2C_HandleTypeDef* hi2c){
+  int i = bus_index(hi2c);
+  s_done_cyc[i] = DWT->CYCCNT;
+  s_it_state[i] = IT_IDLE;
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c){ it_done(hi2c); }
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c){ it_done(hi2c); }
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c){ s_it_state[bus_index(hi2c)] = IT_ERROR; }
+
+void I2C1_EV_IRQHandler(void){ HAL_I2C_EV_IRQHandler(&hi2c1); }
+void I2C1_ER_IRQHandler(void){ HAL_I2C_ER_IRQHandler(&hi2c1); }
+void I2C2_EV_IRQHandler(void){ HAL_I2C_EV_IRQHandler(&hi2c2); }
+void I2C2_ER_IRQHandler(void){ HAL_I2C_ER_IRQHandler(&hi2c2); }
+
+/////////////////////////////////////////////////////////////////////////////
+// Bus recovery (pins as in HAL_I2C_MspInit: I2C1 PB6/PB9, I2C2 PB10/PB11)
+/////////////////////////////////////////////////////////////////////////////
+
+// ~5 us at 168 MHz: half a 100 kHz SCL period
+static void half_bit(void){ for (volatile uint32_t n = 0; n < 200u; n++) { } }
+
+int i2c_hal_recover(uint8_t bus){
+  I2C_HandleTypeDef* h = pick(bus);
+  if(!h) return -1;
+  int i = bus_index(h);
+  uint16_t scl = i ? GPIO_PIN_10 : GPIO_PIN_6;
+  uint16_t sda = i ? GPIO_PIN_11 : GPIO_PIN_9;
+
+  HAL_NVIC_DisableIRQ(i ? I2C2_EV_IRQn : I2C1_EV_IRQn);
+  HAL_NVIC_DisableIRQ(i ? I2C2_ER_IRQn : I2C1_ER_IRQn);
+  s_irq_on[i] = 0;
+  (void)HAL_I2C_DeInit(h);
+
+  // Both lines as open-drain outputs, released (high)
+  GPIO_InitTypeDef g = {0};
+  g.Pin = scl | sda;
+  g.Mode = GPIO_MODE_OUTPUT_OD;
+  g.Pull = GPIO_PULLUP;
+  g.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_WritePin(GPIOB, scl | sda, GPIO_PIN_SET);
+  HAL_GPIO_Init(GPIOB, &g);
+  half_bit();
+
+  // A slave stuck mid-byte lets go of SDA within 9 clocks
+  for (int n = 0; n < 9 && HAL_GPIO_ReadPin(GPIOB, sda) == GPIO_PIN_RESET; n++) {
+    HAL_GPIO_WritePin(GPIOB, scl, GPIO_PIN_RESET);
+    half_bit();
+    HAL_GPIO_WritePin(GPIOB, scl, GPIO_PIN_SET);
+    half_bit();
+  }
+
+  // STOP: SDA rises while SCL is high
+  HAL_GPIO_WritePin(GPIOB, scl, GPIO_PIN_RESET);
+  half_bit();
+  HAL_GPIO_WritePin(GPIOB, sda, GPIO_PIN_RESET);
+  half_bit();
+  HAL_GPIO_WritePin(GPIOB, scl, GPIO_PIN_SET);
+  half_bit();
+  HAL_GPIO_WritePin(GPIOB, sda, GPIO_PIN_SET);
+  half_bit();
+  int free = (HAL_GPIO_ReadPin(GPIOB, sda) == GPIO_PIN_SET);
+
+  HAL_GPIO_DeInit(GPIOB, scl | sda);
+  (void)HAL_I2C_Init(h);  // MspInit restores the alternate function
+  s_it_state[i] = IT_IDLE;
+  return free ? 0 : -2;
+}
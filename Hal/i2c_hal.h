@@ -10,6 +10,25 @@ int i2c_hal_probe(uint8_t bus, uint8_t addr7, uint32_t timeout_ms);
 
 int i2c_hal_write(uint8_t bus, uint8_t addr7, uint8_t reg, const uint8_t* data, uint16_t len, uint32_t timeout_ms);
 
+// Non-blocking register transfers (interrupt driven, one per bus at a time).
+// data must stay valid until i2c_hal_poll() stops returning 1.
+// Start: 0 on success, -1 bad bus/args, -2 if the HAL refuses (bus busy).
+int i2c_hal_read_it(uint8_t bus, uint8_t addr7, uint8_t reg, uint8_t* data, uint16_t len);
+int i2c_hal_write_it(uint8_t bus, uint8_t addr7, uint8_t reg, const uint8_t* data, uint16_t len);
+
+// 1 while the transfer runs, 0 once it completed (or none was started),
+// -2 if it failed (NACK, arbitration lost, bus error).
+int i2c_hal_poll(uint8_t bus);
+
+// DWT cycle count taken in the interrupt that completed the last transfer
+// on the bus (the counter runs once pressure_async_init() enabled it).
+uint32_t i2c_hal_done_cycles(uint8_t bus);
+
+// Bus recovery for a slave holding SDA low: releases the peripheral, clocks
+// SCL until SDA is free (up to 9 pulses), sends a STOP and reinitializes.
+// Aborts a transfer in flight. 0 if SDA is released, -1 bad bus, -2 stuck.
+int i2c_hal_recover(uint8_t bus);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,71 @@
+#include "Hal/oled_ssd1322/oled_dirty.h"
+#include <string.h>
+
+static uint32_t window_bytes(uint8_t row0, uint8_t row1, uint8_t col0, uint8_t col1) {
+  return (uint32_t)(row1 - row0 + 1u) * (uint32_t)(col1 - col0 + 1u) * 2u;
+}
+
+uint8_t oled_dirty_scan(const uint8_t* fb, uint8_t* shadow, uint8_t full, oled_window_t* win) {
+  if (!fb || !shadow || !win) return 0;
+
+  if (full) {
+    memcpy(shadow, fb, OLED_DIRTY_ROWS * OLED_DIRTY_ROW_BYTES);
+    win[0].row0 = 0;
+    win[0].row1 = (uint8_t)(OLED_DIRTY_ROWS - 1u);
+    win[0].col0 = 0;
+    win[0].col1 = (uint8_t)(OLED_DIRTY_COLS - 1u);
+    return 1;
+  }
+
+  uint8_t n = 0;
+  for (uint8_t row = 0; row < OLED_DIRTY_ROWS; row++) {
+    const uint8_t* a = &fb[(uint32_t)row * OLED_DIRTY_ROW_BYTES];
+    uint8_t* b = &shadow[(uint32_t)row * OLED_DIRTY_ROW_BYTES];
+    if (memcmp(a, b, OLED_DIRTY_ROW_BYTES) == 0) continue;
+
+    // First/last changed byte -> SSD1322 column units (2 bytes each)
+    uint8_t first = 0;
+    while (a[first] == b[first]) first++;
+    uint8_t last = (uint8_t)(OLED_DIRTY_ROW_BYTES - 1u);
+    while (a[last] == b[last]) last--;
+    uint8_t c0 = (uint8_t)(first >> 1);
+    uint8_t c1 = (uint8_t)(last >> 1);
+
+    memcpy(b, a, OLED_DIRTY_ROW_BYTES);
+
+    // Extend the previous window down by one row if widening it is cheaper
+    // than the command overhead of a new window. Bytes pulled in by widening
+    // are unchanged, so re-sending them is harmless.
+    if (n) {
+      oled_window_t* w = &win[n - 1u];
+      if (w->row1 + 1u == row) {
+        uint8_t u0 = (c0 < w->col0) ? c0 : w->col0;
+        uint8_t u1 = (c1 > w->col1) ? c1 : w->col1;
+        uint32_t merged = window_bytes(w->row0, row, u0, u1);
+        uint32_t split = window_bytes(w->row0, w->row1, w->col0, w->col1) +
+                         window_bytes(row, row, c0, c1) + OLED_DIRTY_WINDOW_CMD_BYTES;
+        if (merged <= split) {
+          w->row1 = row;
+          w->col0 = u0;
+          w->col1 = u1;
+          continue;
+        }
+      }
+    }
+
+    win[n].row0 = row;
+    win[n].row1 = row;
+    win[n].col0 = c0;
+    win[n].col1 = c1;
+    n++;
+  }
+  return n;
+}
+
+uint32_t oled_dirty_data_bytes(const oled_window_t* win, uint8_t n) {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    total += window_bytes(win[i].row0, win[i].row1, win[i].col0, win[i].col1);
+  }
+  return total;
+}
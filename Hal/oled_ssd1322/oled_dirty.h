@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// SSD1322 dirty-window planner
+// ============================================================================
+// Compares the framebuffer against a shadow copy of what the panel already
+// shows and produces the smallest set of row/column address windows that
+// cover every changed byte. Pure C, no HAL dependency (host-testable).
+//
+// Framebuffer layout: 64 rows x 128 bytes (256 px, 4-bit grey, 2 px/byte).
+// SSD1322 column addresses are in units of 4 pixels = 2 framebuffer bytes.
+
+#define OLED_DIRTY_ROWS        64u
+#define OLED_DIRTY_ROW_BYTES   128u
+#define OLED_DIRTY_COLS        (OLED_DIRTY_ROW_BYTES / 2u)  // 64 column units per row
+
+// Command bytes needed to open one window: 0x15 c0 c1, 0x75 r0 r1, 0x5C
+#define OLED_DIRTY_WINDOW_CMD_BYTES 7u
+
+typedef struct {
+  uint8_t row0, row1;  // inclusive row range (0..63)
+  uint8_t col0, col1;  // inclusive column units (0..63), 2 bytes each
+} oled_window_t;
+
+/**
+ * @brief Find changed regions and bring the shadow up to date
+ * @param fb Current framebuffer (OLED_DIRTY_ROWS * OLED_DIRTY_ROW_BYTES)
+ * @param shadow Copy of the panel contents, updated in place
+ * @param full 1 = shadow unknown (after init/direct GDDRAM writes): emit one full window
+ * @param win Output windows, at least OLED_DIRTY_ROWS entries
+ * @return Number of windows (0 = nothing to send)
+ *
+ * Adjacent dirty rows are merged into one window when widening the column
+ * range costs fewer data bytes than opening a new window.
+ */
+uint8_t oled_dirty_scan(const uint8_t* fb, uint8_t* shadow, uint8_t full, oled_window_t* win);
+
+/** Data bytes the windows will transfer (excludes command bytes). */
+uint32_t oled_dirty_data_bytes(const oled_window_t* win, uint8_t n);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,15 +1,70 @@
 #include "Hal/oled_ssd1322/oled_ssd1322.h"
+#include "Hal/oled_ssd1322/oled_dirty.h"
 #include "Config/oled_pins.h"
 #include "Hal/delay_us.h"
 #include "main.h"
 #include <string.h>
 
-// Framebuffer: flat array compatible with MidiCore UI (256×64 pixels, 4-bit grayscale)
-// Size: OLED_W * OLED_H / 2 = 256 * 64 / 2 = 8192 bytes (8 KB)
+// Double-buffered framebuffer, flat layout compatible with MidiCore UI
+// (256×64 pixels, 4-bit grayscale)
+// Size: OLED_W * OLED_H / 2 = 256 * 64 / 2 = 8192 bytes (8 KB) each
 // Layout: 64 rows × 128 bytes per row (each byte = 2 pixels)
-// Placed in CCMRAM for fast access and to free regular RAM
-// CCMRAM allocation: g_tr(17KB) + OLED_fb(8KB) + active(24KB) = 49KB / 64KB ✅
+//
+// fb (back):     render target returned by oled_framebuffer()
+// fb_front:      last published frame = what the panel GDDRAM shows.
+//                oled_flush() diffs fb against it, copies the changed rows
+//                across and sends them from fb_front, so the transfer never
+//                reads the buffer the UI is drawing into.
+//                Invalid after anything writes GDDRAM directly (init, test patterns).
+//
+// CCMRAM budget (64KB = 65536 B, sizes from the object files): g_tr 24736 +
+// g_automation 4144 + fb 8192 + fb_front 8192 = 45264 B; test builds add the
+// depth-2 undo stacks (16560 B) for 61824 B.
+// With OLED_SPI_HW_DMA the changed windows are packed into s_tx (SRAM, DMA
+// cannot read CCMRAM) and sent from there.
 static uint8_t fb[OLED_W * OLED_H / 2] __attribute__((section(".ccmram")));
+static uint8_t fb_front[OLED_W * OLED_H / 2] __attribute__((section(".ccmram")));
+static uint8_t s_front_valid = 0;
+static oled_window_t s_win[OLED_DIRTY_ROWS];
+static oled_flush_stats_t s_stats;
+static void (*s_flush_cb)(void) = 0;
+
+#if OLED_SPI_HW_DMA
+// Current transfer: the window pixels back to back, and the address
+// commands of each window (0x15 c0 c1, 0x75 r0 r1, 0x5C)
+static uint8_t s_tx[OLED_W * OLED_H / 2];
+static uint8_t s_cmd[OLED_DIRTY_ROWS * OLED_DIRTY_WINDOW_CMD_BYTES];
+static uint8_t s_restore_cmd[6] = { 0x15, 0x1C, 0x5B, 0x75, 0x00, 0x3F };
+static volatile uint8_t s_dma_busy = 0;
+static uint8_t s_dma_n = 0;       // windows in the current transfer
+static uint8_t s_dma_idx = 0;     // current window, s_dma_n = full-screen restore
+static uint8_t s_dma_step = 0;    // next piece of the current window
+static uint16_t s_dma_pix = 0;    // current window's pixels in s_tx
+#endif
+
+#if OLED_SPI_HW_DMA
+
+// Hardware SPI transport: init and test code write bytes by polling, every
+// byte waiting for BSY to clear so DC can be changed right after it.
+// oled_flush() sends everything, address commands included, through TX DMA.
+static inline void spi_write_byte(uint8_t byte) {
+  SPI_TypeDef* spi = OLED_SPI_HANDLE->Instance;
+  while (!(spi->SR & SPI_SR_TXE)) {}
+  *(volatile uint8_t*)&spi->DR = byte;
+  while (!(spi->SR & SPI_SR_TXE)) {}
+  while (spi->SR & SPI_SR_BSY) {}
+}
+
+// Put the bus in its idle state before the init sequence
+static void lines_idle(void) {
+  SPI_HandleTypeDef* h = OLED_SPI_HANDLE;
+  __HAL_SPI_DISABLE(h);
+  MODIFY_REG(h->Instance->CR1, SPI_CR1_BR, OLED_SPI_PRESCALER);
+  __HAL_SPI_ENABLE(h);
+  HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, GPIO_PIN_SET);      // DC high (defaults to data mode)
+}
+
+#else // bit-bang transport
 
 // Software SPI bit-bang implementation (MidiCore compatible)
 // CS is hardwired to GND, so no CS control needed
@@ -82,6 +137,16 @@ static inline void spi_write_byte(uint8_t byte) {
   SCL_LOW();
 }
 
+// Set initial SPI lines states for Mode 0 (CPOL=0, CPHA=0):
+// CRITICAL: MidiCore uses SPI Mode 0, clock must idle LOW (not HIGH)
+static void lines_idle(void) {
+  SCL_LOW();  // clock idle low (required for Mode 0)
+  HAL_GPIO_WritePin(OLED_SDA_GPIO_Port, OLED_SDA_Pin, GPIO_PIN_RESET);  // data line low
+  HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, GPIO_PIN_SET);      // DC high (defaults to data mode)
+}
+
+#endif // OLED_SPI_HW_DMA
+
 // Send command (DC=0) byte
 static void cmd(uint8_t c) {
   HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, GPIO_PIN_RESET);  // DC=0 (command mode)
@@ -111,11 +176,8 @@ void oled_init_progressive(uint8_t max_step) {
   DWT->CYCCNT = 0;
   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
-  // Set initial SPI lines states for Mode 0 (CPOL=0, CPHA=0):
-  // CRITICAL: MidiCore uses SPI Mode 0, clock must idle LOW (not HIGH)
-  SCL_LOW();  // clock idle low (required for Mode 0)
-  HAL_GPIO_WritePin(OLED_SDA_GPIO_Port, OLED_SDA_Pin, GPIO_PIN_RESET);  // data line low
-  HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, GPIO_PIN_SET);      // DC high (defaults to data mode)
+  // Set initial SPI lines states for Mode 0 (CPOL=0, CPHA=0)
+  lines_idle();
 
   // Delay to allow OLED power supply to stabilize (min 100 ms, using 300 ms for safety)
   for (uint16_t ctr = 0; ctr < 300; ++ctr) {
@@ -272,6 +334,7 @@ void oled_init_progressive(uint8_t max_step) {
 
   // Clear framebuffer for future use
   memset(fb, 0x00, sizeof(fb));
+  s_front_valid = 0;  // panel RAM no longer matches the front buffer
 }
 
 // ============================================================================
@@ -290,9 +353,7 @@ void oled_init(void) {
   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
   // Set initial SPI lines for Mode 0 (CPOL=0, CPHA=0)
-  SCL_LOW();  // Clock idle LOW
-  HAL_GPIO_WritePin(OLED_SDA_GPIO_Port, OLED_SDA_Pin, GPIO_PIN_RESET);
-  HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, GPIO_PIN_SET);
+  lines_idle();
 
   // MIOS32: Wait 300ms for power stabilization
   for (uint16_t ctr = 0; ctr < 300; ++ctr) {
@@ -332,6 +393,7 @@ void oled_init(void) {
 
   // Clear framebuffer for future use
   memset(fb, 0x00, sizeof(fb));
+  s_front_valid = 0;  // panel RAM no longer matches the front buffer
 }
 
 #endif // MODULE_TEST_OLED
@@ -350,9 +412,7 @@ void oled_init_newhaven(void) {
   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
   // Set initial SPI lines for Mode 0 (CPOL=0, CPHA=0)
-  SCL_LOW();  // Clock idle LOW
-  HAL_GPIO_WritePin(OLED_SDA_GPIO_Port, OLED_SDA_Pin, GPIO_PIN_RESET);
-  HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, GPIO_PIN_SET);
+  lines_idle();
 
   // Wait 300ms for power stabilization
   for (uint16_t ctr = 0; ctr < 300; ++ctr) {
@@ -454,22 +514,184 @@ void oled_init_newhaven(void) {
   
   // Clear framebuffer
   memset(fb, 0x00, sizeof(fb));
+  s_front_valid = 0;  // panel RAM no longer matches the front buffer
+}
+
+#if !OLED_SPI_HW_DMA
+static void window_cmd(const oled_window_t* win) {
+  cmd(0x15); data((uint8_t)(0x1C + win->col0)); data((uint8_t)(0x1C + win->col1));  // Column window
+  cmd(0x75); data(win->row0); data(win->row1);                                       // Row window
+  cmd(0x5C);                                                                         // Write RAM
+}
+
+// Restore the full-screen window: init and test code only send the start address
+static void window_restore(void) {
+  cmd(0x15); data(0x1C); data(0x5B);
+  cmd(0x75); data(0x00); data(0x3F);
+}
+#endif
+
+#if OLED_SPI_HW_DMA
+// Pieces of a window's address commands in s_cmd: DC low for the command
+// bytes, high for their arguments. The restore sequence uses the first four.
+static const struct { uint8_t off, len, dc; } k_cmd_step[5] = {
+  { 0, 1, 0 }, { 1, 2, 1 }, { 3, 1, 0 }, { 4, 2, 1 }, { 6, 1, 0 }
+};
+
+// Start the next piece of the current transfer, or finish it: per window
+// its five command pieces then its pixels, at the end the full-screen
+// window. Called from oled_flush() and from the SPI TX complete interrupt
+// (the HAL calls it once the bus is idle, so DC can change); it never
+// waits on the bus.
+static void dma_next(void) {
+  uint8_t* src;
+  uint16_t len;
+  uint8_t dc;
+  if (s_dma_idx < s_dma_n && s_dma_step < 5u) {
+    src = &s_cmd[s_dma_idx * OLED_DIRTY_WINDOW_CMD_BYTES + k_cmd_step[s_dma_step].off];
+    len = k_cmd_step[s_dma_step].len;
+    dc = k_cmd_step[s_dma_step].dc;
+    s_dma_step++;
+  } else if (s_dma_idx < s_dma_n) {
+    const oled_window_t* win = &s_win[s_dma_idx];
+    src = &s_tx[s_dma_pix];
+    len = (uint16_t)((win->col1 - win->col0 + 1u) * 2u * (win->row1 - win->row0 + 1u));
+    dc = 1;
+    s_dma_pix = (uint16_t)(s_dma_pix + len);
+    s_dma_idx++;
+    s_dma_step = 0;
+  } else if (s_dma_step < 4u) {
+    src = &s_restore_cmd[k_cmd_step[s_dma_step].off];
+    len = k_cmd_step[s_dma_step].len;
+    dc = k_cmd_step[s_dma_step].dc;
+    s_dma_step++;
+  } else {
+    s_dma_busy = 0;
+    if (s_flush_cb) s_flush_cb();
+    return;
+  }
+
+  HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, dc ? GPIO_PIN_SET : GPIO_PIN_RESET);
+  __HAL_SPI_CLEAR_OVRFLAG(OLED_SPI_HANDLE);
+  if (HAL_SPI_Transmit_DMA(OLED_SPI_HANDLE, src, len) != HAL_OK) {
+    // Panel content is unknown now: resend everything on the next flush
+    s_front_valid = 0;
+    s_dma_busy = 0;
+  }
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi) {
+  if (hspi == OLED_SPI_HANDLE && s_dma_busy) dma_next();
+}
+
+// Stop the transfer in flight and give up on it: the panel content is
+// unknown, so the next flush resends the whole frame
+static void dma_abort(void) {
+  (void)HAL_SPI_Abort(OLED_SPI_HANDLE);
+  s_front_valid = 0;
+  s_stats.dma_errors++;
+  s_dma_busy = 0;
+  if (s_flush_cb) s_flush_cb();
+}
+
+void oled_spi_error_isr(void) {
+  if (s_dma_busy) dma_abort();
+}
+#else
+void oled_spi_error_isr(void) {}
+#endif
+
+uint8_t oled_flush_busy(void) {
+#if OLED_SPI_HW_DMA
+  return s_dma_busy;
+#else
+  return 0;
+#endif
+}
+
+void oled_wait_idle(void) {
+#if OLED_SPI_HW_DMA
+  uint32_t t0 = HAL_GetTick();
+  while (s_dma_busy) {
+    if ((HAL_GetTick() - t0) >= OLED_DMA_TIMEOUT_MS) {
+      // Completion interrupt never came
+      __disable_irq();
+      if (s_dma_busy) dma_abort();
+      __enable_irq();
+      break;
+    }
+  }
+#endif
+}
+
+void oled_set_flush_callback(void (*cb)(void)) {
+  s_flush_cb = cb;
 }
 
 void oled_flush(void) {
-  // Transfer the local framebuffer to OLED GDDRAM (SSD1322 VRAM)
-  // EXACT MidiCore sequence: 1 byte address + 128 bytes data per row
-  for (uint8_t row = 0; row < 64; ++row) {
-    cmd(0x15);                // Set Column Address
-    data(0x1C);               // Column start ONLY (1 byte like MIOS32)
-    cmd(0x75);                // Set Row Address  
-    data(row);                // Row start ONLY (1 byte like MIOS32)
-    cmd(0x5C);                // Write RAM command
-    uint8_t *row_ptr = &fb[row * 128];  // 128 bytes per row
-    for (uint16_t i = 0; i < 128; ++i) {
-      data(row_ptr[i]);       // Write 128 bytes like MIOS32
+  // Publish the back buffer and transfer only the changed regions to OLED GDDRAM.
+  // Each window sets both column and row ranges (start + end), then streams
+  // the window contents row by row after Write RAM (0x5C).
+#if OLED_SPI_HW_DMA
+  // Previous transfer still running: leave the buffers alone, the changes
+  // are picked up by the next flush
+  if (s_dma_busy) {
+    s_stats.busy_skips++;
+    return;
+  }
+#endif
+  uint8_t n = oled_dirty_scan(fb, fb_front, !s_front_valid, s_win);
+  s_front_valid = 1;
+  s_stats.flushes++;
+  s_stats.last_data_bytes = 0;
+  if (n == 0) {
+    s_stats.idle_flushes++;
+    if (s_flush_cb) s_flush_cb();
+    return;
+  }
+
+  uint32_t bytes = oled_dirty_data_bytes(s_win, n);
+  s_stats.windows += n;
+  s_stats.data_bytes += bytes;
+  s_stats.cmd_bytes += (uint32_t)n * OLED_DIRTY_WINDOW_CMD_BYTES + 6u;
+  s_stats.last_data_bytes = bytes;
+
+#if OLED_SPI_HW_DMA
+  // Pack the windows so each goes out as one transfer, narrow ones included
+  uint16_t off = 0;
+  for (uint8_t w = 0; w < n; ++w) {
+    const oled_window_t* win = &s_win[w];
+    uint8_t* c = &s_cmd[w * OLED_DIRTY_WINDOW_CMD_BYTES];
+    c[0] = 0x15; c[1] = (uint8_t)(0x1C + win->col0); c[2] = (uint8_t)(0x1C + win->col1);
+    c[3] = 0x75; c[4] = win->row0; c[5] = win->row1;
+    c[6] = 0x5C;
+    uint16_t nbytes = (uint16_t)((win->col1 - win->col0 + 1u) * 2u);
+    for (uint8_t row = win->row0; row <= win->row1; ++row) {
+      memcpy(&s_tx[off], &fb_front[row * 128 + win->col0 * 2u], nbytes);
+      off = (uint16_t)(off + nbytes);
+    }
+  }
+  s_dma_n = n;
+  s_dma_idx = 0;
+  s_dma_step = 0;
+  s_dma_pix = 0;
+  s_dma_busy = 1;
+  dma_next();
+#else
+  for (uint8_t w = 0; w < n; ++w) {
+    const oled_window_t* win = &s_win[w];
+    window_cmd(win);
+    uint16_t nbytes = (uint16_t)((win->col1 - win->col0 + 1u) * 2u);
+    for (uint8_t row = win->row0; row <= win->row1; ++row) {
+      const uint8_t *p = &fb_front[row * 128 + win->col0 * 2u];
+      for (uint16_t i = 0; i < nbytes; ++i) {
+        data(p[i]);
+      }
     }
   }
+  window_restore();
+  if (s_flush_cb) s_flush_cb();
+#endif
 }
 
 uint8_t *oled_framebuffer(void) {
@@ -480,6 +702,15 @@ void oled_clear(void) {
   memset(fb, 0x00, sizeof(fb));
 }
 
+void oled_invalidate(void) {
+  s_front_valid = 0;
+}
+
+void oled_get_flush_stats(oled_flush_stats_t* out) {
+  if (!out) return;
+  *out = s_stats;
+}
+
 // ============================================================================
 // TEST PATTERN FUNCTIONS - Only compile when MODULE_TEST_OLED is enabled
 // Visual verification patterns for hardware testing
@@ -487,11 +718,18 @@ void oled_clear(void) {
 // ============================================================================
 #ifdef MODULE_TEST_OLED
 
+// Direct GDDRAM writes (test patterns) bypass the front buffer
+static void direct_write_begin(void) {
+  oled_wait_idle();
+  s_front_valid = 0;
+}
+
 // MIOS32-compatible test screen function - EXACT replica
 // Source: github.com/midibox/mios32/apps/mios32_test/app_lcd/ssd1322/app.c testScreen()
 // Left half: gradient pattern, Right half: full white
 // This test bypasses the framebuffer and writes directly to OLED RAM
 void oled_test_mios32_pattern(void) {
+  direct_write_begin();
   uint16_t x = 0;
   uint16_t y = 0;
 
@@ -538,6 +776,7 @@ void oled_test_mios32_pattern(void) {
  * Tests pixel-level control and display uniformity
  */
 void oled_test_checkerboard(void) {
+  direct_write_begin();
   for (uint16_t y = 0; y < 64; y++) {
     cmd(0x15); data(0x1c);
     cmd(0x75); data(y);
@@ -556,6 +795,7 @@ void oled_test_checkerboard(void) {
  * Tests grayscale levels (0x00 to 0xFF)
  */
 void oled_test_h_gradient(void) {
+  direct_write_begin();
   // Pre-calculate gradient values (avoid arithmetic in loop)
   static uint8_t gradient[64];
   static uint8_t initialized = 0;
@@ -584,6 +824,7 @@ void oled_test_h_gradient(void) {
  * Tests grayscale levels vertically
  */
 void oled_test_v_gradient(void) {
+  direct_write_begin();
   // Pre-calculate gradient values (avoid arithmetic in loop)
   static uint8_t gradient[64];
   static uint8_t initialized = 0;
@@ -612,6 +853,7 @@ void oled_test_v_gradient(void) {
  * Tests geometric patterns
  */
 void oled_test_rectangles(void) {
+  direct_write_begin();
   for (uint16_t y = 0; y < 64; y++) {
     cmd(0x15); data(0x1c);
     cmd(0x75); data(y);
@@ -633,6 +875,7 @@ void oled_test_rectangles(void) {
  * Tests diagonal patterns
  */
 void oled_test_stripes(void) {
+  direct_write_begin();
   for (uint16_t y = 0; y < 64; y++) {
     cmd(0x15); data(0x1c);
     cmd(0x75); data(y);
@@ -653,6 +896,7 @@ void oled_test_stripes(void) {
  * Simulates 3D terrain (simplified from LoopA voxelspace)
  */
 void oled_test_voxel_landscape(void) {
+  direct_write_begin();
   // Simple height map (mountains and valleys)
   static uint8_t heightmap[64];  // Changed to 64 to match x-loop
   
@@ -691,6 +935,7 @@ void oled_test_voxel_landscape(void) {
  * Shows all 16 grayscale levels as vertical bars
  */
 void oled_test_gray_levels(void) {
+  direct_write_begin();
   // Pre-calculate gray level patterns
   static uint8_t levels[64];
   static uint8_t initialized = 0;
@@ -720,6 +965,7 @@ void oled_test_gray_levels(void) {
  * Simulates text rendering capability
  */
 void oled_test_text_pattern(void) {
+  direct_write_begin();
   for (uint16_t y = 0; y < 64; y++) {
     cmd(0x15); data(0x1c);
     cmd(0x75); data(y);
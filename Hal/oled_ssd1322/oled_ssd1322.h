@@ -25,9 +25,32 @@ void oled_init_progressive(uint8_t max_step);  // For debugging (step-by-step) -
 // ============================================================================
 // Framebuffer Functions
 // ============================================================================
-uint8_t* oled_framebuffer(void);         // Get framebuffer pointer
-void oled_flush(void);                   // Transfer framebuffer to display
-void oled_clear(void);                   // Clear framebuffer
+// The framebuffer is double-buffered: drawing goes to the back buffer, and
+// oled_flush() publishes it to the front buffer the panel transfer reads from.
+// The back buffer keeps its contents across flushes.
+uint8_t* oled_framebuffer(void);         // Get back (render) buffer pointer
+void oled_flush(void);                   // Publish back buffer, transfer changed regions to display
+                                         // (OLED_SPI_HW_DMA: starts a background DMA transfer and returns)
+void oled_clear(void);                   // Clear back buffer
+void oled_invalidate(void);              // Force next flush to resend the whole frame
+uint8_t oled_flush_busy(void);           // 1 while a DMA flush is in progress (always 0 with bit-bang)
+void oled_wait_idle(void);               // Block until the current flush has completed
+void oled_set_flush_callback(void (*cb)(void));  // Called when a flush completes (ISR context with DMA)
+void oled_spi_error_isr(void);           // SPI/DMA error on OLED_SPI_HANDLE: abort the flush (HAL_SPI_ErrorCallback)
+
+// Flush statistics (partial-update efficiency)
+typedef struct {
+  uint32_t flushes;          // oled_flush() calls
+  uint32_t idle_flushes;     // flushes with nothing to send
+  uint32_t busy_skips;       // flushes skipped because DMA was still sending
+  uint32_t windows;          // address windows opened
+  uint32_t data_bytes;       // pixel bytes sent (total)
+  uint32_t cmd_bytes;        // command/address bytes sent (total)
+  uint32_t last_data_bytes;  // pixel bytes sent by the most recent flush
+  uint32_t dma_errors;       // DMA flushes aborted (SPI error or timeout)
+} oled_flush_stats_t;
+
+void oled_get_flush_stats(oled_flush_stats_t* out);
 
 // ============================================================================
 // OLED Test Functions - Only available when MODULE_TEST_OLED=1
@@ -1,6 +1,7 @@
 #include "Hal/spi_bus.h"
 #include "Config/sd_pins.h"
 #include "Config/ainser64_pins.h"
+#include "Config/module_config.h"  // AINSER64_NUM_MODULES
 // Note: OLED no longer uses hardware SPI (uses software SPI instead)
 
 static osMutexId_t g_spi1_mutex;
@@ -15,44 +16,61 @@ static osMutexId_t g_spi3_mutex;
 // For STM32F407 @ 168 MHz: prescaler 64 gives 168/64 = 2.625 MHz (still within MCP3208 spec)
 static uint32_t presc_sd   = SPI_BAUDRATEPRESCALER_256;  // Start slow for SD init
 static uint32_t presc_ain  = SPI_BAUDRATEPRESCALER_64;
+// AINSER modules on SPI1: APB2 runs at twice the SPI3 (APB1) clock, so one
+// more divider step gives them the same SCK
+static uint32_t presc_ain_spi1 = SPI_BAUDRATEPRESCALER_128;
 
 // Function to change SD card speed after initialization
 void spibus_set_sd_speed_fast(void) {
   presc_sd = SPI_BAUDRATEPRESCALER_4;  // 42 MHz for fast operations
 }
 
+typedef struct {
+  GPIO_TypeDef* cs_port;
+  uint16_t cs_pin;
+  uint8_t on_spi1;  // else SPI3
+} spibus_dev_cfg_t;
+
+#define AIN_ON_SPI1(bus) ((bus) == AINSER64_BUS_SPI1)
+
+static const spibus_dev_cfg_t k_dev[SPIBUS_DEV_AIN3 + 1] = {
+  [SPIBUS_DEV_SD]   = { SD_CS_GPIO_Port, SD_CS_Pin, 1 },
+  [SPIBUS_DEV_AIN]  = { AIN_CS_PORT,  AIN_CS_PIN,  AIN_ON_SPI1(AIN_MOD0_BUS) },
+  [SPIBUS_DEV_AIN1] = { AIN_CS1_PORT, AIN_CS1_PIN, AIN_ON_SPI1(AIN_MOD1_BUS) },
+  [SPIBUS_DEV_AIN2] = { AIN_CS2_PORT, AIN_CS2_PIN, AIN_ON_SPI1(AIN_MOD2_BUS) },
+  [SPIBUS_DEV_AIN3] = { AIN_CS3_PORT, AIN_CS3_PIN, AIN_ON_SPI1(AIN_MOD3_BUS) },
+};
+
+// Extra AINSER CS lines stay untouched unless the modules are configured
+static inline uint8_t dev_present(spibus_dev_t dev) {
+  return (dev <= SPIBUS_DEV_AIN) || ((uint32_t)(dev - SPIBUS_DEV_AIN) < AINSER64_NUM_MODULES);
+}
+
 static void cs_high(spibus_dev_t dev) {
-  if (dev == SPIBUS_DEV_SD)
-    HAL_GPIO_WritePin(SD_CS_GPIO_Port, SD_CS_Pin, GPIO_PIN_SET);
-  else if (dev == SPIBUS_DEV_AIN)
-    HAL_GPIO_WritePin(AIN_CS_PORT, AIN_CS_PIN, GPIO_PIN_SET);
+  if (dev_present(dev))
+    HAL_GPIO_WritePin(k_dev[dev].cs_port, k_dev[dev].cs_pin, GPIO_PIN_SET);
 }
 
 static void cs_low(spibus_dev_t dev) {
-  if (dev == SPIBUS_DEV_SD)
-    HAL_GPIO_WritePin(SD_CS_GPIO_Port, SD_CS_Pin, GPIO_PIN_RESET);
-  else if (dev == SPIBUS_DEV_AIN)
-    HAL_GPIO_WritePin(AIN_CS_PORT, AIN_CS_PIN, GPIO_PIN_RESET);
+  if (dev_present(dev))
+    HAL_GPIO_WritePin(k_dev[dev].cs_port, k_dev[dev].cs_pin, GPIO_PIN_RESET);
 }
 
 static SPI_HandleTypeDef* dev_spi(spibus_dev_t dev) {
-  switch (dev) {
-    case SPIBUS_DEV_SD:   return &hspi1;
-    case SPIBUS_DEV_AIN:  return &hspi3;
-    default:              return &hspi1;
-  }
+  return k_dev[dev].on_spi1 ? &hspi1 : &hspi3;
+}
+
+static osMutexId_t* dev_mutex_slot(spibus_dev_t dev) {
+  return k_dev[dev].on_spi1 ? &g_spi1_mutex : &g_spi3_mutex;
 }
 
 static osMutexId_t dev_mutex(spibus_dev_t dev) {
-  switch (dev) {
-    case SPIBUS_DEV_AIN:  return g_spi3_mutex;
-    default:              return g_spi1_mutex;
-  }
+  return *dev_mutex_slot(dev);
 }
 
 static uint32_t dev_presc(spibus_dev_t dev) {
   if (dev == SPIBUS_DEV_SD) return presc_sd;
-  return presc_ain;
+  return k_dev[dev].on_spi1 ? presc_ain_spi1 : presc_ain;
 }
 
 static void spi_set_prescaler(SPI_HandleTypeDef* hspi, uint32_t prescaler) {
@@ -64,44 +82,61 @@ static void spi_set_prescaler(SPI_HandleTypeDef* hspi, uint32_t prescaler) {
 void spibus_init(void) {
   // Initialize CS pins to high (deselected) immediately
   // This can be done before scheduler starts
-  cs_high(SPIBUS_DEV_SD);
-  cs_high(SPIBUS_DEV_AIN);
+  for (uint32_t d = 0; d <= SPIBUS_DEV_AIN3; ++d) cs_high((spibus_dev_t)d);
   
   // NOTE: Mutex creation MUST be deferred until AFTER scheduler starts!
   // osMutexNew() calls FreeRTOS functions that use critical sections
   // which will fail/deadlock if called before osKernelStart()
-  // Mutexes are now created lazily in spibus_begin() on first use
+  // Mutexes are now created lazily in spibus_acquire() on first use
   g_spi1_mutex = NULL;
   g_spi3_mutex = NULL;
   
   // Note: OLED uses software SPI (bit-bang), not managed by spibus
 }
 
-HAL_StatusTypeDef spibus_begin(spibus_dev_t dev) {
+HAL_StatusTypeDef spibus_acquire(spibus_dev_t dev) {
+  if (!dev_present(dev)) return HAL_ERROR;
+
   // Lazy mutex creation - create on first use (after scheduler has started)
-  if (dev == SPIBUS_DEV_SD && g_spi1_mutex == NULL) {
-    const osMutexAttr_t attr = { .name = "spi1" };
-    g_spi1_mutex = osMutexNew(&attr);
-  }
-  else if (dev == SPIBUS_DEV_AIN && g_spi3_mutex == NULL) {
-    const osMutexAttr_t attr = { .name = "spi3" };
-    g_spi3_mutex = osMutexNew(&attr);
+  osMutexId_t* slot = dev_mutex_slot(dev);
+  if (*slot == NULL) {
+    const osMutexAttr_t attr = { .name = k_dev[dev].on_spi1 ? "spi1" : "spi3" };
+    *slot = osMutexNew(&attr);
   }
-  
-  osMutexId_t m = dev_mutex(dev);
+
+  osMutexId_t m = *slot;
   if (!m) return HAL_ERROR;
   if (osMutexAcquire(m, osWaitForever) != osOK) return HAL_ERROR;
 
-  SPI_HandleTypeDef* h = dev_spi(dev);
-  spi_set_prescaler(h, dev_presc(dev));
+  spi_set_prescaler(dev_spi(dev), dev_presc(dev));
+  return HAL_OK;
+}
+
+void spibus_release(spibus_dev_t dev) {
+  if (!dev_present(dev)) return;
+  osMutexId_t m = dev_mutex(dev);
+  if (m) osMutexRelease(m);
+}
+
+void spibus_select(spibus_dev_t dev, uint8_t selected) {
+  if (selected) cs_low(dev);
+  else cs_high(dev);
+}
+
+uint8_t spibus_same_bus(spibus_dev_t a, spibus_dev_t b) {
+  return (uint8_t)(k_dev[a].on_spi1 == k_dev[b].on_spi1);
+}
+
+HAL_StatusTypeDef spibus_begin(spibus_dev_t dev) {
+  HAL_StatusTypeDef st = spibus_acquire(dev);
+  if (st != HAL_OK) return st;
   cs_low(dev);
   return HAL_OK;
 }
 
 void spibus_end(spibus_dev_t dev) {
   cs_high(dev);
-  osMutexId_t m = dev_mutex(dev);
-  if (m) osMutexRelease(m);
+  spibus_release(dev);
 }
 
 HAL_StatusTypeDef spibus_tx(spibus_dev_t dev, const uint8_t* tx, uint16_t len, uint32_t timeout) {
@@ -113,3 +148,39 @@ HAL_StatusTypeDef spibus_rx(spibus_dev_t dev, uint8_t* rx, uint16_t len, uint32_
 HAL_StatusTypeDef spibus_txrx(spibus_dev_t dev, const uint8_t* tx, uint8_t* rx, uint16_t len, uint32_t timeout) {
   return HAL_SPI_TransmitReceive(dev_spi(dev), (uint8_t*)tx, rx, len, timeout);
 }
+
+// Register-level polling: HAL_SPI_TransmitReceive() runs one bus at a time.
+// Every byte is written to all data registers before any is read back, so
+// the shift registers run concurrently and each RX byte is read before the
+// next TX byte is written (no overrun).
+HAL_StatusTypeDef spibus_txrx_lockstep(const spibus_dev_t* devs, uint8_t n,
+                                       const uint8_t* const* tx, uint8_t* const* rx,
+                                       uint16_t len, uint32_t timeout) {
+  if (!devs || !tx || !rx || n == 0) return HAL_ERROR;
+  if (n == 1) return spibus_txrx(devs[0], tx[0], rx[0], len, timeout);
+  if (n > 2) return HAL_ERROR;  // two SPI peripherals on this bus layer
+  if (spibus_same_bus(devs[0], devs[1])) return HAL_ERROR;
+
+  SPI_TypeDef* spi[2] = { dev_spi(devs[0])->Instance, dev_spi(devs[1])->Instance };
+  for (uint8_t i = 0; i < 2; ++i) {
+    (void)spi[i]->DR;  // drop a stale byte / clear OVR left by a previous user
+    (void)spi[i]->SR;
+  }
+
+  uint32_t t0 = HAL_GetTick();
+  for (uint16_t b = 0; b < len; ++b) {
+    for (uint8_t i = 0; i < 2; ++i) {
+      while (!(spi[i]->SR & SPI_SR_TXE)) {
+        if ((HAL_GetTick() - t0) > timeout) return HAL_TIMEOUT;
+      }
+      *(__IO uint8_t*)&spi[i]->DR = tx[i][b];
+    }
+    for (uint8_t i = 0; i < 2; ++i) {
+      while (!(spi[i]->SR & SPI_SR_RXNE)) {
+        if ((HAL_GetTick() - t0) > timeout) return HAL_TIMEOUT;
+      }
+      rx[i][b] = *(__IO uint8_t*)&spi[i]->DR;
+    }
+  }
+  return HAL_OK;
+}
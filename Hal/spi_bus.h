@@ -5,8 +5,12 @@
 
 typedef enum {
   SPIBUS_DEV_SD = 0,
-  SPIBUS_DEV_AIN,
-  // Note: OLED uses software SPI (bit-bang), not hardware SPI bus
+  SPIBUS_DEV_AIN,   // AINSER64 module 0
+  SPIBUS_DEV_AIN1,  // AINSER64 modules 1..3 (AINSER64_NUM_MODULES > 1),
+  SPIBUS_DEV_AIN2,  // CS and bus from Config/ainser64_pins.h
+  SPIBUS_DEV_AIN3,
+  // Note: OLED uses software SPI (bit-bang), or a dedicated SPI with DMA
+  // (OLED_SPI_HW_DMA in Config/oled_pins.h) - never the shared bus
 } spibus_dev_t;
 
 void spibus_init(void);
@@ -17,3 +21,22 @@ void spibus_set_sd_speed_fast(void);  // Switch SD card to fast speed after init
 HAL_StatusTypeDef spibus_tx(spibus_dev_t dev, const uint8_t* tx, uint16_t len, uint32_t timeout);
 HAL_StatusTypeDef spibus_rx(spibus_dev_t dev, uint8_t* rx, uint16_t len, uint32_t timeout);
 HAL_StatusTypeDef spibus_txrx(spibus_dev_t dev, const uint8_t* tx, uint8_t* rx, uint16_t len, uint32_t timeout);
+
+// Split transactions: spibus_begin() = acquire + select, spibus_end() =
+// deselect + release. A driver that toggles CS between short transfers
+// (AINSER64: one CS pulse per conversion) holds the bus mutex once around
+// the whole burst instead of once per transfer.
+HAL_StatusTypeDef spibus_acquire(spibus_dev_t dev);
+void spibus_release(spibus_dev_t dev);
+void spibus_select(spibus_dev_t dev, uint8_t selected);
+
+// 1 if both devices are on the same SPI peripheral (and share its mutex)
+uint8_t spibus_same_bus(spibus_dev_t a, spibus_dev_t b);
+
+// Full-duplex transfer on n acquired devices at once, one per SPI peripheral:
+// the buses are clocked byte by byte in lockstep, so the burst takes the time
+// of one transfer instead of n. tx[i]/rx[i] belong to devs[i]. Returns
+// HAL_ERROR if two devices share a bus, HAL_TIMEOUT on a stuck bus.
+HAL_StatusTypeDef spibus_txrx_lockstep(const spibus_dev_t* devs, uint8_t n,
+                                       const uint8_t* const* tx, uint8_t* const* rx,
+                                       uint16_t len, uint32_t timeout);
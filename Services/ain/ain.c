@@ -1,17 +1,34 @@
 #include "Services/ain/ain.h"
 #include "Services/ui/ui.h"
+#include "Services/fs/fs_atomic.h"
 #include "Hal/ainser64_hw/hal_ainser64_hw_step.h"
+#include "Config/module_config.h"
 #include "cmsis_os2.h"
 #include <string.h>
 #include <math.h>
 
+#if __has_include("ff.h")
+  #include "ff.h"
+  #define AIN_HAS_FATFS 1
+#else
+  #define AIN_HAS_FATFS 0
+#endif
+
+#if defined(__ARM_FEATURE_SAT)
+  #include <arm_acle.h>
+#endif
+
 typedef enum { ST_IDLE =0, ST_ARMED, ST_DOWN } key_state_t;
 
 typedef struct {
   uint16_t cal_min, cal_max;
+  uint32_t cal_gain;            // frozen: 16383 / (max - min), Q16
+  uint16_t base_min, base_max;  // frozen table, bounds DRIFT
+  uint16_t peak;                // DRIFT: highest filt of the last press
   uint16_t filt;
   uint16_t pos, pos_prev;
   uint32_t t1_ms;
+  uint32_t t_last_ms;  // previous sample (scan interval varies per step)
   uint16_t vb_ema;
   key_state_t st;
 } key_ctx_t;
@@ -29,6 +46,14 @@ static const uint16_t T2   = 6500;
 static const uint16_t TOFF = 4200;
 static const uint16_t HYS  = 250;
 
+// Adaptive scan: a step (8 keys per module) stays "hot" for AIN_HOT_HOLD_MS after any
+// of its keys was armed or moved by AIN_HOT_DELTA; hot steps are read every
+// tick, the rest round robin in the remaining budget.
+#define AIN_HOT_DELTA     64u   // pos units (0..16383) between two samples
+#define AIN_HOT_HOLD_MS   100u
+#define AIN_VB_REF_MS     40u   // velocity B slope unit: the old fixed 8-step scan period
+#define AIN_RATE_WINDOW_MS 1000u
+
 // velocity mapping params
 static const uint32_t DT_MIN_MS = 10;
 static const uint32_t DT_MAX_MS = 160;
@@ -63,7 +88,7 @@ static inline uint16_t clamp_u16(int32_t v, uint16_t lo, uint16_t hi) {
 }
 
 static uint16_t normalize(uint16_t raw, uint16_t mn, uint16_t mx) {
-  if (mx <= mn + 8) return 0;
+  if (mx < mn + AIN_CAL_MIN_SPAN) return 0;  // nothing learned yet, or noise only
   int32_t num = (int32_t)(raw - mn) * 16383;
   int32_t den = (int32_t)(mx - mn);
   int32_t p = num / den;
@@ -72,6 +97,40 @@ static uint16_t normalize(uint16_t raw, uint16_t mn, uint16_t mx) {
 
 static inline uint32_t now_ms(void) { return (uint32_t)osKernelGetTickCount(); }
 
+// ---- Calibration ----
+
+static volatile ain_cal_mode_t g_cal_mode = AIN_CAL_LEARN;
+static uint16_t g_drift_key = 0;
+static uint32_t g_drift_t0 = 0;
+
+// Same result as normalize(), division done once per table change
+static void cal_update_gain(key_ctx_t* k) {
+  uint16_t mn = k->cal_min, mx = k->cal_max;
+  k->cal_gain = (mx >= mn + AIN_CAL_MIN_SPAN) ? ((16383u << 16) / (uint32_t)(mx - mn)) : 0u;
+}
+
+// LEARN starts from an empty range: the first samples set both bounds and
+// every later one can only widen them
+static void cal_learn_reset(key_ctx_t* k) {
+  k->cal_min = 4095;
+  k->cal_max = 0;
+  cal_update_gain(k);
+}
+
+static inline uint16_t sat14(int32_t v) {
+#if defined(__ARM_FEATURE_SAT)
+  return (uint16_t)__usat(v, 14);  // USAT: clamp to 0..16383 without branches
+#else
+  return clamp_u16(v, 0, 16383);
+#endif
+}
+
+// FROZEN/DRIFT per-sample scaling: (filt - offset) * reciprocal gain
+static inline uint16_t scale_frozen(const key_ctx_t* k) {
+  int32_t d = (int32_t)k->filt - (int32_t)k->cal_min;
+  return sat14((int32_t)(((int64_t)d * k->cal_gain) >> 16));
+}
+
 static uint8_t map_velocity_A(uint32_t dt_ms) {
   if (dt_ms <= DT_MIN_MS) return 127;
   if (dt_ms >= DT_MAX_MS) return 1;
@@ -105,19 +164,28 @@ static inline uint8_t fuse_vel(uint8_t vA, uint8_t vB) {
   return (uint8_t)vf;
 }
 
-static void process_key(uint8_t key, uint16_t raw) {
+// Returns 1 while the key needs fast sampling (armed, or moving)
+static uint8_t process_key(uint8_t key, uint16_t raw) {
   key_ctx_t* k = &g_keys[key];
-
-  // calibrate bounds (keep enabled for bring-up; you may freeze later)
-  if (raw < k->cal_min) k->cal_min = raw;
-  if (raw > k->cal_max) k->cal_max = raw;
+  uint32_t t = now_ms();
+  uint32_t dt_sample = t - k->t_last_ms;
+  k->t_last_ms = t;
+  if (dt_sample == 0) dt_sample = 1;
 
   // EMA filter: adaptive
   uint8_t shift = (k->st == ST_DOWN) ? 3 : 2;
   k->filt = (uint16_t)(k->filt + ((int32_t)raw - (int32_t)k->filt) / (1<<shift));
 
   k->pos_prev = k->pos;
-  k->pos = normalize(k->filt, k->cal_min, k->cal_max);
+  if (g_cal_mode == AIN_CAL_LEARN) {
+    // calibrate bounds on every sample (bring-up; freeze with ain_cal_set_mode())
+    if (raw < k->cal_min) k->cal_min = raw;
+    if (raw > k->cal_max) k->cal_max = raw;
+    k->pos = normalize(k->filt, k->cal_min, k->cal_max);
+  } else {
+    k->pos = scale_frozen(k);
+    if (g_cal_mode == AIN_CAL_DRIFT && k->st == ST_DOWN && k->filt > k->peak) k->peak = k->filt;
+  }
 
   // Debug snapshots
   g_dbg_raw[key] = raw;
@@ -131,7 +199,11 @@ static void process_key(uint8_t key, uint16_t raw) {
       k->vb_ema = 0;
     }
   } else if (k->st == ST_ARMED) {
-    uint16_t dpos = (k->pos > k->pos_prev) ? (k->pos - k->pos_prev) : 0;
+    // Slope per AIN_VB_REF_MS, so velocity B does not depend on how often
+    // the scheduler samples this step
+    uint32_t dpos = (k->pos > k->pos_prev) ? (uint32_t)(k->pos - k->pos_prev) : 0u;
+    dpos = dpos * AIN_VB_REF_MS / dt_sample;
+    if (dpos > 0xFFFFu) dpos = 0xFFFFu;
     k->vb_ema = (uint16_t)(k->vb_ema + ((int32_t)dpos - (int32_t)k->vb_ema) / 2);
 
     if (k->pos > T2) {
@@ -155,30 +227,45 @@ static void process_key(uint8_t key, uint16_t raw) {
       k->st = ST_IDLE;
     }
   }
-}
 
-static uint8_t g_bank = 0;
-static uint8_t g_step = 0;
+  uint16_t d = (k->pos > k->pos_prev) ? (uint16_t)(k->pos - k->pos_prev)
+                                      : (uint16_t)(k->pos_prev - k->pos);
+  return (uint8_t)(k->st == ST_ARMED || d >= AIN_HOT_DELTA);
+}
 
 // MidiCore-compatible port re-ordering (matches the wiring on the classic
 // MBHP_AINSER64 PCB).
 // If your PCB/wiring differs, adjust this table.
 static const uint8_t k_mux_port_map[8] = { 0, 5, 2, 7, 4, 1, 6, 3 };
 
-#ifndef AINSER64_NUM_MODULES
-#define AINSER64_NUM_MODULES 1
-#endif
+// Scan slots: mux steps, each read on every module at once
+// (hal_ainser64_read_step_all() interleaves the modules across SPI buses)
+#define AIN_SLOTS 8u
 
+static uint8_t g_bg_slot = 0;                  // background round robin
+static uint8_t g_hot_rr = 0;                   // rotates hot slots when over budget
+static uint32_t g_slot_hot_until[AIN_SLOTS];   // now_ms() until which a slot is hot
+static uint16_t g_slot_reads[AIN_SLOTS];       // reads in the current rate window
+static uint16_t g_slot_rate_hz[AIN_SLOTS];     // reads/s over the last window
+static uint32_t g_rate_t0 = 0;
 void ain_init(void) {
   memset(g_keys, 0, sizeof(g_keys));
   memset(g_dbg_raw, 0, sizeof(g_dbg_raw));
   memset(g_dbg_filt, 0, sizeof(g_dbg_filt));
   memset(g_dbg_pos14, 0, sizeof(g_dbg_pos14));
-  for (uint8_t i=0;i<AIN_NUM_KEYS;i++) {
-    g_keys[i].cal_min = 0;
-    g_keys[i].cal_max = 4095;
+  memset(g_slot_hot_until, 0, sizeof(g_slot_hot_until));
+  memset(g_slot_reads, 0, sizeof(g_slot_reads));
+  memset(g_slot_rate_hz, 0, sizeof(g_slot_rate_hz));
+  g_bg_slot = 0;
+  g_hot_rr = 0;
+  g_rate_t0 = now_ms();
+  for (uint16_t i=0;i<AIN_NUM_KEYS;i++) {
     g_keys[i].st = ST_IDLE;
+    cal_learn_reset(&g_keys[i]);
   }
+  g_cal_mode = AIN_CAL_LEARN;
+  g_drift_key = 0;
+  g_drift_t0 = g_rate_t0;
 }
 
 void ain_debug_get_raw(uint16_t* dst, uint16_t len) {
@@ -199,26 +286,221 @@ void ain_debug_get_pos14(uint16_t* dst, uint16_t len) {
   memcpy(dst, g_dbg_pos14, len * sizeof(uint16_t));
 }
 
-void ain_tick_5ms(void) {
-  uint16_t vals[8] = {0};
-  if (hal_ainser64_read_bank_step(g_bank, g_step, vals) == 0) {
-    uint8_t port = k_mux_port_map[g_step & 7u];
+void ain_debug_get_rate_hz(uint16_t* dst, uint16_t len) {
+  if (!dst) return;
+  if (len > AIN_NUM_KEYS) len = AIN_NUM_KEYS;
+  for (uint16_t key = 0; key < len; key++) {
+    // key = module * 64 + port * 8 + channel; find the mux step wired to that port
+    uint8_t port = (uint8_t)((key / 8u) & 7u);
+    uint8_t step = 0;
+    while (step < 7u && k_mux_port_map[step] != port) step++;
+    dst[key] = g_slot_rate_hz[step];
+  }
+}
+
+static void scan_slot(uint8_t step, uint8_t next_step) {
+  uint16_t vals[AINSER64_NUM_MODULES][8];
+
+  for (uint8_t m = 0; m < AINSER64_NUM_MODULES; m++) hal_ainser64_set_next_step(m, next_step);
+  if (hal_ainser64_read_step_all(step, vals) != 0) return;
+  g_slot_reads[step]++;
+
+  uint8_t port = k_mux_port_map[step];
+  uint8_t hot = 0;
+  for (uint8_t m = 0; m < AINSER64_NUM_MODULES; m++) {
     for (uint8_t ch=0; ch<8; ch++) {
       // Key mapping:
+      // - module selects the 64 key bank
       // - step selects the port group (J6..J13), possibly reordered by k_mux_port_map
       // - MCP3208 channel (0..7) corresponds to A0..A7, reversed to match MidiCore
-      (void)g_bank; // currently only one module supported in this project
-      uint8_t key = (uint8_t)(port * 8u + (uint8_t)(7u - ch));
-      process_key(key, vals[ch]);
+      uint8_t key = (uint8_t)(m * 64u + port * 8u + (uint8_t)(7u - ch));
+      hot |= process_key(key, vals[m][ch]);
+    }
+  }
+  if (hot) g_slot_hot_until[step] = now_ms() + AIN_HOT_HOLD_MS;
+}
+
+// ---- Calibration lifecycle ----
+
+// Move v one count toward target, staying within AIN_CAL_DRIFT_MAX of base
+static uint8_t cal_nudge(uint16_t* v, uint16_t target, uint16_t base) {
+  uint16_t lo = (base > AIN_CAL_DRIFT_MAX) ? (uint16_t)(base - AIN_CAL_DRIFT_MAX) : 0u;
+  uint16_t hi = ((uint32_t)base + AIN_CAL_DRIFT_MAX < 4095u) ? (uint16_t)(base + AIN_CAL_DRIFT_MAX) : 4095u;
+  if (target > *v && *v < hi) { (*v)++; return 1; }
+  if (target < *v && *v > lo) { (*v)--; return 1; }
+  return 0;
+}
+
+// DRIFT: one idle key per AIN_CAL_DRIFT_PERIOD_MS / AIN_NUM_KEYS, so each
+// key moves at most 1 count per period and the sample path stays untouched
+static void cal_drift_tick(uint32_t t) {
+  if ((t - g_drift_t0) < AIN_CAL_DRIFT_PERIOD_MS / AIN_NUM_KEYS) return;
+  g_drift_t0 = t;
+
+  key_ctx_t* k = &g_keys[g_drift_key];
+  g_drift_key = (uint16_t)((g_drift_key + 1u) % AIN_NUM_KEYS);
+  if (k->st != ST_IDLE) return;
+
+  uint8_t changed = cal_nudge(&k->cal_min, k->filt, k->base_min);  // rest position
+  if (k->peak) {
+    changed |= cal_nudge(&k->cal_max, k->peak, k->base_max);
+    k->peak = 0;
+  }
+  if (changed) cal_update_gain(k);
+}
+
+// Current min/max become the frozen table. A key that never travelled
+// AIN_CAL_MIN_SPAN while learning keeps the full ADC range.
+static void cal_freeze(void) {
+  for (uint16_t i = 0; i < AIN_NUM_KEYS; i++) {
+    key_ctx_t* k = &g_keys[i];
+    if (k->cal_max < k->cal_min + AIN_CAL_MIN_SPAN) {
+      k->cal_min = 0;
+      k->cal_max = 4095;
     }
+    k->base_min = k->cal_min;
+    k->base_max = k->cal_max;
+    k->peak = 0;
+    cal_update_gain(k);
+  }
+}
+
+void ain_cal_set_mode(ain_cal_mode_t mode) {
+  if (mode > AIN_CAL_DRIFT) return;
+  if (g_cal_mode == AIN_CAL_LEARN && mode != AIN_CAL_LEARN) {
+    cal_freeze();
+  } else if (g_cal_mode != AIN_CAL_LEARN && mode == AIN_CAL_LEARN) {
+    for (uint16_t i = 0; i < AIN_NUM_KEYS; i++) cal_learn_reset(&g_keys[i]);
   }
-  g_step++;
-  if (g_step >= 8) {
-    g_step = 0;
-    if (AINSER64_NUM_MODULES > 1) {
-      g_bank = (uint8_t)((g_bank + 1) % AINSER64_NUM_MODULES);
-    } else {
-      g_bank = 0;
+  g_cal_mode = mode;
+}
+
+ain_cal_mode_t ain_cal_get_mode(void) {
+  return g_cal_mode;
+}
+
+#define AIN_CAL_MAGIC  0x434E4941u  /* 'AINC' */
+#define AIN_CAL_FMT_V1 1u
+
+typedef struct __attribute__((packed)) {
+  uint32_t magic;
+  uint16_t fmt;
+  uint16_t keys;
+  uint32_t fnv;  // FNV-1a over the records
+} ain_cal_hdr_t;
+
+typedef struct __attribute__((packed)) {
+  uint16_t min, max;
+} ain_cal_rec_t;
+
+static uint32_t cal_fnv(const uint8_t* p, uint32_t n, uint32_t h) {
+  while (n--) h = (h ^ *p++) * 16777619u;
+  return h;
+}
+
+int ain_cal_save(const char* path) {
+  if (!path) return -1;
+#if !AIN_HAS_FATFS
+  return -10;
+#else
+  static uint8_t buf[sizeof(ain_cal_hdr_t) + AIN_NUM_KEYS * sizeof(ain_cal_rec_t)];
+  ain_cal_rec_t* rec = (ain_cal_rec_t*)(buf + sizeof(ain_cal_hdr_t));
+  for (uint16_t i = 0; i < AIN_NUM_KEYS; i++) {
+    // Save the table being used: the frozen one, or the learned bounds
+    rec[i].min = g_keys[i].cal_min;
+    rec[i].max = g_keys[i].cal_max;
+  }
+  ain_cal_hdr_t hdr = {
+    .magic = AIN_CAL_MAGIC, .fmt = AIN_CAL_FMT_V1, .keys = (uint16_t)AIN_NUM_KEYS,
+    .fnv = cal_fnv((const uint8_t*)rec, AIN_NUM_KEYS * sizeof(ain_cal_rec_t), 2166136261u),
+  };
+  memcpy(buf, &hdr, sizeof(hdr));
+  return fs_atomic_write_text(path, (const char*)buf, sizeof(buf));
+#endif
+}
+
+int ain_cal_load(const char* path) {
+  if (!path) return -1;
+#if !AIN_HAS_FATFS
+  return -10;
+#else
+  FIL f;
+  if (f_open(&f, path, FA_READ) != FR_OK) return -2;
+
+  ain_cal_hdr_t hdr;
+  UINT br = 0;
+  if (f_read(&f, &hdr, sizeof(hdr), &br) != FR_OK || br != sizeof(hdr)) {
+    f_close(&f);
+    return -3;
+  }
+  if (hdr.magic != AIN_CAL_MAGIC || hdr.fmt != AIN_CAL_FMT_V1 || hdr.keys == 0) {
+    f_close(&f);
+    return -4;
+  }
+
+  // Read and check every record before touching the live table
+  static ain_cal_rec_t rec[AIN_NUM_KEYS];
+  uint16_t n = (hdr.keys < AIN_NUM_KEYS) ? hdr.keys : (uint16_t)AIN_NUM_KEYS;
+  uint32_t h = 2166136261u;
+  for (uint16_t i = 0; i < hdr.keys; i++) {
+    ain_cal_rec_t r;
+    if (f_read(&f, &r, sizeof(r), &br) != FR_OK || br != sizeof(r)) {
+      f_close(&f);
+      return -3;
+    }
+    h = cal_fnv((const uint8_t*)&r, sizeof(r), h);
+    if (i < n) rec[i] = r;
+  }
+  f_close(&f);
+  if (h != hdr.fnv) return -4;
+
+  for (uint16_t i = 0; i < n; i++) {
+    g_keys[i].cal_min = (rec[i].min <= 4095u) ? rec[i].min : 4095u;
+    g_keys[i].cal_max = (rec[i].max <= 4095u) ? rec[i].max : 4095u;
+  }
+  // New table becomes the frozen one (and the DRIFT bounds)
+  cal_freeze();
+  if (g_cal_mode == AIN_CAL_LEARN) g_cal_mode = AIN_CAL_FROZEN;
+  return 0;
+#endif
+}
+
+void ain_tick_5ms(void) {
+  uint8_t plan[AIN_SCAN_STEPS_PER_TICK];
+  uint8_t n = 0;
+  uint32_t t = now_ms();
+
+  // Hot slots first (all of them if they fit, rotating otherwise), keeping
+  // one read for the background sweep
+  for (uint8_t i = 0; i < AIN_SLOTS && n < AIN_SCAN_STEPS_PER_TICK - 1u; i++) {
+    uint8_t s = (uint8_t)((g_hot_rr + i) % AIN_SLOTS);
+    if ((int32_t)(g_slot_hot_until[s] - t) > 0) plan[n++] = s;
+  }
+  g_hot_rr = (uint8_t)((g_hot_rr + 1u) % AIN_SLOTS);
+
+  // Background: next slot not already planned, so idle keys keep a
+  // guaranteed (slower) rate
+  for (uint8_t i = 0; i < AIN_SLOTS; i++) {
+    uint8_t s = g_bg_slot;
+    g_bg_slot = (uint8_t)((g_bg_slot + 1u) % AIN_SLOTS);
+    uint8_t planned = 0;
+    for (uint8_t j = 0; j < n; j++) if (plan[j] == s) planned = 1;
+    if (!planned) { plan[n++] = s; break; }
+  }
+
+  // The last read preloads the mux for the likely first read of the next tick
+  for (uint8_t i = 0; i < n; i++) {
+    scan_slot(plan[i], (i + 1u < n) ? plan[i + 1u] : g_bg_slot);
+  }
+
+  if (g_cal_mode == AIN_CAL_DRIFT) cal_drift_tick(t);
+
+  if ((t - g_rate_t0) >= AIN_RATE_WINDOW_MS) {
+    uint32_t win = t - g_rate_t0;
+    for (uint8_t s = 0; s < AIN_SLOTS; s++) {
+      g_slot_rate_hz[s] = (uint16_t)(((uint32_t)g_slot_reads[s] * 1000u + win / 2u) / win);
+      g_slot_reads[s] = 0;
     }
+    g_rate_t0 = t;
   }
 }
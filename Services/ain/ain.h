@@ -1,7 +1,9 @@
 #pragma once
 #include <stdint.h>
+#include "Config/module_config.h"
 
-#define AIN_NUM_KEYS 64
+// 64 keys per AINSER64 module: key = module * 64 + port * 8 + channel
+#define AIN_NUM_KEYS (64u * AINSER64_NUM_MODULES)
 
 typedef enum {
   AIN_EV_NONE = 0,
@@ -21,6 +23,37 @@ void ain_init(void);
 void ain_tick_5ms(void);
 uint8_t ain_pop_event(ain_event_t* ev);
 
+// Calibration -----------------------------------------------------------------
+// LEARN:  per-key min/max start empty and widen with every sample (bring-up,
+//         default after init); a key outputs 0 until it has travelled
+//         AIN_CAL_MIN_SPAN counts. Entering LEARN again starts over.
+// FROZEN: fixed per-key offset (min) and reciprocal gain, so a sample costs a
+//         subtract, a multiply and a saturate - no compares, no divisions.
+// DRIFT:  FROZEN, plus min following the rest position and max following the
+//         press peaks by 1 count per AIN_CAL_DRIFT_PERIOD_MS at most, within
+//         AIN_CAL_DRIFT_MAX of the frozen table (Config/module_config.h).
+// Leaving LEARN freezes the learned min/max as the table (keys that never
+// travelled AIN_CAL_MIN_SPAN get the full 0..4095 range).
+typedef enum {
+  AIN_CAL_LEARN = 0,
+  AIN_CAL_FROZEN,
+  AIN_CAL_DRIFT
+} ain_cal_mode_t;
+
+#define AIN_CAL_DEFAULT_PATH "0:/cfg/ain_cal.bin"
+
+void ain_cal_set_mode(ain_cal_mode_t mode);
+ain_cal_mode_t ain_cal_get_mode(void);
+
+// Binary table: header (magic, format, key count, FNV-1a of the records)
+// then one {min, max} uint16 pair per key.
+// Save returns 0 on success, -1 bad args, -10 without FATFS, other <0 from
+// fs_atomic_write_text(). Load returns 0 on success (keys beyond the file's
+// count keep their values) and switches LEARN to FROZEN; -2 open, -3 read,
+// -4 bad header or checksum.
+int ain_cal_save(const char* path);
+int ain_cal_load(const char* path);
+
 // Debug helpers --------------------------------------------------------------
 // Copies the latest raw (ADC counts, typically 0..4095) values for each key.
 // dst must point to an array of at least AIN_NUM_KEYS uint16_t.
@@ -31,3 +64,8 @@ void ain_debug_get_filt(uint16_t* dst, uint16_t dst_len);
 
 // Copies the latest scaled position values (0..16383).
 void ain_debug_get_pos(uint16_t* dst, uint16_t dst_len);
+
+// Copies each key's effective sample rate in Hz over the last second. The
+// scanner reads mux steps with armed or moving keys every tick and sweeps
+// idle steps in the background, so rates differ per key.
+void ain_debug_get_rate_hz(uint16_t* dst, uint16_t dst_len);
@@ -16,22 +16,37 @@
 #define AINSER_MAP_DEFAULT_THRESHOLD 8u
 #endif
 
-#ifndef AINSER_MAP_DEFAULT_SMOOTHING
-#define AINSER_MAP_DEFAULT_SMOOTHING 6u
+// One-pole low-pass: filtered += (raw - filtered) >> shift (3 = 1/8 new)
+#ifndef AINSER_MAP_SMOOTH_SHIFT
+#define AINSER_MAP_SMOOTH_SHIFT 3u
 #endif
 
+// Default per-channel rate limit: 10 ms = at most 100 updates/s
+#ifndef AINSER_MAP_DEFAULT_RATE_MS
+#define AINSER_MAP_DEFAULT_RATE_MS 10u
+#endif
+
+#define AM_FRAC_BITS 4u        // fractional bits kept by the filter
+#define AM_VAL14_MAX 16383u
+#define AM_NONE      0xFFFFu
+
 static AINSER_MapEntry s_map[AINSER_NUM_CHANNELS];
-static uint16_t s_prev_raw[AINSER_NUM_CHANNELS];
-static uint16_t s_filtered[AINSER_NUM_CHANNELS];
-static uint8_t  s_last_cc[AINSER_NUM_CHANNELS];
+static uint16_t s_prev_raw[AINSER_NUM_CHANNELS]; // last reading past the threshold
+static uint16_t s_filtered[AINSER_NUM_CHANNELS]; // raw12 << AM_FRAC_BITS
+static uint16_t s_last_out[AINSER_NUM_CHANNELS]; // last sent value (mode resolution)
+static uint16_t s_pending[AINSER_NUM_CHANNELS];  // held by the rate limit, or AM_NONE
+static uint16_t s_sent_ms[AINSER_NUM_CHANNELS];  // low 16 bits of the last send time
+static uint16_t s_pending_count = 0;
+static uint32_t s_now_ms = 0;
+static uint8_t  s_have_clock = 0;
 static AINSER_MapOutputFn s_output_cb = 0;
 
-// Simple integer square root for 16-bit domain (0..127*127 ~= 16129).
+// Simple integer square root, 32-bit domain (0..16383*16383).
 // Enough for our cheap "log-ish" curve.
-static uint16_t ainser_isqrt16(uint16_t v)
+static uint16_t ainser_isqrt32(uint32_t v)
 {
-    uint16_t res = 0;
-    uint16_t bit = 1u << 14; // The second-to-top bit is set
+    uint32_t res = 0;
+    uint32_t bit = 1ul << 30; // The second-to-top bit is set
 
     // "bit" starts at the highest power of four <= the argument.
     while (bit > v)
@@ -39,34 +54,34 @@ static uint16_t ainser_isqrt16(uint16_t v)
 
     while (bit != 0u) {
         if (v >= res + bit) {
-            v -= (uint16_t)(res + bit);
-            res = (uint16_t)((res >> 1) + bit);
+            v -= res + bit;
+            res = (res >> 1) + bit;
         } else {
             res >>= 1;
         }
         bit >>= 2;
     }
-    return res;
+    return (uint16_t)res;
 }
 
-static uint8_t ainser_apply_curve(uint8_t in, uint8_t curve)
+// Curves in the 0..16383 domain (7-bit output is the top 7 bits)
+static uint16_t ainser_apply_curve(uint16_t in, uint8_t curve)
 {
     switch (curve) {
     case AINSER_CURVE_EXPO: {
         // Exponential-ish: square then renormalise.
-        uint16_t sq = (uint16_t)in * (uint16_t)in; // 0..16129
-        uint16_t v = (uint16_t)((sq + 127u) / 127u);
-        if (v > 127u)
-            v = 127u;
-        return (uint8_t)v;
+        uint32_t sq = (uint32_t)in * (uint32_t)in;
+        uint32_t v = (sq + AM_VAL14_MAX / 2u) / AM_VAL14_MAX;
+        if (v > AM_VAL14_MAX)
+            v = AM_VAL14_MAX;
+        return (uint16_t)v;
     }
     case AINSER_CURVE_LOG: {
-        // Log-ish: take sqrt in 0..127 space.
-        uint16_t scaled = (uint16_t)in * 127u / 127u;
-        uint16_t v = ainser_isqrt16(scaled * 127u);
-        if (v > 127u)
-            v = 127u;
-        return (uint8_t)v;
+        // Log-ish: take sqrt in 0..16383 space.
+        uint16_t v = ainser_isqrt32((uint32_t)in * AM_VAL14_MAX);
+        if (v > AM_VAL14_MAX)
+            v = AM_VAL14_MAX;
+        return v;
     }
     case AINSER_CURVE_LINEAR:
     default:
@@ -74,6 +89,42 @@ static uint8_t ainser_apply_curve(uint8_t in, uint8_t curve)
     }
 }
 
+static void ainser_send(uint16_t index, uint16_t out)
+{
+    const AINSER_MapEntry *e = &s_map[index];
+
+    s_last_out[index] = out;
+    s_sent_ms[index] = (uint16_t)s_now_ms;
+    if (!s_output_cb)
+        return;
+
+    switch (e->mode) {
+    case AINSER_MODE_CC14:
+        s_output_cb(e->channel, e->cc, (uint8_t)(out >> 7));
+        if (e->cc < 32u)
+            s_output_cb(e->channel, (uint8_t)(e->cc + 32u), (uint8_t)(out & 0x7Fu));
+        break;
+    case AINSER_MODE_NRPN:
+        s_output_cb(e->channel, 99u, (uint8_t)((e->nrpn >> 7) & 0x7Fu));
+        s_output_cb(e->channel, 98u, (uint8_t)(e->nrpn & 0x7Fu));
+        s_output_cb(e->channel, 6u, (uint8_t)(out >> 7));
+        s_output_cb(e->channel, 38u, (uint8_t)(out & 0x7Fu));
+        break;
+    case AINSER_MODE_CC7:
+    default:
+        s_output_cb(e->channel, e->cc, (uint8_t)out);
+        break;
+    }
+}
+
+static void ainser_clear_pending(uint16_t index)
+{
+    if (s_pending[index] != AM_NONE) {
+        s_pending[index] = AM_NONE;
+        s_pending_count--;
+    }
+}
+
 AINSER_MapEntry *ainser_map_get_table(void)
 {
     return s_map;
@@ -88,31 +139,37 @@ void ainser_map_init_defaults(void)
 {
     // Basic linear defaults:
     //  - all channels enabled
-    //  - CC numbers starting at 16 (16..79)
-    //  - channel 0 (MIDI ch.1)
+    //  - CC numbers starting at 16 (16..79) on each module
+    //  - MIDI channel = module (module 0 -> ch.1)
     //  - full ADC range
     //  - linear curve, non-inverted
-    //  - default threshold
-    for (uint8_t i = 0; i < AINSER_NUM_CHANNELS; ++i) {
-        s_map[i].cc        = (uint8_t)(16u + i);
-        s_map[i].channel   = 0u;
+    //  - default threshold, 7-bit CC, default rate limit
+    for (uint16_t i = 0; i < AINSER_NUM_CHANNELS; ++i) {
+        s_map[i].cc        = (uint8_t)(16u + (i & 63u));
+        s_map[i].channel   = (uint8_t)(i / 64u);
         s_map[i].curve     = (uint8_t)AINSER_CURVE_LINEAR;
         s_map[i].invert    = 0u;
         s_map[i].enabled   = 1u;
-        s_map[i].reserved  = 0u;
+        s_map[i].mode      = (uint8_t)AINSER_MODE_CC7;
         s_map[i].min       = 0u;
         s_map[i].max       = AINSER_ADC_MAX;
         s_map[i].threshold = (uint16_t)AINSER_MAP_DEFAULT_THRESHOLD;
+        s_map[i].nrpn      = 0u;
+        s_map[i].rate_ms   = (uint8_t)AINSER_MAP_DEFAULT_RATE_MS;
+        s_map[i].reserved  = 0u;
     }
 
-    for (uint8_t i = 0; i < AINSER_NUM_CHANNELS; ++i) {
-        s_prev_raw[i] = 0xFFFFu;
-        s_filtered[i] = 0xFFFFu;
-        s_last_cc[i]  = 0xFFu;
+    for (uint16_t i = 0; i < AINSER_NUM_CHANNELS; ++i) {
+        s_prev_raw[i] = AM_NONE;
+        s_filtered[i] = AM_NONE;
+        s_last_out[i] = AM_NONE;
+        s_pending[i]  = AM_NONE;
+        s_sent_ms[i]  = 0u;
     }
+    s_pending_count = 0;
 }
 
-void ainser_map_process_channel(uint8_t index, uint16_t raw12)
+void ainser_map_process_channel(uint16_t index, uint16_t raw12)
 {
     if (index >= AINSER_NUM_CHANNELS)
         return;
@@ -121,34 +178,38 @@ void ainser_map_process_channel(uint8_t index, uint16_t raw12)
     if (!e->enabled)
         return;
 
+    if (raw12 > AINSER_ADC_MAX)
+        raw12 = AINSER_ADC_MAX;
+
     uint16_t old = s_prev_raw[index];
-    if (old == 0xFFFFu) {
+    if (old == AM_NONE) {
         // First measurement: initialise caches, do not emit CC yet.
         s_prev_raw[index] = raw12;
-        s_filtered[index] = raw12;
+        s_filtered[index] = (uint16_t)(raw12 << AM_FRAC_BITS);
         return;
     }
 
+    // Deadband against the last accepted reading (not the previous sample,
+    // which let a slow sweep through in sub-threshold steps that were never
+    // emitted). Accepted readings become the filter target.
     uint16_t diff = (raw12 > old) ? (uint16_t)(raw12 - old) : (uint16_t)(old - raw12);
     uint16_t th   = e->threshold ? e->threshold : (uint16_t)AINSER_MAP_DEFAULT_THRESHOLD;
-    if (diff < th) {
-        // Update the previous raw to slowly follow slow drifts,
-        // but do not bother computing/scaling.
+    if (diff >= th) {
+        old = raw12;
         s_prev_raw[index] = raw12;
-        return;
     }
-    s_prev_raw[index] = raw12;
-
-    // Smoothing: simple one-pole low-pass in integer domain.
-    uint16_t filtered = s_filtered[index];
-    if (filtered == 0xFFFFu) {
-        filtered = raw12;
-    } else {
-        uint16_t alpha = (uint16_t)AINSER_MAP_DEFAULT_SMOOTHING;
-        uint32_t acc = (uint32_t)filtered * alpha + (uint32_t)raw12;
-        filtered = (uint16_t)(acc / (uint32_t)(alpha + 1u));
-    }
-    s_filtered[index] = filtered;
+
+    // Smoothing: one-pole low-pass toward the target with AM_FRAC_BITS
+    // fractional bits (the 14-bit modes get more than the ADC's 12 bits of
+    // steps). The last step snaps, so the filter settles on the target and
+    // the resting value is always reached; once settled there is nothing to do.
+    int32_t filtered = s_filtered[index];
+    int32_t delta = (int32_t)((uint32_t)old << AM_FRAC_BITS) - filtered;
+    if (delta == 0)
+        return;
+    int32_t step = delta >> AINSER_MAP_SMOOTH_SHIFT;
+    filtered += step ? step : delta;
+    s_filtered[index] = (uint16_t)filtered;
 
     // Clamp to min/max and optionally invert.
     uint16_t minv = e->min;
@@ -157,44 +218,65 @@ void ainser_map_process_channel(uint8_t index, uint16_t raw12)
         minv = 0u;
         maxv = AINSER_ADC_MAX;
     }
-    uint16_t val = filtered;
-    if (val <= minv) {
-        val = minv;
-    } else if (val >= maxv) {
-        val = maxv;
+    uint32_t lo = (uint32_t)minv << AM_FRAC_BITS;
+    uint32_t hi = (uint32_t)maxv << AM_FRAC_BITS;
+    uint32_t val = (uint32_t)filtered;
+    if (val <= lo) {
+        val = lo;
+    } else if (val >= hi) {
+        val = hi;
     }
 
-    uint16_t span = (uint16_t)(maxv - minv);
-    uint16_t rel;
-    if (span == 0u) {
-        rel = 0u;
-    } else {
-        if (e->invert) {
-            rel = (uint16_t)(maxv - val);
-        } else {
-            rel = (uint16_t)(val - minv);
-        }
+    uint32_t span = hi - lo;
+    uint32_t rel = e->invert ? (hi - val) : (val - lo);
+
+    // 0..16383, rounded
+    uint16_t v14 = (uint16_t)((rel * AM_VAL14_MAX + span / 2u) / span);
+
+    // Apply curve in 0..16383 domain, then reduce to the output resolution.
+    v14 = ainser_apply_curve(v14, e->curve);
+    uint16_t out = (e->mode == AINSER_MODE_CC7) ? (uint16_t)(v14 >> 7) : v14;
+
+    // Only emit if changed.
+    if (out == s_last_out[index]) {
+        // Back at the sent value before the hold expired: nothing to flush.
+        ainser_clear_pending(index);
+        return;
     }
 
-    uint8_t out7 = 0u;
-    if (span != 0u) {
-        uint32_t scaled = (uint32_t)rel * 127u + (span / 2u); // for rounding
-        scaled /= (uint32_t)span;
-        if (scaled > 127u)
-            scaled = 127u;
-        out7 = (uint8_t)scaled;
+    // Rate limit: hold the newest value until rate_ms after the last send
+    // (ainser_map_tick() flushes it if no newer change comes in).
+    if (s_have_clock && e->rate_ms &&
+        (uint16_t)((uint16_t)s_now_ms - s_sent_ms[index]) < e->rate_ms) {
+        if (s_pending[index] == AM_NONE)
+            s_pending_count++;
+        s_pending[index] = out;
+        return;
     }
 
-    // Apply curve in 0..127 domain.
-    out7 = ainser_apply_curve(out7, e->curve);
+    ainser_clear_pending(index);
+    ainser_send(index, out);
+}
 
-    // Only emit if changed.
-    if (out7 == s_last_cc[index])
+void ainser_map_tick(uint32_t now_ms)
+{
+    s_now_ms = now_ms;
+    s_have_clock = 1u;
+    if (s_pending_count == 0u)
         return;
-    s_last_cc[index] = out7;
 
-    if (s_output_cb) {
-        s_output_cb(e->channel, e->cc, out7);
+    for (uint16_t i = 0; i < AINSER_NUM_CHANNELS && s_pending_count; ++i) {
+        if (s_pending[i] == AM_NONE)
+            continue;
+        if (!s_map[i].enabled) {
+            ainser_clear_pending(i);
+            continue;
+        }
+        if ((uint16_t)((uint16_t)now_ms - s_sent_ms[i]) < s_map[i].rate_ms)
+            continue;
+        uint16_t out = s_pending[i];
+        ainser_clear_pending(i);
+        ainser_send(i, out);
     }
 }
 
@@ -317,13 +399,30 @@ int ainser_map_load_sd(const char* path) {
       e->threshold = am_u16(v);
     } else if (am_keyeq(k, "ENABLED") || am_keyeq(k, "ENABLE")) {
       e->enabled = am_u8(v) ? 1u : 0u;
+    } else if (am_keyeq(k, "MODE")) {
+      // Numeric (0..2) or text (CC / CC14 / NRPN)
+      if (v[0] >= '0' && v[0] <= '9') {
+        uint8_t t = am_u8(v);
+        e->mode = (t <= (uint8_t)AINSER_MODE_NRPN) ? t : (uint8_t)AINSER_MODE_CC7;
+      } else if (am_keyeq(v, "NRPN")) {
+        e->mode = (uint8_t)AINSER_MODE_NRPN;
+      } else if (am_keyeq(v, "CC14")) {
+        e->mode = (uint8_t)AINSER_MODE_CC14;
+      } else if (am_keyeq(v, "CC") || am_keyeq(v, "CC7")) {
+        e->mode = (uint8_t)AINSER_MODE_CC7;
+      }
+    } else if (am_keyeq(k, "NRPN")) {
+      e->nrpn = (uint16_t)(am_u16(v) & 0x3FFFu);
+    } else if (am_keyeq(k, "RATE") || am_keyeq(k, "RATE_MS")) {
+      uint16_t t = am_u16(v);
+      e->rate_ms = (uint8_t)((t > 255u) ? 255u : t);
     }
   }
 
   f_close(&f);
 
   // Sanity/post-process
-  for (uint8_t i = 0; i < AINSER_NUM_CHANNELS; ++i) {
+  for (uint16_t i = 0; i < AINSER_NUM_CHANNELS; ++i) {
     if (s_map[i].min > s_map[i].max) {
       uint16_t t = s_map[i].min;
       s_map[i].min = s_map[i].max;
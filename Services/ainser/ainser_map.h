@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "Config/module_config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,15 +20,18 @@ extern "C" {
 //      * inversion
 //      * enable flag
 //      * per-channel threshold (minimal delta before emitting)
+//      * output mode: 7-bit CC, 14-bit CC pair or NRPN
+//      * maximum output rate (intermediate values coalesced)
 //  - optional output callback to integrate either with:
 //      * simple UART/USB MIDI sender (selftest)
 //      * higher level router in the main application
 //
 // This module is intentionally agnostic of the AINSER backend:
-//  - it only assumes channel indices 0..63
+//  - it only assumes channel indices 0..AINSER_NUM_CHANNELS-1, 64 per module
+//    (index = module * 64 + step * 8 + channel)
 //  - you call ainser_map_process_channel(idx, raw12) from your scan loop.
 
-#define AINSER_NUM_CHANNELS 64u
+#define AINSER_NUM_CHANNELS (64u * AINSER64_NUM_MODULES)
 #define AINSER_ADC_MAX      4095u
 
 // Curves for mapping the 0..127 domain.
@@ -38,17 +42,31 @@ typedef enum {
     AINSER_CURVE_LOG    = 2u  // more resolution near 127
 } AINSER_Curve;
 
-// One entry per AINSER logical channel (0..63).
+// Output modes. All of them go out through the CC callback:
+//  - CC7:  cc = value (0..127)
+//  - CC14: cc = MSB, cc+32 = LSB (14-bit pair, cc 0..31; higher cc numbers
+//          have no LSB partner and send the MSB only)
+//  - NRPN: CC99/CC98 = parameter nrpn, CC6/CC38 = 14-bit data entry
+typedef enum {
+    AINSER_MODE_CC7  = 0u,
+    AINSER_MODE_CC14 = 1u,
+    AINSER_MODE_NRPN = 2u
+} AINSER_Mode;
+
+// One entry per AINSER logical channel (0..AINSER_NUM_CHANNELS-1).
 typedef struct {
     uint8_t  cc;        // MIDI CC number (0..127)
     uint8_t  channel;   // MIDI channel (0..15)
     uint8_t  curve;     // AINSER_Curve
     uint8_t  invert;    // 0=normal, 1=inverted
     uint8_t  enabled;   // 0=ignore, 1=active
-    uint8_t  reserved;  // padding / future use
+    uint8_t  mode;      // AINSER_Mode
     uint16_t min;       // 12-bit ADC min  (0..4095)
     uint16_t max;       // 12-bit ADC max  (0..4095), must be > min
     uint16_t threshold; // minimal delta (12-bit) to trigger an update
+    uint16_t nrpn;      // NRPN parameter number (0..16383), AINSER_MODE_NRPN
+    uint8_t  rate_ms;   // minimum ms between two sends, 0 = no limit
+    uint8_t  reserved;  // padding / future use
 } AINSER_MapEntry;
 
 // Output callback type:
@@ -69,15 +87,24 @@ void ainser_map_init_defaults(void);
 // If NULL, events are computed but discarded.
 void ainser_map_set_output_cb(AINSER_MapOutputFn cb);
 
-// Process a single AINSER logical channel (0..63) with a 12-bit raw value.
-// This function:
-//  - applies per-channel threshold
-//  - applies smoothing
+// Process a single AINSER logical channel (0..AINSER_NUM_CHANNELS-1) with a
+// 12-bit raw value. This function:
+//  - applies per-channel threshold (deadband around the last accepted value)
+//  - applies smoothing (one-pole, shift based, 4 fractional bits)
 //  - clamps to min/max and applies inversion
-//  - applies curve (linear/expo/log)
-//  - quantises to 0..127
-//  - only emits a new value when the 7-bit result actually changes
-void ainser_map_process_channel(uint8_t index, uint16_t raw12);
+//  - applies curve (linear/expo/log) at 14-bit resolution
+//  - quantises to 0..127 (CC7) or 0..16383 (CC14, NRPN)
+//  - only emits a new value when the quantised result actually changes,
+//    and at most once per rate_ms (see ainser_map_tick())
+void ainser_map_process_channel(uint16_t index, uint16_t raw12);
+
+// Give the mapper the time and flush coalesced values: a change arriving
+// less than rate_ms after the previous send is held, replaced by any newer
+// value, and sent here once rate_ms has passed, so the resting value always
+// goes out. Call from the scan loop, once per pass or every few ms. Until
+// the first call rate_ms is ignored (every change is sent).
+void ainser_map_tick(uint32_t now_ms);
+
 // Load mapping overrides from SD card config file (0:/cfg/ainser_map.ngc by default).
 // Returns 0 on success, negative on error. Defaults remain in place for channels not mentioned in the file.
 int ainser_map_load_sd(const char* path);
@@ -4,6 +4,8 @@
  */
 
 #include "Services/bellows_expression/bellows_expression.h"
+#include "Services/expression/expr_curve.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <string.h>
 
 typedef struct {
@@ -14,68 +16,97 @@ typedef struct {
     uint8_t expression_cc;
     uint8_t breath_cc;
     uint8_t smoothing;
+    uint16_t alpha;             // EMA weight of the new value, Q8 (from smoothing)
     uint16_t attack_ms;
     uint16_t release_ms;
     bellows_direction_t direction;
     uint8_t current_expression;
     uint8_t target_expression;
+    uint16_t filt;              // EMA state, 0..127 in Q8
     uint32_t last_update_ms;
 } bellows_config_t;
 
 static bellows_config_t g_bellows[BELLOWS_MAX_TRACKS];
 static uint32_t g_tick_counter = 0;
+static uint8_t g_sched = 0;  // driven by tick_sched: its clock is newer between dispatches
 static bellows_cc_output_cb_t g_output_callback = NULL;
 
-/**
- * @brief Apply expression curve
- */
-static uint8_t apply_curve(bellows_curve_t curve, uint8_t linear_value) {
-    uint16_t value = linear_value;
-    
+// One 128-entry table per curve, built by bellows_init() (and for the user
+// curve by bellows_load_user_curve()); per sample the curve is one lookup.
+static uint8_t g_curve_lut[BELLOWS_CURVE_COUNT][128];
+
+static uint8_t isqrt16(uint16_t v) {
+    uint8_t r = 0;
+    for (uint8_t bit = 0x80; bit; bit >>= 1) {
+        uint8_t t = (uint8_t)(r | bit);
+        if ((uint16_t)t * t <= v) r = t;
+    }
+    return r;
+}
+
+static uint8_t curve_value(bellows_curve_t curve, uint8_t x) {
+    uint16_t value = x;
     switch (curve) {
-        case BELLOWS_CURVE_LINEAR:
-            return linear_value;
-            
         case BELLOWS_CURVE_EXPONENTIAL:
             // y = x^2 / 127
-            value = (linear_value * linear_value) / 127;
+            value = (uint16_t)((x * x) / 127);
             break;
-            
-        case BELLOWS_CURVE_LOGARITHMIC:
-            // y = sqrt(x * 127)
-            value = 127;
-            for (uint8_t i = 0; i < linear_value; i++) {
-                if ((i * i) / 127 > linear_value) {
-                    value = i;
-                    break;
-                }
-            }
+        case BELLOWS_CURVE_LOGARITHMIC: {
+            // y = sqrt(x * 127), rounded
+            uint16_t sq = (uint16_t)(x * 127);
+            value = isqrt16(sq);
+            if ((uint32_t)value * value + value < sq) value++;
             break;
-            
+        }
         case BELLOWS_CURVE_S_CURVE:
             // Simple S-curve approximation
-            if (linear_value < 32) {
-                value = linear_value / 2;
-            } else if (linear_value < 96) {
-                value = 16 + ((linear_value - 32) * 3) / 2;
+            if (x < 32) {
+                value = x / 2;
+            } else if (x < 96) {
+                value = 16 + ((x - 32) * 3) / 2;
             } else {
-                value = 112 + (linear_value - 96) / 2;
+                value = 112 + (x - 96) / 2;
             }
             break;
-            
         default:
-            return linear_value;
+            break;
     }
-    
     if (value > 127) value = 127;
     return (uint8_t)value;
 }
 
+static void build_curves(void) {
+    for (uint8_t c = 0; c < BELLOWS_CURVE_COUNT; c++) {
+        for (uint8_t x = 0; x < 128; x++) {
+            g_curve_lut[c][x] = curve_value((bellows_curve_t)c, x);
+        }
+    }
+}
+
+static uint16_t smoothing_alpha(uint8_t smoothing) {
+    return (uint16_t)(((100u - smoothing) * 256u + 50u) / 100u);
+}
+
+/**
+ * @brief Load the BELLOWS_CURVE_USER points from SD (see expr_curve.h)
+ */
+int bellows_load_user_curve(const char* path) {
+    expr_curve_points_t pts;
+    int r = expr_curve_load_sd(&pts, path);
+    if (r != 0) return r;
+    for (uint8_t x = 0; x < 128; x++) {
+        uint16_t y = expr_curve_eval(&pts, (uint16_t)(((uint32_t)x * 65535u + 63u) / 127u));
+        g_curve_lut[BELLOWS_CURVE_USER][x] = (uint8_t)(((uint32_t)y * 127u + 32767u) / 65535u);
+    }
+    return 0;
+}
+
 /**
  * @brief Initialize bellows expression module
  */
 void bellows_init(void) {
     memset(g_bellows, 0, sizeof(g_bellows));
+    build_curves();
     
     for (uint8_t t = 0; t < BELLOWS_MAX_TRACKS; t++) {
         g_bellows[t].curve = BELLOWS_CURVE_LINEAR;
@@ -85,6 +116,7 @@ void bellows_init(void) {
         g_bellows[t].expression_cc = 11;  // Expression
         g_bellows[t].breath_cc = 2;       // Breath
         g_bellows[t].smoothing = 30;      // 30% smoothing
+        g_bellows[t].alpha = smoothing_alpha(30);
         g_bellows[t].attack_ms = 10;
         g_bellows[t].release_ms = 50;
         g_bellows[t].direction = BELLOWS_DIR_NEUTRAL;
@@ -183,6 +215,7 @@ void bellows_set_smoothing(uint8_t track, uint8_t amount) {
     if (track >= BELLOWS_MAX_TRACKS) return;
     if (amount > 100) amount = 100;
     g_bellows[track].smoothing = amount;
+    g_bellows[track].alpha = smoothing_alpha(amount);
 }
 
 /**
@@ -228,15 +261,15 @@ void bellows_process_pressure(uint8_t track, int32_t pressure_pa, uint8_t channe
     if (normalized > 127) normalized = 127;
     
     // Apply curve
-    uint8_t curved_value = apply_curve(cfg->curve, (uint8_t)normalized);
+    uint8_t curved_value = g_curve_lut[cfg->curve][normalized];
     
-    // Apply smoothing (exponential moving average)
-    if (cfg->smoothing > 0) {
-        uint16_t alpha = 100 - cfg->smoothing;  // Inverted for EMA
-        cfg->target_expression = curved_value;
-        curved_value = (uint8_t)(((uint16_t)cfg->current_expression * cfg->smoothing + 
-                                   (uint16_t)curved_value * alpha) / 100);
-    }
+    // Apply smoothing (exponential moving average, Q8 state so small
+    // steps still converge instead of truncating away)
+    cfg->target_expression = curved_value;
+    int32_t f = cfg->filt;
+    f += ((((int32_t)curved_value << 8) - f) * cfg->alpha) >> 8;
+    cfg->filt = (uint16_t)f;
+    curved_value = (uint8_t)((f + 128) >> 8);
     
     // Update current value
     if (curved_value != cfg->current_expression) {
@@ -249,7 +282,7 @@ void bellows_process_pressure(uint8_t track, int32_t pressure_pa, uint8_t channe
         }
     }
     
-    cfg->last_update_ms = g_tick_counter;
+    cfg->last_update_ms = g_sched ? tick_sched_now() : g_tick_counter;
 }
 
 /**
@@ -276,6 +309,15 @@ void bellows_tick_1ms(void) {
     // Smoothing is handled in process_pressure
 }
 
+/**
+ * @brief tick_sched handler: nothing is time driven, so never due
+ */
+uint32_t bellows_service(uint32_t now_ms) {
+    g_sched = 1;
+    g_tick_counter = now_ms;
+    return TICK_SCHED_IDLE;
+}
+
 /**
  * @brief Set output callback
  */
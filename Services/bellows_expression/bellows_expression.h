@@ -33,9 +33,12 @@ typedef enum {
     BELLOWS_CURVE_EXPONENTIAL,  // More sensitive at low pressure
     BELLOWS_CURVE_LOGARITHMIC,  // More sensitive at high pressure
     BELLOWS_CURVE_S_CURVE,      // Smooth at extremes
+    BELLOWS_CURVE_USER,         // Points loaded by bellows_load_user_curve()
     BELLOWS_CURVE_COUNT
 } bellows_curve_t;
 
+#define BELLOWS_USER_CURVE_PATH "0:/cfg/bellows_curve.ngc"
+
 /**
  * @brief Initialize bellows expression module
  */
@@ -55,6 +58,13 @@ void bellows_set_curve(uint8_t track, bellows_curve_t curve);
  */
 bellows_curve_t bellows_get_curve(uint8_t track);
 
+/**
+ * @brief Load the user curve (BELLOWS_CURVE_USER) from SD
+ * @param path .ngc file with POINT=in,out lines (see expr_curve.h)
+ * @return 0 on success, negative on error (previous user curve kept)
+ */
+int bellows_load_user_curve(const char* path);
+
 /**
  * @brief Set pressure range (calibration)
  * @param track Track index (0-3)
@@ -162,6 +172,12 @@ uint8_t bellows_get_expression_value(uint8_t track);
  */
 void bellows_tick_1ms(void);
 
+/**
+ * @brief tick_sched handler (TICK_SVC_BELLOWS)
+ * @return Always TICK_SCHED_IDLE: smoothing runs per pressure sample
+ */
+uint32_t bellows_service(uint32_t now_ms);
+
 /**
  * @brief Callback for outputting CC messages
  * @param track Track index
@@ -1,17 +1,26 @@
 /**
  * @file bellows_shake.c
  * @brief Bellows Shake implementation
+ *
+ * Detection works on the band-passed pressure stream (pressure_pipe shake
+ * output): a zero crossing counts only after the signal has swung past the
+ * sensitivity threshold, and its time is interpolated between the two
+ * samples around it, so the period resolution is in microseconds instead
+ * of the sample interval. Two consecutive half periods make one period,
+ * which cancels any offset left in the signal.
+ *
+ * The tremolo is a 32-bit phase accumulator (one cycle = 2^32) advanced by
+ * the elapsed microseconds and re-locked to the bellows at every crossing;
+ * its top 8 bits index a sine table. Outputs are sent only when their value
+ * changes, and at most once per BELLOWS_SHAKE_OUT_MIN_US each.
  */
 
 #include "Services/bellows_shake/bellows_shake.h"
 #include <string.h>
 
-#define HISTORY_SIZE 32  // Pressure history for shake detection
+#define PHASE_HALF 0x80000000u
 
-typedef struct {
-    int32_t pressure;
-    uint32_t timestamp_ms;
-} pressure_sample_t;
+enum { OUT_CC11 = 0, OUT_CC74, OUT_PB, OUT_COUNT };
 
 typedef struct {
     uint8_t enabled;
@@ -20,13 +29,33 @@ typedef struct {
     shake_target_t target;
     uint8_t min_freq_hz;
     uint8_t max_freq_hz;
-    pressure_sample_t history[HISTORY_SIZE];
-    uint8_t history_head;
+    // Derived from the settings above
+    int32_t thr_pa;           // swing needed to arm the next crossing
+    uint32_t period_min_us;
+    uint32_t period_max_us;
+    int32_t amp_q8;           // sine (+-127) -> modulation offset (+-63)
+    int32_t pb_amp_q8;        // sine (+-127) -> pitchbend (+-4096)
+    // Detector
+    uint8_t have_prev;
+    uint8_t armed;
+    uint8_t have_zc;
+    uint8_t oscillation_count;
     uint8_t shake_detected;
     uint8_t detected_freq_hz;
+    uint16_t freq_chz;
+    int32_t prev_pa;
+    uint32_t prev_us;
+    uint32_t last_zc_us;
+    uint32_t last_half_us;
+    // Tremolo
+    uint32_t phase;
+    uint32_t phase_inc;       // per microsecond
     uint8_t current_modulation;
-    uint32_t last_zero_crossing;
-    uint8_t oscillation_count;
+    int16_t pb_value;
+    // Outputs
+    uint8_t channel;
+    int16_t out_last[OUT_COUNT];
+    uint32_t out_us[OUT_COUNT];
 } bellows_shake_config_t;
 
 static bellows_shake_config_t g_shake[BELLOWS_SHAKE_MAX_TRACKS];
@@ -34,6 +63,94 @@ static uint32_t g_tick_counter = 0;
 static bellows_shake_cc_output_cb_t g_cc_callback = NULL;
 static bellows_shake_pb_output_cb_t g_pb_callback = NULL;
 
+// round(127 * sin(2*pi*i/256))
+static const int8_t k_sine[256] = {
+     0,    3,    6,    9,   12,   16,   19,   22,   25,   28,   31,   34,   37,   40,   43,   46,
+    49,   51,   54,   57,   60,   63,   65,   68,   71,   73,   76,   78,   81,   83,   85,   88,
+    90,   92,   94,   96,   98,  100,  102,  104,  106,  107,  109,  111,  112,  113,  115,  116,
+   117,  118,  120,  121,  122,  122,  123,  124,  125,  125,  126,  126,  126,  127,  127,  127,
+   127,  127,  127,  127,  126,  126,  126,  125,  125,  124,  123,  122,  122,  121,  120,  118,
+   117,  116,  115,  113,  112,  111,  109,  107,  106,  104,  102,  100,   98,   96,   94,   92,
+    90,   88,   85,   83,   81,   78,   76,   73,   71,   68,   65,   63,   60,   57,   54,   51,
+    49,   46,   43,   40,   37,   34,   31,   28,   25,   22,   19,   16,   12,    9,    6,    3,
+     0,   -3,   -6,   -9,  -12,  -16,  -19,  -22,  -25,  -28,  -31,  -34,  -37,  -40,  -43,  -46,
+   -49,  -51,  -54,  -57,  -60,  -63,  -65,  -68,  -71,  -73,  -76,  -78,  -81,  -83,  -85,  -88,
+   -90,  -92,  -94,  -96,  -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+  -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+  -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+  -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100,  -98,  -96,  -94,  -92,
+   -90,  -88,  -85,  -83,  -81,  -78,  -76,  -73,  -71,  -68,  -65,  -63,  -60,  -57,  -54,  -51,
+   -49,  -46,  -43,  -40,  -37,  -34,  -31,  -28,  -25,  -22,  -19,  -16,  -12,   -9,   -6,   -3,
+};
+
+static const int16_t k_out_neutral[OUT_COUNT] = { 64, 64, 0 };
+
+static void update_thr(bellows_shake_config_t* cfg) {
+    cfg->thr_pa = BELLOWS_SHAKE_THR_MIN_PA +
+        ((int32_t)(100 - cfg->sensitivity) * (BELLOWS_SHAKE_THR_MAX_PA - BELLOWS_SHAKE_THR_MIN_PA)) / 100;
+}
+
+static void update_depth(bellows_shake_config_t* cfg) {
+    cfg->amp_q8 = ((int32_t)cfg->depth * 63 * 256) / (127 * 100);
+    cfg->pb_amp_q8 = ((int32_t)cfg->depth * 4096 * 256) / (127 * 100);
+}
+
+static void update_range(bellows_shake_config_t* cfg) {
+    cfg->period_min_us = 1000000u / cfg->max_freq_hz;
+    cfg->period_max_us = 1000000u / cfg->min_freq_hz;
+}
+
+static void reset_detector(bellows_shake_config_t* cfg) {
+    cfg->have_prev = 0;
+    cfg->armed = 0;
+    cfg->have_zc = 0;
+    cfg->oscillation_count = 0;
+    cfg->shake_detected = 0;
+    cfg->detected_freq_hz = 0;
+    cfg->freq_chz = 0;
+    cfg->last_half_us = 0;
+    cfg->phase = 0;
+    cfg->phase_inc = 0;
+    cfg->current_modulation = 64;
+    cfg->pb_value = 0;
+}
+
+/**
+ * @brief Send one output if it changed and its rate limit allows
+ */
+static void out_send(uint8_t track, bellows_shake_config_t* cfg, uint8_t slot,
+                     int16_t value, uint32_t now_us) {
+    if (value == cfg->out_last[slot]) return;
+    if ((uint32_t)(now_us - cfg->out_us[slot]) < BELLOWS_SHAKE_OUT_MIN_US) return;
+
+    if (slot == OUT_PB) {
+        if (!g_pb_callback) return;
+        g_pb_callback(track, value, cfg->channel);
+    } else {
+        if (!g_cc_callback) return;
+        g_cc_callback(track, slot == OUT_CC11 ? 11 : 74, (uint8_t)value, cfg->channel);
+    }
+    cfg->out_last[slot] = value;
+    cfg->out_us[slot] = now_us;
+}
+
+static void update_outputs(uint8_t track, bellows_shake_config_t* cfg, uint32_t now_us) {
+    int16_t cc = cfg->current_modulation;
+    int16_t pb = cfg->pb_value;
+
+    // Outputs of other targets (after a target change) fall back to neutral
+    int16_t want[OUT_COUNT] = { k_out_neutral[OUT_CC11], k_out_neutral[OUT_CC74],
+                                k_out_neutral[OUT_PB] };
+    switch (cfg->target) {
+        case SHAKE_TARGET_VOLUME: want[OUT_CC11] = cc; break;
+        case SHAKE_TARGET_PITCH:  want[OUT_PB] = pb; break;
+        case SHAKE_TARGET_FILTER: want[OUT_CC74] = cc; break;
+        case SHAKE_TARGET_BOTH:   want[OUT_CC11] = cc; want[OUT_PB] = pb / 2; break;
+        default: break;
+    }
+    for (uint8_t s = 0; s < OUT_COUNT; s++) out_send(track, cfg, s, want[s], now_us);
+}
+
 /**
  * @brief Initialize bellows shake module
  */
@@ -41,12 +158,18 @@ void bellows_shake_init(void) {
     memset(g_shake, 0, sizeof(g_shake));
     
     for (uint8_t t = 0; t < BELLOWS_SHAKE_MAX_TRACKS; t++) {
-        g_shake[t].enabled = 0;
-        g_shake[t].sensitivity = 50;
-        g_shake[t].depth = 50;
-        g_shake[t].target = SHAKE_TARGET_VOLUME;
-        g_shake[t].min_freq_hz = 4;   // 4 Hz minimum
-        g_shake[t].max_freq_hz = 12;  // 12 Hz maximum
+        bellows_shake_config_t* cfg = &g_shake[t];
+        cfg->enabled = 0;
+        cfg->sensitivity = 50;
+        cfg->depth = 50;
+        cfg->target = SHAKE_TARGET_VOLUME;
+        cfg->min_freq_hz = 4;   // 4 Hz minimum
+        cfg->max_freq_hz = 12;  // 12 Hz maximum
+        update_thr(cfg);
+        update_depth(cfg);
+        update_range(cfg);
+        reset_detector(cfg);
+        for (uint8_t s = 0; s < OUT_COUNT; s++) cfg->out_last[s] = k_out_neutral[s];
     }
 }
 
@@ -55,7 +178,14 @@ void bellows_shake_init(void) {
  */
 void bellows_shake_set_enabled(uint8_t track, uint8_t enabled) {
     if (track >= BELLOWS_SHAKE_MAX_TRACKS) return;
-    g_shake[track].enabled = enabled ? 1 : 0;
+    bellows_shake_config_t* cfg = &g_shake[track];
+    if (!enabled && cfg->enabled) {
+        // Leave the synth at rest: no rate limit for this last update
+        reset_detector(cfg);
+        for (uint8_t s = 0; s < OUT_COUNT; s++) cfg->out_us[s] = cfg->prev_us - BELLOWS_SHAKE_OUT_MIN_US;
+        update_outputs(track, cfg, cfg->prev_us);
+    }
+    cfg->enabled = enabled ? 1 : 0;
 }
 
 /**
@@ -73,6 +203,7 @@ void bellows_shake_set_sensitivity(uint8_t track, uint8_t sensitivity) {
     if (track >= BELLOWS_SHAKE_MAX_TRACKS) return;
     if (sensitivity > 100) sensitivity = 100;
     g_shake[track].sensitivity = sensitivity;
+    update_thr(&g_shake[track]);
 }
 
 /**
@@ -90,6 +221,7 @@ void bellows_shake_set_depth(uint8_t track, uint8_t depth) {
     if (track >= BELLOWS_SHAKE_MAX_TRACKS) return;
     if (depth > 100) depth = 100;
     g_shake[track].depth = depth;
+    update_depth(&g_shake[track]);
 }
 
 /**
@@ -128,6 +260,7 @@ void bellows_shake_set_freq_range(uint8_t track, uint8_t min_hz, uint8_t max_hz)
     
     g_shake[track].min_freq_hz = min_hz;
     g_shake[track].max_freq_hz = max_hz;
+    update_range(&g_shake[track]);
 }
 
 /**
@@ -140,117 +273,96 @@ void bellows_shake_get_freq_range(uint8_t track, uint8_t* min_hz, uint8_t* max_h
 }
 
 /**
- * @brief Detect zero crossings and calculate frequency
+ * @brief Handle one sample: arm on a full swing, then time the crossing
  */
-static void detect_shake(uint8_t track) {
-    bellows_shake_config_t* cfg = &g_shake[track];
-    
-    // Simple zero-crossing detection
-    // Look at recent pressure samples
-    if (cfg->history_head < 2) return;
-    
-    uint8_t prev_idx = (cfg->history_head - 1) % HISTORY_SIZE;
-    uint8_t curr_idx = cfg->history_head % HISTORY_SIZE;
-    
-    int32_t prev_pressure = cfg->history[prev_idx].pressure;
-    int32_t curr_pressure = cfg->history[curr_idx].pressure;
-    
-    // Check for zero crossing
-    if ((prev_pressure < 0 && curr_pressure >= 0) || 
-        (prev_pressure >= 0 && curr_pressure < 0)) {
-        
-        uint32_t current_time = cfg->history[curr_idx].timestamp_ms;
-        
-        if (cfg->last_zero_crossing > 0) {
-            uint32_t period_ms = current_time - cfg->last_zero_crossing;
-            
-            if (period_ms > 0) {
-                // Calculate frequency
-                uint16_t freq_hz = (1000 / period_ms) / 2;  // Divide by 2 for full period
-                
-                // Check if within valid range
-                if (freq_hz >= cfg->min_freq_hz && freq_hz <= cfg->max_freq_hz) {
-                    cfg->oscillation_count++;
-                    
-                    // Need at least 2 cycles to confirm
-                    if (cfg->oscillation_count >= 2) {
-                        cfg->shake_detected = 1;
-                        cfg->detected_freq_hz = (uint8_t)freq_hz;
-                    }
-                } else {
-                    cfg->oscillation_count = 0;
-                    cfg->shake_detected = 0;
-                }
+static void detect_shake(bellows_shake_config_t* cfg, int32_t pa, uint32_t t_us) {
+    int32_t prev = cfg->prev_pa;
+    uint8_t rising = (prev < 0 && pa >= 0);
+    uint8_t falling = (prev >= 0 && pa < 0);
+
+    if ((rising || falling) && cfg->armed) {
+        // Linear interpolation of the crossing between the two samples
+        uint32_t a = (uint32_t)(prev < 0 ? -prev : prev);
+        uint32_t b = (uint32_t)(pa < 0 ? -pa : pa);
+        uint32_t dt = t_us - cfg->prev_us;
+        uint32_t t_zc = cfg->prev_us + (uint32_t)(((uint64_t)dt * a) / (a + b));
+        cfg->armed = 0;
+
+        if (cfg->have_zc) {
+            uint32_t half = t_zc - cfg->last_zc_us;
+            uint32_t period = half + cfg->last_half_us;
+            if (cfg->last_half_us != 0 &&
+                period >= cfg->period_min_us && period <= cfg->period_max_us) {
+                if (cfg->oscillation_count < 255) cfg->oscillation_count++;
+                cfg->phase_inc = (uint32_t)((1ull << 32) / period);
+                cfg->freq_chz = (uint16_t)((100000000u + period / 2) / period);
+                cfg->detected_freq_hz = (uint8_t)((cfg->freq_chz + 50u) / 100u);
+                // Need at least 2 periods to confirm
+                if (cfg->oscillation_count >= 2) cfg->shake_detected = 1;
+            } else if (cfg->last_half_us != 0) {
+                cfg->oscillation_count = 0;
+                cfg->shake_detected = 0;
             }
+            cfg->last_half_us = half;
         }
-        
-        cfg->last_zero_crossing = current_time;
+        cfg->have_zc = 1;
+        cfg->last_zc_us = t_zc;
+
+        // Lock the tremolo to the bellows: rising crossing = phase 0
+        cfg->phase = (rising ? 0u : PHASE_HALF) + cfg->phase_inc * (t_us - t_zc);
     }
-    
-    // Timeout shake detection if no oscillations for 500ms
-    if (cfg->shake_detected) {
-        uint32_t elapsed = g_tick_counter - cfg->last_zero_crossing;
-        if (elapsed > 500) {
-            cfg->shake_detected = 0;
-            cfg->oscillation_count = 0;
-        }
+
+    if (pa >= cfg->thr_pa || pa <= -cfg->thr_pa) cfg->armed = 1;
+
+    // Timeout shake detection if no oscillations for a while
+    if (cfg->have_zc && (uint32_t)(t_us - cfg->last_zc_us) > BELLOWS_SHAKE_TIMEOUT_US) {
+        cfg->have_zc = 0;
+        cfg->last_half_us = 0;
+        cfg->oscillation_count = 0;
+        cfg->shake_detected = 0;
     }
 }
 
 /**
- * @brief Process bellows pressure reading
+ * @brief Process a band-passed pressure sample with a microsecond timestamp
  */
-void bellows_shake_process_pressure(uint8_t track, int32_t pressure_pa,
-                                   uint32_t timestamp_ms, uint8_t channel) {
+void bellows_shake_process_pressure_us(uint8_t track, int32_t pressure_pa,
+                                       uint32_t t_us, uint8_t channel) {
     if (track >= BELLOWS_SHAKE_MAX_TRACKS) return;
     
     bellows_shake_config_t* cfg = &g_shake[track];
     if (!cfg->enabled) return;
-    
-    // Add to history
-    uint8_t idx = cfg->history_head % HISTORY_SIZE;
-    cfg->history[idx].pressure = pressure_pa;
-    cfg->history[idx].timestamp_ms = timestamp_ms;
-    cfg->history_head++;
-    
-    // Detect shake
-    detect_shake(track);
-    
-    // Generate tremolo if shake detected
+    cfg->channel = channel & 0x0F;
+
+    if (!cfg->have_prev) {
+        cfg->have_prev = 1;
+        cfg->prev_pa = pressure_pa;
+        cfg->prev_us = t_us;
+        return;
+    }
+
+    cfg->phase += cfg->phase_inc * (t_us - cfg->prev_us);
+    detect_shake(cfg, pressure_pa, t_us);
+    cfg->prev_pa = pressure_pa;
+    cfg->prev_us = t_us;
+
     if (cfg->shake_detected) {
-        // Simple sine-wave approximation based on detected frequency
-        // Phase = (timestamp * freq * 2π) / 1000
-        uint32_t phase = (timestamp_ms * cfg->detected_freq_hz) % 1000;
-        
-        // Convert to modulation value (0-127)
-        // Simple triangle wave for now
-        uint8_t mod_value;
-        if (phase < 500) {
-            mod_value = (uint8_t)((phase * 127) / 500);
-        } else {
-            mod_value = (uint8_t)(127 - ((phase - 500) * 127) / 500);
-        }
-        
-        // Apply depth
-        mod_value = 64 + (((int16_t)mod_value - 64) * cfg->depth) / 100;
-        cfg->current_modulation = mod_value;
-        
-        // Output based on target
-        if (cfg->target == SHAKE_TARGET_VOLUME && g_cc_callback) {
-            g_cc_callback(track, 11, mod_value, channel);  // Expression CC
-        } else if (cfg->target == SHAKE_TARGET_PITCH && g_pb_callback) {
-            int16_t pb = ((int16_t)mod_value - 64) * 64;  // ±4096 range
-            g_pb_callback(track, pb, channel);
-        } else if (cfg->target == SHAKE_TARGET_FILTER && g_cc_callback) {
-            g_cc_callback(track, 74, mod_value, channel);  // Filter CC
-        } else if (cfg->target == SHAKE_TARGET_BOTH) {
-            if (g_cc_callback) g_cc_callback(track, 11, mod_value, channel);
-            if (g_pb_callback) {
-                int16_t pb = ((int16_t)mod_value - 64) * 32;  // Smaller pitch mod
-                g_pb_callback(track, pb, channel);
-            }
-        }
+        int32_t s = k_sine[cfg->phase >> 24];
+        cfg->current_modulation = (uint8_t)(64 + (s * cfg->amp_q8) / 256);
+        cfg->pb_value = (int16_t)((s * cfg->pb_amp_q8) / 256);
+    } else {
+        cfg->current_modulation = 64;
+        cfg->pb_value = 0;
     }
+    update_outputs(track, cfg, t_us);
+}
+
+/**
+ * @brief Process bellows pressure reading
+ */
+void bellows_shake_process_pressure(uint8_t track, int32_t pressure_pa,
+                                   uint32_t timestamp_ms, uint8_t channel) {
+    bellows_shake_process_pressure_us(track, pressure_pa, timestamp_ms * 1000u, channel);
 }
 
 /**
@@ -266,7 +378,15 @@ uint8_t bellows_shake_is_detected(uint8_t track) {
  */
 uint8_t bellows_shake_get_frequency(uint8_t track) {
     if (track >= BELLOWS_SHAKE_MAX_TRACKS) return 0;
-    return g_shake[track].detected_freq_hz;
+    return g_shake[track].shake_detected ? g_shake[track].detected_freq_hz : 0;
+}
+
+/**
+ * @brief Get detected shake frequency in 0.01 Hz
+ */
+uint16_t bellows_shake_get_frequency_chz(uint8_t track) {
+    if (track >= BELLOWS_SHAKE_MAX_TRACKS) return 0;
+    return g_shake[track].shake_detected ? g_shake[track].freq_chz : 0;
 }
 
 /**
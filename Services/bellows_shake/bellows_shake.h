@@ -15,6 +15,24 @@ extern "C" {
 
 #define BELLOWS_SHAKE_MAX_TRACKS 4
 
+/** Swing (Pa) needed to arm a zero crossing at sensitivity 100 and 0 */
+#ifndef BELLOWS_SHAKE_THR_MIN_PA
+#define BELLOWS_SHAKE_THR_MIN_PA 5
+#endif
+#ifndef BELLOWS_SHAKE_THR_MAX_PA
+#define BELLOWS_SHAKE_THR_MAX_PA 300
+#endif
+
+/** Shake ends when no crossing is seen for this long */
+#ifndef BELLOWS_SHAKE_TIMEOUT_US
+#define BELLOWS_SHAKE_TIMEOUT_US 500000u
+#endif
+
+/** Minimum interval between two messages of the same output (CC11, CC74, PB) */
+#ifndef BELLOWS_SHAKE_OUT_MIN_US
+#define BELLOWS_SHAKE_OUT_MIN_US 5000u
+#endif
+
 /**
  * @brief Tremolo target parameters
  */
@@ -109,10 +127,27 @@ void bellows_shake_get_freq_range(uint8_t track, uint8_t* min_hz, uint8_t* max_h
  * @param pressure_pa Pressure in Pascals
  * @param timestamp_ms Current time in milliseconds
  * @param channel MIDI channel
+ *
+ * Same as bellows_shake_process_pressure_us() with a millisecond timestamp.
  */
 void bellows_shake_process_pressure(uint8_t track, int32_t pressure_pa, 
                                    uint32_t timestamp_ms, uint8_t channel);
 
+/**
+ * @brief Process a band-passed pressure sample (e.g. the pressure_pipe
+ *        shake stream) with a microsecond timestamp
+ * @param track Track index (0-3)
+ * @param pressure_pa Pressure in Pascals, centered on zero
+ * @param t_us Sample time in microseconds (wraps)
+ * @param channel MIDI channel
+ *
+ * Zero crossings are interpolated between samples. CC/pitchbend callbacks
+ * fire only when the output value changes, at most once per
+ * BELLOWS_SHAKE_OUT_MIN_US per output.
+ */
+void bellows_shake_process_pressure_us(uint8_t track, int32_t pressure_pa,
+                                       uint32_t t_us, uint8_t channel);
+
 /**
  * @brief Get current shake detection state
  * @param track Track index (0-3)
@@ -127,6 +162,13 @@ uint8_t bellows_shake_is_detected(uint8_t track);
  */
 uint8_t bellows_shake_get_frequency(uint8_t track);
 
+/**
+ * @brief Get detected shake frequency with more resolution
+ * @param track Track index (0-3)
+ * @return Frequency in 0.01 Hz (0 if not detected)
+ */
+uint16_t bellows_shake_get_frequency_chz(uint8_t track);
+
 /**
  * @brief Get current tremolo modulation value
  * @param track Track index (0-3)
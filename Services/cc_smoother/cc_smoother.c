@@ -4,6 +4,7 @@
  */
 
 #include "Services/cc_smoother/cc_smoother.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <string.h>
 #include <math.h>
 
@@ -51,12 +52,17 @@ typedef struct {
 
 static track_config_t g_tracks[CC_SMOOTHER_MAX_TRACKS];
 static uint32_t g_tick_counter = 0;
+static uint8_t g_sched = 0;  // driven by tick_sched: its clock is newer between dispatches
 static cc_smoother_output_cb_t g_output_callback = NULL;
 
 // Forward declarations
 static float calculate_smoothing_coefficient(uint16_t time_ms);
 static void apply_smoothing(track_config_t* track, cc_state_t* cc, float dt_ms);
 
+static uint32_t now_ms(void) {
+    return g_sched ? tick_sched_now() : g_tick_counter;
+}
+
 /**
  * @brief Initialize CC smoother module
  */
@@ -309,7 +315,7 @@ uint8_t cc_smoother_process(uint8_t track, uint8_t cc_number, uint8_t value) {
     
     // Update target value
     cc->target_value = (float)value;
-    cc->last_update_ms = g_tick_counter;
+    cc->last_update_ms = now_ms();
     
     // If this is the first value or mode is OFF, snap to target
     if (cc->current_value == 0.0f && cc->last_output == 0 && value > 0) {
@@ -324,14 +330,19 @@ uint8_t cc_smoother_process(uint8_t track, uint8_t cc_number, uint8_t value) {
     if (output > 127) output = 127;
     
     cc->last_output = output;
+    if (fabsf(cc->target_value - cc->current_value) >= 0.1f) {
+        tick_sched_wake(TICK_SVC_CC_SMOOTHER, 0);
+    }
     return output;
 }
 
 /**
- * @brief Update smoothing (call every 1ms)
+ * @brief Step every CC that is still moving towards its target
+ * @return 1 while any CC is moving, TICK_SCHED_IDLE when all have settled
  */
-void cc_smoother_tick_1ms(void) {
-    g_tick_counter++;
+static uint32_t service_at(uint32_t now) {
+    uint8_t moving = 0;
+    g_tick_counter = now;
     
     for (uint8_t t = 0; t < CC_SMOOTHER_MAX_TRACKS; t++) {
         track_config_t* track = &g_tracks[t];
@@ -351,6 +362,7 @@ void cc_smoother_tick_1ms(void) {
             
             // Apply smoothing
             apply_smoothing(track, cc, 1.0f);
+            if (fabsf(cc->target_value - cc->current_value) >= 0.1f) moving = 1;
             
             // Convert to integer and check if changed
             uint8_t output = (uint8_t)(cc->current_value + 0.5f);
@@ -363,6 +375,22 @@ void cc_smoother_tick_1ms(void) {
             }
         }
     }
+    return moving ? 1u : TICK_SCHED_IDLE;
+}
+
+/**
+ * @brief Update smoothing (call every 1ms)
+ */
+void cc_smoother_tick_1ms(void) {
+    (void)service_at(g_tick_counter + 1);
+}
+
+/**
+ * @brief tick_sched handler
+ */
+uint32_t cc_smoother_service(uint32_t now_ms) {
+    g_sched = 1;
+    return service_at(now_ms);
 }
 
 /**
@@ -175,6 +175,15 @@ uint8_t cc_smoother_process(uint8_t track, uint8_t cc_number, uint8_t value);
  */
 void cc_smoother_tick_1ms(void);
 
+/**
+ * @brief tick_sched handler (TICK_SVC_CC_SMOOTHER): step smoothing at now_ms
+ * @return 1 while a CC is still moving, TICK_SCHED_IDLE once all settled
+ * 
+ * @note Use instead of cc_smoother_tick_1ms(); incoming CCs wake the
+ *       service through tick_sched_wake().
+ */
+uint32_t cc_smoother_service(uint32_t now_ms);
+
 /**
  * @brief Reset all smoothing state for a track
  * @param track Track index (0-3)
@@ -9,6 +9,35 @@
 #include "Services/cli/module_cli_helpers.h"
 #include <string.h>
 
+// =============================================================================
+// PARAMETER WRAPPERS
+// =============================================================================
+
+static const char* s_cal_mode_names[] = {
+  "LEARN",
+  "FROZEN",
+  "DRIFT",
+};
+
+static int ain_param_get_cal_mode(uint8_t track, param_value_t* out) {
+  (void)track;
+  out->int_val = (int32_t)ain_cal_get_mode();
+  return 0;
+}
+
+// Leaving LEARN freezes the learned table; it is saved to SD so the next
+// boot starts frozen
+static int ain_param_set_cal_mode(uint8_t track, const param_value_t* val) {
+  (void)track;
+  if (val->int_val < AIN_CAL_LEARN || val->int_val > AIN_CAL_DRIFT) return -1;
+  ain_cal_mode_t prev = ain_cal_get_mode();
+  ain_cal_set_mode((ain_cal_mode_t)val->int_val);
+  if (prev == AIN_CAL_LEARN && val->int_val != AIN_CAL_LEARN) {
+    return (ain_cal_save(AIN_CAL_DEFAULT_PATH) == 0) ? 0 : -1;
+  }
+  return 0;
+}
+
 // =============================================================================
 // MODULE CONTROL WRAPPERS
 // =============================================================================
@@ -54,8 +83,23 @@ static module_descriptor_t s_ain_descriptor = {
 // =============================================================================
 
 static void setup_ain_parameters(void) {
-  // AIN module has no runtime parameters, all config is compile-time
-  s_ain_descriptor.param_count = 0;
+  module_param_t params[] = {
+    {
+      .name = "cal_mode",
+      .description = "Calibration (leaving LEARN saves to SD)",
+      .type = PARAM_TYPE_ENUM,
+      .min = 0,
+      .max = 2,
+      .enum_values = s_cal_mode_names,
+      .enum_count = 3,
+      .read_only = 0,
+      .get_value = ain_param_get_cal_mode,
+      .set_value = ain_param_set_cal_mode
+    }
+  };
+
+  s_ain_descriptor.param_count = sizeof(params) / sizeof(params[0]);
+  memcpy(s_ain_descriptor.params, params, sizeof(params));
 }
 
 // =============================================================================
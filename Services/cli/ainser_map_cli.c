@@ -2,7 +2,7 @@
  * @file ainser_map_cli.c
  * @brief CLI integration for AINSER64 analog input mapping
  * 
- * AINSER64 (SPI ADC) analog input to MIDI CC mapper with 64 channels
+ * AINSER64 (SPI ADC) analog input to MIDI CC mapper, 64 channels per module
  */
 
 #include "Services/ainser/ainser_map.h"
@@ -16,77 +16,112 @@
 
 static int ainser_map_param_get_channel_count(uint8_t track, param_value_t* out) {
   (void)track;
-  out->int_val = 64; // AINSER64 has 64 channels
+  out->int_val = AINSER_NUM_CHANNELS; // 64 per AINSER64 module
   return 0;
 }
 
+// The registry's track argument is the channel index. It is widened here:
+// AINSER_NUM_CHANNELS reaches 256 with four modules, past the uint8_t range.
+static AINSER_MapEntry* channel_entry(uint16_t ch) {
+  if (ch >= AINSER_NUM_CHANNELS) return NULL;
+  return &ainser_map_get_table()[ch];
+}
+
 static int ainser_map_param_get_cc(uint8_t track, param_value_t* out) {
-  const AINSER_MapEntry* table = ainser_map_get_table();
-  if (track >= 64) return -1;
-  out->int_val = table[track].cc;
+  const AINSER_MapEntry* e = channel_entry(track);
+  if (!e) return -1;
+  out->int_val = e->cc;
   return 0;
 }
 
 static int ainser_map_param_set_cc(uint8_t track, const param_value_t* val) {
-  AINSER_MapEntry* table = (AINSER_MapEntry*)ainser_map_get_table();
-  if (track >= 64 || val->int_val < 0 || val->int_val > 127) return -1;
-  table[track].cc = (uint8_t)val->int_val;
+  AINSER_MapEntry* e = channel_entry(track);
+  if (!e || val->int_val < 0 || val->int_val > 127) return -1;
+  e->cc = (uint8_t)val->int_val;
   return 0;
 }
 
 static int ainser_map_param_get_curve(uint8_t track, param_value_t* out) {
-  const AINSER_MapEntry* table = ainser_map_get_table();
-  if (track >= 64) return -1;
-  out->int_val = table[track].curve;
+  const AINSER_MapEntry* e = channel_entry(track);
+  if (!e) return -1;
+  out->int_val = e->curve;
   return 0;
 }
 
 static int ainser_map_param_set_curve(uint8_t track, const param_value_t* val) {
-  AINSER_MapEntry* table = (AINSER_MapEntry*)ainser_map_get_table();
-  if (track >= 64 || val->int_val < 0 || val->int_val >= 4) return -1;
-  table[track].curve = (uint8_t)val->int_val;
+  AINSER_MapEntry* e = channel_entry(track);
+  if (!e || val->int_val < 0 || val->int_val >= 4) return -1;
+  e->curve = (uint8_t)val->int_val;
   return 0;
 }
 
 static int ainser_map_param_get_deadband(uint8_t track, param_value_t* out) {
-  const AINSER_MapEntry* table = ainser_map_get_table();
-  if (track >= 64) return -1;
-  out->int_val = table[track].threshold;
+  const AINSER_MapEntry* e = channel_entry(track);
+  if (!e) return -1;
+  out->int_val = e->threshold;
   return 0;
 }
 
 static int ainser_map_param_set_deadband(uint8_t track, const param_value_t* val) {
-  AINSER_MapEntry* table = (AINSER_MapEntry*)ainser_map_get_table();
-  if (track >= 64 || val->int_val < 0 || val->int_val > 4095) return -1;
-  table[track].threshold = (uint16_t)val->int_val;
+  AINSER_MapEntry* e = channel_entry(track);
+  if (!e || val->int_val < 0 || val->int_val > 4095) return -1;
+  e->threshold = (uint16_t)val->int_val;
   return 0;
 }
 
 static int ainser_map_param_get_min(uint8_t track, param_value_t* out) {
-  const AINSER_MapEntry* table = ainser_map_get_table();
-  if (track >= 64) return -1;
-  out->int_val = table[track].min;
+  const AINSER_MapEntry* e = channel_entry(track);
+  if (!e) return -1;
+  out->int_val = e->min;
   return 0;
 }
 
 static int ainser_map_param_set_min(uint8_t track, const param_value_t* val) {
-  AINSER_MapEntry* table = (AINSER_MapEntry*)ainser_map_get_table();
-  if (track >= 64 || val->int_val < 0 || val->int_val > 4095) return -1;
-  table[track].min = (uint16_t)val->int_val;
+  AINSER_MapEntry* e = channel_entry(track);
+  if (!e || val->int_val < 0 || val->int_val > 4095) return -1;
+  e->min = (uint16_t)val->int_val;
   return 0;
 }
 
 static int ainser_map_param_get_max(uint8_t track, param_value_t* out) {
-  const AINSER_MapEntry* table = ainser_map_get_table();
-  if (track >= 64) return -1;
-  out->int_val = table[track].max;
+  const AINSER_MapEntry* e = channel_entry(track);
+  if (!e) return -1;
+  out->int_val = e->max;
   return 0;
 }
 
 static int ainser_map_param_set_max(uint8_t track, const param_value_t* val) {
-  AINSER_MapEntry* table = (AINSER_MapEntry*)ainser_map_get_table();
-  if (track >= 64 || val->int_val < 0 || val->int_val > 4095) return -1;
-  table[track].max = (uint16_t)val->int_val;
+  AINSER_MapEntry* e = channel_entry(track);
+  if (!e || val->int_val < 0 || val->int_val > 4095) return -1;
+  e->max = (uint16_t)val->int_val;
+  return 0;
+}
+
+static int ainser_map_param_get_mode(uint8_t track, param_value_t* out) {
+  const AINSER_MapEntry* e = channel_entry(track);
+  if (!e) return -1;
+  out->int_val = e->mode;
+  return 0;
+}
+
+static int ainser_map_param_set_mode(uint8_t track, const param_value_t* val) {
+  AINSER_MapEntry* e = channel_entry(track);
+  if (!e || val->int_val < 0 || val->int_val > AINSER_MODE_NRPN) return -1;
+  e->mode = (uint8_t)val->int_val;
+  return 0;
+}
+
+static int ainser_map_param_get_rate_ms(uint8_t track, param_value_t* out) {
+  const AINSER_MapEntry* e = channel_entry(track);
+  if (!e) return -1;
+  out->int_val = e->rate_ms;
+  return 0;
+}
+
+static int ainser_map_param_set_rate_ms(uint8_t track, const param_value_t* val) {
+  AINSER_MapEntry* e = channel_entry(track);
+  if (!e || val->int_val < 0 || val->int_val > 255) return -1;
+  e->rate_ms = (uint8_t)val->int_val;
   return 0;
 }
 
@@ -120,6 +155,12 @@ static const char* s_curve_names[] = {
   "S_CURVE",
 };
 
+static const char* s_mode_names[] = {
+  "CC",
+  "CC14",
+  "NRPN",
+};
+
 // =============================================================================
 // MODULE DESCRIPTOR
 // =============================================================================
@@ -131,7 +172,7 @@ static int ainser_map_cli_init(void) {
 
 static module_descriptor_t s_ainser_map_descriptor = {
   .name = "ainser",
-  .description = "AINSER64 analog input mapping (64 channels, 12-bit ADC)",
+  .description = "AINSER64 analog input mapping (64 ch/module, 12-bit)",
   .category = MODULE_CATEGORY_INPUT,
   .init = ainser_map_cli_init,
   .enable = ainser_map_cli_enable,
@@ -151,8 +192,8 @@ static void setup_ainser_map_parameters(void) {
       .name = "channel_count",
       .description = "Total number of AINSER channels",
       .type = PARAM_TYPE_INT,
-      .min = 64,
-      .max = 64,
+      .min = AINSER_NUM_CHANNELS,
+      .max = AINSER_NUM_CHANNELS,
       .read_only = 1,
       .get_value = ainser_map_param_get_channel_count,
       .set_value = NULL
@@ -208,6 +249,28 @@ static void setup_ainser_map_parameters(void) {
       .read_only = 0,
       .get_value = ainser_map_param_get_max,
       .set_value = ainser_map_param_set_max
+    },
+    {
+      .name = "mode",
+      .description = "Output: 7-bit CC, 14-bit CC pair or NRPN",
+      .type = PARAM_TYPE_ENUM,
+      .min = 0,
+      .max = 2,
+      .enum_values = s_mode_names,
+      .enum_count = 3,
+      .read_only = 0,
+      .get_value = ainser_map_param_get_mode,
+      .set_value = ainser_map_param_set_mode
+    },
+    {
+      .name = "rate_ms",
+      .description = "Min ms between sends (0 = no limit)",
+      .type = PARAM_TYPE_INT,
+      .min = 0,
+      .max = 255,
+      .read_only = 0,
+      .get_value = ainser_map_param_get_rate_ms,
+      .set_value = ainser_map_param_set_rate_ms
     }
   };
   
@@ -19,7 +19,7 @@ static int bellows_expression_param_get_curve(uint8_t track, param_value_t* out)
 }
 
 static int bellows_expression_param_set_curve(uint8_t track, const param_value_t* val) {
-  if (val->int_val < 0 || val->int_val >= 4) return -1;
+  if (val->int_val < 0 || val->int_val >= BELLOWS_CURVE_COUNT) return -1;
   bellows_set_curve(track, (bellows_curve_t)val->int_val);
   return 0;
 }
@@ -87,6 +87,7 @@ static const char* s_curve_names[] = {
   "EXPONENTIAL",
   "LOGARITHMIC",
   "S_CURVE",
+  "USER",
 };
 
 // =============================================================================
@@ -95,6 +96,7 @@ static const char* s_curve_names[] = {
 
 static int bellows_expression_cli_init(void) { 
   bellows_init(); 
+  (void)bellows_load_user_curve(BELLOWS_USER_CURVE_PATH);  // USER stays linear without it
   return 0; 
 }
 
@@ -121,9 +123,9 @@ static void setup_bellows_expression_parameters(void) {
       .description = "Expression curve",
       .type = PARAM_TYPE_ENUM,
       .min = 0,
-      .max = 3,
+      .max = 4,
       .enum_values = s_curve_names,
-      .enum_count = 4,
+      .enum_count = 5,
       .read_only = 0,
       .get_value = bellows_expression_param_get_curve,
       .set_value = bellows_expression_param_set_curve
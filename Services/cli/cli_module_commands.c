@@ -272,6 +272,11 @@ int cli_module_commands_init(void)
   extern int stack_monitor_cli_init(void);
   stack_monitor_cli_init();
 #endif
+
+#if MODULE_ENABLE_UI
+  extern int ui_cli_init(void);
+  ui_cli_init();
+#endif
   
   return result;
 }
@@ -23,7 +23,7 @@ static int expression_param_get_curve(uint8_t track, param_value_t* out) {
 
 static int expression_param_set_curve(uint8_t track, const param_value_t* val) {
   (void)track;
-  if (val->int_val < 0 || val->int_val >= 3) return -1;
+  if (val->int_val < 0 || val->int_val > EXPR_CURVE_USER) return -1;
   const expr_cfg_t* current = expression_get_cfg();
   expr_cfg_t cfg = *current;
   cfg.curve = (uint8_t)val->int_val;
@@ -108,6 +108,7 @@ static const char* s_curve_names[] = {
   "LINEAR",
   "EXPONENTIAL",
   "S_CURVE",
+  "USER",
 };
 
 // =============================================================================
@@ -146,9 +147,9 @@ static void setup_expression_parameters(void) {
       .description = "Response curve",
       .type = PARAM_TYPE_ENUM,
       .min = 0,
-      .max = 2,
+      .max = 3,
       .enum_values = s_curve_names,
-      .enum_count = 3,
+      .enum_count = 4,
       .read_only = 0,
       .get_value = expression_param_get_curve,
       .set_value = expression_param_set_curve
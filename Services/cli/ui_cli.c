@@ -6,6 +6,7 @@
  */
 
 #include "Services/ui/ui.h"
+#include "Services/cli/cli.h"
 #include "Services/cli/module_cli_helpers.h"
 #include <string.h>
 #include <stdio.h>
@@ -127,6 +128,50 @@ static void setup_ui_parameters(void) {
   memcpy(s_ui_descriptor.params, params, sizeof(params));
 }
 
+// =============================================================================
+// RENDER STATISTICS COMMAND
+// =============================================================================
+
+/**
+ * @brief ui_stats command - per-page render counts and time
+ * Usage: ui_stats [reset]
+ */
+static cli_result_t cmd_ui_stats(int argc, char* argv[])
+{
+  if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+    ui_reset_stats();
+    cli_puts("UI stats reset"); cli_newline();
+    return CLI_OK;
+  }
+
+  uint32_t frames = 0, skipped = 0;
+  ui_get_frame_stats(&frames, &skipped);
+
+  cli_newline();
+  cli_puts("UI frames: "); cli_print_u32(frames);
+  cli_puts("  skipped (clean): "); cli_print_u32(skipped);
+  cli_newline();
+  cli_puts("  page   renders  hdr_only  avg_us  max_us"); cli_newline();
+  for (uint8_t p = 0; p < UI_PAGE_COUNT; p++) {
+    ui_page_stats_t st;
+    if (ui_get_page_stats((ui_page_t)p, &st) != 0) continue;
+    if (st.renders == 0 && st.header_only == 0) continue;
+    cli_puts("  ");
+    cli_puts(ui_get_page_tag((ui_page_t)p));
+    cli_puts(": ");
+    cli_print_u32(st.renders);
+    cli_puts("  ");
+    cli_print_u32(st.header_only);
+    cli_puts("  ");
+    cli_print_u32(st.renders ? st.total_us / st.renders : 0);
+    cli_puts("  ");
+    cli_print_u32(st.max_us);
+    cli_newline();
+  }
+  cli_newline();
+  return CLI_OK;
+}
+
 // =============================================================================
 // REGISTRATION
 // =============================================================================
@@ -135,3 +180,13 @@ int ui_register_cli(void) {
   setup_ui_parameters();
   return module_registry_register(&s_ui_descriptor);
 }
+
+/**
+ * @brief Register UI CLI commands
+ */
+int ui_cli_init(void) {
+  return cli_register_command("ui_stats", cmd_ui_stats,
+                              "UI page render counts and time",
+                              "ui_stats [reset]",
+                              "system");
+}
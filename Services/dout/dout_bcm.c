@@ -0,0 +1,84 @@
+#include "Services/dout/dout_bcm.h"
+#include "Services/dout/dout_map.h"
+#include <string.h>
+
+#if DOUT_BCM_BITS < 1 || DOUT_BCM_BITS > 6
+#error "DOUT_BCM_BITS must be 1..6"
+#endif
+
+#define BCM_OUTPUTS (DOUT_BCM_BYTES * 8u)
+#define BCM_SLOTS   ((1u << DOUT_BCM_BITS) - 1u)
+
+static uint8_t g_level[BCM_OUTPUTS];
+static uint8_t g_plane[DOUT_BCM_BITS][DOUT_BCM_BYTES];
+static uint8_t g_logical[DOUT_BCM_BYTES];
+static uint8_t g_slot;
+
+void dout_bcm_init(void) {
+  memset(g_level, 0, sizeof(g_level));
+  memset(g_logical, 0, sizeof(g_logical));
+  for (uint16_t i = 0; i < DOUT_BCM_BYTES; i++) {
+    uint8_t off = dout_map_inv_mask(i);
+    for (uint8_t k = 0; k < DOUT_BCM_BITS; k++) g_plane[k][i] = off;
+  }
+  g_slot = 0;
+}
+
+int dout_bcm_set(uint16_t bit, uint8_t level) {
+  if (bit >= BCM_OUTPUTS) return -1;
+  if (level > DOUT_BCM_MAX) level = DOUT_BCM_MAX;
+  if (g_level[bit] == level) return 0;
+  g_level[bit] = level;
+
+  // Patch this output in every plane (single byte stores: the scan
+  // interrupt never sees a half-written byte)
+  uint16_t byte = (uint16_t)(bit >> 3);
+  uint8_t m = (uint8_t)(1u << (bit & 7u));
+  uint8_t inv = (uint8_t)(dout_map_inv_mask(byte) & m);
+  for (uint8_t k = 0; k < DOUT_BCM_BITS; k++) {
+    uint8_t on = ((level >> k) & 1u) ? m : 0u;
+    g_plane[k][byte] = (uint8_t)((g_plane[k][byte] & (uint8_t)~m) | (on ^ inv));
+  }
+  return 0;
+}
+
+uint8_t dout_bcm_get(uint16_t bit) {
+  return (bit < BCM_OUTPUTS) ? g_level[bit] : 0u;
+}
+
+void dout_bcm_set_rgb(uint8_t led, uint8_t r, uint8_t g, uint8_t b) {
+  if (led >= 16) return;
+  const config_t* cfg = dout_map_config();
+  if (r > DOUT_BCM_MAX) r = DOUT_BCM_MAX;
+  if (g > DOUT_BCM_MAX) g = DOUT_BCM_MAX;
+  if (b > DOUT_BCM_MAX) b = DOUT_BCM_MAX;
+  if (cfg->rgb_r_invert) r = (uint8_t)(DOUT_BCM_MAX - r);
+  if (cfg->rgb_g_invert) g = (uint8_t)(DOUT_BCM_MAX - g);
+  if (cfg->rgb_b_invert) b = (uint8_t)(DOUT_BCM_MAX - b);
+
+  if (cfg->rgb_map_r[led] != 0xFF) (void)dout_bcm_set(cfg->rgb_map_r[led], r);
+  if (cfg->rgb_map_g[led] != 0xFF) (void)dout_bcm_set(cfg->rgb_map_g[led], g);
+  if (cfg->rgb_map_b[led] != 0xFF) (void)dout_bcm_set(cfg->rgb_map_b[led], b);
+}
+
+void dout_bcm_load_logical(const uint8_t* logical, uint16_t bytes) {
+  if (!logical) return;
+  if (bytes > DOUT_BCM_BYTES) bytes = DOUT_BCM_BYTES;
+  for (uint16_t i = 0; i < bytes; i++) {
+    uint8_t diff = (uint8_t)(logical[i] ^ g_logical[i]);
+    if (!diff) continue;
+    g_logical[i] = logical[i];
+    while (diff) {
+      uint8_t bit = (uint8_t)__builtin_ctz(diff);
+      diff &= (uint8_t)(diff - 1u);
+      (void)dout_bcm_set((uint16_t)(i * 8u + bit), ((logical[i] >> bit) & 1u) ? DOUT_BCM_MAX : 0u);
+    }
+  }
+}
+
+const uint8_t* dout_bcm_next_frame(void) {
+  // Slot s = 1..2^B-1 shows plane B-1-ctz(s): plane k gets 2^k slots
+  if (++g_slot > BCM_SLOTS) g_slot = 1;
+  uint8_t k = (uint8_t)(DOUT_BCM_BITS - 1u - (uint8_t)__builtin_ctz(g_slot));
+  return g_plane[k];
+}
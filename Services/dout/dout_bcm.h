@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per-output LED brightness by binary code modulation (BCM).
+//
+// Each output has a DOUT_BCM_BITS brightness level. Bit k of all levels
+// forms bitplane k (already in physical polarity, see dout_map_inv_mask),
+// and plane k is shown for 2^k of the (2^DOUT_BCM_BITS - 1) scan slots of
+// a BCM frame. The SRIO DMA scan pulls one plane per scan through
+// dout_bcm_next_frame(); planes are only patched when a level changes.
+// Slots are interleaved (plane B-1 every other scan, plane B-2 every
+// fourth, ...) so the frame flickers less than one long on-time per bit:
+// with a 1 ms scan and 4 bits a frame is 15 ms.
+
+#ifndef DOUT_BCM_BITS
+#define DOUT_BCM_BITS 4  // 1..6
+#endif
+
+#ifndef DOUT_BCM_BYTES
+#define DOUT_BCM_BYTES 8  // 64 outputs
+#endif
+
+#define DOUT_BCM_MAX ((uint8_t)((1u << DOUT_BCM_BITS) - 1u))
+
+// All outputs off. Call after dout_map_init() (uses its inversion masks).
+void dout_bcm_init(void);
+
+// Set the brightness of output bit (0..DOUT_BCM_BYTES*8-1), level clipped
+// to DOUT_BCM_MAX. Returns 0, -1 on bad bit.
+int dout_bcm_set(uint16_t bit, uint8_t level);
+uint8_t dout_bcm_get(uint16_t bit);
+
+// RGB LED 0..15 through the dout_map RGB pin mapping; channel inversion
+// (rgb_*_invert) mirrors the level.
+void dout_bcm_set_rgb(uint8_t led, uint8_t r, uint8_t g, uint8_t b);
+
+// On/off outputs from a logical buffer as in dout_map_apply(): only the
+// bits that differ from the previous call are touched.
+void dout_bcm_load_logical(const uint8_t* logical, uint16_t bytes);
+
+// Scan hook (interrupt context): the DOUT bytes for the next scan slot.
+const uint8_t* dout_bcm_next_frame(void);
+
+#ifdef __cplusplus
+}
+#endif
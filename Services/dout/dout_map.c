@@ -3,6 +3,10 @@
 
 static config_t g_cfg;
 
+// Physical inversion per output bit (global invert ^ bit_inv), as bytes
+static uint8_t g_inv_mask[DOUT_MAP_BYTES];
+static uint8_t g_inv_rest;  // bytes past the per-bit table: global only
+
 static inline void bit_set(uint8_t* buf, uint16_t bit, uint8_t v) {
   uint16_t b = bit >> 3;
   uint8_t m = (uint8_t)(1u << (bit & 7));
@@ -13,23 +17,30 @@ static inline void bit_set(uint8_t* buf, uint16_t bit, uint8_t v) {
 void dout_map_init(const config_t* cfg) {
   if (cfg) g_cfg = *cfg;
   else config_set_defaults(&g_cfg);
+
+  g_inv_rest = g_cfg.dout_invert_default ? 0xFFu : 0x00u;
+  for (uint16_t i = 0; i < DOUT_MAP_BYTES; i++) {
+    uint8_t m = g_inv_rest;
+    for (uint8_t bit = 0; bit < 8u; bit++) {
+      if (g_cfg.bit_inv[i * 8u + bit]) m ^= (uint8_t)(1u << bit);
+    }
+    g_inv_mask[i] = m;
+  }
 }
 
 void dout_map_apply(const uint8_t* logical, uint8_t* physical, uint16_t bytes) {
   if (!logical || !physical || !bytes) return;
-  memcpy(physical, logical, bytes);
-
-  if (g_cfg.dout_invert_default) {
-    for (uint16_t i=0;i<bytes;i++) physical[i] ^= 0xFF;
+  for (uint16_t i = 0; i < bytes; i++) {
+    physical[i] = (uint8_t)(logical[i] ^ (i < DOUT_MAP_BYTES ? g_inv_mask[i] : g_inv_rest));
   }
+}
 
-  uint16_t max_bits = bytes * 8u;
-  if (max_bits > 64) max_bits = 64;
-  for (uint16_t bit=0; bit<max_bits; bit++) {
-    if (g_cfg.bit_inv[bit]) {
-      physical[bit>>3] ^= (uint8_t)(1u << (bit & 7));
-    }
-  }
+uint8_t dout_map_inv_mask(uint16_t byte) {
+  return (byte < DOUT_MAP_BYTES) ? g_inv_mask[byte] : g_inv_rest;
+}
+
+const config_t* dout_map_config(void) {
+  return &g_cfg;
 }
 
 void dout_set_rgb(uint8_t* logical, uint8_t led, uint8_t r, uint8_t g, uint8_t b) {
@@ -6,10 +6,17 @@
 extern "C" {
 #endif
 
+#define DOUT_MAP_BYTES 8  // outputs with per-bit inversion (config_t.bit_inv)
+
 void dout_map_init(const config_t* cfg);
 void dout_map_apply(const uint8_t* logical, uint8_t* physical, uint16_t bytes);
 void dout_set_rgb(uint8_t* logical, uint8_t led, uint8_t r, uint8_t g, uint8_t b);
 
+// Physical inversion of the 8 outputs of DOUT byte 'byte' (precomputed by
+// dout_map_init from dout_invert_default and bit_inv)
+uint8_t dout_map_inv_mask(uint16_t byte);
+const config_t* dout_map_config(void);
+
 #ifdef __cplusplus
 }
 #endif
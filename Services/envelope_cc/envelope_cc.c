@@ -4,6 +4,7 @@
  */
 
 #include "Services/envelope_cc/envelope_cc.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <string.h>
 
 #define DEFAULT_ATTACK_MS 100
@@ -69,6 +70,8 @@ static uint8_t calculate_envelope_value(uint8_t track, uint32_t time_ms) {
         case ENVELOPE_STAGE_ATTACK:
             if (cfg->attack_ms == 0) {
                 value = cfg->max_value;
+                cfg->stage = ENVELOPE_STAGE_DECAY;
+                cfg->stage_start_time = time_ms;
             } else if (elapsed >= cfg->attack_ms) {
                 value = cfg->max_value;
                 // Move to decay stage
@@ -89,6 +92,8 @@ static uint8_t calculate_envelope_value(uint8_t track, uint32_t time_ms) {
         case ENVELOPE_STAGE_DECAY:
             if (cfg->decay_ms == 0) {
                 value = cfg->sustain_level;
+                cfg->stage = ENVELOPE_STAGE_SUSTAIN;
+                cfg->stage_start_time = time_ms;
             } else if (elapsed >= cfg->decay_ms) {
                 value = cfg->sustain_level;
                 // Move to sustain stage
@@ -180,6 +185,7 @@ void envelope_cc_set_callback(envelope_cc_callback_t callback) {
 void envelope_cc_set_enabled(uint8_t track, uint8_t enabled) {
     if (track >= ENVELOPE_CC_MAX_TRACKS) return;
     g_envelope_config[track].enabled = enabled ? 1 : 0;
+    tick_sched_wake(TICK_SVC_ENVELOPE_CC, 0);
 }
 
 /**
@@ -336,6 +342,7 @@ void envelope_cc_trigger(uint8_t track) {
     envelope_cc_config_t* cfg = &g_envelope_config[track];
     cfg->stage = ENVELOPE_STAGE_ATTACK;
     cfg->stage_start_time = 0;  // Will be set by next tick
+    tick_sched_wake(TICK_SVC_ENVELOPE_CC, 0);
 }
 
 /**
@@ -351,6 +358,7 @@ void envelope_cc_release(uint8_t track) {
     if (cfg->stage != ENVELOPE_STAGE_IDLE && cfg->stage != ENVELOPE_STAGE_RELEASE) {
         cfg->stage = ENVELOPE_STAGE_RELEASE;
         cfg->stage_start_time = 0;  // Will be set by next tick
+        tick_sched_wake(TICK_SVC_ENVELOPE_CC, 0);
     }
 }
 
@@ -385,6 +393,21 @@ void envelope_cc_tick(uint32_t time_ms) {
     }
 }
 
+/**
+ * @brief tick_sched handler
+ */
+uint32_t envelope_cc_service(uint32_t now_ms) {
+    envelope_cc_tick(now_ms);
+    
+    // Ramps need every ms; sustain and idle wait for release/trigger
+    for (uint8_t track = 0; track < ENVELOPE_CC_MAX_TRACKS; track++) {
+        const envelope_cc_config_t* cfg = &g_envelope_config[track];
+        if (!cfg->enabled) continue;
+        if (cfg->stage != ENVELOPE_STAGE_IDLE && cfg->stage != ENVELOPE_STAGE_SUSTAIN) return 1;
+    }
+    return TICK_SCHED_IDLE;
+}
+
 /**
  * @brief Get current envelope stage
  */
@@ -193,6 +193,12 @@ void envelope_cc_release(uint8_t track);
  */
 void envelope_cc_tick(uint32_t time_ms);
 
+/**
+ * @brief tick_sched handler (TICK_SVC_ENVELOPE_CC): envelope_cc_tick(now_ms)
+ * @return 1 while an envelope ramps, TICK_SCHED_IDLE in sustain or idle
+ */
+uint32_t envelope_cc_service(uint32_t now_ms);
+
 /**
  * @brief Get current envelope stage
  * @param track Track index (0-3)
@@ -0,0 +1,85 @@
+#include "Services/expression/expr_curve.h"
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#if __has_include("ff.h")
+  #include "ff.h"
+  #define XC_HAS_FATFS 1
+#else
+  #define XC_HAS_FATFS 0
+#endif
+
+#if XC_HAS_FATFS
+static void trim(char* s){
+  char* p = s;
+  while(*p && isspace((unsigned char)*p)) p++;
+  if (p != s) memmove(s,p,strlen(p)+1);
+  size_t n=strlen(s);
+  while(n && isspace((unsigned char)s[n-1])) s[--n]=0;
+}
+
+static int keyeq(const char* a,const char* b){
+  while(*a && *b){
+    char ca=(char)toupper((unsigned char)*a++);
+    char cb=(char)toupper((unsigned char)*b++);
+    if(ca!=cb) return 0;
+  }
+  return *a==0 && *b==0;
+}
+
+static uint8_t u7(long x){ if(x<0) x=0; if(x>127) x=127; return (uint8_t)x; }
+#endif
+
+int expr_curve_load_sd(expr_curve_points_t* c, const char* path){
+#if !XC_HAS_FATFS
+  (void)c;(void)path;
+  return -10;
+#else
+  if(!c||!path) return -1;
+  FIL f;
+  if(f_open(&f,path,FA_READ)!=FR_OK) return -2;
+  expr_curve_points_t t;
+  t.n = 0;
+  char line[80];
+  while(f_gets(line,sizeof(line),&f)){
+    trim(line);
+    if(!line[0]||line[0]=='#'||line[0]==';') continue;
+    char* eq=strchr(line,'=');
+    if(!eq) continue;
+    *eq=0;
+    char* k=line; char* v=eq+1;
+    trim(k); trim(v);
+    if(!keyeq(k,"POINT") || t.n >= EXPR_CURVE_MAX_POINTS) continue;
+    char* end;
+    long in = strtol(v,&end,0);
+    while(*end==' '||*end==',') end++;
+    t.x[t.n] = u7(in);
+    t.y[t.n] = u7(strtol(end,0,0));
+    t.n++;
+  }
+  f_close(&f);
+
+  if(t.n < 2) return -3;
+  for(uint8_t i=1;i<t.n;i++) if(t.x[i] <= t.x[i-1]) return -3;
+  *c = t;
+  return 0;
+#endif
+}
+
+// Point coordinates scaled to the Q16 input: v * 65535 / 127 ~ v * 516.03
+static uint32_t q16(uint8_t v){ return ((uint32_t)v * 65535u + 63u) / 127u; }
+
+uint16_t expr_curve_eval(const expr_curve_points_t* c, uint16_t x){
+  if(!c || c->n == 0) return x;
+  if(x <= q16(c->x[0])) return (uint16_t)q16(c->y[0]);
+  for(uint8_t i=1;i<c->n;i++){
+    uint32_t x1 = q16(c->x[i]);
+    if(x > x1) continue;
+    uint32_t x0 = q16(c->x[i-1]);
+    int32_t y0 = (int32_t)q16(c->y[i-1]);
+    int32_t y1 = (int32_t)q16(c->y[i]);
+    return (uint16_t)(y0 + (int64_t)(y1 - y0) * (int64_t)(x - x0) / (int64_t)(x1 - x0));
+  }
+  return (uint16_t)q16(c->y[c->n-1]);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// User-defined response curves, shared by expression and bellows_expression.
+//
+// A curve is a list of points read from SD (.ngc):
+//   POINT = in,out      # both 0..127, in strictly increasing
+// and is evaluated piecewise linearly between them (flat before the first
+// and after the last point). Modules sample it once into their own lookup
+// table when the curve is loaded.
+
+#define EXPR_CURVE_MAX_POINTS 32
+
+typedef struct {
+  uint8_t n;
+  uint8_t x[EXPR_CURVE_MAX_POINTS];
+  uint8_t y[EXPR_CURVE_MAX_POINTS];
+} expr_curve_points_t;
+
+// 0 on success, -1 bad args, -2 cannot open, -3 fewer than 2 points or
+// inputs not increasing, -10 without FatFS
+int expr_curve_load_sd(expr_curve_points_t* c, const char* path);
+
+// x and result in Q16 over 0..127 (0 = 0, 65535 = 127)
+uint16_t expr_curve_eval(const expr_curve_points_t* c, uint16_t x);
+
+#ifdef __cplusplus
+}
+#endif
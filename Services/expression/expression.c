@@ -1,4 +1,5 @@
 #include "Services/expression/expression.h"
+#include "Services/expression/expr_curve.h"
 #include "Services/router/router.h"
 #include <string.h>
 #include <math.h>
@@ -7,20 +8,28 @@ static expr_cfg_t g_cfg;
 static uint16_t g_raw = 0;
 static int32_t g_pa = 0;
 static uint32_t g_ms = 0;
-static float g_filt = 0.0f;
+static int32_t g_filt = 0;        // EMA state, CC value in Q16
+static uint16_t g_alpha = 256;    // EMA weight of the new value, Q8 (1..256)
 static uint8_t g_last_sent = 255;
 static int8_t g_last_dir = 0;
 
+// Response curve over t = 0..1 as 257 Q16 entries (t = i / 256), rebuilt
+// when the curve, its parameter or the user curve changes. The 1 ms tick
+// only interpolates between two entries.
+#define CURVE_LUT_BITS 8
+#define CURVE_LUT_N    ((1u << CURVE_LUT_BITS) + 1u)
+static uint16_t g_lut[CURVE_LUT_N];
+static uint8_t g_lut_curve = 0xFF;
+static uint16_t g_lut_param;
+static expr_curve_points_t g_user;  // EXPR_CURVE_USER (identity until loaded)
+
 static inline uint8_t clamp8(int v){ 
   if(v<0) return 0; 
   if(v>127) return 127; 
   return (uint8_t)v; 
 }
 
-static float apply_curve(float t){
-  if(t < 0.0f) t = 0.0f;
-  if(t > 1.0f) t = 1.0f;
-
+static float curve_f(float t){
   switch(g_cfg.curve){
     default:
     case EXPR_CURVE_LINEAR: return t;
@@ -35,31 +44,65 @@ static float apply_curve(float t){
   }
 }
 
+static void lut_update(void){
+  if(g_cfg.curve == g_lut_curve && g_cfg.curve_param == g_lut_param) return;
+  for(uint32_t i = 0; i < CURVE_LUT_N; i++){
+    uint32_t v;
+    if(g_cfg.curve == EXPR_CURVE_USER){
+      uint32_t x = i << (16 - CURVE_LUT_BITS);
+      v = expr_curve_eval(&g_user, (uint16_t)(x > 65535u ? 65535u : x));
+    } else {
+      float t = (float)i / (float)(CURVE_LUT_N - 1u);
+      v = (uint32_t)(curve_f(t) * 65535.0f + 0.5f);
+    }
+    g_lut[i] = (uint16_t)(v > 65535u ? 65535u : v);
+  }
+  g_lut_curve = g_cfg.curve;
+  g_lut_param = g_cfg.curve_param;
+}
+
+// u: t in Q16 (65536 = 1.0), returns curve(t) in Q16 (65535 = 1.0)
+static uint32_t apply_curve(uint32_t u){
+  if(u >= 65536u) return g_lut[CURVE_LUT_N - 1u];
+  uint32_t i = u >> (16 - CURVE_LUT_BITS);
+  int32_t f = (int32_t)(u & ((1u << (16 - CURVE_LUT_BITS)) - 1u));
+  int32_t a = g_lut[i], b = g_lut[i + 1u];
+  return (uint32_t)(a + (((b - a) * f) >> (16 - CURVE_LUT_BITS)));
+}
+
+static uint8_t map_out(uint32_t c){
+  int32_t span = (int32_t)g_cfg.out_max - (int32_t)g_cfg.out_min;
+  return clamp8((int32_t)g_cfg.out_min + (((int32_t)c * span + 32768) >> 16));
+}
+
 static uint8_t map_linear(uint16_t r){
   if(g_cfg.raw_max == g_cfg.raw_min) return g_cfg.out_min;
   int32_t x = (int32_t)r - (int32_t)g_cfg.raw_min;
   int32_t den = (int32_t)g_cfg.raw_max - (int32_t)g_cfg.raw_min;
-  float t = (float)x / (float)den;
-  t = apply_curve(t);
-  float y = (float)g_cfg.out_min + t * (float)((int)g_cfg.out_max - (int)g_cfg.out_min);
-  return clamp8((int)(y + 0.5f));
+  if(x <= 0) return map_out(apply_curve(0));
+  if(x >= den) return map_out(apply_curve(65536u));
+  return map_out(apply_curve(((uint32_t)x << 16) / (uint32_t)den));
 }
 
 static uint8_t map_bidir(uint8_t is_push){
   // g_raw is expected centered mapping 0..4095 (pressure.ngc MAP_MODE=1)
-  float t = 0.0f;
+  uint32_t u;
   if(is_push){
     int32_t r = (int32_t)g_raw - 2048;
     if(r < 0) r = 0;
-    t = (float)r / 2047.0f;
+    u = ((uint32_t)r << 16) / 2047u;
   } else {
     int32_t r = 2048 - (int32_t)g_raw;
     if(r < 0) r = 0;
-    t = (float)r / 2048.0f;
+    u = (uint32_t)r << 5;  // / 2048 in Q16
   }
-  t = apply_curve(t);
-  float y = (float)g_cfg.out_min + t * (float)((int)g_cfg.out_max - (int)g_cfg.out_min);
-  return clamp8((int)(y + 0.5f));
+  return map_out(apply_curve(u));
+}
+
+// Weight of the new value: 1 - smoothing / 255, at least 0.02
+static void alpha_update(void){
+  uint32_t a = ((255u - g_cfg.smoothing) * 256u + 127u) / 255u;
+  g_alpha = (uint16_t)(a < 5u ? 5u : a);
 }
 
 static int should_send(uint8_t out){
@@ -108,12 +151,27 @@ void expression_init(void){
   g_raw = 0;
   g_pa = 0;
   g_ms = 0;
-  g_filt = 0.0f;
+  g_filt = 0;
   g_last_sent = 255;
   g_last_dir = 0;
+  alpha_update();
+  lut_update();
+}
+
+void expression_set_cfg(const expr_cfg_t* cfg){
+  if(!cfg) return;
+  g_cfg = *cfg;
+  alpha_update();
+  lut_update();
 }
 
-void expression_set_cfg(const expr_cfg_t* cfg){ if(cfg) g_cfg = *cfg; }
+int expression_load_user_curve(const char* path){
+  int r = expr_curve_load_sd(&g_user, path);
+  if(r != 0) return r;
+  g_lut_curve = 0xFF;  // force a rebuild
+  lut_update();
+  return 0;
+}
 const expr_cfg_t* expression_get_cfg(void){ return &g_cfg; }
 
 void expression_set_raw(uint16_t raw){ g_raw = raw; }
@@ -142,12 +200,9 @@ void expression_tick_1ms(void){
     target = map_linear(g_raw);
   }
 
-  // EMA smoothing
-  float a = 1.0f - ((float)g_cfg.smoothing / 255.0f);
-  if(a < 0.02f) a = 0.02f;
-  if(a > 1.0f) a = 1.0f;
-  g_filt = g_filt + a * ((float)target - g_filt);
-  uint8_t out = clamp8((int)(g_filt + 0.5f));
+  // EMA smoothing (Q16 state, Q8 weight)
+  g_filt += ((((int32_t)target << 16) - g_filt) * (int32_t)g_alpha) >> 8;
+  uint8_t out = clamp8((g_filt + 32768) >> 16);
 
   if(g_ms >= (uint32_t)g_cfg.rate_ms){
     g_ms = 0;
@@ -163,7 +218,7 @@ void expression_tick_1ms(void){
 
 void expression_runtime_reset(void){
   g_ms = 0;
-  g_filt = 0.0f;
+  g_filt = 0;
   g_last_sent = 255;
   g_last_dir = 0;
 }
@@ -8,9 +8,12 @@ extern "C" {
 typedef enum {
   EXPR_CURVE_LINEAR = 0,
   EXPR_CURVE_EXPO   = 1,   // gamma curve, param = gamma*100 (e.g. 180 => 1.80)
-  EXPR_CURVE_S      = 2    // smoothstep-ish
+  EXPR_CURVE_S      = 2,   // smoothstep-ish
+  EXPR_CURVE_USER   = 3    // points loaded by expression_load_user_curve()
 } expr_curve_t;
 
+#define EXPR_USER_CURVE_PATH "0:/cfg/expr_curve.ngc"
+
 typedef enum {
   EXPR_BIDIR_OFF = 0,
   EXPR_BIDIR_PUSH_PULL = 1
@@ -51,6 +54,10 @@ void expression_init(void);
 void expression_set_cfg(const expr_cfg_t* cfg);
 const expr_cfg_t* expression_get_cfg(void);
 
+// Loads the EXPR_CURVE_USER points (see expr_curve.h). Returns 0 on success,
+// else the expr_curve_load_sd() error; the previous user curve is kept.
+int expression_load_user_curve(const char* path);
+
 void expression_set_raw(uint16_t raw);          // 0..4095
 void expression_set_pressure_pa(int32_t pa);    // signed Pa (for BIDIR)
 
@@ -112,7 +112,7 @@ int expression_cfg_load_sd(expr_cfg_t* c, const char* path){
   if(c->raw_min>c->raw_max){ uint16_t t=c->raw_min; c->raw_min=c->raw_max; c->raw_max=t; }
 
   if(c->deadband_cc==0) c->deadband_cc=1;
-  if(c->curve>2) c->curve=0;
+  if(c->curve>EXPR_CURVE_USER) c->curve=0;
   if(c->bidir>1) c->bidir=0;
   if(c->curve_param==0) c->curve_param=180;
 
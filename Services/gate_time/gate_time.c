@@ -4,6 +4,7 @@
  */
 
 #include "Services/gate_time/gate_time.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <string.h>
 #include <stdint.h>
 
@@ -276,6 +277,7 @@ uint8_t gate_time_process_note_on(uint8_t track, uint8_t note, uint8_t velocity,
     cfg->notes[slot].active = 1;
     cfg->note_count++;
     cfg->total_notes_processed++;
+    tick_sched_wake(TICK_SVC_GATE_TIME, gate_length);
     
     // Send note on via callback
     if (g_note_callback) {
@@ -326,6 +328,27 @@ void gate_time_tick(uint32_t time_ms) {
     }
 }
 
+/**
+ * @brief tick_sched handler
+ */
+uint32_t gate_time_service(uint32_t now_ms) {
+    uint32_t next = TICK_SCHED_IDLE;
+    gate_time_tick(now_ms);
+    
+    // Earliest pending note off
+    for (uint8_t track = 0; track < GATE_TIME_MAX_TRACKS; track++) {
+        const gate_time_config_t* cfg = &g_gate_time_config[track];
+        if (!cfg->enabled || cfg->note_count == 0) continue;
+        
+        for (uint8_t i = 0; i < GATE_TIME_MAX_NOTES_PER_TRACK; i++) {
+            if (!cfg->notes[i].active) continue;
+            uint32_t left = cfg->notes[i].note_off_time_ms - now_ms;
+            if (left < next) next = left;
+        }
+    }
+    return next;
+}
+
 /**
  * @brief Reset gate time state for a track
  */
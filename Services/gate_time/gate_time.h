@@ -154,6 +154,12 @@ void gate_time_process_note_off(uint8_t track, uint8_t note, uint8_t channel);
  */
 void gate_time_tick(uint32_t time_ms);
 
+/**
+ * @brief tick_sched handler (TICK_SVC_GATE_TIME): gate_time_tick(now_ms)
+ * @return ms until the earliest pending note off, TICK_SCHED_IDLE when none
+ */
+uint32_t gate_time_service(uint32_t now_ms);
+
 /**
  * @brief Calculate gate time for a note
  * @param track Track index (0-3)
@@ -8,6 +8,12 @@
 #ifndef INPUT_MAX_ENCODERS
 #define INPUT_MAX_ENCODERS 16
 #endif
+#ifndef INPUT_DB_PLANES
+#define INPUT_DB_PLANES 5  // vertical counter bits: up to 31 scans of debounce
+#endif
+
+#define INPUT_DIN_WORDS ((INPUT_MAX_BUTTONS + 31u) / 32u)
+#define INPUT_DB_MAX_SAMPLES ((1u << INPUT_DB_PLANES) - 1u)
 
 typedef struct {
   uint8_t stable;
@@ -20,6 +26,15 @@ static uint32_t g_now = 0;
 
 static db_t g_btn[INPUT_MAX_BUTTONS];
 
+// DIN frame debounce, 32 inputs per word (bit n of word w = phys w*32+n).
+// g_din_cnt is a vertical counter: plane p holds bit p of every input's
+// count of consecutive scans that disagreed with the debounced state.
+static uint32_t g_din_state[INPUT_DIN_WORDS];  // debounced, 1 = pressed
+static uint32_t g_din_cnt[INPUT_DB_PLANES][INPUT_DIN_WORDS];
+static uint8_t g_db_samples = 1;               // scans needed to accept a change
+
+static input_button_hook_t g_hook = 0;
+
 static uint8_t g_shift = 0;
 static uint16_t g_shift_phys = 0xFFFF;
 static uint32_t g_shift_press_ms = 0;
@@ -42,6 +57,8 @@ static inline uint8_t map_button(uint16_t phys, uint8_t shift) {
   return 0;
 }
 
+static void button_event(uint16_t phys_id, uint8_t pressed);
+
 static uint8_t map_encoder(uint16_t phys) {
   (void)phys;
   // single encoder -> UI encoder
@@ -52,6 +69,7 @@ void input_init(const input_config_t* cfg) {
   g_cfg.debounce_ms = 20;
   g_cfg.shift_hold_ms = 500;
   g_cfg.shift_button_id = 10;
+  g_cfg.din_scan_ms = 1;
 
   if (cfg) g_cfg = *cfg;
 
@@ -64,8 +82,18 @@ void input_init(const input_config_t* cfg) {
   g_shift = 0;
   g_shift_phys = 0xFFFF;
   g_shift_press_ms = 0;
+
+  memset(g_din_state, 0, sizeof(g_din_state));
+  memset(g_din_cnt, 0, sizeof(g_din_cnt));
+  uint16_t scan_ms = g_cfg.din_scan_ms ? g_cfg.din_scan_ms : 1u;
+  uint32_t samples = g_cfg.debounce_ms / scan_ms;
+  if (samples < 1u) samples = 1u;
+  if (samples > INPUT_DB_MAX_SAMPLES) samples = INPUT_DB_MAX_SAMPLES;
+  g_db_samples = (uint8_t)samples;
 }
 
+void input_set_button_hook(input_button_hook_t hook) { g_hook = hook; }
+
 uint8_t input_shift_active(void) { return g_shift; }
 
 void input_tick(uint32_t now_ms) {
@@ -95,7 +123,57 @@ void input_feed_button(uint16_t phys_id, uint8_t pressed) {
   }
 
   if (pressed == b->stable) return;
-  b->stable = pressed;
+  button_event(phys_id, pressed);
+}
+
+uint16_t input_scan_din(const uint8_t* din, uint16_t nbytes, uint8_t invert) {
+  if (!din) return 0;
+  if (nbytes > INPUT_DIN_WORDS * 4u) nbytes = (uint16_t)(INPUT_DIN_WORDS * 4u);
+
+  uint16_t events = 0;
+  for (uint16_t w = 0; w < INPUT_DIN_WORDS; w++) {
+    uint16_t b0 = (uint16_t)(w * 4u);
+    if (b0 >= nbytes) break;
+
+    uint32_t raw = 0;
+    uint16_t n = (uint16_t)(nbytes - b0);
+    if (n > 4u) n = 4u;
+    for (uint16_t k = 0; k < n; k++) raw |= (uint32_t)din[b0 + k] << (8u * k);
+    if (invert) raw = ~raw;
+    if (n < 4u) raw &= (1u << (8u * n)) - 1u;
+
+    // Count consecutive disagreeing scans (+1 where delta, cleared
+    // elsewhere) and flag the inputs whose count reached g_db_samples
+    uint32_t delta = raw ^ g_din_state[w];
+    uint32_t carry = delta;
+    uint32_t hit = delta;
+    for (uint8_t p = 0; p < INPUT_DB_PLANES; p++) {
+      uint32_t c = g_din_cnt[p][w];
+      uint32_t next = (c ^ carry) & delta;
+      carry &= c;
+      g_din_cnt[p][w] = next;
+      hit &= ((g_db_samples >> p) & 1u) ? next : ~next;
+    }
+    if (!hit) continue;
+
+    g_din_state[w] ^= hit;
+    for (uint8_t p = 0; p < INPUT_DB_PLANES; p++) g_din_cnt[p][w] &= ~hit;
+
+    // Only the inputs that changed and settled are visited
+    while (hit) {
+      uint32_t bit = (uint32_t)__builtin_ctz(hit);
+      hit &= hit - 1u;
+      button_event((uint16_t)(w * 32u + bit), (uint8_t)((g_din_state[w] >> bit) & 1u));
+      events++;
+    }
+  }
+  return events;
+}
+
+// Debounced state change of a physical button
+static void button_event(uint16_t phys_id, uint8_t pressed) {
+  g_btn[phys_id].stable = pressed;
+  if (g_hook && g_hook(phys_id, pressed)) return;
 
   // SHIFT physical button (default phys 10)
   if (phys_id == 10) {
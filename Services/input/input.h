@@ -10,8 +10,13 @@ typedef struct {
   uint16_t debounce_ms;        // default 20
   uint16_t shift_hold_ms;      // default 500 (long-press to enter shift)
   uint8_t  shift_button_id;    // logical button id used for SHIFT (default 10 internal)
+  uint16_t din_scan_ms;        // period of input_scan_din() calls (0 = 1 ms)
 } input_config_t;
 
+/** Optional hook for debounced button changes, called before the UI
+ *  mapping. Return nonzero to consume the event. */
+typedef uint8_t (*input_button_hook_t)(uint16_t phys_id, uint8_t pressed);
+
 void input_init(const input_config_t* cfg);
 
 /** Call at 1ms or 5ms periodic rate (your choice; set debounce accordingly). */
@@ -20,6 +25,15 @@ void input_tick(uint32_t now_ms);
 /** Feed a raw physical button state change. phys_id: 0..N-1. pressed: 1/0. */
 void input_feed_button(uint16_t phys_id, uint8_t pressed);
 
+/** Debounce a whole DIN frame (bit n of byte b = phys b*8+n), once per
+ *  scan. Inputs are debounced as bitfields, 32 per word, and must disagree
+ *  with their debounced state for debounce_ms / din_scan_ms consecutive
+ *  scans before a press/release event is generated. invert: 1 if a 0 bit
+ *  means pressed (active-low buttons). Returns the number of events. */
+uint16_t input_scan_din(const uint8_t* din, uint16_t nbytes, uint8_t invert);
+
+void input_set_button_hook(input_button_hook_t hook);
+
 /** Feed encoder delta (already decoded). phys_id: 0..N-1. delta: -127..127. */
 void input_feed_encoder(uint16_t phys_id, int8_t delta);
 
@@ -0,0 +1,98 @@
+#include "Services/input/input_enc.h"
+#include <string.h>
+
+typedef struct {
+  uint16_t phys_a;
+  uint16_t phys_b;
+  uint8_t  detent;
+  uint8_t  accel;
+  uint8_t  prev_ab;
+  int8_t   sub;        // transitions toward the next step
+  int8_t   last_dir;
+  uint32_t last_ms;    // time of the previous step
+  volatile int32_t pos; // written by input_enc_sample() only
+  int32_t  taken;       // written by input_enc_take() only
+} enc_t;
+
+static enc_t g_enc[INPUT_ENC_MAX];
+
+// Gray code step table, index = (prev_ab << 2) | ab
+static const int8_t k_step_lut[16] = {
+  0, +1, -1, 0,
+  -1, 0, 0, +1,
+  +1, 0, 0, -1,
+  0, -1, +1, 0
+};
+
+static inline uint8_t din_bit(const uint8_t* din, uint16_t nbytes, uint16_t phys) {
+  uint16_t byte = (uint16_t)(phys >> 3);
+  if (byte >= nbytes) return 0;
+  return (uint8_t)((din[byte] >> (phys & 7u)) & 1u);
+}
+
+void input_enc_init(void) {
+  memset(g_enc, 0, sizeof(g_enc));
+  for (uint8_t e = 0; e < INPUT_ENC_MAX; e++) {
+    g_enc[e].phys_a = 0xFFFFu;
+    g_enc[e].phys_b = 0xFFFFu;
+    g_enc[e].detent = 1;
+  }
+}
+
+int input_enc_config(uint8_t enc, uint16_t phys_a, uint16_t phys_b, uint8_t detent, uint8_t accel) {
+  if (enc >= INPUT_ENC_MAX) return -1;
+  enc_t* c = &g_enc[enc];
+  c->phys_a = 0xFFFFu;  // disabled while being changed
+  c->detent = detent ? detent : 1u;
+  c->accel = accel ? 1u : 0u;
+  c->sub = 0;
+  c->last_dir = 0;
+  c->prev_ab = 0xFFu;   // first sample only records the position
+  c->phys_b = phys_b;
+  c->phys_a = (phys_b == 0xFFFFu) ? 0xFFFFu : phys_a;
+  return 0;
+}
+
+void input_enc_sample(const uint8_t* din, uint16_t nbytes, uint8_t invert, uint32_t now_ms) {
+  if (!din) return;
+  for (uint8_t e = 0; e < INPUT_ENC_MAX; e++) {
+    enc_t* c = &g_enc[e];
+    if (c->phys_a == 0xFFFFu) continue;
+
+    uint8_t ab = (uint8_t)((din_bit(din, nbytes, c->phys_a) << 1) | din_bit(din, nbytes, c->phys_b));
+    if (invert) ab ^= 3u;
+    if (c->prev_ab > 3u) { c->prev_ab = ab; continue; }
+    if (ab == c->prev_ab) continue;
+
+    int8_t step = k_step_lut[(c->prev_ab << 2) | ab];
+    c->prev_ab = ab;
+    if (!step) continue;  // both contacts changed: direction unknown
+
+    // A reversal drops the partial detent
+    if ((step > 0) != (c->sub > 0) && c->sub != 0) c->sub = 0;
+    c->sub = (int8_t)(c->sub + step);
+    if (c->sub < (int8_t)c->detent && c->sub > -(int8_t)c->detent) continue;
+
+    int8_t dir = (c->sub > 0) ? 1 : -1;
+    c->sub = 0;
+
+    int32_t mult = 1;
+    if (c->accel && dir == c->last_dir) {
+      uint32_t dt = now_ms - c->last_ms;
+      if (dt < INPUT_ENC_ACCEL_FAST_MS) mult = 4;
+      else if (dt < INPUT_ENC_ACCEL_SLOW_MS) mult = 2;
+    }
+    c->last_dir = dir;
+    c->last_ms = now_ms;
+    c->pos += dir * mult;
+  }
+}
+
+int32_t input_enc_take(uint8_t enc) {
+  if (enc >= INPUT_ENC_MAX) return 0;
+  enc_t* c = &g_enc[enc];
+  int32_t pos = c->pos;  // single aligned load
+  int32_t d = pos - c->taken;
+  c->taken = pos;
+  return d;
+}
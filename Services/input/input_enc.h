@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Quadrature encoder decoding on raw DIN frames.
+//
+// input_enc_sample() runs in the fast scan path (the SRIO scan completion,
+// 1 kHz or more) so that fast spins don't skip Gray-code states. Steps are
+// scaled by the measured step rate and accumulated per encoder; the UI side
+// only collects the sum with input_enc_take().
+
+#ifndef INPUT_ENC_MAX
+#define INPUT_ENC_MAX 8
+#endif
+
+// Acceleration: a detent that follows the previous one in the same
+// direction within FAST_MS counts x4, within SLOW_MS x2
+#ifndef INPUT_ENC_ACCEL_FAST_MS
+#define INPUT_ENC_ACCEL_FAST_MS 15
+#endif
+#ifndef INPUT_ENC_ACCEL_SLOW_MS
+#define INPUT_ENC_ACCEL_SLOW_MS 40
+#endif
+
+void input_enc_init(void);
+
+/** Assign DIN bits (phys ids as in input_scan_din) to encoder enc.
+ *  detent: Gray-code transitions per reported step (4 for most detented
+ *  encoders, 1 = every transition). accel: 1 enables acceleration.
+ *  phys_a/phys_b 65535 disables the encoder. Returns 0, -1 on bad args. */
+int input_enc_config(uint8_t enc, uint16_t phys_a, uint16_t phys_b, uint8_t detent, uint8_t accel);
+
+/** Decode one DIN frame. invert: 1 if the A/B contacts are active-low.
+ *  Interrupt safe; must not run concurrently with itself. */
+void input_enc_sample(const uint8_t* din, uint16_t nbytes, uint8_t invert, uint32_t now_ms);
+
+/** Steps accumulated (with acceleration) since the previous call.
+ *  Single consumer, safe against a concurrent input_enc_sample(). */
+int32_t input_enc_take(uint8_t enc);
+
+#ifdef __cplusplus
+}
+#endif
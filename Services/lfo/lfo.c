@@ -1,4 +1,5 @@
 #include "Services/lfo/lfo.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <math.h>
 #include <stdlib.h>
 
@@ -14,7 +15,7 @@ typedef struct {
     lfo_target_t target;
     uint8_t bpm_sync;
     uint8_t bpm_divisor;       // 1, 2, 4, 8, 16, 32 bars
-    uint32_t phase;            // 0-65535 (16-bit phase accumulator)
+    uint32_t phase;            // One cycle = 2^32, top 8 bits index the tables
     uint32_t phase_increment;  // How much to add per ms
     int16_t last_random;       // For smooth random interpolation
     int16_t next_random;       // Target for smooth random
@@ -24,6 +25,8 @@ typedef struct {
 static lfo_state_t g_lfo[LFO_MAX_TRACKS];
 static uint16_t g_tempo_bpm = 120;
 static uint32_t g_random_seed = 0x87654321u;
+static uint32_t g_tick_counter = 0;  // time the phases were last advanced to
+static uint8_t g_sched = 0;          // driven by tick_sched: its clock is newer between dispatches
 
 // Fast sin approximation using lookup table (256 entries)
 static const int16_t sine_table[256] = {
@@ -50,25 +53,58 @@ static inline uint32_t lcg_random(void) {
     return g_random_seed;
 }
 
+/**
+ * Advance every enabled LFO to now. Phases are integrated lazily (here and
+ * before each read), so a running LFO costs nothing between reads.
+ */
+static void advance(uint32_t now) {
+    uint32_t dt = now - g_tick_counter;
+    g_tick_counter = now;
+    if (dt == 0) return;
+    
+    for (uint8_t i = 0; i < LFO_MAX_TRACKS; i++) {
+        if (!g_lfo[i].enabled) continue;
+        
+        lfo_state_t* lfo = &g_lfo[i];
+        uint64_t phase = (uint64_t)lfo->phase + (uint64_t)lfo->phase_increment * dt;
+        lfo->phase = (uint32_t)phase;
+        
+        // Check for phase wrap (completed one cycle)
+        if (phase >> 32) {
+            // Wrapped around - generate new random values
+            if (lfo->waveform == LFO_WAVEFORM_RANDOM || 
+                lfo->waveform == LFO_WAVEFORM_SAMPLE_HOLD) {
+                lfo->last_random = lfo->next_random;
+                lfo->next_random = (int16_t)((lcg_random() & 0xFFFF) - 32768);
+            }
+        }
+    }
+}
+
+static void sync(void) {
+    if (g_sched) advance(tick_sched_now());
+}
+
 static void calculate_phase_increment(uint8_t track) {
     lfo_state_t* lfo = &g_lfo[track];
+    sync();  // finish the elapsed time at the old rate
     
     if (lfo->bpm_sync && g_tempo_bpm > 0) {
         // BPM sync mode: calculate based on tempo and divisor
-        // phase_inc = (65536 * 1000) / (ms_per_cycle)
+        // phase_inc = 2^32 / ms_per_cycle
         // ms_per_cycle = (60000 * 4 * divisor) / bpm
         uint32_t ms_per_cycle = (60000UL * 4UL * lfo->bpm_divisor) / g_tempo_bpm;
         if (ms_per_cycle > 0) {
-            lfo->phase_increment = (65536000UL) / ms_per_cycle;
+            lfo->phase_increment = (uint32_t)((1ull << 32) / ms_per_cycle);
         } else {
             lfo->phase_increment = 0;
         }
     } else {
         // Free-running mode: use rate_hundredths
-        // phase_inc = (rate_hz * 65536 * 1000) / 1000000
+        // phase_inc = rate_hz * 2^32 / 1000
         // rate_hz = rate_hundredths / 100
         if (lfo->rate_hundredths > 0) {
-            lfo->phase_increment = (lfo->rate_hundredths * 65536UL) / 100UL;
+            lfo->phase_increment = (uint32_t)(((uint64_t)lfo->rate_hundredths << 32) / 100000UL);
         } else {
             lfo->phase_increment = 0;
         }
@@ -76,7 +112,7 @@ static void calculate_phase_increment(uint8_t track) {
 }
 
 static int16_t get_waveform_value(lfo_state_t* lfo) {
-    uint16_t phase_8bit = lfo->phase >> 8;  // Convert to 8-bit for lookup
+    uint16_t phase_8bit = lfo->phase >> 24;  // Convert to 8-bit for lookup
     int16_t value = 0;
     
     switch (lfo->waveform) {
@@ -103,7 +139,7 @@ static int16_t get_waveform_value(lfo_state_t* lfo) {
         case LFO_WAVEFORM_RANDOM:
             // Smooth random: interpolate between last and next random values
             {
-                uint16_t interp = lfo->phase >> 8;
+                uint16_t interp = lfo->phase >> 24;
                 int32_t diff = lfo->next_random - lfo->last_random;
                 value = lfo->last_random + ((diff * interp) >> 8);
             }
@@ -140,29 +176,18 @@ void lfo_init(void) {
 }
 
 void lfo_tick_1ms(void) {
-    for (uint8_t i = 0; i < LFO_MAX_TRACKS; i++) {
-        if (!g_lfo[i].enabled) continue;
-        
-        lfo_state_t* lfo = &g_lfo[i];
-        uint16_t old_phase_high = lfo->phase >> 16;
-        
-        lfo->phase += lfo->phase_increment;
-        
-        // Check for phase wrap (completed one cycle)
-        uint16_t new_phase_high = lfo->phase >> 16;
-        if (new_phase_high < old_phase_high) {
-            // Wrapped around - generate new random values
-            if (lfo->waveform == LFO_WAVEFORM_RANDOM || 
-                lfo->waveform == LFO_WAVEFORM_SAMPLE_HOLD) {
-                lfo->last_random = lfo->next_random;
-                lfo->next_random = (int16_t)((lcg_random() & 0xFFFF) - 32768);
-            }
-        }
-    }
+    advance(g_tick_counter + 1);
+}
+
+uint32_t lfo_service(uint32_t now_ms) {
+    g_sched = 1;
+    advance(now_ms);
+    return TICK_SCHED_IDLE;  // nothing to push: readers sync the phase
 }
 
 void lfo_set_enabled(uint8_t track, uint8_t enabled) {
     if (track >= LFO_MAX_TRACKS) return;
+    sync();  // a newly enabled LFO starts from now
     g_lfo[track].enabled = enabled ? 1 : 0;
 }
 
@@ -244,6 +269,7 @@ uint8_t lfo_get_bpm_divisor(uint8_t track) {
 
 void lfo_reset_phase(uint8_t track) {
     if (track >= LFO_MAX_TRACKS) return;
+    sync();
     g_lfo[track].phase = 0;
 }
 
@@ -251,6 +277,7 @@ uint8_t lfo_get_velocity_value(uint8_t track, uint8_t base_velocity) {
     if (track >= LFO_MAX_TRACKS || !g_lfo[track].enabled) return base_velocity;
     if (g_lfo[track].target != LFO_TARGET_VELOCITY) return base_velocity;
     
+    sync();
     int16_t lfo_val = get_waveform_value(&g_lfo[track]);
     int32_t modulation = ((int32_t)lfo_val * g_lfo[track].depth) / 32767;  // -depth to +depth
     int32_t result = base_velocity + modulation;
@@ -264,6 +291,7 @@ int8_t lfo_get_timing_value(uint8_t track) {
     if (track >= LFO_MAX_TRACKS || !g_lfo[track].enabled) return 0;
     if (g_lfo[track].target != LFO_TARGET_TIMING) return 0;
     
+    sync();
     int16_t lfo_val = get_waveform_value(&g_lfo[track]);
     // Scale to ±12 ticks based on depth
     int32_t modulation = ((int32_t)lfo_val * g_lfo[track].depth * 12) / (32767 * 100);
@@ -277,6 +305,7 @@ uint8_t lfo_get_pitch_value(uint8_t track, uint8_t base_note) {
     if (track >= LFO_MAX_TRACKS || !g_lfo[track].enabled) return base_note;
     if (g_lfo[track].target != LFO_TARGET_PITCH) return base_note;
     
+    sync();
     int16_t lfo_val = get_waveform_value(&g_lfo[track]);
     // Scale to ±12 semitones based on depth
     int32_t modulation = ((int32_t)lfo_val * g_lfo[track].depth * 12) / (32767 * 100);
@@ -42,6 +42,16 @@ void lfo_init(void);
  */
 void lfo_tick_1ms(void);
 
+/**
+ * @brief tick_sched handler (TICK_SVC_LFO): advance phases to now_ms
+ * @return Always TICK_SCHED_IDLE
+ * 
+ * Once driven by tick_sched, phases are integrated from its clock whenever
+ * an LFO value is read or a setting changes, so running LFOs need no
+ * periodic dispatch.
+ */
+uint32_t lfo_service(uint32_t now_ms);
+
 /**
  * @brief Enable/disable LFO for a track
  * @param track Track index (0-3)
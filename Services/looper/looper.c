@@ -38,6 +38,7 @@ typedef struct {
   uint32_t play_tick;
   uint32_t next_idx;
   uint32_t count;
+  volatile uint32_t gen;   // edit generation, bumped on every event/loop-length change
   looper_evt_t ev[LOOPER_MAX_EVENTS];
 
   uint8_t active_notes[16][128];
@@ -108,7 +109,9 @@ typedef struct {
 
 // Moved to CCMRAM for production to free regular RAM for bootloader
 // This provides ~8KB more RAM headroom (important for bootloader operation)
-// CCMRAM usage: g_tr(17KB) + fb(8KB) + active(24KB) + g_automation(8KB) = 57KB / 64KB ✅
+// CCMRAM usage (sizes from the object files): g_tr 24736 + g_automation 4144
+// + OLED fb/front 16384 = 45264 B / 64KB; test builds add undo_stacks
+// 16560 = 61824 B ✅
 static looper_automation_t g_automation[LOOPER_TRACKS] __attribute__((section(".ccmram")));
 
 static uint32_t g_ticks_per_ms_q16 = 0;
@@ -119,7 +122,9 @@ static osMutexId_t g_mutex;
 // Helper: ensure mutex is created (call before first use)
 static inline void ensure_looper_mutex(void) {
   if (g_mutex == NULL) {
-    const osMutexAttr_t attr = { .name = "looper" };
+    // UiTask (low priority) takes it for snapshots: inherit so the main
+    // task is never stuck behind a preempted renderer
+    const osMutexAttr_t attr = { .name = "looper", .attr_bits = osMutexPrioInherit };
     g_mutex = osMutexNew(&attr);
   }
 }
@@ -262,7 +267,14 @@ static inline uint32_t quantize_tick(uint32_t t, uint32_t step) {
   return (r < half_step) ? down : (down + step);
 }
 
+// Bump the edit generation so UI snapshots know the event list changed.
+// Always called with the looper mutex held.
+static inline void mark_edited(looper_track_t* t) {
+  t->gen++;
+}
+
 static void clear_track(looper_track_t* t) {
+  mark_edited(t);
   t->count = 0;
   t->loop_len_ticks = 0;
   t->write_tick = 0;
@@ -272,6 +284,7 @@ static void clear_track(looper_track_t* t) {
 }
 
 static void sort_events(looper_track_t* t) {
+  mark_edited(t);
   for (uint32_t i=1;i<t->count;i++) {
     looper_evt_t key = t->ev[i];
     uint32_t j = i;
@@ -283,8 +296,11 @@ static void sort_events(looper_track_t* t) {
   }
 }
 
+static uint8_t g_snap_valid = 0;  // see read-only track snapshots below
+
 void looper_init(void) {
   memset(g_tr, 0, sizeof(g_tr));
+  g_snap_valid = 0;  // generations restart at 0, drop any published view
   
   // Lazy creation: mutex will be created on first use (after scheduler starts)
   g_mutex = NULL;
@@ -473,6 +489,7 @@ static uint32_t ensure_loop_len(looper_track_t* t) {
   if (t->loop_beats) {
     t->loop_len_ticks = beats_to_ticks(t->loop_beats);
     if (t->loop_len_ticks < LOOPER_PPQN) t->loop_len_ticks = LOOPER_PPQN;
+    mark_edited(t);
     return t->loop_len_ticks;
   }
   return 0;
@@ -595,6 +612,7 @@ void looper_on_router_msg(uint8_t in_node, const router_msg_t* msg) {
     e->b0 = msg->b0;
     e->b1 = msg->b1;
     e->b2 = msg->b2;
+    mark_edited(t);
     
     // Check if this is a CC message and automation recording is active
     if ((status & 0xF0) == 0xB0 && g_automation[tr].recording) {
@@ -865,6 +883,140 @@ uint32_t looper_export_events(uint8_t track, looper_event_view_t* out, uint32_t
   return n;
 }
 
+// ---- Read-only track snapshots ----
+// Two buffers: the front one is what UI pages currently read, the back one is
+// rebuilt when a page asks for a different track or a newer generation.
+// RAM: 2 x (512 x 12 + 256 x 16) = ~20KB, replacing the page-local copies the
+// piano roll (ev/notes + 24KB CCMRAM pairing table) and timeline used to keep.
+#define SNAPSHOT_MAX_OPEN 32u   // Max simultaneously held notes tracked while pairing
+
+typedef struct {
+  looper_snapshot_t hdr;
+  looper_event_view_t ev[LOOPER_MAX_EVENTS];
+  looper_note_span_t spans[LOOPER_SNAPSHOT_MAX_SPANS];
+} snapshot_buf_t;
+
+static snapshot_buf_t g_snap[2];
+static uint8_t g_snap_front = 0;
+
+uint32_t looper_get_generation(uint8_t track) {
+  if (track >= LOOPER_TRACKS) return 0;
+  return g_tr[track].gen;
+}
+
+// Events are appended unsorted while overdubbing; keep the view ordered by tick
+// (stable, so note-on/off at the same tick keep their recording order).
+static void snapshot_sort_view(snapshot_buf_t* b) {
+  looper_event_view_t* v = b->ev;
+  for (uint32_t i=1; i<b->hdr.event_count; i++) {
+    if (v[i].tick >= v[i-1].tick) continue;
+    looper_event_view_t key = v[i];
+    uint32_t j = i;
+    while (j>0 && v[j-1].tick > key.tick) {
+      v[j] = v[j-1];
+      j--;
+    }
+    v[j] = key;
+  }
+}
+
+// Pair note-on/note-off events into spans. Spans are allocated at note-on time,
+// so they come out sorted by start tick. Open notes are tracked in a small list
+// instead of a 16x128 table: only notes actually held at the same time cost memory.
+static void snapshot_pair_notes(snapshot_buf_t* b) {
+  struct { uint16_t span; uint8_t ch; uint8_t note; } open[SNAPSHOT_MAX_OPEN];
+  uint32_t open_n = 0;
+  uint32_t n = 0;
+  uint32_t L = b->hdr.loop_len_ticks ? b->hdr.loop_len_ticks : (uint32_t)LOOPER_PPQN * 4u;
+
+  for (uint32_t i=0; i<b->hdr.event_count; i++) {
+    const looper_event_view_t* e = &b->ev[i];
+    if (e->len != 3) continue;
+    uint8_t on = is_note_on(e->b0, e->b2);
+    if (!on && !is_note_off(e->b0, e->b2)) continue;
+    uint8_t ch = e->b0 & 0x0F;
+
+    // A note-off closes the matching open note; a retrigger closes it at the new note-on
+    for (uint32_t k=0; k<open_n; k++) {
+      if (open[k].ch != ch || open[k].note != e->b1) continue;
+      looper_note_span_t* s = &b->spans[open[k].span];
+      s->end = e->tick;
+      if (on) {
+        if (s->end <= s->start) s->end = s->start + 1u;
+      } else {
+        s->off_idx = (uint16_t)e->idx;
+        if (s->end <= s->start) s->end += L;  // wraps into the next loop pass
+      }
+      open[k] = open[--open_n];
+      break;
+    }
+
+    if (!on || n >= LOOPER_SNAPSHOT_MAX_SPANS) continue;
+    looper_note_span_t* s = &b->spans[n];
+    s->start = e->tick;
+    s->end = 0;  // resolved by note-off, retrigger, or implicitly at loop end
+    s->on_idx = (uint16_t)e->idx;
+    s->off_idx = LOOPER_SPAN_NO_OFF;
+    s->ch = ch;
+    s->note = e->b1;
+    s->vel = e->b2;
+    s->reserved = 0;
+    if (open_n < SNAPSHOT_MAX_OPEN) {
+      open[open_n].span = (uint16_t)n;
+      open[open_n].ch = ch;
+      open[open_n].note = e->b1;
+      open_n++;
+    }
+    n++;
+  }
+
+  // Notes still held (or not trackable): implicit end at loop end
+  for (uint32_t i=0; i<n; i++) {
+    looper_note_span_t* s = &b->spans[i];
+    if (s->end != 0) continue;
+    s->end = L;
+    if (s->end <= s->start) s->end = s->start + 1u;
+  }
+  b->hdr.span_count = n;
+}
+
+const looper_snapshot_t* looper_snapshot_get(uint8_t track) {
+  if (track >= LOOPER_TRACKS) return NULL;
+
+  snapshot_buf_t* f = &g_snap[g_snap_front];
+  if (g_snap_valid && f->hdr.track == track && f->hdr.gen == g_tr[track].gen) {
+    return &f->hdr;  // Unchanged since last build: zero-copy
+  }
+
+  snapshot_buf_t* b = &g_snap[g_snap_front ^ 1u];
+  ensure_looper_mutex();
+  osMutexAcquire(g_mutex, osWaitForever);
+  looper_track_t* t = &g_tr[track];
+  b->hdr.track = track;
+  b->hdr.gen = t->gen;
+  b->hdr.loop_len_ticks = t->loop_len_ticks;
+  b->hdr.event_count = t->count;
+  for (uint32_t i=0; i<t->count; i++) {
+    b->ev[i].idx  = i;
+    b->ev[i].tick = t->ev[i].tick;
+    b->ev[i].len  = t->ev[i].len;
+    b->ev[i].b0   = t->ev[i].b0;
+    b->ev[i].b1   = t->ev[i].b1;
+    b->ev[i].b2   = t->ev[i].b2;
+  }
+  if (g_mutex) osMutexRelease(g_mutex);
+
+  // Ordering and pairing work on the private copy, outside the looper mutex
+  snapshot_sort_view(b);
+  snapshot_pair_notes(b);
+  b->hdr.events = b->ev;
+  b->hdr.spans = b->spans;
+
+  g_snap_front ^= 1u;
+  g_snap_valid = 1;
+  return &b->hdr;
+}
+
 static void sort_events(looper_track_t* t); // forward
 
 int looper_edit_event(uint8_t track, uint32_t idx, uint32_t new_tick,
@@ -1007,6 +1159,7 @@ void looper_load_from_scene(uint8_t scene, uint8_t track) {
   // Restore metadata (in a full implementation, restore event data too)
   t->loop_beats = slot->loop_beats;
   t->loop_len_ticks = slot->loop_len_ticks;
+  mark_edited(t);
   // Note: Not changing state automatically - user controls playback
   
   if (g_mutex) osMutexRelease(g_mutex);
@@ -1927,6 +2080,7 @@ int looper_undo(uint8_t track) {
     g_tr[track].ev[i].b1 = state->events[i].b1;
     g_tr[track].ev[i].b2 = state->events[i].b2;
   }
+  mark_edited(&g_tr[track]);
   
   if (g_mutex) osMutexRelease(g_mutex);
   return 0;
@@ -1968,6 +2122,7 @@ int looper_redo(uint8_t track) {
     g_tr[track].ev[i].b1 = state->events[i].b1;
     g_tr[track].ev[i].b2 = state->events[i].b2;
   }
+  mark_edited(&g_tr[track]);
   
   if (g_mutex) osMutexRelease(g_mutex);
   return 0;
@@ -2198,6 +2353,7 @@ void looper_quantize_track(uint8_t track, uint8_t resolution) {
       }
     }
   }
+  mark_edited(t);
   
   if (g_mutex) osMutexRelease(g_mutex);
 }
@@ -2506,6 +2662,7 @@ int looper_paste_track(uint8_t track) {
   for (uint32_t i = 0; i < track_clipboard.count && i < LOOPER_MAX_EVENTS; i++) {
     t->ev[i] = track_clipboard.events[i];
   }
+  mark_edited(t);
   
   osMutexRelease(g_mutex);
   return 0;
@@ -2667,6 +2824,7 @@ void looper_transpose_all_tracks(int8_t semitones) {
         t->ev[i].b1 = (uint8_t)note;
       }
     }
+    mark_edited(t);
   }
   
   osMutexRelease(g_mutex);
@@ -2931,6 +3089,7 @@ void looper_humanize_track(uint8_t track, uint8_t velocity_amount,
       }
     }
   }
+  mark_edited(t);
   
   osMutexRelease(g_mutex);
 }
@@ -257,6 +257,63 @@ uint32_t looper_get_loop_len_ticks(uint8_t track);
 /** Copy events snapshot into out[]. Returns number copied. */
 uint32_t looper_export_events(uint8_t track, looper_event_view_t* out, uint32_t max);
 
+// ---- Read-only track snapshots (UI pages) ----
+// Instead of copying events into page-local arrays on every refresh, UI pages
+// ask the looper for a published, read-only view of a track. The view is
+// double-buffered inside the looper and only rebuilt when the track's edit
+// generation changes, so an unchanged track costs one counter compare.
+
+#ifndef LOOPER_SNAPSHOT_MAX_SPANS
+#define LOOPER_SNAPSHOT_MAX_SPANS 256u   // Max pre-paired note spans per snapshot
+#endif
+
+#define LOOPER_SPAN_NO_OFF 0xFFFFu       // off_idx value for notes without a note-off
+
+typedef struct {
+  uint32_t start;    // note-on tick
+  uint32_t end;      // note-off tick (> start; may exceed loop length when the note wraps)
+  uint16_t on_idx;   // event index of the note-on
+  uint16_t off_idx;  // event index of the note-off, or LOOPER_SPAN_NO_OFF (implicit end at loop end)
+  uint8_t  ch;       // MIDI channel 0-15
+  uint8_t  note;     // MIDI note 0-127
+  uint8_t  vel;      // note-on velocity
+  uint8_t  reserved;
+} looper_note_span_t;
+
+typedef struct {
+  uint8_t  track;                     // track this view belongs to
+  uint32_t gen;                       // edit generation the view was built from
+  uint32_t loop_len_ticks;            // loop length at build time (0 = not yet known)
+  uint32_t event_count;
+  const looper_event_view_t* events;  // sorted by tick
+  uint32_t span_count;
+  const looper_note_span_t* spans;    // sorted by start tick
+} looper_snapshot_t;
+
+/**
+ * @brief Get the edit generation of a track
+ * @param track Track index (0-3)
+ * @return Counter that changes whenever events or loop length of the track change
+ *
+ * Lock-free; UI pages compare it against the generation of the view they hold
+ * to decide whether anything has to be re-read.
+ */
+uint32_t looper_get_generation(uint8_t track);
+
+/**
+ * @brief Get a read-only snapshot of a track's events and note spans
+ * @param track Track index (0-3)
+ * @return Published view, or NULL on invalid track
+ *
+ * If the last published view is for the same track and generation it is
+ * returned as-is (no copy, no lock). Otherwise the back buffer is rebuilt
+ * under the looper mutex and swapped in. A returned pointer stays valid until
+ * the view has been rebuilt twice, so a page may keep it across one refresh of
+ * another page. Event indices in the view are valid for looper_edit_event() /
+ * looper_delete_event() as long as the generation has not changed.
+ */
+const looper_snapshot_t* looper_snapshot_get(uint8_t track);
+
 /** 
  * @brief Edit an event (tick + bytes)
  * @param track Track index (0-3)
@@ -283,6 +340,14 @@ int looper_edit_event(uint8_t track, uint32_t idx, uint32_t new_tick,
  */
 int looper_add_event(uint8_t track, uint32_t tick, uint8_t len, uint8_t b0, uint8_t b1, uint8_t b2);
 
+/**
+ * @brief Delete an event from track
+ * @param track Track index (0-3)
+ * @param idx Event index from looper_export_events() / looper_snapshot_get()
+ * @return 0 on success, negative on error (invalid track, invalid index)
+ */
+int looper_delete_event(uint8_t track, uint32_t idx);
+
 // ---- Song Mode / Scene Management ----
 // Number of scene slots (configurable for memory optimization)
 // Each scene uses minimal memory (~32 bytes per track)
@@ -8,6 +8,7 @@
 #if MODULE_ENABLE_MIDI_DELAY_FX
 
 #include "Services/midi_delay/midi_delay.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <string.h>
 
 // Division names
@@ -56,6 +57,7 @@ typedef struct {
 static delay_config_t g_delay[MIDI_DELAY_MAX_TRACKS];
 static uint16_t g_tempo = 120;  // BPM
 static uint32_t g_tick_counter = 0;
+static uint8_t g_sched = 0;  // driven by tick_sched: its clock is newer between dispatches
 static midi_delay_output_cb_t g_output_callback = NULL;
 
 /**
@@ -73,6 +75,10 @@ static uint32_t calculate_delay_ms(midi_delay_division_t division) {
     return ms_per_64th * division_multipliers[division];
 }
 
+static uint32_t now_ms(void) {
+    return g_sched ? tick_sched_now() : g_tick_counter;
+}
+
 /**
  * @brief Initialize MIDI delay module
  */
@@ -98,15 +104,18 @@ void midi_delay_set_tempo(uint16_t tempo) {
     if (tempo < 20) tempo = 20;
     if (tempo > 300) tempo = 300;
     g_tempo = tempo;
+    tick_sched_wake(TICK_SVC_MIDI_DELAY, 0);  // delay times changed
 }
 
 /**
- * @brief Called every 1ms to process delayed events
+ * @brief Trigger due echoes
+ * @return ms until the next echo, TICK_SCHED_IDLE when none is pending
  */
-void midi_delay_tick_1ms(void) {
-    g_tick_counter++;
+static uint32_t service_at(uint32_t now) {
+    uint32_t next = TICK_SCHED_IDLE;
+    g_tick_counter = now;
     
-    if (!g_output_callback) return;
+    if (!g_output_callback) return next;
     
     for (uint8_t t = 0; t < MIDI_DELAY_MAX_TRACKS; t++) {
         delay_config_t* cfg = &g_delay[t];
@@ -140,10 +149,30 @@ void midi_delay_tick_1ms(void) {
                 } else {
                     // No more repeats
                     evt->active = 0;
+                    continue;
                 }
+                elapsed = 0;
             }
+            
+            if (delay_time - elapsed < next) next = delay_time - elapsed;
         }
     }
+    return next;
+}
+
+/**
+ * @brief Called every 1ms to process delayed events
+ */
+void midi_delay_tick_1ms(void) {
+    (void)service_at(g_tick_counter + 1);
+}
+
+/**
+ * @brief tick_sched handler
+ */
+uint32_t midi_delay_service(uint32_t now_ms) {
+    g_sched = 1;
+    return service_at(now_ms);
 }
 
 /**
@@ -152,6 +181,7 @@ void midi_delay_tick_1ms(void) {
 void midi_delay_set_enabled(uint8_t track, uint8_t enabled) {
     if (track >= MIDI_DELAY_MAX_TRACKS) return;
     g_delay[track].enabled = enabled ? 1 : 0;
+    tick_sched_wake(TICK_SVC_MIDI_DELAY, 0);
 }
 
 /**
@@ -169,6 +199,7 @@ void midi_delay_set_division(uint8_t track, midi_delay_division_t division) {
     if (track >= MIDI_DELAY_MAX_TRACKS) return;
     if (division >= DELAY_DIV_COUNT) return;
     g_delay[track].division = division;
+    tick_sched_wake(TICK_SVC_MIDI_DELAY, 0);
 }
 
 /**
@@ -246,8 +277,9 @@ void midi_delay_process_note(uint8_t track, uint8_t note, uint8_t velocity, uint
             cfg->events[i].note = note;
             cfg->events[i].velocity = velocity;
             cfg->events[i].channel = channel;
-            cfg->events[i].trigger_time_ms = g_tick_counter;
+            cfg->events[i].trigger_time_ms = now_ms();
             cfg->events[i].repeat_count = 0;
+            tick_sched_wake(TICK_SVC_MIDI_DELAY, calculate_delay_ms(cfg->division));
             break;
         }
     }
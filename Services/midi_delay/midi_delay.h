@@ -10,6 +10,7 @@
 #pragma once
 #include <stdint.h>
 #include "Config/module_config.h"
+#include "Services/tick_sched/tick_sched.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +63,7 @@ typedef void (*midi_delay_output_cb_t)(uint8_t track, uint8_t note, uint8_t velo
 void midi_delay_init(uint16_t tempo);
 void midi_delay_set_tempo(uint16_t tempo);
 void midi_delay_tick_1ms(void);
+uint32_t midi_delay_service(uint32_t now_ms);  // tick_sched handler: ms to next echo or TICK_SCHED_IDLE
 void midi_delay_set_enabled(uint8_t track, uint8_t enabled);
 uint8_t midi_delay_is_enabled(uint8_t track);
 void midi_delay_set_division(uint8_t track, midi_delay_division_t division);
@@ -84,6 +86,7 @@ void midi_delay_set_output_callback(midi_delay_output_cb_t callback);
 static inline void midi_delay_init(uint16_t tempo) { (void)tempo; }
 static inline void midi_delay_set_tempo(uint16_t tempo) { (void)tempo; }
 static inline void midi_delay_tick_1ms(void) {}
+static inline uint32_t midi_delay_service(uint32_t now_ms) { (void)now_ms; return TICK_SCHED_IDLE; }
 static inline void midi_delay_set_enabled(uint8_t track, uint8_t enabled) { (void)track; (void)enabled; }
 static inline uint8_t midi_delay_is_enabled(uint8_t track) { (void)track; return 0; }
 static inline void midi_delay_set_division(uint8_t track, midi_delay_division_t division) { (void)track; (void)division; }
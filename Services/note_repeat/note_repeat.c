@@ -4,6 +4,7 @@
  */
 
 #include "Services/note_repeat/note_repeat.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <string.h>
 
 // Rate names
@@ -49,6 +50,7 @@ typedef struct {
 static repeat_config_t g_repeat[NOTE_REPEAT_MAX_TRACKS];
 static uint16_t g_tempo = 120;
 static uint32_t g_tick_counter = 0;
+static uint8_t g_sched = 0;  // driven by tick_sched: its clock is newer between dispatches
 static note_repeat_output_cb_t g_output_callback = NULL;
 
 /**
@@ -75,6 +77,10 @@ static uint32_t calculate_interval_ms(note_repeat_rate_t rate) {
     }
 }
 
+static uint32_t now_ms(void) {
+    return g_sched ? tick_sched_now() : g_tick_counter;
+}
+
 /**
  * @brief Initialize note repeat module
  */
@@ -99,15 +105,18 @@ void note_repeat_set_tempo(uint16_t tempo) {
     if (tempo < 20) tempo = 20;
     if (tempo > 300) tempo = 300;
     g_tempo = tempo;
+    tick_sched_wake(TICK_SVC_NOTE_REPEAT, 0);  // intervals changed
 }
 
 /**
- * @brief Called every 1ms to generate repeats
+ * @brief Send due note offs and repeats
+ * @return ms until the next one, TICK_SCHED_IDLE when no repeat is active
  */
-void note_repeat_tick_1ms(void) {
-    g_tick_counter++;
+static uint32_t service_at(uint32_t now) {
+    uint32_t next = TICK_SCHED_IDLE;
+    g_tick_counter = now;
     
-    if (!g_output_callback) return;
+    if (!g_output_callback) return next;
     
     for (uint8_t t = 0; t < NOTE_REPEAT_MAX_TRACKS; t++) {
         repeat_config_t* cfg = &g_repeat[t];
@@ -146,8 +155,28 @@ void note_repeat_tick_1ms(void) {
             cfg->state.note_on = 1;
             cfg->state.last_trigger_ms = g_tick_counter;
             cfg->state.repeat_count++;
+            elapsed = 0;
         }
+        
+        if (interval - elapsed < next) next = interval - elapsed;
+        if (cfg->state.note_on && gate_time - elapsed < next) next = gate_time - elapsed;
     }
+    return next;
+}
+
+/**
+ * @brief Called every 1ms to generate repeats
+ */
+void note_repeat_tick_1ms(void) {
+    (void)service_at(g_tick_counter + 1);
+}
+
+/**
+ * @brief tick_sched handler
+ */
+uint32_t note_repeat_service(uint32_t now_ms) {
+    g_sched = 1;
+    return service_at(now_ms);
 }
 
 /**
@@ -156,6 +185,7 @@ void note_repeat_tick_1ms(void) {
 void note_repeat_set_enabled(uint8_t track, uint8_t enabled) {
     if (track >= NOTE_REPEAT_MAX_TRACKS) return;
     g_repeat[track].enabled = enabled ? 1 : 0;
+    tick_sched_wake(TICK_SVC_NOTE_REPEAT, 0);
 }
 
 /**
@@ -173,6 +203,7 @@ void note_repeat_set_rate(uint8_t track, note_repeat_rate_t rate) {
     if (track >= NOTE_REPEAT_MAX_TRACKS) return;
     if (rate >= REPEAT_RATE_COUNT) return;
     g_repeat[track].rate = rate;
+    tick_sched_wake(TICK_SVC_NOTE_REPEAT, 0);
 }
 
 /**
@@ -191,6 +222,7 @@ void note_repeat_set_gate(uint8_t track, uint8_t gate) {
     if (gate < 10) gate = 10;
     if (gate > 95) gate = 95;
     g_repeat[track].gate = gate;
+    tick_sched_wake(TICK_SVC_NOTE_REPEAT, 0);
 }
 
 /**
@@ -247,9 +279,10 @@ void note_repeat_trigger(uint8_t track, uint8_t note, uint8_t velocity, uint8_t
     cfg->state.note = note;
     cfg->state.base_velocity = velocity;
     cfg->state.channel = channel;
-    cfg->state.last_trigger_ms = g_tick_counter;
+    cfg->state.last_trigger_ms = now_ms();
     cfg->state.repeat_count = 0;
     cfg->state.note_on = 0;
+    tick_sched_wake(TICK_SVC_NOTE_REPEAT, calculate_interval_ms(cfg->rate));
 }
 
 /**
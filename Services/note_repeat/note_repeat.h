@@ -47,6 +47,12 @@ void note_repeat_set_tempo(uint16_t tempo);
  */
 void note_repeat_tick_1ms(void);
 
+/**
+ * @brief tick_sched handler (TICK_SVC_NOTE_REPEAT)
+ * @return ms until the next note on/off, TICK_SCHED_IDLE when nothing repeats
+ */
+uint32_t note_repeat_service(uint32_t now_ms);
+
 /**
  * @brief Enable/disable note repeat for a track
  * @param track Track index (0-3)
@@ -3,13 +3,13 @@
 #include "Services/dream/dream_sysex.h"
 #include "Services/safe/safe_mode.h"
 #include "Services/patch/patch.h"
-#include "Services/patch/patch_router.h"
 #include "Services/patch/patch_sd_mount.h"
 
 #include <string.h>
 
 static const char* k_state_path = "0:/patch/state.ngs";
 static const char* k_router_default = "0:/cfg/router_default.ngc";
+static const char* k_chord_default = "/cfg/chord_bank.ngc";
 
 void patch_manager_init(patch_manager_t* pm) {
   memset(pm, 0, sizeof(*pm));
@@ -103,13 +103,24 @@ static int find_patch_chord_bank(const char* patch_path, char* out, size_t out_s
 #endif
 }
 
-int patch_manager_apply(patch_manager_t* pm) {
-  if (!pm) return -1;
+static const char* chord_bank_path(const char* path) {
+  return (path && path[0]) ? path : k_chord_default;
+}
+
+int patch_manager_prepare_chords(const patch_manager_t* pm, patch_manager_staged_t* st) {
+  if (!pm || !st) return -1;
+  return chord_bank_load(&st->chords, chord_bank_path(pm->bank.chord_bank_path));
+}
+
+int patch_manager_prepare(const patch_manager_t* pm, patch_manager_staged_t* st) {
+  if (!pm || !st) return -1;
 
-  // Apply router defaults first
+  // Router defaults first
+  patch_router_clear(&st->routes);
   (void)patch_load(k_router_default);
   patch_ctx_t pctx = { .midi_ch = 1, .in_node = 0 };
-  (void)patch_router_apply(&pctx);
+  patch_router_parse(&pctx, &st->routes);
+  (void)patch_manager_prepare_chords(pm, st);
 
   // Load patch file
   int pr = patch_load(pm->current_patch_path);
@@ -117,16 +128,12 @@ int patch_manager_apply(patch_manager_t* pm) {
 
   // Chord bank selection priority:
   // 1) per-patch override: CHORD_BANK=...
-  // 2) per-bank default:   pm->bank.chord_bank_path
+  // 2) per-bank default:   pm->bank.chord_bank_path (staged above)
   // 3) global default:     /cfg/chord_bank.ngc
   char chord_path[96] = {0};
   int fr = find_patch_chord_bank(pm->current_patch_path, chord_path, sizeof(chord_path));
   if (fr > 0) {
-    (void)ui_reload_chord_bank(chord_path);
-  } else if (pm->bank.chord_bank_path[0]) {
-    (void)ui_reload_chord_bank(pm->bank.chord_bank_path);
-  } else {
-    (void)ui_reload_chord_bank(0);
+    (void)chord_bank_load(&st->chords, chord_path);
   }
 
   // DREAM init (optional)
@@ -134,10 +141,19 @@ int patch_manager_apply(patch_manager_t* pm) {
     (void)dream_apply_from_patch(pm->current_patch_path);
   }
 
-  // Apply routing and save state
-  (void)patch_router_apply(&pctx);
-  if (!safe_mode_is_enabled()) {
-    (void)patch_state_save(&pm->state, k_state_path);
-  }
+  // Patch routing on top of the defaults
+  patch_router_parse(&pctx, &st->routes);
   return 0;
 }
+
+void patch_manager_commit(const patch_manager_staged_t* st, uint8_t with_routes) {
+  if (!st) return;
+  if (with_routes) patch_router_commit(&st->routes);
+  ui_set_chord_bank(&st->chords);
+}
+
+int patch_manager_save_state(const patch_manager_t* pm) {
+  if (!pm) return -1;
+  if (safe_mode_is_enabled()) return 0;
+  return patch_state_save(&pm->state, k_state_path);
+}
@@ -2,6 +2,8 @@
 #include <stdint.h>
 #include "Services/patch/patch_bank.h"
 #include "Services/patch/patch_state.h"
+#include "Services/patch/patch_router.h"
+#include "Services/ui/chord_cfg.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,7 +18,25 @@ typedef struct {
 void patch_manager_init(patch_manager_t* pm);
 int patch_manager_boot(patch_manager_t* pm);
 int patch_manager_select_patch(patch_manager_t* pm, uint16_t patch_index);
-int patch_manager_apply(patch_manager_t* pm);
+
+// A patch apply in three steps, so storage access and the live state
+// change can run on different tasks:
+// - prepare: reads the router defaults, the patch and its chord bank from
+//   SD, sends its DREAM SysEx, and stages routes and chords in st
+//   (returns <0 if the patch cannot be loaded; the defaults and the bank's
+//   chord bank are staged anyway)
+// - commit: applies st to the router and the chord bank; no storage access
+// - save state: remembers bank and patch on SD
+typedef struct {
+  patch_routes_t routes;  // router defaults, then the patch's routes
+  chord_bank_t chords;
+} patch_manager_staged_t;
+
+int patch_manager_prepare(const patch_manager_t* pm, patch_manager_staged_t* st);
+// Stage only the bank's chord bank (bank change without apply)
+int patch_manager_prepare_chords(const patch_manager_t* pm, patch_manager_staged_t* st);
+void patch_manager_commit(const patch_manager_staged_t* st, uint8_t with_routes);
+int patch_manager_save_state(const patch_manager_t* pm);
 
 #ifdef __cplusplus
 }
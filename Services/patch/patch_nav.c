@@ -0,0 +1,133 @@
+#include "Services/patch/patch_nav.h"
+#include "Services/patch/patch_system.h"
+#include "Services/ui/ui.h"
+#include "cmsis_os2.h"
+
+typedef struct {
+  uint8_t op;
+  int8_t delta;
+} patch_nav_intent_t;
+
+typedef struct {
+  int32_t patch_delta;
+  int32_t bank_delta;
+  uint8_t apply;
+} patch_nav_batch_t;
+
+// Follow-up once the worker has staged the change: the commit touches
+// state the main task uses without locks (patch state, router, chord bank,
+// OLED labels), the state save is storage again and stays on the worker
+#define FOLLOW_COMMIT 0x01u  // main task: make the staged state live, refresh the header labels
+#define FOLLOW_SAVE   0x02u  // worker: remember the applied patch on SD
+
+static osMessageQueueId_t g_q = NULL;
+static osSemaphoreId_t g_followed = NULL;
+static volatile uint8_t g_follow = 0;
+static volatile uint32_t g_dropped = 0;
+
+static void refresh_patch_status(void) {
+  const patch_manager_t* pm = patch_system_get();
+  const char* bank = pm->bank.bank_id[0] ? pm->bank.bank_id : pm->bank.bank_name;
+  const char* patch = pm->bank.patches[pm->state.patch_index].label[0] ?
+                      pm->bank.patches[pm->state.patch_index].label : "patch";
+  ui_set_patch_status(bank, patch);
+}
+
+static void merge(patch_nav_batch_t* b, const patch_nav_intent_t* in) {
+  switch ((patch_nav_op_t)in->op) {
+    case PATCH_NAV_PATCH: b->patch_delta += in->delta; break;
+    case PATCH_NAV_BANK:  b->bank_delta += in->delta; break;
+    case PATCH_NAV_APPLY: b->apply = 1; break;
+    default: break;
+  }
+}
+
+// Bank load, patch selection and every file read of an apply, staged;
+// returns the follow-up work
+static uint8_t execute(const patch_nav_batch_t* b) {
+  uint8_t f = 0;
+  uint8_t bank = (b->bank_delta && patch_system_bank_step((int)b->bank_delta) == 0) ? 1u : 0u;
+  if (b->patch_delta) (void)patch_system_patch_step((int)b->patch_delta);
+  if (b->apply) {
+    if (patch_system_prepare_apply() == 0) f |= FOLLOW_SAVE;  // reloads the chords too
+  } else if (bank) {
+    (void)patch_system_prepare_chords();
+  }
+  if (b->bank_delta || b->patch_delta || b->apply) f |= FOLLOW_COMMIT;
+  return f;
+}
+
+// Main task: no storage access here
+static void follow_up(uint8_t f) {
+  if (!(f & FOLLOW_COMMIT)) return;
+  patch_system_commit();
+  refresh_patch_status();
+}
+
+static void finish(uint8_t f) {
+  if (f & FOLLOW_SAVE) (void)patch_system_save_state();
+}
+
+int patch_nav_enable_worker(void) {
+  if (!g_q) {
+    const osMessageQueueAttr_t attr = { .name = "patch_nav" };
+    g_q = osMessageQueueNew(PATCH_NAV_QUEUE_LEN, sizeof(patch_nav_intent_t), &attr);
+    if (!g_q) return -1;
+  }
+  if (!g_followed) {
+    const osSemaphoreAttr_t attr = { .name = "patch_nav_done" };
+    g_followed = osSemaphoreNew(1, 0, &attr);
+    if (!g_followed) {
+      (void)osMessageQueueDelete(g_q);
+      g_q = NULL;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+void patch_nav_post(patch_nav_op_t op, int8_t delta) {
+  patch_nav_intent_t in = { .op = (uint8_t)op, .delta = delta };
+  if (g_q) {
+    if (osMessageQueuePut(g_q, &in, 0, 0) != osOK) g_dropped++;
+    return;
+  }
+  patch_nav_batch_t b = { 0, 0, 0 };
+  merge(&b, &in);
+  uint8_t f = execute(&b);
+  follow_up(f);
+  finish(f);
+}
+
+uint32_t patch_nav_process(uint32_t timeout_ms) {
+  if (!g_q) return 0;
+
+  patch_nav_intent_t in;
+  if (osMessageQueueGet(g_q, &in, NULL, timeout_ms) != osOK) return 0;
+
+  patch_nav_batch_t b = { 0, 0, 0 };
+  uint32_t n = 0;
+  do {
+    merge(&b, &in);
+    n++;
+  } while (!b.apply && osMessageQueueGet(g_q, &in, NULL, PATCH_NAV_SETTLE_MS) == osOK);
+
+  uint8_t f = execute(&b);
+  if (f & FOLLOW_COMMIT) {
+    // The main task owns the commit; the staged state stays put until it is done
+    g_follow = f;
+    (void)osSemaphoreAcquire(g_followed, osWaitForever);
+  }
+  finish(f);
+  return n;
+}
+
+void patch_nav_main_service(void) {
+  uint8_t f = g_follow;
+  if (!f) return;
+  follow_up(f);
+  g_follow = 0;
+  (void)osSemaphoreRelease(g_followed);
+}
+
+uint32_t patch_nav_get_dropped(void) { return g_dropped; }
@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Patch/bank navigation intents.
+//
+// Input handlers post intents and return at once. With the worker enabled
+// (PatchTask, see App/patch_task.c) the intents are queued and the worker
+// does the bank loads and patch selection. Intents that arrive within
+// PATCH_NAV_SETTLE_MS of each other are merged, so a fast encoder scroll
+// ends in a single bank load. An APPLY closes the batch: navigation posted
+// after it is applied separately.
+// The worker also does every file read of an apply (router defaults,
+// patch, chord bank) into staged copies. Making them live touches state
+// the main task uses (patch state, router, chord bank, OLED header labels),
+// so the worker hands that cheap commit to patch_nav_main_service() and
+// waits for it before saving the state and starting the next batch.
+// Without the worker, patch_nav_post() runs the whole intent directly.
+
+#ifndef PATCH_NAV_QUEUE_LEN
+#define PATCH_NAV_QUEUE_LEN 16
+#endif
+
+#ifndef PATCH_NAV_SETTLE_MS
+#define PATCH_NAV_SETTLE_MS 40
+#endif
+
+typedef enum {
+  PATCH_NAV_PATCH = 0,  // move delta patches in the current bank
+  PATCH_NAV_BANK,       // move delta banks
+  PATCH_NAV_APPLY       // apply the selected patch
+} patch_nav_op_t;
+
+// Create the intent queue. Returns 0 on success, -1 if it cannot be created.
+int patch_nav_enable_worker(void);
+
+// Never blocks. Intents are dropped (and counted) if the queue is full.
+void patch_nav_post(patch_nav_op_t op, int8_t delta);
+
+// Worker: wait up to timeout_ms for an intent, merge the ones that follow
+// and execute the batch. Returns the number of intents handled.
+uint32_t patch_nav_process(uint32_t timeout_ms);
+
+// Main task: commit the state staged by the worker (patch state swap,
+// routes, chord bank) and update the header; never touches storage.
+// Does nothing when there is none (or without the worker).
+void patch_nav_main_service(void);
+
+uint32_t patch_nav_get_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
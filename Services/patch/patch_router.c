@@ -149,7 +149,10 @@ static void parse_route_value(const char* value, int* src, int* dst, uint16_t* c
   *dst = parse_node_name(sdst);
 }
 
-void patch_router_apply(const patch_ctx_t* ctx) {
+// Calls fn for each [router] route of the loaded patch entries
+static void for_each_route(const patch_ctx_t* ctx,
+                           void (*fn)(void* user, uint8_t src, uint8_t dst, uint16_t chmask),
+                           void* user) {
   // Iterate all entries in [router] section
   uint32_t n = patch_adv_count();
   for (uint32_t i=0;i<n;i++) {
@@ -167,7 +170,44 @@ void patch_router_apply(const patch_ctx_t* ctx) {
     parse_route_value(e->value, &src, &dst, &chmask);
     if (src < 0 || dst < 0) continue;
 
-    router_set_route((uint8_t)src, (uint8_t)dst, 1);
-    router_set_chanmask((uint8_t)src, (uint8_t)dst, chmask);
+    fn(user, (uint8_t)src, (uint8_t)dst, chmask);
+  }
+}
+
+static void route_to_router(void* user, uint8_t src, uint8_t dst, uint16_t chmask) {
+  (void)user;
+  router_set_route(src, dst, 1);
+  router_set_chanmask(src, dst, chmask);
+}
+
+static void route_to_set(void* user, uint8_t src, uint8_t dst, uint16_t chmask) {
+  patch_routes_t* r = (patch_routes_t*)user;
+  if (src >= ROUTER_NUM_NODES || dst >= ROUTER_NUM_NODES) return;
+  r->set[src] |= (uint16_t)(1u << dst);
+  r->chmask[src][dst] = chmask;
+}
+
+void patch_router_apply(const patch_ctx_t* ctx) {
+  for_each_route(ctx, route_to_router, NULL);
+}
+
+void patch_router_clear(patch_routes_t* r) {
+  if (r) memset(r, 0, sizeof(*r));
+}
+
+void patch_router_parse(const patch_ctx_t* ctx, patch_routes_t* r) {
+  if (!r) return;
+  for_each_route(ctx, route_to_set, r);
+}
+
+void patch_router_commit(const patch_routes_t* r) {
+  if (!r) return;
+  for (uint8_t src=0; src<ROUTER_NUM_NODES; src++) {
+    if (!r->set[src]) continue;
+    for (uint8_t dst=0; dst<ROUTER_NUM_NODES; dst++) {
+      if (!(r->set[src] & (1u << dst))) continue;
+      router_set_route(src, dst, 1);
+      router_set_chanmask(src, dst, r->chmask[src][dst]);
+    }
   }
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include "Services/patch/patch_adv.h"
+#include "Config/router_config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,6 +28,23 @@ extern "C" {
  */
 void patch_router_apply(const patch_ctx_t* ctx);
 
+/**
+ * Routes parsed ahead of time, so they can be applied without the patch
+ * entries (patch_router_commit only calls the router setters).
+ * Later routes override the channel mask of earlier ones, as applying
+ * them in turn would.
+ */
+typedef struct {
+  uint16_t set[ROUTER_NUM_NODES];                       // bit out_node: route enabled
+  uint16_t chmask[ROUTER_NUM_NODES][ROUTER_NUM_NODES];  // [in_node][out_node]
+} patch_routes_t;
+
+void patch_router_clear(patch_routes_t* r);
+// Add the [router] routes of the loaded patch entries to r
+void patch_router_parse(const patch_ctx_t* ctx, patch_routes_t* r);
+// Enable the routes in r and set their channel masks
+void patch_router_commit(const patch_routes_t* r);
+
 #ifdef __cplusplus
 }
 #endif
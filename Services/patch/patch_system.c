@@ -6,7 +6,39 @@
 #include <ctype.h>
 #include <stdlib.h>
 
-static patch_manager_t g_pm;
+#if __has_include("ff.h")
+  #include "ff.h"
+  #define PS_HAS_FATFS 1
+#else
+  #define PS_HAS_FATFS 0
+#endif
+
+#define BANK_DIR "0:/patch/banks"
+
+// Live state (patch_system_get) and the next one: navigation and the
+// storage reads of an apply build the next state while readers keep using
+// the live one, and patch_system_commit() swaps the buffers
+static patch_manager_t g_pm_buf[2];
+static patch_manager_t* volatile g_pm = &g_pm_buf[0];
+static patch_manager_t* g_next = NULL;  // staged state, NULL when none
+
+#define STAGED_CHORDS 0x01u
+#define STAGED_ROUTES 0x02u
+
+static patch_manager_staged_t g_staged;  // routes and chord bank for the next commit
+static uint8_t g_staged_what = 0;
+
+// The state to change: a copy of the live one, made on first use
+static patch_manager_t* next_pm(void) {
+  if (!g_next) {
+    g_next = (g_pm == &g_pm_buf[0]) ? &g_pm_buf[1] : &g_pm_buf[0];
+    *g_next = *g_pm;
+  }
+  return g_next;
+}
+
+// What the next commit will show
+static const patch_manager_t* cur_pm(void) { return g_next ? g_next : g_pm; }
 
 static int extract_bank_number(const char* path) {
   if (!path) return -1;
@@ -20,81 +52,152 @@ static int extract_bank_number(const char* path) {
 }
 
 static void set_bank_number(char* out, size_t out_sz, int n) {
-  snprintf(out, out_sz, "0:/patch/banks/bank_%02d.ngb", n);
+  snprintf(out, out_sz, BANK_DIR "/bank_%02d.ngb", n);
+}
+
+#if PS_HAS_FATFS
+// "BANK_07.NGB" -> 7 (8.3 names come back upper case), -1 if not a bank file
+static int bank_file_number(const char* name) {
+  if (strncasecmp(name, "bank_", 5) != 0 || !isdigit((unsigned char)name[5])) return -1;
+  char* end;
+  long n = strtol(name + 5, &end, 10);
+  if (strcasecmp(end, ".ngb") != 0 || n < 1 || n > 99) return -1;
+  return (int)n;
+}
+#endif
+
+// The bank furthest from cur, towards and not past target, that exists on
+// the card: one directory pass instead of a load attempt per bank.
+// Returns -1 if there is none.
+static int furthest_bank(int cur, int target) {
+#if PS_HAS_FATFS
+  DIR dir;
+  FILINFO fno;
+  if (f_opendir(&dir, BANK_DIR) != FR_OK) return -1;
+  int best = -1;
+  while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+    if (fno.fattrib & AM_DIR) continue;
+    int n = bank_file_number(fno.fname);
+    if (n < 0) continue;
+    if (target > cur) {
+      if (n > cur && n <= target && n > best) best = n;
+    } else {
+      if (n >= target && n < cur && (best < 0 || n < best)) best = n;
+    }
+  }
+  (void)f_closedir(&dir);
+  return best;
+#else
+  (void)cur;
+  return target;
+#endif
 }
 
 void patch_system_init(void) {
+  patch_manager_t* pm = &g_pm_buf[0];
+  g_pm = pm;
+  g_next = NULL;
+  g_staged_what = 0;
 
 	  // Phase de test : on initialise juste la structure, sans toucher à la SD / FatFS
-	  patch_manager_init(&g_pm);
+	  patch_manager_init(pm);
 
 	  // Optionnel : indiquer au reste du système qu'on est en mode "NO PATCH"
-	  strcpy(g_pm.bank.bank_name, "TEST");
-	  strcpy(g_pm.bank.bank_id, "NP"); // No Patch
-	  g_pm.bank.patch_count = 0;
-	  g_pm.current_patch_path[0] = 0;
+	  strcpy(pm->bank.bank_name, "TEST");
+	  strcpy(pm->bank.bank_id, "NP"); // No Patch
+	  pm->bank.patch_count = 0;
+	  pm->current_patch_path[0] = 0;
 
-//  patch_manager_init(&g_pm);
-//  int br = patch_manager_boot(&g_pm);
+//  patch_manager_init(pm);
+//  int br = patch_manager_boot(pm);
 //  if (br < 0) {
-//    strcpy(g_pm.bank.bank_name, "NO_SD");
-//    strcpy(g_pm.bank.bank_id, "SD?");
-//    g_pm.bank.patch_count = 1;
-//    strcpy(g_pm.bank.patches[0].label, "Init");
-//    g_pm.state.patch_index = 0;
-//    g_pm.current_patch_path[0] = 0;
+//    strcpy(pm->bank.bank_name, "NO_SD");
+//    strcpy(pm->bank.bank_id, "SD?");
+//    pm->bank.patch_count = 1;
+//    strcpy(pm->bank.patches[0].label, "Init");
+//    pm->state.patch_index = 0;
+//    pm->current_patch_path[0] = 0;
 //    safe_mode_set_sd_ok(0);
 //    return;
 //  }
-//  (void)patch_manager_apply(&g_pm);
+//  (void)patch_system_apply();
 }
-int patch_system_apply(void) {
-  (void)ui_reload_chord_bank(g_pm.bank.chord_bank_path);
-  return patch_manager_apply(&g_pm);
+
+int patch_system_prepare_chords(void) {
+  int r = patch_manager_prepare_chords(cur_pm(), &g_staged);
+  g_staged_what |= STAGED_CHORDS;
+  return r;
 }
 
-int patch_system_patch_next(void) {
-  if (g_pm.bank.patch_count == 0) return -20;
-  uint16_t idx = g_pm.state.patch_index;
-  idx = (uint16_t)((idx + 1u) % g_pm.bank.patch_count);
-  patch_manager_select_patch(&g_pm, idx);
-  return 0;
+int patch_system_prepare_apply(void) {
+  int r = patch_manager_prepare(cur_pm(), &g_staged);
+  g_staged_what |= STAGED_CHORDS | STAGED_ROUTES;
+  return r;
 }
 
-int patch_system_patch_prev(void) {
-  if (g_pm.bank.patch_count == 0) return -20;
-  uint16_t idx = g_pm.state.patch_index;
-  idx = (uint16_t)((idx == 0u) ? (g_pm.bank.patch_count - 1u) : (idx - 1u));
-  patch_manager_select_patch(&g_pm, idx);
+void patch_system_commit(void) {
+  if (g_next) {
+    g_pm = g_next;
+    g_next = NULL;
+  }
+  if (g_staged_what) patch_manager_commit(&g_staged, (g_staged_what & STAGED_ROUTES) ? 1u : 0u);
+  g_staged_what = 0;
+}
+
+int patch_system_save_state(void) {
+  return patch_manager_save_state(g_pm);
+}
+
+int patch_system_apply(void) {
+  int r = patch_system_prepare_apply();
+  patch_system_commit();
+  if (r == 0) (void)patch_system_save_state();
+  return r;
+}
+
+int patch_system_patch_step(int delta) {
+  const patch_manager_t* cur = cur_pm();
+  if (cur->bank.patch_count == 0) return -20;
+  int n = (int)cur->bank.patch_count;
+  int idx = ((int)cur->state.patch_index + delta % n + n) % n;
+  patch_manager_select_patch(next_pm(), (uint16_t)idx);
   return 0;
 }
 
+int patch_system_patch_next(void) { return patch_system_patch_step(+1); }
+int patch_system_patch_prev(void) { return patch_system_patch_step(-1); }
+
 static int bank_step(int delta) {
-  int cur = extract_bank_number(g_pm.state.bank_path);
+  int cur = extract_bank_number(cur_pm()->state.bank_path);
   if (cur < 0) cur = 1;
   int next = cur + delta;
   if (next < 1) next = 1;
+  if (next != cur) {
+    next = furthest_bank(cur, next);
+    if (next < 0) return -1;
+  }
 
-  patch_state_t st = g_pm.state;
+  patch_state_t st = cur_pm()->state;
   set_bank_number(st.bank_path, sizeof(st.bank_path), next);
 
   patch_bank_t bk;
   int br = patch_bank_load(&bk, st.bank_path);
   if (br < 0) return br;
 
-  g_pm.state = st;
-  g_pm.bank = bk;
-  (void)ui_reload_chord_bank(g_pm.bank.chord_bank_path);
-  if (g_pm.bank.patch_count == 0) g_pm.state.patch_index = 0;
-  else if (g_pm.state.patch_index >= g_pm.bank.patch_count) g_pm.state.patch_index = 0;
+  patch_manager_t* pm = next_pm();
+  pm->state = st;
+  pm->bank = bk;
+  if (pm->bank.patch_count == 0) pm->state.patch_index = 0;
+  else if (pm->state.patch_index >= pm->bank.patch_count) pm->state.patch_index = 0;
 
-  strncpy(g_pm.current_patch_path,
-          g_pm.bank.patches[g_pm.state.patch_index].file,
-          sizeof(g_pm.current_patch_path)-1);
+  strncpy(pm->current_patch_path,
+          pm->bank.patches[pm->state.patch_index].file,
+          sizeof(pm->current_patch_path)-1);
   return 0;
 }
 
+int patch_system_bank_step(int delta) { return bank_step(delta); }
 int patch_system_bank_next(void) { return bank_step(+1); }
 int patch_system_bank_prev(void) { return bank_step(-1); }
 
-const patch_manager_t* patch_system_get(void) { return &g_pm; }
+const patch_manager_t* patch_system_get(void) { return g_pm; }
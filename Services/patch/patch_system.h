@@ -7,6 +7,8 @@ extern "C" {
 #endif
 
 void patch_system_init(void);
+
+// Apply the current patch in the caller: prepare, commit, save state
 int patch_system_apply(void);
 
 int patch_system_patch_next(void);
@@ -15,6 +17,28 @@ int patch_system_patch_prev(void);
 int patch_system_bank_next(void);
 int patch_system_bank_prev(void);
 
+// Multi-step navigation (wraps for patches, banks stop at bank 1).
+// One patch select / one bank load however large delta is: a bank step
+// past the last bank on the card settles on the furthest one there, and
+// fails (-1, nothing changes) if there is no bank in that direction.
+// Steps change a staged copy of the state; patch_system_get() keeps
+// returning the live one until patch_system_commit().
+int patch_system_patch_step(int delta);
+int patch_system_bank_step(int delta);
+
+// Storage side of a bank change (its chord bank) or of a patch apply
+// (router defaults, patch, chord bank, DREAM SysEx), staged for the
+// next commit. Returns <0 if the file cannot be loaded.
+int patch_system_prepare_chords(void);
+int patch_system_prepare_apply(void);
+
+// Make the staged state live: buffer swap, staged routes and chord bank.
+// Never touches storage, for the task that owns router and chord bank.
+void patch_system_commit(void);
+
+// Remember bank and patch on SD (after a successful apply)
+int patch_system_save_state(void);
+
 const patch_manager_t* patch_system_get(void);
 
 #ifdef __cplusplus
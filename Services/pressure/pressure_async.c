@@ -0,0 +1,202 @@
+#include "Services/pressure/pressure_async.h"
+#include "Services/pressure/pressure_i2c.h"
+#include "Hal/i2c_hal.h"
+#include <string.h>
+
+// Latency uses the DWT cycle counter; the host test (Tests/test_pressure_async.c)
+// provides its own clock with the same two macros.
+#ifndef PRESSURE_ASYNC_CYCLES
+#include "main.h"
+#define PRESSURE_ASYNC_CYCLES() (DWT->CYCCNT)
+#define PRESSURE_ASYNC_CYCLES_ENABLE() do { \
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; \
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; \
+  } while (0)
+#endif
+
+typedef enum {
+  PA_IDLE = 0,   // waiting for the next interval
+  PA_CONV,       // conversion command in flight
+  PA_WAIT,       // sensor converting
+  PA_READ,       // data read in flight
+  PA_BACKOFF     // failed transfer, retry on the next tick
+} pa_state_t;
+
+static pa_state_t s_state;
+static uint8_t s_attempt;
+static uint32_t s_next_ms;     // next sample due
+static uint32_t s_phase_ms;    // start of the current transfer / wait
+static uint32_t s_t0_cyc;      // conversion start, for latency
+static uint32_t s_us;          // microsecond clock, see clock_us()
+static uint32_t s_us_cyc;      // cycle count at s_us
+static uint8_t s_buf[4];
+static const uint8_t k_conv_cmd = PRESSURE_XGZP_CMD_CONV;
+
+static pressure_sample_t s_sample;
+static uint8_t s_have_sample;
+static pressure_async_stats_t s_stats;
+static uint64_t s_lat_sum_us;
+
+static int due(uint32_t now, uint32_t t){ return (int32_t)(now - t) >= 0; }
+
+// Microseconds from the cycle counter. Advanced on every tick, so the
+// 32-bit cycle count (25 s at 168 MHz) never wraps between two updates.
+static uint32_t clock_us(void){
+  uint32_t mhz = SystemCoreClock / 1000000u;
+  uint32_t d = (PRESSURE_ASYNC_CYCLES() - s_us_cyc) / mhz;
+  s_us_cyc += d * mhz;
+  s_us += d;
+  return s_us;
+}
+
+uint32_t pressure_async_now_us(void){ return clock_us(); }
+
+void pressure_async_init(void){
+  s_state = PA_IDLE;
+  s_attempt = 0;
+  s_next_ms = 0;
+  s_have_sample = 0;
+  memset(&s_sample, 0, sizeof(s_sample));
+  pressure_async_reset_stats();
+  PRESSURE_ASYNC_CYCLES_ENABLE();
+  s_us = 0;
+  s_us_cyc = PRESSURE_ASYNC_CYCLES();
+}
+
+void pressure_async_reset_stats(void){
+  memset(&s_stats, 0, sizeof(s_stats));
+  s_lat_sum_us = 0;
+}
+
+void pressure_async_get_stats(pressure_async_stats_t* out){
+  if(out) *out = s_stats;
+}
+
+int pressure_async_get(pressure_sample_t* out){
+  if(!out || !s_have_sample) return -1;
+  *out = s_sample;
+  return 0;
+}
+
+static void start_read(const pressure_cfg_t* c, uint32_t now);
+static void fail(const pressure_cfg_t* c, int timeout);
+
+// First transfer of a sample (or of a retry): conversion command for the
+// XGZP, straight to the data read for generic sensors.
+static void start_sample(const pressure_cfg_t* c, uint32_t now){
+  s_phase_ms = now;
+  if(c->type != PRESS_TYPE_XGZP6847D_24B){
+    start_read(c, now);
+    return;
+  }
+  if(i2c_hal_write_it(c->i2c_bus, c->addr7, PRESSURE_XGZP_REG_CMD, &k_conv_cmd, 1) != 0){
+    fail(c, 0);
+    return;
+  }
+  s_state = PA_CONV;
+}
+
+static void start_read(const pressure_cfg_t* c, uint32_t now){
+  s_phase_ms = now;
+  if(i2c_hal_read_it(c->i2c_bus, c->addr7, pressure_data_reg(), s_buf, pressure_data_len()) != 0){
+    fail(c, 0);
+    return;
+  }
+  s_state = PA_READ;
+}
+
+// A transfer failed (err) or hung (timeout). Retry from the conversion
+// start; a hung bus or the last failed retry gets a bus recovery instead.
+static void fail(const pressure_cfg_t* c, int timeout){
+  if(timeout) s_stats.timeouts++;
+  else s_stats.errors++;
+
+  if(timeout || s_attempt >= PRESSURE_ASYNC_RETRIES){
+    (void)i2c_hal_recover(c->i2c_bus);
+    s_stats.recoveries++;
+  }
+  s_state = PA_BACKOFF;
+}
+
+static void publish(const pressure_cfg_t* c, uint32_t now){
+  int32_t v = 0;
+  if(pressure_decode(s_buf, &v) != 0) return;
+  // Back-date to the completion interrupt: this poll sees it up to a tick later
+  uint32_t t_us = clock_us();
+  int32_t ago = (int32_t)(s_us_cyc - i2c_hal_done_cycles(c->i2c_bus));
+  if(ago > 0) t_us -= (uint32_t)ago / (SystemCoreClock / 1000000u);
+  s_sample.value = v;
+  s_sample.t_ms = now;
+  s_sample.t_us = t_us;
+  s_sample.seq++;
+  s_have_sample = 1;
+
+  uint32_t us = (PRESSURE_ASYNC_CYCLES() - s_t0_cyc) / (SystemCoreClock / 1000000u);
+  s_stats.samples++;
+  s_stats.lat_last_us = us;
+  if(us > s_stats.lat_max_us) s_stats.lat_max_us = us;
+  s_lat_sum_us += us;
+  s_stats.lat_avg_us = (uint32_t)(s_lat_sum_us / s_stats.samples);
+}
+
+int pressure_async_tick(uint32_t now_ms){
+  const pressure_cfg_t* c = pressure_get_cfg();
+  (void)clock_us();
+  if(!c->enable && s_state == PA_IDLE) return 0;
+
+  switch(s_state){
+    case PA_IDLE:
+      if(!due(now_ms, s_next_ms)) return 0;
+      {
+        // Keep the cadence after a late sample, restart it after a long gap
+        uint32_t iv = c->interval_ms ? c->interval_ms : 5;
+        s_next_ms += iv;
+        if(due(now_ms, s_next_ms)) s_next_ms = now_ms + iv;
+      }
+      s_attempt = 0;
+      s_t0_cyc = PRESSURE_ASYNC_CYCLES();
+      start_sample(c, now_ms);
+      return 0;
+
+    case PA_CONV: {
+      int r = i2c_hal_poll(c->i2c_bus);
+      if(r == 0){
+        s_state = PA_WAIT;
+        s_phase_ms = now_ms;
+      } else if(r < 0){
+        fail(c, 0);
+      } else if(due(now_ms, s_phase_ms + PRESSURE_ASYNC_TIMEOUT_MS)){
+        fail(c, 1);
+      }
+      return 0;
+    }
+
+    case PA_WAIT:
+      if(due(now_ms, s_phase_ms + PRESSURE_ASYNC_CONV_MS)) start_read(c, now_ms);
+      return 0;
+
+    case PA_READ: {
+      int r = i2c_hal_poll(c->i2c_bus);
+      if(r == 0){
+        s_state = PA_IDLE;
+        publish(c, now_ms);
+        return 1;
+      }
+      if(r < 0) fail(c, 0);
+      else if(due(now_ms, s_phase_ms + PRESSURE_ASYNC_TIMEOUT_MS)) fail(c, 1);
+      return 0;
+    }
+
+    case PA_BACKOFF:
+      if(s_attempt >= PRESSURE_ASYNC_RETRIES || !c->enable){
+        s_stats.dropped++;
+        s_state = PA_IDLE;
+        return 0;
+      }
+      s_attempt++;
+      s_stats.retries++;
+      start_sample(c, now_ms);
+      return 0;
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Non-blocking pressure sensor driver.
+//
+// pressure_async_tick() runs one step of a state machine per call (1 ms main
+// task tick): every cfg interval_ms it starts a conversion (XGZP6847D: CMD
+// register write), waits PRESSURE_ASYNC_CONV_MS, reads the data registers
+// and publishes a timestamped sample. All bus traffic is interrupt driven
+// (i2c_hal_*_it), so no call blocks. Failed transfers are retried up to
+// PRESSURE_ASYNC_RETRIES times; a timeout or the last failed retry runs
+// i2c_hal_recover() and drops that sample.
+
+#ifndef PRESSURE_ASYNC_CONV_MS
+#define PRESSURE_ASYNC_CONV_MS 2      // XGZP6847D single conversion (OSR 1024)
+#endif
+#ifndef PRESSURE_ASYNC_TIMEOUT_MS
+#define PRESSURE_ASYNC_TIMEOUT_MS 3   // one transfer; 4 bytes at 100 kHz take < 0.5 ms
+#endif
+#ifndef PRESSURE_ASYNC_RETRIES
+#define PRESSURE_ASYNC_RETRIES 2
+#endif
+
+#define PRESSURE_XGZP_REG_CMD  0x30
+#define PRESSURE_XGZP_CMD_CONV 0x0A   // combined pressure+temperature conversion
+
+typedef struct {
+  int32_t value;   // same units as pressure_read_once(): signed Pa (XGZP) or raw
+  uint32_t t_ms;   // tick at which the data read completed
+  uint32_t t_us;   // when the data read completed (interrupt), on the driver's
+                   // free running microsecond clock (cycle counter based)
+  uint32_t seq;    // incremented for each published sample
+} pressure_sample_t;
+
+typedef struct {
+  uint32_t samples;       // published samples
+  uint32_t errors;        // failed transfers (NACK, bus error, refused start)
+  uint32_t timeouts;      // transfers that did not complete in PRESSURE_ASYNC_TIMEOUT_MS
+  uint32_t retries;
+  uint32_t recoveries;    // i2c_hal_recover() runs
+  uint32_t dropped;       // samples given up after the last retry
+  uint32_t lat_last_us;   // conversion start to published sample
+  uint32_t lat_max_us;
+  uint32_t lat_avg_us;
+} pressure_async_stats_t;
+
+void pressure_async_init(void);
+
+// Returns 1 when a new sample was published, 0 otherwise.
+int pressure_async_tick(uint32_t now_ms);
+
+// Latest sample: 0 on success, -1 if none was published yet.
+int pressure_async_get(pressure_sample_t* out);
+
+// The microsecond clock sample t_us is on, read now. Wraps at 2^32.
+uint32_t pressure_async_now_us(void);
+
+void pressure_async_get_stats(pressure_async_stats_t* out);
+void pressure_async_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,6 +14,19 @@
 
 static pressure_cfg_t g_cfg;
 
+// Fixed-point conversion constants, derived from g_cfg in pressure_set_cfg().
+// The M4F has no double precision FPU, so the per-sample transfer functions
+// run in integer math:
+//  - generic scale, exactly: scale == g_scale_m / 2^g_scale_sh (float
+//    mantissa and exponent), so (raw - offset) * scale matches the double
+//    product bit for bit while |raw - offset| < 2^29
+//  - 12-bit center map: 4095 / (pmax - pmin) as a Q32 reciprocal, with a
+//    remainder check so the result is the exactly rounded quotient
+static int32_t g_scale_m;
+static uint8_t g_scale_sh;
+static int32_t g_map_span;   // |pmax - pmin|, at least 1
+static int64_t g_map_k;      // round(4095 * 2^32 / g_map_span)
+
 void pressure_defaults(pressure_cfg_t* c){
   if(!c) return;
   memset(c,0,sizeof(*c));
@@ -100,23 +113,112 @@ int pressure_load_sd(pressure_cfg_t* c, const char* path){
 #endif
 }
 
-void pressure_set_cfg(const pressure_cfg_t* c){ if(c) g_cfg=*c; else pressure_defaults(&g_cfg); }
+// n / 2^sh, rounded half away from zero like llround()
+static int64_t shr_round(int64_t n, uint8_t sh){
+  if(sh==0) return n;
+  int64_t h = (int64_t)1 << (sh-1);
+  return (n >= 0) ? ((n + h) >> sh) : -((-n + h) >> sh);
+}
+
+static int32_t sat_s32(int64_t v){
+  if(v > INT32_MAX) return INT32_MAX;
+  if(v < INT32_MIN) return INT32_MIN;
+  return (int32_t)v;
+}
+
+static void fix_update(void){
+  int e = 0;
+  float m = frexpf(g_cfg.scale, &e);   // scale = m * 2^e, 0.5 <= |m| < 1
+  int32_t mi = (int32_t)ldexpf(m, 24);
+  int sh = 24 - e;
+  if(sh < 0){                          // scale >= 2^24: no sensible config, saturate
+    mi = (g_cfg.scale < 0.0f) ? -(1 << 30) : (1 << 30);
+    sh = 0;
+  }
+  while(sh > 0 && mi != 0 && (mi & 1) == 0){ mi >>= 1; sh--; }
+  if(sh > 62) { mi = 0; sh = 0; }     // denormal scale
+  g_scale_m = mi;
+  g_scale_sh = (uint8_t)sh;
+
+  int64_t span = (int64_t)g_cfg.pmax_pa - (int64_t)g_cfg.pmin_pa;
+  if(span < 0) span = -span;
+  if(span == 0) span = 1;
+  if(span > INT32_MAX) span = INT32_MAX;
+  g_map_span = (int32_t)span;
+  g_map_k = (int64_t)((((uint64_t)4095 << 32) + (uint64_t)span / 2) / (uint64_t)span);
+}
+
+// (value - offset) * scale, rounded
+static int64_t scale_apply(int32_t value){
+  int64_t n = ((int64_t)value - (int64_t)g_cfg.offset) * (int64_t)g_scale_m;
+  return shr_round(n, g_scale_sh);
+}
+
+// Pa -> 0..4095 over PMIN..PMAX (reversed when PMAX < PMIN)
+static uint16_t map_center(int32_t pa){
+  int64_t d = (g_cfg.pmax_pa >= g_cfg.pmin_pa)
+            ? (int64_t)pa - (int64_t)g_cfg.pmin_pa
+            : (int64_t)g_cfg.pmin_pa - (int64_t)pa;
+  if(d <= 0) return 0;
+  if(d >= g_map_span) return 4095;
+  // Estimate from the reciprocal, then settle on round(d * 4095 / span)
+  // exactly: u is the largest value with u * 2 * span <= 2 * d * 4095 + span
+  int64_t u = (d * g_map_k) >> 32;
+  int64_t n = 2 * d * 4095 + g_map_span;
+  int64_t s2 = 2 * (int64_t)g_map_span;
+  while(u > 0 && u * s2 > n) u--;
+  while((u + 1) * s2 <= n) u++;
+  return (uint16_t)u;
+}
+
+void pressure_set_cfg(const pressure_cfg_t* c){
+  if(c) g_cfg=*c; else pressure_defaults(&g_cfg);
+  fix_update();
+}
 const pressure_cfg_t* pressure_get_cfg(void){ return &g_cfg; }
 
 // XGZP6847D absolute decode (Pa) from datasheet equation
+static int32_t xgzp_decode_abs(const pressure_cfg_t* c, const uint8_t* b){
+  uint32_t sum = ((uint32_t)b[0]<<16) | ((uint32_t)b[1]<<8) | (uint32_t)b[2];
+  int32_t ssum = (sum < 8388608UL) ? (int32_t)sum : (int32_t)(sum - 16777216UL);
+
+  const int64_t span = (int64_t)c->pmax_pa - (int64_t)c->pmin_pa;
+  // Here we interpret PMIN/PMAX as the *configured physical range*, used only for scaling.
+  // For absolute reading, we still use PMIN/PMAX because the chip's transfer function expects them.
+  // p = ssum / 2^21 * span + pmin, as one exact Q21 sum (|ssum| < 2^23, |span| < 2^32)
+  int64_t q21 = (int64_t)ssum * span + ((int64_t)c->pmin_pa << 21);
+  return sat_s32(shr_round(q21, 21));
+}
+
 static int xgzp_read_pa_abs(const pressure_cfg_t* c, int32_t* out_pa_abs){
   uint8_t b[3]={0,0,0};
   int r = i2c_hal_read(c->i2c_bus, c->addr7, 0x04, b, 3, 10);
   if(r!=0) return r;
+  *out_pa_abs = xgzp_decode_abs(c, b);
+  return 0;
+}
 
-  uint32_t sum = ((uint32_t)b[0]<<16) | ((uint32_t)b[1]<<8) | (uint32_t)b[2];
-  int32_t ssum = (sum < 8388608UL) ? (int32_t)sum : (int32_t)(sum - 16777216UL);
+uint8_t pressure_data_reg(void){
+  return (g_cfg.type == PRESS_TYPE_XGZP6847D_24B) ? 0x04 : g_cfg.reg;
+}
 
-  const int32_t span = (c->pmax_pa - c->pmin_pa);
-  // Here we interpret PMIN/PMAX as the *configured physical range*, used only for scaling.
-  // For absolute reading, we still use PMIN/PMAX because the chip's transfer function expects them.
-  double p = ((double)ssum / (double)(1<<21)) * (double)span + (double)c->pmin_pa;
-  *out_pa_abs = (int32_t)llround(p);
+uint8_t pressure_data_len(void){
+  return (g_cfg.type == PRESS_TYPE_XGZP6847D_24B) ? 3 : 2;
+}
+
+int pressure_decode(const uint8_t* b, int32_t* out_value){
+  if(!b || !out_value) return -1;
+  const pressure_cfg_t* c=&g_cfg;
+
+  if(c->type == PRESS_TYPE_XGZP6847D_24B){
+    *out_value = xgzp_decode_abs(c, b) - c->atm0_pa; // Pa signed
+    return 0;
+  }
+  if(c->type==PRESS_TYPE_GENERIC_S16BE){
+    *out_value = (int32_t)(int16_t)((b[0]<<8)|b[1]);
+  } else {
+    *out_value = (int32_t)(uint16_t)((b[0]<<8)|b[1]);
+  }
   return 0;
 }
 
@@ -145,8 +247,7 @@ int pressure_read_pa(int32_t* out_pa_signed){
   int32_t raw=0;
   int r = pressure_read_once(&raw);
   if(r!=0) return r;
-  double p = ((double)(raw - c->offset)) * (double)c->scale;
-  *out_pa_signed = (int32_t)llround(p);
+  *out_pa_signed = sat_s32(scale_apply(raw));
   return 0;
 }
 
@@ -162,17 +263,7 @@ int pressure_read_once(int32_t* out_value){
   uint8_t b[2]={0,0};
   int r = i2c_hal_read(c->i2c_bus, c->addr7, c->reg, b, 2, 10);
   if(r!=0) return r;
-
-  int32_t raw=0;
-  if(c->type==PRESS_TYPE_GENERIC_S16BE){
-    int16_t s = (int16_t)((b[0]<<8)|b[1]);
-    raw = (int32_t)s;
-  } else {
-    uint16_t u = (uint16_t)((b[0]<<8)|b[1]);
-    raw = (int32_t)u;
-  }
-  *out_value = raw;
-  return 0;
+  return pressure_decode(b, out_value);
 }
 
 static uint16_t clamp_u12(int32_t y, uint16_t mn, uint16_t mx){
@@ -186,30 +277,16 @@ static uint16_t clamp_u12(int32_t y, uint16_t mn, uint16_t mx){
 uint16_t pressure_mid_raw(void){
   const pressure_cfg_t* c=&g_cfg;
   if(c->type != PRESS_TYPE_XGZP6847D_24B) return 2048;
-  double pmin = (double)c->pmin_pa;
-  double pmax = (double)c->pmax_pa;
-  if(pmax == pmin) return 2048;
-  double t = (0.0 - pmin) / (pmax - pmin);
-  double u = t * 4095.0;
-  int32_t mid = (int32_t)llround(u);
-  if(mid < 0) mid = 0;
-  if(mid > 4095) mid = 4095;
-  return (uint16_t)mid;
+  if(c->pmax_pa == c->pmin_pa) return 2048;
+  return map_center(0);
 }
 
 uint16_t pressure_to_12b(int32_t value){
   const pressure_cfg_t* c=&g_cfg;
 
   if(c->type == PRESS_TYPE_XGZP6847D_24B && c->map_mode == PRESS_MAP_CENTER_0PA){
-    double p = (double)value;
-    double pmin = (double)c->pmin_pa;
-    double pmax = (double)c->pmax_pa;
-    if(pmax == pmin) pmax = pmin + 1.0;
-    double t = (p - pmin) / (pmax - pmin);
-    double u = t * 4095.0;
-    return clamp_u12((int32_t)llround(u), 0, 4095);
+    return map_center(value);
   }
 
-  double x = ((double)(value - c->offset)) * (double)c->scale;
-  return clamp_u12((int32_t)llround(x), c->clamp_min, c->clamp_max);
+  return clamp_u12(sat_s32(scale_apply(value)), c->clamp_min, c->clamp_max);
 }
@@ -53,6 +53,13 @@ int  pressure_read_pa(int32_t* out_pa_signed);
 // Reads absolute sensor pressure (Pa) before subtracting atm0_pa (XGZP only)
 int  pressure_read_pa_abs(int32_t* out_pa_abs);
 
+// Sensor data register/length read by pressure_read_once(), and the decoder
+// for those bytes (same units as pressure_read_once()). Used by the
+// non-blocking driver, see pressure_async.h.
+uint8_t pressure_data_reg(void);
+uint8_t pressure_data_len(void);
+int  pressure_decode(const uint8_t* b, int32_t* out_value);
+
 uint16_t pressure_to_12b(int32_t value); // value is Pa for XGZP, else raw
 uint16_t pressure_mid_raw(void);         // raw position corresponding to 0 Pa (for center mapping)
 
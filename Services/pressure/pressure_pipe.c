@@ -0,0 +1,101 @@
+#include "Services/pressure/pressure_pipe.h"
+#include <string.h>
+
+#define CIC_ORDER 3u
+
+// log2(PRESSURE_PIPE_DECIM^3): CIC gain, removed with a shift
+#define CIC_SHIFT (CIC_ORDER * (uint32_t)__builtin_ctz(PRESSURE_PIPE_DECIM))
+
+// Group delay of the CIC in input samples: ORDER * (DECIM - 1) / 2
+#define CIC_DELAY_US ((CIC_ORDER * (PRESSURE_PIPE_DECIM - 1u) * PRESSURE_PIPE_PERIOD_US) / 2u)
+
+_Static_assert((PRESSURE_PIPE_DECIM & (PRESSURE_PIPE_DECIM - 1u)) == 0u,
+               "PRESSURE_PIPE_DECIM must be a power of two");
+
+// Integrators and combs wrap modulo 2^32 by design: the output is exact as
+// long as it fits, |Pa - first input| * DECIM^3 < 2^31 (4 MPa at DECIM 8).
+static uint32_t s_integ[CIC_ORDER];
+static uint32_t s_comb[CIC_ORDER];
+static uint32_t s_phase;
+static int32_t s_ref;        // first input, subtracted from everything
+
+// Band-pass state, Q8 (|Pa - first input| < 2^23)
+static int32_t s_base;
+static int32_t s_lp1, s_lp2;
+static uint8_t s_primed;
+
+static int32_t s_expr_pa, s_shake_pa;
+static uint32_t s_expr_t, s_shake_t;
+static uint8_t s_have_expr, s_have_shake;
+
+static pressure_pipe_cb_t s_expr_cb;
+static pressure_pipe_cb_t s_shake_cb;
+
+void pressure_pipe_init(void){
+  memset(s_integ, 0, sizeof(s_integ));
+  memset(s_comb, 0, sizeof(s_comb));
+  s_phase = 0;
+  s_base = s_lp1 = s_lp2 = 0;
+  s_ref = 0;
+  s_primed = 0;
+  s_have_expr = s_have_shake = 0;
+}
+
+void pressure_pipe_set_expr_cb(pressure_pipe_cb_t cb){ s_expr_cb = cb; }
+void pressure_pipe_set_shake_cb(pressure_pipe_cb_t cb){ s_shake_cb = cb; }
+
+int pressure_pipe_get_expr(int32_t* pa, uint32_t* t_us){
+  if(!s_have_expr) return -1;
+  if(pa) *pa = s_expr_pa;
+  if(t_us) *t_us = s_expr_t;
+  return 0;
+}
+
+int pressure_pipe_get_shake(int32_t* pa, uint32_t* t_us){
+  if(!s_have_shake) return -1;
+  if(pa) *pa = s_shake_pa;
+  if(t_us) *t_us = s_shake_t;
+  return 0;
+}
+
+static void cic_push(int32_t pa, uint32_t t_us){
+  uint32_t v = (uint32_t)(pa - s_ref);
+  for(uint32_t i = 0; i < CIC_ORDER; i++){
+    s_integ[i] += v;
+    v = s_integ[i];
+  }
+  if(++s_phase < PRESSURE_PIPE_DECIM) return;
+  s_phase = 0;
+
+  for(uint32_t i = 0; i < CIC_ORDER; i++){
+    uint32_t d = v - s_comb[i];
+    s_comb[i] = v;
+    v = d;
+  }
+  s_expr_pa = ((int32_t)v >> CIC_SHIFT) + s_ref;
+  s_expr_t = t_us - CIC_DELAY_US;
+  s_have_expr = 1;
+  if(s_expr_cb) s_expr_cb(s_expr_pa, s_expr_t);
+}
+
+static void bp_push(int32_t pa, uint32_t t_us){
+  int32_t x = (pa - s_ref) * 256;
+  s_base += (x - s_base) >> PRESSURE_PIPE_HP_SHIFT;
+  s_lp1 += ((x - s_base) - s_lp1) >> PRESSURE_PIPE_LP_SHIFT;
+  s_lp2 += (s_lp1 - s_lp2) >> PRESSURE_PIPE_LP_SHIFT;
+  s_shake_pa = s_lp2 / 256;
+  s_shake_t = t_us;
+  s_have_shake = 1;
+  if(s_shake_cb) s_shake_cb(s_shake_pa, s_shake_t);
+}
+
+void pressure_pipe_push(int32_t pa, uint32_t t_us){
+  if(!s_primed){
+    // Filters run relative to the first sample, so both streams start
+    // settled instead of ramping up from 0 Pa
+    s_ref = pa;
+    s_primed = 1;
+  }
+  cic_push(pa, t_us);
+  bp_push(pa, t_us);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Oversampled pressure front end.
+//
+// pressure_pipe_push() is clocked at a fixed PRESSURE_PIPE_RATE_HZ with the
+// latest sensor value (held between sensor conversions) and splits it into
+// two streams:
+//  - expression: 3rd order CIC decimator by PRESSURE_PIPE_DECIM, gain
+//    normalized, one sample per PRESSURE_PIPE_DECIM inputs. The timestamp
+//    is compensated for the CIC group delay.
+//  - shake: every input, band-passed (one-pole high-pass removing the
+//    bellows pressure itself, two one-pole low-passes above the tremolo
+//    band) for zero-crossing detection.
+// Timestamps are in microseconds.
+
+#ifndef PRESSURE_PIPE_RATE_HZ
+#define PRESSURE_PIPE_RATE_HZ 1000u
+#endif
+#ifndef PRESSURE_PIPE_DECIM
+#define PRESSURE_PIPE_DECIM 8u       // 125 Hz expression stream, power of two
+#endif
+#ifndef PRESSURE_PIPE_HP_SHIFT
+#define PRESSURE_PIPE_HP_SHIFT 7u    // fs / (2 pi 2^7) = 1.2 Hz
+#endif
+#ifndef PRESSURE_PIPE_LP_SHIFT
+#define PRESSURE_PIPE_LP_SHIFT 3u    // fs / (2 pi 2^3) = 20 Hz, applied twice
+#endif
+
+#define PRESSURE_PIPE_PERIOD_US (1000000u / PRESSURE_PIPE_RATE_HZ)
+
+typedef void (*pressure_pipe_cb_t)(int32_t pa, uint32_t t_us);
+
+void pressure_pipe_init(void);
+
+// One input sample (Pa, or raw for generic sensors) taken at t_us
+void pressure_pipe_push(int32_t pa, uint32_t t_us);
+
+void pressure_pipe_set_expr_cb(pressure_pipe_cb_t cb);
+void pressure_pipe_set_shake_cb(pressure_pipe_cb_t cb);
+
+// Latest output of each stream: 0 on success, -1 if none yet
+int pressure_pipe_get_expr(int32_t* pa, uint32_t* t_us);
+int pressure_pipe_get_shake(int32_t* pa, uint32_t* t_us);
+
+#ifdef __cplusplus
+}
+#endif
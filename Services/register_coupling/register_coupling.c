@@ -4,6 +4,7 @@
  */
 
 #include "Services/register_coupling/register_coupling.h"
+#include "Services/tick_sched/tick_sched.h"
 #include <string.h>
 
 static const char* register_names[] = {
@@ -46,6 +47,7 @@ typedef struct {
 
 static reg_coupling_config_t g_coupling[REG_COUPLING_MAX_TRACKS];
 static uint32_t g_tick_counter = 0;
+static uint8_t g_sched = 0;  // driven by tick_sched: its clock is newer between dispatches
 static reg_coupling_output_cb_t g_output_callback = NULL;
 
 /**
@@ -74,7 +76,8 @@ void reg_coupling_set_register(uint8_t track, accordion_register_t reg) {
     if (cfg->smooth_transition && reg != cfg->current_register) {
         cfg->previous_register = cfg->current_register;
         cfg->transitioning = 1;
-        cfg->transition_start_ms = g_tick_counter;
+        cfg->transition_start_ms = g_sched ? tick_sched_now() : g_tick_counter;
+        tick_sched_wake(TICK_SVC_REG_COUPLING, cfg->transition_time_ms);
     }
     
     cfg->current_register = reg;
@@ -216,10 +219,12 @@ const char* reg_coupling_get_register_name(accordion_register_t reg) {
 }
 
 /**
- * @brief Called every 1ms for smooth transitions
+ * @brief End finished transitions
+ * @return ms until the next one ends, TICK_SCHED_IDLE when none is running
  */
-void reg_coupling_tick_1ms(void) {
-    g_tick_counter++;
+static uint32_t service_at(uint32_t now) {
+    uint32_t next = TICK_SCHED_IDLE;
+    g_tick_counter = now;
     
     // Handle smooth transitions
     for (uint8_t t = 0; t < REG_COUPLING_MAX_TRACKS; t++) {
@@ -229,9 +234,27 @@ void reg_coupling_tick_1ms(void) {
             uint32_t elapsed = g_tick_counter - cfg->transition_start_ms;
             if (elapsed >= cfg->transition_time_ms) {
                 cfg->transitioning = 0;
+            } else if (cfg->transition_time_ms - elapsed < next) {
+                next = cfg->transition_time_ms - elapsed;
             }
         }
     }
+    return next;
+}
+
+/**
+ * @brief Called every 1ms for smooth transitions
+ */
+void reg_coupling_tick_1ms(void) {
+    (void)service_at(g_tick_counter + 1);
+}
+
+/**
+ * @brief tick_sched handler
+ */
+uint32_t reg_coupling_service(uint32_t now_ms) {
+    g_sched = 1;
+    return service_at(now_ms);
 }
 
 /**
@@ -161,6 +161,12 @@ const char* reg_coupling_get_register_name(accordion_register_t reg);
  */
 void reg_coupling_tick_1ms(void);
 
+/**
+ * @brief tick_sched handler (TICK_SVC_REG_COUPLING)
+ * @return ms until the running transition ends, TICK_SCHED_IDLE when none
+ */
+uint32_t reg_coupling_service(uint32_t now_ms);
+
 /**
  * @brief Callback for outputting notes with reed set info
  * @param track Track index
@@ -98,7 +98,7 @@ static inline uint8_t scheduler_running(void) {
 // ONLY safe to call when scheduler is running!
 static inline void ensure_mutex(void) {
   if (g_router_mutex == NULL && scheduler_running()) {
-    const osMutexAttr_t attr = { .name = "router" };
+    const osMutexAttr_t attr = { .name = "router", .attr_bits = osMutexPrioInherit };
     g_router_mutex = osMutexNew(&attr);
   }
 }
@@ -40,6 +40,43 @@ static uint8_t* g_din_buffer = NULL;
 // change notification flags
 static uint8_t* g_din_changed = NULL;
 
+#ifndef SRIO_MAX_DIN_BYTES
+#define SRIO_MAX_DIN_BYTES 16  // Maximum DIN chain size (128 inputs)
+#endif
+#ifndef SRIO_MAX_DOUT_BYTES
+#define SRIO_MAX_DOUT_BYTES 32 // Maximum DOUT chain size (256 outputs)
+#endif
+
+#if SRIO_SCAN_DMA
+// Timer driven scan: one full-duplex DMA transfer per scan clocks DOUT out of
+// s_tx[s_tx_front] and DIN into s_rx[s_rx_idx]. DOUT updates are staged in
+// the other tx buffer and swapped in at the start of the next scan; DIN
+// frames alternate so a finished frame is never overwritten by the next scan.
+#define SRIO_CHAIN_BYTES (SRIO_MAX_DOUT_BYTES > SRIO_MAX_DIN_BYTES ? SRIO_MAX_DOUT_BYTES : SRIO_MAX_DIN_BYTES)
+
+static uint8_t s_tx[2][SRIO_CHAIN_BYTES];
+static uint8_t s_rx[2][SRIO_CHAIN_BYTES];
+static volatile uint8_t s_tx_front;      // tx buffer used by the scans
+static volatile uint8_t s_dout_writing;  // srio_write_dout() is filling the back buffer
+static volatile uint8_t s_dout_pending;  // back buffer holds new DOUT values
+static uint8_t s_rx_idx;
+static uint16_t s_xfer_len;              // max(din_bytes, dout_bytes)
+
+static volatile uint8_t s_scan_running;
+static volatile uint8_t s_scan_busy;
+static uint16_t s_scan_div = 1;
+static uint16_t s_scan_ctr;
+static volatile uint32_t s_scan_seq;     // completed scans
+static uint32_t s_read_seq;              // last scan returned by srio_read_din()
+static volatile uint32_t s_scan_overruns;
+static volatile uint32_t s_scan_errors;
+static void (*s_scan_cb)(void);
+static const uint8_t* (*s_dout_src)(void);  // per-scan DOUT frame (BCM)
+
+static DMA_HandleTypeDef s_hdma_rx;
+static DMA_HandleTypeDef s_hdma_tx;
+#endif
+
 #if MODULE_ENABLE_AINSER64
 extern SPI_HandleTypeDef hspi3;
 #endif
@@ -68,12 +105,84 @@ static void srio_set_spi_mode(SPI_HandleTypeDef* hspi, uint32_t cpol, uint32_t c
   __HAL_SPI_ENABLE(hspi);
 }
 
+// Pulse RC1 (595 RCLK) and RC2 (165 /PL) together: 1->0->1
+// MidiCore pulses BOTH RC_PIN (RC1/RCLK) and RC_PIN2 (RC2//PL) together
+static void srio_rc_pulse(void)
+{
+  if (g.dout_rclk_port) {
+    HAL_GPIO_WritePin(g.dout_rclk_port, g.dout_rclk_pin, GPIO_PIN_RESET);  // RC1 LOW
+  }
+#if SRIO_DIN_PL_ACTIVE_LOW
+  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_RESET);  // RC2 active (LOW)
+#else
+  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_SET);    // RC2 active (HIGH)
+#endif
+
+  // delay disabled - the delay caused by HAL_GPIO_WritePin function calls is sufficient
+  // (MidiCore comment: "delay disabled - the delay caused by MIOS32_SPI_RC_PinSet function calls is sufficient")
+  // We add explicit NOPs for safety on faster MCUs
+  for (volatile uint16_t i = 0; i < 10; ++i) { __NOP(); }
+
+  // Release BOTH RC pins back to idle HIGH
+  if (g.dout_rclk_port) {
+    HAL_GPIO_WritePin(g.dout_rclk_port, g.dout_rclk_pin, GPIO_PIN_SET);    // RC1 HIGH
+  }
+#if SRIO_DIN_PL_ACTIVE_LOW
+  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_SET);     // RC2 idle (HIGH)
+#else
+  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_RESET);   // RC2 idle (LOW)
+#endif
+}
+
+// copy/or buffered DIN values/changed flags
+// Update internal DIN buffers with change detection (matches MidiCore exactly)
+static void srio_din_update(const uint8_t* in)
+{
+  if (!g_din || !g_din_buffer || !g_din_changed) return;
+
+  // STEP 1: ALWAYS copy buffered DIN values and detect changes (matches MIOS32)
+  // This must happen BEFORE debounce logic is applied
+  uint8_t any_change = 0;
+  for (uint8_t i = 0; i < g_num_sr; ++i) {
+    g_din_buffer[i] = in[i];
+    uint8_t change_mask = g_din[i] ^ g_din_buffer[i]; // these are the changed pins
+    g_din_changed[i] |= change_mask;
+    g_din[i] = g_din_buffer[i];
+    if (change_mask) {
+      any_change = 1;
+    }
+  }
+
+  // STEP 2: Start debounce counter if any change detected (matches MIOS32_SRIO_DebounceStart)
+  if (any_change && g_debounce_time) {
+    g_debounce_ctr = g_debounce_time;
+  }
+
+  // STEP 3: Apply debounce XOR trick if counter is active (matches MIOS32)
+  // As long as debounce counter is != 0, clear all "changed" flags to ignore button movements 
+  // at this time. In order to ensure, that a new final state of a button won't get lost, 
+  // the DIN values are XORed with the "changed" flags (yes, this idea is ill, but it works! :)
+  // Even the encoder handler (or others which are notified by the scan_finished_hook) still
+  // work properly, because they are clearing the appr. "changed" flags, so that the DIN
+  // values won't be touched by the XOR operation.
+  if (g_debounce_time && g_debounce_ctr) {
+    --g_debounce_ctr;
+    for (uint8_t i = 0; i < g_num_sr; ++i) {
+      g_din[i] ^= g_din_changed[i];
+      g_din_changed[i] = 0;
+    }
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Initializes SPI pins and peripheral
 // \param[in] cfg configuration structure
 // Based on MIOS32_SRIO_Init()
 /////////////////////////////////////////////////////////////////////////////
 void srio_init(const srio_config_t* cfg) {
+#if SRIO_SCAN_DMA
+  srio_scan_stop();
+#endif
   if (cfg) g = *cfg;
   g_inited = (g.hspi && g.din_pl_port && g.din_bytes) ? 1u : 0u;
 
@@ -105,6 +214,8 @@ void srio_init(const srio_config_t* cfg) {
   
   srio_set_dout_enable(1);
 
+  if (g.din_bytes > SRIO_MAX_DIN_BYTES) g.din_bytes = SRIO_MAX_DIN_BYTES;
+  if (g.dout_bytes > SRIO_MAX_DOUT_BYTES) g.dout_bytes = SRIO_MAX_DOUT_BYTES;
   g_num_sr = (uint8_t)g.din_bytes;
   
   // initial debounce time (debouncing disabled by default)
@@ -113,9 +224,6 @@ void srio_init(const srio_config_t* cfg) {
 
   // clear chains - use maximum size for static buffers
   // SRIO_DIN_BYTES is defined in srio_user_config.h when SRIO_ENABLE is set
-  #ifndef SRIO_MAX_DIN_BYTES
-  #define SRIO_MAX_DIN_BYTES 16  // Maximum DIN chain size (128 inputs)
-  #endif
   static uint8_t din[SRIO_MAX_DIN_BYTES];
   static uint8_t din_buffer[SRIO_MAX_DIN_BYTES];
   static uint8_t din_changed[SRIO_MAX_DIN_BYTES];
@@ -157,38 +265,30 @@ void srio_set_dout_enable(uint8_t enable) {
 int srio_read_din(uint8_t* out) {
   if (!g_inited || !out) return -1;
 
+#if SRIO_SCAN_DMA
+  if (s_scan_running) {
+    // DMA scan owns the chain: hand out the DIN state of the latest scan.
+    // The completion interrupt may update it while we copy, retry then.
+    uint32_t seq;
+    do {
+      seq = s_scan_seq;
+      memcpy(out, g_din, g_num_sr);
+    } while (seq != s_scan_seq);
+    if (seq == s_read_seq) return -3;  // no scan finished since the last call
+    s_read_seq = seq;
+    return 0;
+  }
+#endif
+
   // MidiCore Scan Sequence - matches MIOS32_SRIO_ScanStart() exactly
   
   // before first byte will be sent:
   // latch DIN registers by pulsing RCLK: 1->0->1
-  // MidiCore pulses BOTH RC_PIN (RC1/RCLK) and RC_PIN2 (RC2//PL) together
-  if (g.dout_rclk_port) {
-    HAL_GPIO_WritePin(g.dout_rclk_port, g.dout_rclk_pin, GPIO_PIN_RESET);  // RC1 LOW
-  }
-#if SRIO_DIN_PL_ACTIVE_LOW
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_RESET);  // RC2 active (LOW)
-#else
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_SET);    // RC2 active (HIGH)
-#endif
-  
-  // delay disabled - the delay caused by HAL_GPIO_WritePin function calls is sufficient
-  // (MidiCore comment: "delay disabled - the delay caused by MIOS32_SPI_RC_PinSet function calls is sufficient")
-  // We add explicit NOPs for safety on faster MCUs
-  for (volatile uint16_t i = 0; i < 10; ++i) { __NOP(); }
-  
-  // Release BOTH RC pins back to idle HIGH
-  if (g.dout_rclk_port) {
-    HAL_GPIO_WritePin(g.dout_rclk_port, g.dout_rclk_pin, GPIO_PIN_SET);    // RC1 HIGH
-  }
-#if SRIO_DIN_PL_ACTIVE_LOW
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_SET);     // RC2 idle (HIGH)
-#else
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_RESET);   // RC2 idle (LOW)
-#endif
+  srio_rc_pulse();
   
   // start bulk SPI transfer (matches MIOS32_SPI_TransferBlock behavior)
   // MidiCore uses DMA, we use blocking HAL - functionally equivalent for sync operation
-  static uint8_t dout_dummy[32] = {0};  // Dummy DOUT data for full-duplex SPI
+  static uint8_t dout_dummy[SRIO_MAX_DIN_BYTES] = {0};  // Dummy DOUT data for full-duplex SPI
   
   if (HAL_SPI_TransmitReceive(g.hspi, dout_dummy, out, g.din_bytes, 100) != HAL_OK) {
     return -2;
@@ -196,63 +296,9 @@ int srio_read_din(uint8_t* out) {
   
   // DMA callback equivalent - matches MIOS32_SRIO_DMA_Callback()
   // latch DOUT registers by pulsing RCLK: 1->0->1
-  if (g.dout_rclk_port) {
-    HAL_GPIO_WritePin(g.dout_rclk_port, g.dout_rclk_pin, GPIO_PIN_RESET);  // RC1 LOW
-  }
-#if SRIO_DIN_PL_ACTIVE_LOW
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_RESET);  // RC2 active (LOW)
-#else
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_SET);    // RC2 active (HIGH)
-#endif
-  
-  for (volatile uint16_t i = 0; i < 10; ++i) { __NOP(); }
-  
-  // Release BOTH RC pins back to idle HIGH
-  if (g.dout_rclk_port) {
-    HAL_GPIO_WritePin(g.dout_rclk_port, g.dout_rclk_pin, GPIO_PIN_SET);    // RC1 HIGH
-  }
-#if SRIO_DIN_PL_ACTIVE_LOW
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_SET);     // RC2 idle (HIGH)
-#else
-  HAL_GPIO_WritePin(g.din_pl_port, g.din_pl_pin, GPIO_PIN_RESET);   // RC2 idle (LOW)
-#endif
+  srio_rc_pulse();
   
-  // copy/or buffered DIN values/changed flags
-  // Update internal DIN buffers with change detection (matches MidiCore exactly)
-  if (g_din && g_din_buffer && g_din_changed) {
-    // STEP 1: ALWAYS copy buffered DIN values and detect changes (matches MIOS32)
-    // This must happen BEFORE debounce logic is applied
-    uint8_t any_change = 0;
-    for (uint8_t i = 0; i < g_num_sr; ++i) {
-      g_din_buffer[i] = out[i];
-      uint8_t change_mask = g_din[i] ^ g_din_buffer[i]; // these are the changed pins
-      g_din_changed[i] |= change_mask;
-      g_din[i] = g_din_buffer[i];
-      if (change_mask) {
-        any_change = 1;
-      }
-    }
-    
-    // STEP 2: Start debounce counter if any change detected (matches MIOS32_SRIO_DebounceStart)
-    if (any_change && g_debounce_time) {
-      g_debounce_ctr = g_debounce_time;
-    }
-    
-    // STEP 3: Apply debounce XOR trick if counter is active (matches MIOS32)
-    // As long as debounce counter is != 0, clear all "changed" flags to ignore button movements 
-    // at this time. In order to ensure, that a new final state of a button won't get lost, 
-    // the DIN values are XORed with the "changed" flags (yes, this idea is ill, but it works! :)
-    // Even the encoder handler (or others which are notified by the scan_finished_hook) still
-    // work properly, because they are clearing the appr. "changed" flags, so that the DIN
-    // values won't be touched by the XOR operation.
-    if (g_debounce_time && g_debounce_ctr) {
-      --g_debounce_ctr;
-      for (uint8_t i = 0; i < g_num_sr; ++i) {
-        g_din[i] ^= g_din_changed[i];
-        g_din_changed[i] = 0;
-      }
-    }
-  }
+  srio_din_update(out);
 
   return 0;
 }
@@ -261,6 +307,22 @@ int srio_write_dout(const uint8_t* in) {
   if (!g_inited || !in) return -1;
   if (!g.dout_rclk_port || !g.dout_bytes) return -1;
 
+#if SRIO_SCAN_DMA
+  if (s_scan_running) {
+    // Stage into the back buffer, the next scan clocks it out. The first
+    // bytes of a transfer longer than the DOUT chain fall off its end, so
+    // the DOUT values go last.
+    s_dout_writing = 1;
+    __DMB();
+    uint8_t back = (uint8_t)(s_tx_front ^ 1u);
+    memcpy(&s_tx[back][s_xfer_len - g.dout_bytes], in, g.dout_bytes);
+    s_dout_pending = 1;
+    __DMB();
+    s_dout_writing = 0;
+    return 0;
+  }
+#endif
+
   // Shift out to 595 chain.
   if (HAL_SPI_Transmit(g.hspi, (uint8_t*)in, g.dout_bytes, 10) != HAL_OK) return -2;
 
@@ -272,6 +334,167 @@ int srio_write_dout(const uint8_t* in) {
   return 0;
 }
 
+#if SRIO_SCAN_DMA
+/////////////////////////////////////////////////////////////////////////////
+// DMA scan (SPI2: RX = DMA1 Stream3, TX = DMA1 Stream4, channel 0)
+// Based on MIOS32_SRIO_ScanStart() and MIOS32_SRIO_DMA_Callback()
+/////////////////////////////////////////////////////////////////////////////
+
+static int srio_dma_init(void)
+{
+  if (!g.hspi || g.hspi->Instance != SPI2) return -1;
+
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  s_hdma_rx.Instance = DMA1_Stream3;
+  s_hdma_rx.Init.Channel = DMA_CHANNEL_0;
+  s_hdma_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  s_hdma_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+  s_hdma_rx.Init.MemInc = DMA_MINC_ENABLE;
+  s_hdma_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  s_hdma_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  s_hdma_rx.Init.Mode = DMA_NORMAL;
+  s_hdma_rx.Init.Priority = DMA_PRIORITY_LOW;
+  s_hdma_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+  if (HAL_DMA_Init(&s_hdma_rx) != HAL_OK) return -2;
+  __HAL_LINKDMA(g.hspi, hdmarx, s_hdma_rx);
+
+  s_hdma_tx.Instance = DMA1_Stream4;
+  s_hdma_tx.Init = s_hdma_rx.Init;
+  s_hdma_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  if (HAL_DMA_Init(&s_hdma_tx) != HAL_OK) return -2;
+  __HAL_LINKDMA(g.hspi, hdmatx, s_hdma_tx);
+
+  // Completion notifies tasks: keep it at a FreeRTOS-safe priority
+  HAL_NVIC_SetPriority(DMA1_Stream3_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+  HAL_NVIC_SetPriority(DMA1_Stream4_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream4_IRQn);
+  return 0;
+}
+
+void DMA1_Stream3_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&s_hdma_rx);
+}
+
+void DMA1_Stream4_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&s_hdma_tx);
+}
+
+int srio_scan_start(uint16_t period_ms)
+{
+  if (!g_inited) return -1;
+  if (s_scan_running) return 0;
+
+  static uint8_t s_dma_ready = 0;
+  if (!s_dma_ready) {
+    int rc = srio_dma_init();
+    if (rc < 0) return rc;
+    s_dma_ready = 1;
+  }
+
+  s_xfer_len = (g.din_bytes > g.dout_bytes) ? g.din_bytes : g.dout_bytes;
+  memset(s_tx, 0, sizeof(s_tx));
+  s_tx_front = 0;
+  s_dout_pending = 0;
+  s_dout_writing = 0;
+  s_rx_idx = 0;
+  s_scan_busy = 0;
+  s_scan_div = period_ms ? period_ms : 1u;
+  s_scan_ctr = 0;
+  s_read_seq = s_scan_seq;
+  s_scan_running = 1;
+  return 0;
+}
+
+void srio_scan_stop(void)
+{
+  if (!s_scan_running) return;
+  s_scan_running = 0;
+
+  // A chain transfer takes well under 1 ms
+  uint32_t t0 = HAL_GetTick();
+  while (s_scan_busy && (HAL_GetTick() - t0) < 5u) {}
+  if (s_scan_busy) {
+    (void)HAL_SPI_Abort(g.hspi);
+    s_scan_busy = 0;
+  }
+}
+
+void srio_scan_timer_isr(void)
+{
+  if (!s_scan_running) return;
+  if (++s_scan_ctr < s_scan_div) return;
+  s_scan_ctr = 0;
+
+  if (s_scan_busy) {
+    s_scan_overruns++;
+    return;
+  }
+  if (s_dout_src) {
+    // DOUT frame changes every scan (brightness bitplanes)
+    const uint8_t* f = s_dout_src();
+    if (f) memcpy(&s_tx[s_tx_front][s_xfer_len - g.dout_bytes], f, g.dout_bytes);
+  } else if (s_dout_pending && !s_dout_writing) {
+    s_tx_front ^= 1u;
+    s_dout_pending = 0;
+  }
+
+  // latch DIN registers (and the DOUT values of the previous scan)
+  srio_rc_pulse();
+
+  s_scan_busy = 1;
+  if (HAL_SPI_TransmitReceive_DMA(g.hspi, s_tx[s_tx_front], s_rx[s_rx_idx], s_xfer_len) != HAL_OK) {
+    s_scan_busy = 0;
+    s_scan_errors++;
+  }
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+  if (hspi != g.hspi || !s_scan_busy) return;
+
+  // latch DOUT registers by pulsing RCLK: 1->0->1
+  srio_rc_pulse();
+
+  srio_din_update(s_rx[s_rx_idx]);
+  s_rx_idx ^= 1u;
+  s_scan_seq++;
+  s_scan_busy = 0;
+
+  if (s_scan_cb) s_scan_cb();
+}
+
+void srio_spi_error_isr(SPI_HandleTypeDef* hspi)
+{
+  if (hspi != g.hspi || !s_scan_busy) return;
+  s_scan_errors++;
+  s_scan_busy = 0;
+}
+
+void srio_set_scan_callback(void (*cb)(void))
+{
+  s_scan_cb = cb;
+}
+
+int srio_set_dout_source(const uint8_t* (*next_frame)(void), uint16_t frame_bytes)
+{
+  if (next_frame && frame_bytes < g.dout_bytes) return -1;
+  s_dout_src = next_frame;
+  return 0;
+}
+
+void srio_get_scan_stats(srio_scan_stats_t* out)
+{
+  if (!out) return;
+  out->scans = s_scan_seq;
+  out->overruns = s_scan_overruns;
+  out->errors = s_scan_errors;
+}
+#endif
+
 uint8_t srio_din_get(uint16_t sr)
 {
   if (!g_din || sr >= g_num_sr) return 0xFFu;
@@ -281,8 +504,13 @@ uint8_t srio_din_get(uint16_t sr)
 uint8_t srio_din_changed_get_and_clear(uint16_t sr, uint8_t mask)
 {
   if (!g_din_changed || sr >= g_num_sr) return 0u;
+  // The scan-complete interrupt ORs new changes in: read and clear with
+  // interrupts masked so none is lost between the two
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
   uint8_t changed = g_din_changed[sr] & mask;
   g_din_changed[sr] &= (uint8_t)(~mask);
+  __set_PRIMASK(primask);
   return changed;
 }
 
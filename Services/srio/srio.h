@@ -33,6 +33,7 @@
 
 // Include main.h for portable STM32 HAL (F4/F7/H7 compatibility)
 #include "main.h"
+#include "Config/module_config.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -82,6 +83,53 @@ int srio_read_din(uint8_t* out);
 //! \return 0 on success, < 0 on errors
 int srio_write_dout(const uint8_t* in);
 
+#if SRIO_SCAN_DMA
+//! Starts the timer driven DMA scan
+//!
+//! From now on every period_ms-th call of srio_scan_timer_isr() latches the
+//! chains and starts one full-duplex DMA transfer: DOUT is clocked out and
+//! DIN clocked in together, and the completion interrupt updates the DIN
+//! state and changed flags (with debouncing, as the blocking scan does).
+//! While the scan runs, srio_read_din() copies the DIN state of the latest
+//! scan and returns -3 if no scan finished since the previous call, and
+//! srio_write_dout() stages the values for the next scan. Neither blocks.
+//! srio_write_dout() must be called from a single task.
+//! \param[in] period_ms scan period in timer ticks (1 ms)
+//! \return 0 on success, -1 if not initialized or the SPI is not SPI2,
+//!         -2 on DMA setup errors
+int srio_scan_start(uint16_t period_ms);
+
+//! Stops the DMA scan (waits for the transfer in flight) and returns to
+//! blocking transfers. srio_init() calls it.
+void srio_scan_stop(void);
+
+//! Scan timer hook, called from the 1 ms TIM6 interrupt
+void srio_scan_timer_isr(void);
+
+//! SPI error hook, called from HAL_SPI_ErrorCallback (ignores other SPIs)
+void srio_spi_error_isr(SPI_HandleTypeDef* hspi);
+
+//! Sets a function called from the DMA completion interrupt after each scan
+//! (e.g. to wake the task that consumes DIN changes). NULL disables it.
+void srio_set_scan_callback(void (*cb)(void));
+
+//! Sets a function called from the scan timer interrupt before each scan
+//! that returns the DOUT bytes to clock out (e.g. the next BCM bitplane,
+//! see Services/dout/dout_bcm.h). While set, srio_write_dout() values are
+//! not used. NULL returns to srio_write_dout().
+//! \param[in] frame_bytes size of the returned frames
+//! \return 0 on success, -1 if frames are shorter than the DOUT chain
+int srio_set_dout_source(const uint8_t* (*next_frame)(void), uint16_t frame_bytes);
+
+typedef struct {
+  uint32_t scans;     //!< completed DMA scans
+  uint32_t overruns;  //!< timer ticks skipped because a scan was still running
+  uint32_t errors;    //!< failed DMA starts or SPI errors
+} srio_scan_stats_t;
+
+void srio_get_scan_stats(srio_scan_stats_t* out);
+#endif
+
 //! Enables or disables DOUT output (/OE control)
 //! \param[in] enable 1 to enable outputs, 0 to disable (high-Z)
 void srio_set_dout_enable(uint8_t enable);
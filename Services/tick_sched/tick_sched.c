@@ -0,0 +1,146 @@
+#include "Services/tick_sched/tick_sched.h"
+#include <string.h>
+
+typedef struct {
+  tick_sched_fn_t fn;
+  uint32_t due;
+  int8_t pos;           // index in s_heap, -1 when idle
+} svc_t;
+
+static svc_t s_svc[TICK_SVC_COUNT];
+static tick_sched_stats_t s_stats[TICK_SVC_COUNT];
+static uint8_t s_heap[TICK_SVC_COUNT];
+static uint8_t s_heap_n;
+static uint32_t s_now;
+static uint8_t s_in_run;
+static uint32_t s_runs, s_idle_runs;
+
+// Wrap-safe "deadline a is before deadline b"
+static inline int before(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+static void heap_set(uint8_t i, uint8_t id) {
+  s_heap[i] = id;
+  s_svc[id].pos = (int8_t)i;
+}
+
+static void sift_up(uint8_t i) {
+  uint8_t id = s_heap[i];
+  while (i > 0) {
+    uint8_t p = (uint8_t)((i - 1u) / 2u);
+    if (!before(s_svc[id].due, s_svc[s_heap[p]].due)) break;
+    heap_set(i, s_heap[p]);
+    i = p;
+  }
+  heap_set(i, id);
+}
+
+static void sift_down(uint8_t i) {
+  uint8_t id = s_heap[i];
+  for (;;) {
+    uint8_t c = (uint8_t)(2u * i + 1u);
+    if (c >= s_heap_n) break;
+    if (c + 1u < s_heap_n && before(s_svc[s_heap[c + 1u]].due, s_svc[s_heap[c]].due)) c++;
+    if (!before(s_svc[s_heap[c]].due, s_svc[id].due)) break;
+    heap_set(i, s_heap[c]);
+    i = c;
+  }
+  heap_set(i, id);
+}
+
+static uint8_t heap_pop(void) {
+  uint8_t id = s_heap[0];
+  s_svc[id].pos = -1;
+  if (--s_heap_n > 0) {
+    s_heap[0] = s_heap[s_heap_n];
+    sift_down(0);
+  }
+  return id;
+}
+
+// Schedule id at due, keeping an earlier pending deadline
+static void schedule_at(uint8_t id, uint32_t due) {
+  svc_t* s = &s_svc[id];
+  if (s->pos < 0) {
+    s->due = due;
+    s_heap[s_heap_n] = id;
+    sift_up(s_heap_n++);
+  } else if (before(due, s->due)) {
+    s->due = due;
+    sift_up((uint8_t)s->pos);
+  }
+}
+
+void tick_sched_init(uint32_t now_ms) {
+  memset(s_svc, 0, sizeof(s_svc));
+  memset(s_stats, 0, sizeof(s_stats));
+  for (uint8_t i = 0; i < TICK_SVC_COUNT; i++) s_svc[i].pos = -1;
+  s_heap_n = 0;
+  s_now = now_ms;
+  s_in_run = 0;
+  s_runs = s_idle_runs = 0;
+}
+
+int tick_sched_register(tick_svc_t id, const char* name, tick_sched_fn_t fn) {
+  if ((unsigned)id >= TICK_SVC_COUNT || !fn) return -1;
+  s_svc[id].fn = fn;
+  s_stats[id].name = name;
+  return 0;
+}
+
+void tick_sched_wake(tick_svc_t id, uint32_t delay_ms) {
+  if ((unsigned)id >= TICK_SVC_COUNT || !s_svc[id].fn) return;
+  s_stats[id].wakes++;
+  // A handler waking a service from inside tick_sched_run() gets the next
+  // tick, so a run always terminates
+  if (delay_ms == 0 && s_in_run) delay_ms = 1;
+  schedule_at((uint8_t)id, s_now + delay_ms);
+}
+
+uint32_t tick_sched_run(uint32_t now_ms) {
+  s_now = now_ms;
+  s_runs++;
+  if (s_heap_n == 0 || before(now_ms, s_svc[s_heap[0]].due)) {
+    s_idle_runs++;
+    return 0;
+  }
+
+  uint32_t n = 0;
+  s_in_run = 1;
+  while (s_heap_n > 0 && !before(now_ms, s_svc[s_heap[0]].due)) {
+    uint8_t id = heap_pop();
+    tick_sched_stats_t* st = &s_stats[id];
+    uint32_t late = now_ms - s_svc[id].due;
+    if (late > st->late_max_ms) st->late_max_ms = late;
+    st->dispatches++;
+    n++;
+
+    uint32_t next = s_svc[id].fn(now_ms);
+    if (next != TICK_SCHED_IDLE) schedule_at(id, now_ms + (next ? next : 1u));
+  }
+  s_in_run = 0;
+  return n;
+}
+
+uint32_t tick_sched_now(void) {
+  return s_now;
+}
+
+int tick_sched_get_stats(tick_svc_t id, tick_sched_stats_t* out) {
+  if ((unsigned)id >= TICK_SVC_COUNT || !out) return -1;
+  *out = s_stats[id];
+  return 0;
+}
+
+void tick_sched_get_totals(uint32_t* runs, uint32_t* idle_runs) {
+  if (runs) *runs = s_runs;
+  if (idle_runs) *idle_runs = s_idle_runs;
+}
+
+void tick_sched_reset_stats(void) {
+  for (uint8_t i = 0; i < TICK_SVC_COUNT; i++) {
+    s_stats[i].dispatches = 0;
+    s_stats[i].wakes = 0;
+    s_stats[i].late_max_ms = 0;
+  }
+  s_runs = s_idle_runs = 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Deadline scheduler for the 1 ms time-based services.
+//
+// Each service registers a handler that runs the work due at now_ms and
+// returns how many ms until it needs to run again (TICK_SCHED_IDLE when it
+// has nothing pending). Deadlines live in a binary min-heap, so
+// tick_sched_run() costs one compare on a tick where nothing is due and
+// idle services are never called. Modules call tick_sched_wake() when new
+// work arrives (note in, envelope trigger, setting change); the handler
+// then computes its real deadline.
+//
+// Runs in the main task: register, wake and run must not be called from
+// interrupts or other tasks.
+
+#define TICK_SCHED_IDLE 0xFFFFFFFFu
+
+typedef enum {
+  TICK_SVC_CC_SMOOTHER = 0,
+  TICK_SVC_LFO,
+  TICK_SVC_MIDI_DELAY,
+  TICK_SVC_NOTE_REPEAT,
+  TICK_SVC_ENVELOPE_CC,
+  TICK_SVC_GATE_TIME,
+  TICK_SVC_BELLOWS,
+  TICK_SVC_REG_COUPLING,
+  TICK_SVC_COUNT
+} tick_svc_t;
+
+// Runs work due at now_ms; returns ms until the next deadline or TICK_SCHED_IDLE
+typedef uint32_t (*tick_sched_fn_t)(uint32_t now_ms);
+
+typedef struct {
+  const char* name;
+  uint32_t dispatches;  // handler calls
+  uint32_t wakes;       // tick_sched_wake() calls
+  uint32_t late_max_ms; // worst dispatch delay past the deadline
+} tick_sched_stats_t;
+
+void tick_sched_init(uint32_t now_ms);
+
+// Returns 0 on success, -1 on bad id or NULL handler. The service starts
+// idle; wake it if it may already have work.
+int tick_sched_register(tick_svc_t id, const char* name, tick_sched_fn_t fn);
+
+// Run the service no later than delay_ms from now (an earlier deadline is
+// kept). Ignored for services that are not registered.
+void tick_sched_wake(tick_svc_t id, uint32_t delay_ms);
+
+// Dispatch every service whose deadline has passed. Returns the number of
+// handlers called.
+uint32_t tick_sched_run(uint32_t now_ms);
+
+// Time of the last tick_sched_run(): the clock services use to timestamp
+// events that arrive between dispatches.
+uint32_t tick_sched_now(void);
+
+int tick_sched_get_stats(tick_svc_t id, tick_sched_stats_t* out);  // 0 on success, -1 on bad id
+void tick_sched_get_totals(uint32_t* runs, uint32_t* idle_runs);   // ticks, ticks with no dispatch
+void tick_sched_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
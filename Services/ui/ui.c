@@ -22,7 +22,10 @@
 #endif
 #include "Services/ui/ui_state.h"
 #include "Services/ui/chord_cfg.h"
+#include "Services/looper/looper.h"
 #include "Hal/oled_ssd1322/oled_ssd1322.h"
+#include "main.h"
+#include "cmsis_os2.h"
 #include <string.h>
 #include <stdio.h>
 static char s_status_line[22] = {0};
@@ -36,6 +39,87 @@ void ui_set_status_line(const char* line) {
 static ui_page_t g_page = UI_PAGE_LOOPER;
 static uint32_t g_ms = 0;
 static uint32_t g_last_flush = 0;
+
+// Cooperative mode renders every 20 ms but only flushes every 100 ms to keep
+// the bit-bang transfer out of most main-task ticks. Task mode flushes every frame.
+static uint32_t g_flush_interval_ms = 100;
+
+// ---- Redraw invalidation ----
+// A frame only re-renders what one of the page's sources invalidated: input
+// (handled here), looper changes, MIDI monitor appends, an animation timer,
+// or ui_invalidate() from other modules. Unchanged frames skip rendering.
+#define UI_HEADER_H 12
+#define UI_IDLE_REFRESH_MS 1000u  // backstop for values changed outside the UI (CLI, SysEx)
+
+// Render timing uses the DWT cycle counter; host builds (Tests/ui_host)
+// provide their own clock with the same two macros.
+#ifndef UI_CYCLE_COUNTER
+#define UI_CYCLE_COUNTER() (DWT->CYCCNT)
+#define UI_CYCLE_COUNTER_ENABLE() do { \
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; \
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; \
+  } while (0)
+#endif
+
+#define UI_SRC_LOOPER   0x01u  // track state/mute/generation, transport, scene
+#define UI_SRC_MIDI_MON 0x02u  // MIDI monitor captured a message
+
+typedef struct {
+  const char* tag;     // short name for header and CLI
+  uint8_t sources;     // UI_SRC_* bits that invalidate the page body
+  uint8_t own_header;  // page clears the screen and draws its own header
+  uint16_t anim_ms;    // periodic redraw for moving content (0 = none)
+} ui_page_info_t;
+
+static const ui_page_info_t k_pages[UI_PAGE_COUNT] = {
+  [UI_PAGE_LOOPER]       = { "LOOP",  UI_SRC_LOOPER,   1, 0 },
+  [UI_PAGE_LOOPER_TL]    = { "TIME",  UI_SRC_LOOPER,   1, 40 },   // playhead
+  [UI_PAGE_LOOPER_PR]    = { "PIANO", UI_SRC_LOOPER,   1, 0 },
+  [UI_PAGE_SONG]         = { "SONG",  UI_SRC_LOOPER,   1, 0 },
+  [UI_PAGE_MIDI_MONITOR] = { "MMON",  UI_SRC_MIDI_MON, 1, 0 },
+  [UI_PAGE_SYSEX]        = { "SYSX",  0,               1, 250 },  // transfer status
+  [UI_PAGE_CONFIG]       = { "CONF",  0,               1, 0 },
+  [UI_PAGE_LIVEFX]       = { "LFXC",  0,               1, 0 },
+  [UI_PAGE_RHYTHM]       = { "RHYT",  0,               1, 40 },   // live timing feedback
+  [UI_PAGE_HUMANIZER]    = { "HUMN",  UI_SRC_LOOPER,   1, 0 },
+  [UI_PAGE_AUTOMATION]   = { "AUTO",  UI_SRC_LOOPER,   1, 0 },
+  [UI_PAGE_ROUTER]       = { "UI",    0,               0, 0 },
+  [UI_PAGE_PATCH]        = { "UI",    0,               0, 0 },
+  [UI_PAGE_OLED_TEST]    = { "TEST",  0,               0, 20 },   // FPS test
+};
+
+static uint8_t g_dirty = UI_DIRTY_ALL;          // set by input handlers (UI context)
+static volatile uint32_t g_req_gen[2];          // ui_invalidate() from any task: header, body
+static uint32_t g_req_seen[2];
+static ui_page_t g_drawn_page = UI_PAGE_COUNT;
+static uint32_t g_looper_sig = 0;
+static uint32_t g_last_render = 0;
+
+static ui_page_stats_t g_page_stats[UI_PAGE_COUNT];
+static uint32_t g_frames = 0;
+static uint32_t g_skipped = 0;
+
+// Task mode: input from the input service is queued and handled back on the
+// main task (ui_process_input), which owns the looper/LiveFX/config state
+// the page handlers change. Handlers and rendering (UiTask) share the page
+// state under g_page_mutex; the main task only try-locks it and leaves the
+// events queued while a frame is being drawn.
+#define UI_INPUT_QUEUE_LEN 32u
+
+typedef struct {
+  uint8_t type;   // 0 = button, 1 = encoder
+  uint8_t id;
+  int8_t value;   // pressed (button) or delta (encoder)
+  uint8_t reserved;
+} ui_input_evt_t;
+
+static osMessageQueueId_t g_input_q = NULL;
+static volatile uint32_t g_input_dropped = 0;
+static osMutexId_t g_page_mutex;
+
+static void ui_handle_button(uint8_t id, uint8_t pressed);
+static void ui_handle_encoder(int8_t delta);
+
 static uint8_t g_chord_mode = 0;
 static chord_bank_t g_chord_bank;
 
@@ -46,7 +130,25 @@ static uint8_t g_combo_active = 0; // Visual feedback: 1 when B5 held for combin
 static char g_bank_label[24] = "Bank";
 static char g_patch_label[24] = "Patch";
 
+// The labels are written by the patch code (main task) and read by the
+// renderer (UiTask in task mode): both sides copy under this mutex
+static osMutexId_t g_label_mutex;
+
+static void label_lock(void) {
+  if (osKernelGetState() != osKernelRunning) return;
+  if (g_label_mutex == NULL) {
+    const osMutexAttr_t attr = { .name = "ui_label", .attr_bits = osMutexPrioInherit };
+    g_label_mutex = osMutexNew(&attr);
+  }
+  if (g_label_mutex) osMutexAcquire(g_label_mutex, osWaitForever);
+}
+
+static void label_unlock(void) {
+  if (osKernelGetState() == osKernelRunning && g_label_mutex) osMutexRelease(g_label_mutex);
+}
+
 void ui_set_patch_status(const char* bank, const char* patch) {
+  label_lock();
   if (bank && bank[0]) {
     strncpy(g_bank_label, bank, sizeof(g_bank_label)-1);
     g_bank_label[sizeof(g_bank_label)-1] = 0;
@@ -55,14 +157,73 @@ void ui_set_patch_status(const char* bank, const char* patch) {
     strncpy(g_patch_label, patch, sizeof(g_patch_label)-1);
     g_patch_label[sizeof(g_patch_label)-1] = 0;
   }
+  label_unlock();
+  ui_invalidate(UI_DIRTY_HEADER);
+}
+
+void ui_invalidate(uint8_t regions) {
+  if (regions & UI_DIRTY_HEADER) g_req_gen[0]++;
+  if (regions & UI_DIRTY_BODY) g_req_gen[1]++;
 }
 
 void ui_init(void) {
+  // Cycle counter for per-page render time (left running, never reset here)
+  UI_CYCLE_COUNTER_ENABLE();
+
   ui_gfx_set_fb(oled_framebuffer(), OLED_W, OLED_H);
   oled_clear();
   oled_flush();
 }
 
+int ui_enable_task_mode(uint32_t frame_ms) {
+  if (!g_page_mutex) {
+    const osMutexAttr_t attr = { .name = "ui_page", .attr_bits = osMutexPrioInherit };
+    g_page_mutex = osMutexNew(&attr);
+    if (!g_page_mutex) return -1;
+  }
+  if (!g_input_q) {
+    const osMessageQueueAttr_t attr = { .name = "ui_input" };
+    g_input_q = osMessageQueueNew(UI_INPUT_QUEUE_LEN, sizeof(ui_input_evt_t), &attr);
+    if (!g_input_q) return -1;
+  }
+  g_flush_interval_ms = frame_ms;
+  return 0;
+}
+
+void ui_on_button(uint8_t id, uint8_t pressed) {
+  if (g_input_q) {
+    ui_input_evt_t ev = { .type = 0, .id = id, .value = (int8_t)pressed, .reserved = 0 };
+    if (osMessageQueuePut(g_input_q, &ev, 0, 0) != osOK) g_input_dropped++;
+    return;
+  }
+  ui_handle_button(id, pressed);
+}
+
+void ui_on_encoder(int8_t delta) {
+  if (g_input_q) {
+    ui_input_evt_t ev = { .type = 1, .id = 0, .value = delta, .reserved = 0 };
+    if (osMessageQueuePut(g_input_q, &ev, 0, 0) != osOK) g_input_dropped++;
+    return;
+  }
+  ui_handle_encoder(delta);
+}
+
+uint32_t ui_process_input(void) {
+  if (!g_input_q) return 0;
+  if (osMutexAcquire(g_page_mutex, 0) != osOK) return 0;  // frame in progress: next tick
+  uint32_t n = 0;
+  ui_input_evt_t ev;
+  while (osMessageQueueGet(g_input_q, &ev, NULL, 0) == osOK) {
+    if (ev.type == 0) ui_handle_button(ev.id, (uint8_t)ev.value);
+    else ui_handle_encoder(ev.value);
+    n++;
+  }
+  osMutexRelease(g_page_mutex);
+  return n;
+}
+
+uint32_t ui_get_input_dropped(void) { return g_input_dropped; }
+
 void ui_set_page(ui_page_t p) { if (p < UI_PAGE_COUNT) { g_page = p; ui_state_mark_dirty(); } }
 ui_page_t ui_get_page(void) { return g_page; }
 
@@ -73,9 +234,12 @@ int ui_reload_chord_bank(const char* path) {
   const char* p = (path && path[0]) ? path : "/cfg/chord_bank.ngc";
   return chord_bank_load(&g_chord_bank, p);
 }
+void ui_set_chord_bank(const chord_bank_t* b) { if (b) g_chord_bank = *b; }
 void ui_set_chord_mode(uint8_t en) { g_chord_mode = en ? 1 : 0; ui_state_mark_dirty(); }
 
-void ui_on_button(uint8_t id, uint8_t pressed) {
+static void ui_handle_button(uint8_t id, uint8_t pressed) {
+  g_dirty |= UI_DIRTY_ALL;  // page state and the [B5] combo indicator
+
   // Update button state for combined key detection
   if (id < 10) {
     g_button_state[id] = pressed ? 1 : 0;
@@ -164,33 +328,6 @@ void ui_on_button(uint8_t id, uint8_t pressed) {
     return;
   }
 
-
-// Header (bank/patch + page)
-ui_gfx_rect(0, 0, OLED_W, 12, 0); // clear header band (black)
-char line1[64];
-const char* page = (g_page == UI_PAGE_LOOPER) ? "LOOP" :
-                   (g_page == UI_PAGE_LOOPER_TL) ? "TIME" :
-                   (g_page == UI_PAGE_LOOPER_PR) ? "PIANO" :
-                   (g_page == UI_PAGE_SONG) ? "SONG" :
-                   (g_page == UI_PAGE_MIDI_MONITOR) ? "MMON" :
-                   (g_page == UI_PAGE_SYSEX) ? "SYSX" :
-                   (g_page == UI_PAGE_CONFIG) ? "CONF" :
-                   (g_page == UI_PAGE_LIVEFX) ? "LFXC" :
-                   (g_page == UI_PAGE_RHYTHM) ? "RHYT" :
-                   (g_page == UI_PAGE_AUTOMATION) ? "AUTO" :
-#if MODULE_ENABLE_LFO && MODULE_ENABLE_HUMANIZER
-                   (g_page == UI_PAGE_HUMANIZER) ? "HUMN" :
-#endif
-                   (g_page == UI_PAGE_OLED_TEST) ? "TEST" :
-                   "UI";
-// Bank | Patch | Page (with combo indicator)
-if (g_combo_active) {
-  snprintf(line1, sizeof(line1), "%s:%s  %s [B5]", g_bank_label, g_patch_label, page);
-} else {
-  snprintf(line1, sizeof(line1), "%s:%s  %s", g_bank_label, g_patch_label, page);
-}
-ui_gfx_text(0, 2, line1, 15);
-
   switch (g_page) {
     case UI_PAGE_LOOPER: ui_page_looper_on_button(id, pressed); break;
     case UI_PAGE_LOOPER_TL: ui_page_looper_timeline_on_button(id, pressed); break;
@@ -213,28 +350,9 @@ ui_gfx_text(0, 2, line1, 15);
     default: break;
   }
 }
-void ui_on_encoder(int8_t delta) {
 
-// Header (bank/patch + page)
-ui_gfx_rect(0, 0, OLED_W, 12, 0); // clear header band (black)
-char line1[64];
-const char* page = (g_page == UI_PAGE_LOOPER) ? "LOOP" :
-                   (g_page == UI_PAGE_LOOPER_TL) ? "TIME" :
-                   (g_page == UI_PAGE_LOOPER_PR) ? "PIANO" :
-                   (g_page == UI_PAGE_SONG) ? "SONG" :
-                   (g_page == UI_PAGE_MIDI_MONITOR) ? "MMON" :
-                   (g_page == UI_PAGE_SYSEX) ? "SYSX" :
-                   (g_page == UI_PAGE_CONFIG) ? "CONF" :
-                   (g_page == UI_PAGE_LIVEFX) ? "LFXC" :
-                   (g_page == UI_PAGE_RHYTHM) ? "RHYT" :
-#if MODULE_ENABLE_LFO && MODULE_ENABLE_HUMANIZER
-                   (g_page == UI_PAGE_HUMANIZER) ? "HUMN" :
-#endif
-                   (g_page == UI_PAGE_OLED_TEST) ? "TEST" :
-                   "UI";
-// Bank | Patch | Page
-snprintf(line1, sizeof(line1), "%s:%s  %s", g_bank_label, g_patch_label, page);
-ui_gfx_text(0, 2, line1, 15);
+static void ui_handle_encoder(int8_t delta) {
+  g_dirty |= UI_DIRTY_BODY;
 
   switch (g_page) {
     case UI_PAGE_LOOPER: ui_page_looper_on_encoder(delta); break;
@@ -257,32 +375,23 @@ ui_gfx_text(0, 2, line1, 15);
   }
 }
 
-void ui_tick_20ms(void) {
-  g_ms += 20;
-  ui_state_tick_20ms();
-
-
-// Header (bank/patch + page)
-ui_gfx_rect(0, 0, OLED_W, 12, 0); // clear header band (black)
-char line1[64];
-const char* page = (g_page == UI_PAGE_LOOPER) ? "LOOP" :
-                   (g_page == UI_PAGE_LOOPER_TL) ? "TIME" :
-                   (g_page == UI_PAGE_LOOPER_PR) ? "PIANO" :
-                   (g_page == UI_PAGE_SONG) ? "SONG" :
-                   (g_page == UI_PAGE_MIDI_MONITOR) ? "MMON" :
-                   (g_page == UI_PAGE_SYSEX) ? "SYSX" :
-                   (g_page == UI_PAGE_CONFIG) ? "CONF" :
-                   (g_page == UI_PAGE_LIVEFX) ? "LFXC" :
-                   (g_page == UI_PAGE_RHYTHM) ? "RHYT" :
-#if MODULE_ENABLE_LFO && MODULE_ENABLE_HUMANIZER
-                   (g_page == UI_PAGE_HUMANIZER) ? "HUMN" :
-#endif
-                   (g_page == UI_PAGE_OLED_TEST) ? "TEST" :
-                   "UI";
-// Bank | Patch | Page
-snprintf(line1, sizeof(line1), "%s:%s  %s", g_bank_label, g_patch_label, page);
-ui_gfx_text(0, 2, line1, 15);
+// Header (bank/patch + page), only visible on pages that leave the band to ui.c
+static void ui_draw_header(void) {
+  ui_gfx_rect(0, 0, OLED_W, UI_HEADER_H, 0); // clear header band (black)
+  char line1[64];
+  const char* page = k_pages[g_page].tag;
+  // Bank | Patch | Page (with combo indicator)
+  label_lock();
+  if (g_combo_active) {
+    snprintf(line1, sizeof(line1), "%s:%s  %s [B5]", g_bank_label, g_patch_label, page);
+  } else {
+    snprintf(line1, sizeof(line1), "%s:%s  %s", g_bank_label, g_patch_label, page);
+  }
+  label_unlock();
+  ui_gfx_text(0, 2, line1, 15);
+}
 
+static void ui_render_page(void) {
   switch (g_page) {
     case UI_PAGE_LOOPER: ui_page_looper_render(g_ms); break;
     case UI_PAGE_LOOPER_TL: ui_page_looper_timeline_render(g_ms); break;
@@ -304,9 +413,105 @@ ui_gfx_text(0, 2, line1, 15);
 #endif
     default: break;
   }
+}
 
-  if ((g_ms - g_last_flush) >= 100) {
+// Everything the looper-backed pages display that can change without UI
+// input: per-track edit generation, state and mute, transport and scene.
+// All getters are lock-free reads.
+static uint32_t ui_looper_signature(void) {
+  looper_transport_t tp;
+  looper_get_transport(&tp);
+  uint32_t sig = (uint32_t)tp.bpm | ((uint32_t)tp.ts_num << 16) | ((uint32_t)tp.ts_den << 24);
+  sig = sig * 31u + looper_get_current_scene();
+  for (uint8_t t = 0; t < LOOPER_TRACKS; t++) {
+    sig = sig * 31u + looper_get_generation(t);
+    sig = sig * 31u + (uint32_t)looper_get_state(t);
+    sig = sig * 31u + looper_is_track_muted(t);
+  }
+  return sig;
+}
+
+// Collect invalidations for the active page; returns UI_DIRTY_* bits
+static uint8_t ui_collect_dirty(const ui_page_info_t* pi) {
+  uint8_t dirty = g_dirty;
+  g_dirty = 0;
+
+  if (g_page != g_drawn_page) {
+    g_drawn_page = g_page;
+    dirty = UI_DIRTY_ALL;
+  }
+  uint32_t req = g_req_gen[0];
+  if (req != g_req_seen[0]) { g_req_seen[0] = req; dirty |= UI_DIRTY_HEADER; }
+  req = g_req_gen[1];
+  if (req != g_req_seen[1]) { g_req_seen[1] = req; dirty |= UI_DIRTY_BODY; }
+
+  if (pi->sources & UI_SRC_LOOPER) {
+    uint32_t sig = ui_looper_signature();
+    if (sig != g_looper_sig) { g_looper_sig = sig; dirty |= UI_DIRTY_BODY; }
+  }
+  if ((pi->sources & UI_SRC_MIDI_MON) && ui_page_midi_monitor_needs_redraw(g_ms)) {
+    dirty |= UI_DIRTY_BODY;
+  }
+
+  uint32_t since = g_ms - g_last_render;
+  if ((pi->anim_ms && since >= pi->anim_ms) || since >= UI_IDLE_REFRESH_MS) {
+    dirty |= UI_DIRTY_BODY;
+  }
+
+  // Pages that clear the screen overwrite ui.c's header band anyway
+  if (pi->own_header) dirty &= (uint8_t)~UI_DIRTY_HEADER;
+  return dirty;
+}
+
+void ui_tick_20ms(void) {
+  if (g_page_mutex) osMutexAcquire(g_page_mutex, osWaitForever);
+  g_ms += 20;
+  ui_state_tick_20ms();
+  g_frames++;
+
+  const ui_page_info_t* pi = &k_pages[g_page];
+  uint8_t dirty = ui_collect_dirty(pi);
+  ui_page_stats_t* st = &g_page_stats[g_page];
+
+  if (dirty & UI_DIRTY_HEADER) {
+    ui_draw_header();
+    if (!(dirty & UI_DIRTY_BODY)) st->header_only++;
+  }
+  if (dirty & UI_DIRTY_BODY) {
+    uint32_t t0 = UI_CYCLE_COUNTER();
+    ui_render_page();
+    uint32_t us = (UI_CYCLE_COUNTER() - t0) / (SystemCoreClock / 1000000u);
+    st->renders++;
+    st->total_us += us;
+    if (us > st->max_us) st->max_us = us;
+    g_last_render = g_ms;
+  }
+  if (!dirty) g_skipped++;
+  if (g_page_mutex) osMutexRelease(g_page_mutex);
+
+  if ((g_ms - g_last_flush) >= g_flush_interval_ms) {
     oled_flush();
     g_last_flush = g_ms;
   }
 }
+
+int ui_get_page_stats(ui_page_t p, ui_page_stats_t* out) {
+  if (p >= UI_PAGE_COUNT || !out) return -1;
+  *out = g_page_stats[p];
+  return 0;
+}
+
+void ui_get_frame_stats(uint32_t* frames, uint32_t* skipped) {
+  if (frames) *frames = g_frames;
+  if (skipped) *skipped = g_skipped;
+}
+
+void ui_reset_stats(void) {
+  memset(g_page_stats, 0, sizeof(g_page_stats));
+  g_frames = 0;
+  g_skipped = 0;
+}
+
+const char* ui_get_page_tag(ui_page_t p) {
+  return (p < UI_PAGE_COUNT) ? k_pages[p].tag : "UI";
+}
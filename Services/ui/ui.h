@@ -27,12 +27,47 @@ void ui_tick_20ms(void);
 void ui_set_page(ui_page_t p);
 ui_page_t ui_get_page(void);
 
+// Switch to task mode (UiTask, see App/ui_task.c): UiTask calls
+// ui_tick_20ms(), ui_on_button/ui_on_encoder only queue the event and the
+// main task handles it in ui_process_input(). Flushes every frame_ms.
+// Returns 0 on success, -1 if the input queue or page lock cannot be created.
+int ui_enable_task_mode(uint32_t frame_ms);
+
 void ui_on_button(uint8_t id, uint8_t pressed);
 void ui_on_encoder(int8_t delta);
 
+// Task mode, main task: handle queued input unless a frame is being drawn
+// (never blocks). Returns the number of events handled (always 0 in
+// cooperative mode).
+uint32_t ui_process_input(void);
+uint32_t ui_get_input_dropped(void);  // Events lost because the queue was full
+
 // Status header
 void ui_set_patch_status(const char* bank, const char* patch);
 
+// ---- Redraw invalidation ----
+// ui_tick_20ms() skips rendering unless something invalidated the screen.
+// Input, page changes, looper changes, MIDI monitor appends and page
+// animation timers are tracked by ui.c; other modules that change what a
+// page shows call ui_invalidate(). Safe from any task.
+#define UI_DIRTY_HEADER 0x01u  // bank/patch/page band (y 0-11)
+#define UI_DIRTY_BODY   0x02u  // active page
+#define UI_DIRTY_ALL    (UI_DIRTY_HEADER | UI_DIRTY_BODY)
+
+void ui_invalidate(uint8_t regions);
+
+typedef struct {
+  uint32_t renders;      // page body renders
+  uint32_t header_only;  // frames that redrew only the header band
+  uint32_t total_us;     // time spent in the page renderer
+  uint32_t max_us;
+} ui_page_stats_t;
+
+int ui_get_page_stats(ui_page_t p, ui_page_stats_t* out);    // 0 on success, -1 on bad page
+void ui_get_frame_stats(uint32_t* frames, uint32_t* skipped); // ticks, ticks with nothing to draw
+void ui_reset_stats(void);
+const char* ui_get_page_tag(ui_page_t p);                     // "LOOP", "TIME", ...
+
 // Optional: chord mode flag (UI-only for now)
 uint8_t ui_get_chord_mode(void);
 
@@ -42,3 +77,5 @@ const chord_bank_t* ui_get_chord_bank(void);
 
 // Reload chord bank config (SD). If path is NULL/empty, loads default /cfg/chord_bank.ngc
 int ui_reload_chord_bank(const char* path);
+// Replace the chord bank with one loaded elsewhere (no storage access)
+void ui_set_chord_bank(const chord_bank_t* b);
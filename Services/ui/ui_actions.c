@@ -19,8 +19,8 @@
   #define ACT_HAS_UI 0
 #endif
 
-#if __has_include("Services/patch/patch_system.h")
-  #include "Services/patch/patch_system.h"
+#if __has_include("Services/patch/patch_nav.h")
+  #include "Services/patch/patch_nav.h"
   #define ACT_HAS_PATCHSYS 1
 #else
   #define ACT_HAS_PATCHSYS 0
@@ -90,11 +90,11 @@ static void apply_action(ui_action_t a) {
 
 #if ACT_HAS_PATCHSYS
   switch (a) {
-    case UI_ACT_PATCH_PREV: (void)patch_system_patch_prev(); return;
-    case UI_ACT_PATCH_NEXT: (void)patch_system_patch_next(); return;
-    case UI_ACT_BANK_PREV:  (void)patch_system_bank_prev();  return;
-    case UI_ACT_BANK_NEXT:  (void)patch_system_bank_next();  return;
-    case UI_ACT_LOAD_APPLY: (void)patch_system_apply();      return;
+    case UI_ACT_PATCH_PREV: patch_nav_post(PATCH_NAV_PATCH, -1); return;
+    case UI_ACT_PATCH_NEXT: patch_nav_post(PATCH_NAV_PATCH, +1); return;
+    case UI_ACT_BANK_PREV:  patch_nav_post(PATCH_NAV_BANK, -1);  return;
+    case UI_ACT_BANK_NEXT:  patch_nav_post(PATCH_NAV_BANK, +1);  return;
+    case UI_ACT_LOAD_APPLY: patch_nav_post(PATCH_NAV_APPLY, 0);  return;
     default: break;
   }
 #endif
@@ -37,12 +37,16 @@ void ui_encoders_defaults(ui_encoders_cfg_t* c) {
   c->enc_b[0] = 7;
   c->enc_btn[0] = 8;
   c->enc_mode[0] = UI_ENC_MODE_NAV;
+  c->enc_detent[0] = 4;
+  c->enc_accel[0] = 0;  // one patch per detent
 
   // ENC1 disabled by default
   c->enc_a[1] = 0xFFFFu;
   c->enc_b[1] = 0xFFFFu;
   c->enc_btn[1] = 0xFFFFu;
   c->enc_mode[1] = UI_ENC_MODE_UI;
+  c->enc_detent[1] = 4;
+  c->enc_accel[1] = 1;
 }
 
 static ui_enc_mode_t parse_mode(const char* v) {
@@ -85,6 +89,8 @@ uint32_t u=0;
 if (!strcmp(k,"A")) { if (!parse_u32(v,&u)) c->enc_a[enc]=(uint16_t)u; return; }
 if (!strcmp(k,"B")) { if (!parse_u32(v,&u)) c->enc_b[enc]=(uint16_t)u; return; }
 if (!strcmp(k,"BTN")) { if (!parse_u32(v,&u)) c->enc_btn[enc]=(uint16_t)u; return; }
+if (!strcmp(k,"DETENT")) { if (!parse_u32(v,&u) && u && u <= 4u) c->enc_detent[enc]=(uint8_t)u; return; }
+if (!strcmp(k,"ACCEL")) { if (!parse_u32(v,&u)) c->enc_accel[enc]=(uint8_t)(u?1:0); return; }
 return;
 }
 
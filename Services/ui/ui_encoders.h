@@ -23,6 +23,8 @@ typedef struct {
   uint16_t enc_b[UI_MAX_ENCODERS];
   uint16_t enc_btn[UI_MAX_ENCODERS];   // optional, 65535 disables
   ui_enc_mode_t enc_mode[UI_MAX_ENCODERS];
+  uint8_t  enc_detent[UI_MAX_ENCODERS];  // Gray-code transitions per step (default 4)
+  uint8_t  enc_accel[UI_MAX_ENCODERS];   // 1 = speed-dependent acceleration
 } ui_encoders_cfg_t;
 
 void ui_encoders_defaults(ui_encoders_cfg_t* c);
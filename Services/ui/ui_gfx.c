@@ -8,132 +8,165 @@ static uint16_t g_w = 0, g_h = 0;
 // Font selection: 0 = 5x7 (default), 1 = 8x8
 static uint8_t g_current_font = 0;
 
-static const uint8_t font5x7[96][5] = {
-  {0,0,0,0,0},{0,0,0x5F,0,0},{0,0x07,0,0x07,0},{0x14,0x7F,0x14,0x7F,0x14},
-  {0x24,0x2A,0x7F,0x2A,0x12},{0x23,0x13,0x08,0x64,0x62},{0x36,0x49,0x55,0x22,0x50},{0,0x05,0x03,0,0},
-  {0,0x1C,0x22,0x41,0},{0,0x41,0x22,0x1C,0},{0x14,0x08,0x3E,0x08,0x14},{0x08,0x08,0x3E,0x08,0x08},
-  {0,0x50,0x30,0,0},{0x08,0x08,0x08,0x08,0x08},{0,0x60,0x60,0,0},{0x20,0x10,0x08,0x04,0x02},
-  {0x3E,0x51,0x49,0x45,0x3E},{0,0x42,0x7F,0x40,0},{0x42,0x61,0x51,0x49,0x46},{0x21,0x41,0x45,0x4B,0x31},
-  {0x18,0x14,0x12,0x7F,0x10},{0x27,0x45,0x45,0x45,0x39},{0x3C,0x4A,0x49,0x49,0x30},{0x01,0x71,0x09,0x05,0x03},
-  {0x36,0x49,0x49,0x49,0x36},{0x06,0x49,0x49,0x29,0x1E},{0,0x36,0x36,0,0},{0,0x56,0x36,0,0},
-  {0x08,0x14,0x22,0x41,0},{0x14,0x14,0x14,0x14,0x14},{0,0x41,0x22,0x14,0x08},{0x02,0x01,0x51,0x09,0x06},
-  {0x32,0x49,0x79,0x41,0x3E},{0x7E,0x11,0x11,0x11,0x7E},{0x7F,0x49,0x49,0x49,0x36},{0x3E,0x41,0x41,0x41,0x22},
-  {0x7F,0x41,0x41,0x22,0x1C},{0x7F,0x49,0x49,0x49,0x41},{0x7F,0x09,0x09,0x09,0x01},{0x3E,0x41,0x49,0x49,0x7A},
-  {0x7F,0x08,0x08,0x08,0x7F},{0,0x41,0x7F,0x41,0},{0x20,0x40,0x41,0x3F,0x01},{0x7F,0x08,0x14,0x22,0x41},
-  {0x7F,0x40,0x40,0x40,0x40},{0x7F,0x02,0x0C,0x02,0x7F},{0x7F,0x04,0x08,0x10,0x7F},{0x3E,0x41,0x41,0x41,0x3E},
-  {0x7F,0x09,0x09,0x09,0x06},{0x3E,0x41,0x51,0x21,0x5E},{0x7F,0x09,0x19,0x29,0x46},{0x46,0x49,0x49,0x49,0x31},
-  {0x01,0x01,0x7F,0x01,0x01},{0x3F,0x40,0x40,0x40,0x3F},{0x1F,0x20,0x40,0x20,0x1F},{0x7F,0x20,0x18,0x20,0x7F},
-  {0x63,0x14,0x08,0x14,0x63},{0x03,0x04,0x78,0x04,0x03},{0x61,0x51,0x49,0x45,0x43},{0,0x7F,0x41,0x41,0},
-  {0x02,0x04,0x08,0x10,0x20},{0,0x41,0x41,0x7F,0},{0x04,0x02,0x01,0x02,0x04},{0x40,0x40,0x40,0x40,0x40},
-  {0,0x01,0x02,0x04,0},{0x20,0x54,0x54,0x54,0x78},{0x7F,0x48,0x44,0x44,0x38},{0x38,0x44,0x44,0x44,0x20},
-  {0x38,0x44,0x44,0x48,0x7F},{0x38,0x54,0x54,0x54,0x18},{0x08,0x7E,0x09,0x01,0x02},{0x0C,0x52,0x52,0x52,0x3E},
-  {0x7F,0x08,0x04,0x04,0x78},{0,0x44,0x7D,0x40,0},{0x20,0x40,0x44,0x3D,0},{0x7F,0x10,0x28,0x44,0},
-  {0,0x41,0x7F,0x40,0},{0x7C,0x04,0x18,0x04,0x78},{0x7C,0x08,0x04,0x04,0x78},{0x38,0x44,0x44,0x44,0x38},
-  {0x7C,0x14,0x14,0x14,0x08},{0x08,0x14,0x14,0x18,0x7C},{0x7C,0x08,0x04,0x04,0x08},{0x48,0x54,0x54,0x54,0x20},
-  {0x04,0x3F,0x44,0x40,0x20},{0x3C,0x40,0x40,0x20,0x7C},{0x1C,0x20,0x40,0x20,0x1C},{0x3C,0x40,0x30,0x40,0x3C},
-  {0x44,0x28,0x10,0x28,0x44},{0x0C,0x50,0x50,0x50,0x3C},{0x44,0x64,0x54,0x4C,0x44},{0,0x08,0x36,0x41,0},
-  {0,0,0x7F,0,0},{0,0x41,0x36,0x08,0},{0x08,0x04,0x08,0x10,0x08},
+#ifdef UI_GFX_STATS
+static ui_gfx_stats_t g_stats;
+#define GFX_STAT(field) (g_stats.field++)
+void ui_gfx_get_stats(ui_gfx_stats_t* out) { if (out) *out = g_stats; }
+void ui_gfx_reset_stats(void) { memset(&g_stats, 0, sizeof(g_stats)); }
+#else
+#define GFX_STAT(field) ((void)0)
+#endif
+
+// Glyphs are rasterized at compile time into 4bpp masks: one uint32_t per
+// glyph row, 8 nibbles, leftmost pixel in the top nibble (same order as the
+// framebuffer, even x = high nibble). A set pixel is 0xF, so a row can be
+// blitted a byte at a time and colorized with a single AND.
+#define GLYPH_NIB(b, bit, sh) ((((b) & (bit)) != 0) ? (0xFu << (sh)) : 0u)
+
+// 5x7 source data is column-major (bit n of each column byte = row n)
+#define G5_ROW(a, b, c, d, e, r) \
+  (GLYPH_NIB(a, 1u << (r), 28) | GLYPH_NIB(b, 1u << (r), 24) | GLYPH_NIB(c, 1u << (r), 20) | \
+   GLYPH_NIB(d, 1u << (r), 16) | GLYPH_NIB(e, 1u << (r), 12))
+#define G5(a, b, c, d, e) \
+  { G5_ROW(a, b, c, d, e, 0), G5_ROW(a, b, c, d, e, 1), G5_ROW(a, b, c, d, e, 2), \
+    G5_ROW(a, b, c, d, e, 3), G5_ROW(a, b, c, d, e, 4), G5_ROW(a, b, c, d, e, 5), \
+    G5_ROW(a, b, c, d, e, 6) }
+
+// 8x8 source data is row-major (bit 7 = leftmost column)
+#define G8_ROW(b) \
+  (GLYPH_NIB(b, 0x80u, 28) | GLYPH_NIB(b, 0x40u, 24) | GLYPH_NIB(b, 0x20u, 20) | \
+   GLYPH_NIB(b, 0x10u, 16) | GLYPH_NIB(b, 0x08u, 12) | GLYPH_NIB(b, 0x04u, 8) | \
+   GLYPH_NIB(b, 0x02u, 4) | GLYPH_NIB(b, 0x01u, 0))
+#define G8(r0, r1, r2, r3, r4, r5, r6, r7) \
+  { G8_ROW(r0), G8_ROW(r1), G8_ROW(r2), G8_ROW(r3), \
+    G8_ROW(r4), G8_ROW(r5), G8_ROW(r6), G8_ROW(r7) }
+
+static const uint32_t font5x7[96][7] = {
+  G5(0,0,0,0,0),G5(0,0,0x5F,0,0),G5(0,0x07,0,0x07,0),G5(0x14,0x7F,0x14,0x7F,0x14),
+  G5(0x24,0x2A,0x7F,0x2A,0x12),G5(0x23,0x13,0x08,0x64,0x62),G5(0x36,0x49,0x55,0x22,0x50),G5(0,0x05,0x03,0,0),
+  G5(0,0x1C,0x22,0x41,0),G5(0,0x41,0x22,0x1C,0),G5(0x14,0x08,0x3E,0x08,0x14),G5(0x08,0x08,0x3E,0x08,0x08),
+  G5(0,0x50,0x30,0,0),G5(0x08,0x08,0x08,0x08,0x08),G5(0,0x60,0x60,0,0),G5(0x20,0x10,0x08,0x04,0x02),
+  G5(0x3E,0x51,0x49,0x45,0x3E),G5(0,0x42,0x7F,0x40,0),G5(0x42,0x61,0x51,0x49,0x46),G5(0x21,0x41,0x45,0x4B,0x31),
+  G5(0x18,0x14,0x12,0x7F,0x10),G5(0x27,0x45,0x45,0x45,0x39),G5(0x3C,0x4A,0x49,0x49,0x30),G5(0x01,0x71,0x09,0x05,0x03),
+  G5(0x36,0x49,0x49,0x49,0x36),G5(0x06,0x49,0x49,0x29,0x1E),G5(0,0x36,0x36,0,0),G5(0,0x56,0x36,0,0),
+  G5(0x08,0x14,0x22,0x41,0),G5(0x14,0x14,0x14,0x14,0x14),G5(0,0x41,0x22,0x14,0x08),G5(0x02,0x01,0x51,0x09,0x06),
+  G5(0x32,0x49,0x79,0x41,0x3E),G5(0x7E,0x11,0x11,0x11,0x7E),G5(0x7F,0x49,0x49,0x49,0x36),G5(0x3E,0x41,0x41,0x41,0x22),
+  G5(0x7F,0x41,0x41,0x22,0x1C),G5(0x7F,0x49,0x49,0x49,0x41),G5(0x7F,0x09,0x09,0x09,0x01),G5(0x3E,0x41,0x49,0x49,0x7A),
+  G5(0x7F,0x08,0x08,0x08,0x7F),G5(0,0x41,0x7F,0x41,0),G5(0x20,0x40,0x41,0x3F,0x01),G5(0x7F,0x08,0x14,0x22,0x41),
+  G5(0x7F,0x40,0x40,0x40,0x40),G5(0x7F,0x02,0x0C,0x02,0x7F),G5(0x7F,0x04,0x08,0x10,0x7F),G5(0x3E,0x41,0x41,0x41,0x3E),
+  G5(0x7F,0x09,0x09,0x09,0x06),G5(0x3E,0x41,0x51,0x21,0x5E),G5(0x7F,0x09,0x19,0x29,0x46),G5(0x46,0x49,0x49,0x49,0x31),
+  G5(0x01,0x01,0x7F,0x01,0x01),G5(0x3F,0x40,0x40,0x40,0x3F),G5(0x1F,0x20,0x40,0x20,0x1F),G5(0x7F,0x20,0x18,0x20,0x7F),
+  G5(0x63,0x14,0x08,0x14,0x63),G5(0x03,0x04,0x78,0x04,0x03),G5(0x61,0x51,0x49,0x45,0x43),G5(0,0x7F,0x41,0x41,0),
+  G5(0x02,0x04,0x08,0x10,0x20),G5(0,0x41,0x41,0x7F,0),G5(0x04,0x02,0x01,0x02,0x04),G5(0x40,0x40,0x40,0x40,0x40),
+  G5(0,0x01,0x02,0x04,0),G5(0x20,0x54,0x54,0x54,0x78),G5(0x7F,0x48,0x44,0x44,0x38),G5(0x38,0x44,0x44,0x44,0x20),
+  G5(0x38,0x44,0x44,0x48,0x7F),G5(0x38,0x54,0x54,0x54,0x18),G5(0x08,0x7E,0x09,0x01,0x02),G5(0x0C,0x52,0x52,0x52,0x3E),
+  G5(0x7F,0x08,0x04,0x04,0x78),G5(0,0x44,0x7D,0x40,0),G5(0x20,0x40,0x44,0x3D,0),G5(0x7F,0x10,0x28,0x44,0),
+  G5(0,0x41,0x7F,0x40,0),G5(0x7C,0x04,0x18,0x04,0x78),G5(0x7C,0x08,0x04,0x04,0x78),G5(0x38,0x44,0x44,0x44,0x38),
+  G5(0x7C,0x14,0x14,0x14,0x08),G5(0x08,0x14,0x14,0x18,0x7C),G5(0x7C,0x08,0x04,0x04,0x08),G5(0x48,0x54,0x54,0x54,0x20),
+  G5(0x04,0x3F,0x44,0x40,0x20),G5(0x3C,0x40,0x40,0x20,0x7C),G5(0x1C,0x20,0x40,0x20,0x1C),G5(0x3C,0x40,0x30,0x40,0x3C),
+  G5(0x44,0x28,0x10,0x28,0x44),G5(0x0C,0x50,0x50,0x50,0x3C),G5(0x44,0x64,0x54,0x4C,0x44),G5(0,0x08,0x36,0x41,0),
+  G5(0,0,0x7F,0,0),G5(0,0x41,0x36,0x08,0),G5(0x08,0x04,0x08,0x10,0x08),
 };
 
 // 8x8 font - cleaner and more readable than 5x7
-// Each character is 8 bytes (8 rows x 8 columns)
-static const uint8_t font8x8[96][8] = {
-  {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // ' '
-  {0x18,0x3C,0x3C,0x18,0x18,0x00,0x18,0x00}, // '!'
-  {0x36,0x36,0x00,0x00,0x00,0x00,0x00,0x00}, // '"'
-  {0x36,0x36,0x7F,0x36,0x7F,0x36,0x36,0x00}, // '#'
-  {0x0C,0x3E,0x03,0x1E,0x30,0x1F,0x0C,0x00}, // '$'
-  {0x00,0x63,0x33,0x18,0x0C,0x66,0x63,0x00}, // '%'
-  {0x1C,0x36,0x1C,0x6E,0x3B,0x33,0x6E,0x00}, // '&'
-  {0x06,0x06,0x03,0x00,0x00,0x00,0x00,0x00}, // '''
-  {0x18,0x0C,0x06,0x06,0x06,0x0C,0x18,0x00}, // '('
-  {0x06,0x0C,0x18,0x18,0x18,0x0C,0x06,0x00}, // ')'
-  {0x00,0x66,0x3C,0xFF,0x3C,0x66,0x00,0x00}, // '*'
-  {0x00,0x0C,0x0C,0x3F,0x0C,0x0C,0x00,0x00}, // '+'
-  {0x00,0x00,0x00,0x00,0x00,0x0C,0x0C,0x06}, // ','
-  {0x00,0x00,0x00,0x3F,0x00,0x00,0x00,0x00}, // '-'
-  {0x00,0x00,0x00,0x00,0x00,0x0C,0x0C,0x00}, // '.'
-  {0x60,0x30,0x18,0x0C,0x06,0x03,0x01,0x00}, // '/'
-  {0x3E,0x63,0x73,0x7B,0x6F,0x67,0x3E,0x00}, // '0'
-  {0x0C,0x0E,0x0C,0x0C,0x0C,0x0C,0x3F,0x00}, // '1'
-  {0x1E,0x33,0x30,0x1C,0x06,0x33,0x3F,0x00}, // '2'
-  {0x1E,0x33,0x30,0x1C,0x30,0x33,0x1E,0x00}, // '3'
-  {0x38,0x3C,0x36,0x33,0x7F,0x30,0x78,0x00}, // '4'
-  {0x3F,0x03,0x1F,0x30,0x30,0x33,0x1E,0x00}, // '5'
-  {0x1C,0x06,0x03,0x1F,0x33,0x33,0x1E,0x00}, // '6'
-  {0x3F,0x33,0x30,0x18,0x0C,0x0C,0x0C,0x00}, // '7'
-  {0x1E,0x33,0x33,0x1E,0x33,0x33,0x1E,0x00}, // '8'
-  {0x1E,0x33,0x33,0x3E,0x30,0x18,0x0E,0x00}, // '9'
-  {0x00,0x0C,0x0C,0x00,0x00,0x0C,0x0C,0x00}, // ':'
-  {0x00,0x0C,0x0C,0x00,0x00,0x0C,0x0C,0x06}, // ';'
-  {0x18,0x0C,0x06,0x03,0x06,0x0C,0x18,0x00}, // '<'
-  {0x00,0x00,0x3F,0x00,0x00,0x3F,0x00,0x00}, // '='
-  {0x06,0x0C,0x18,0x30,0x18,0x0C,0x06,0x00}, // '>'
-  {0x1E,0x33,0x30,0x18,0x0C,0x00,0x0C,0x00}, // '?'
-  {0x3E,0x63,0x7B,0x7B,0x7B,0x03,0x1E,0x00}, // '@'
-  {0x0C,0x1E,0x33,0x33,0x3F,0x33,0x33,0x00}, // 'A'
-  {0x3F,0x66,0x66,0x3E,0x66,0x66,0x3F,0x00}, // 'B'
-  {0x3C,0x66,0x03,0x03,0x03,0x66,0x3C,0x00}, // 'C'
-  {0x1F,0x36,0x66,0x66,0x66,0x36,0x1F,0x00}, // 'D'
-  {0x7F,0x46,0x16,0x1E,0x16,0x46,0x7F,0x00}, // 'E'
-  {0x7F,0x46,0x16,0x1E,0x16,0x06,0x0F,0x00}, // 'F'
-  {0x3C,0x66,0x03,0x03,0x73,0x66,0x7C,0x00}, // 'G'
-  {0x33,0x33,0x33,0x3F,0x33,0x33,0x33,0x00}, // 'H'
-  {0x1E,0x0C,0x0C,0x0C,0x0C,0x0C,0x1E,0x00}, // 'I'
-  {0x78,0x30,0x30,0x30,0x33,0x33,0x1E,0x00}, // 'J'
-  {0x67,0x66,0x36,0x1E,0x36,0x66,0x67,0x00}, // 'K'
-  {0x0F,0x06,0x06,0x06,0x46,0x66,0x7F,0x00}, // 'L'
-  {0x63,0x77,0x7F,0x7F,0x6B,0x63,0x63,0x00}, // 'M'
-  {0x63,0x67,0x6F,0x7B,0x73,0x63,0x63,0x00}, // 'N'
-  {0x1C,0x36,0x63,0x63,0x63,0x36,0x1C,0x00}, // 'O'
-  {0x3F,0x66,0x66,0x3E,0x06,0x06,0x0F,0x00}, // 'P'
-  {0x1E,0x33,0x33,0x33,0x3B,0x1E,0x38,0x00}, // 'Q'
-  {0x3F,0x66,0x66,0x3E,0x36,0x66,0x67,0x00}, // 'R'
-  {0x1E,0x33,0x07,0x0E,0x38,0x33,0x1E,0x00}, // 'S'
-  {0x3F,0x2D,0x0C,0x0C,0x0C,0x0C,0x1E,0x00}, // 'T'
-  {0x33,0x33,0x33,0x33,0x33,0x33,0x3F,0x00}, // 'U'
-  {0x33,0x33,0x33,0x33,0x33,0x1E,0x0C,0x00}, // 'V'
-  {0x63,0x63,0x63,0x6B,0x7F,0x77,0x63,0x00}, // 'W'
-  {0x63,0x63,0x36,0x1C,0x1C,0x36,0x63,0x00}, // 'X'
-  {0x33,0x33,0x33,0x1E,0x0C,0x0C,0x1E,0x00}, // 'Y'
-  {0x7F,0x63,0x31,0x18,0x4C,0x66,0x7F,0x00}, // 'Z'
-  {0x1E,0x06,0x06,0x06,0x06,0x06,0x1E,0x00}, // '['
-  {0x03,0x06,0x0C,0x18,0x30,0x60,0x40,0x00}, // '\'
-  {0x1E,0x18,0x18,0x18,0x18,0x18,0x1E,0x00}, // ']'
-  {0x08,0x1C,0x36,0x63,0x00,0x00,0x00,0x00}, // '^'
-  {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF}, // '_'
-  {0x0C,0x0C,0x18,0x00,0x00,0x00,0x00,0x00}, // '`'
-  {0x00,0x00,0x1E,0x30,0x3E,0x33,0x6E,0x00}, // 'a'
-  {0x07,0x06,0x06,0x3E,0x66,0x66,0x3B,0x00}, // 'b'
-  {0x00,0x00,0x1E,0x33,0x03,0x33,0x1E,0x00}, // 'c'
-  {0x38,0x30,0x30,0x3e,0x33,0x33,0x6E,0x00}, // 'd'
-  {0x00,0x00,0x1E,0x33,0x3f,0x03,0x1E,0x00}, // 'e'
-  {0x1C,0x36,0x06,0x0f,0x06,0x06,0x0F,0x00}, // 'f'
-  {0x00,0x00,0x6E,0x33,0x33,0x3E,0x30,0x1F}, // 'g'
-  {0x07,0x06,0x36,0x6E,0x66,0x66,0x67,0x00}, // 'h'
-  {0x0C,0x00,0x0E,0x0C,0x0C,0x0C,0x1E,0x00}, // 'i'
-  {0x30,0x00,0x30,0x30,0x30,0x33,0x33,0x1E}, // 'j'
-  {0x07,0x06,0x66,0x36,0x1E,0x36,0x67,0x00}, // 'k'
-  {0x0E,0x0C,0x0C,0x0C,0x0C,0x0C,0x1E,0x00}, // 'l'
-  {0x00,0x00,0x33,0x7F,0x7F,0x6B,0x63,0x00}, // 'm'
-  {0x00,0x00,0x1F,0x33,0x33,0x33,0x33,0x00}, // 'n'
-  {0x00,0x00,0x1E,0x33,0x33,0x33,0x1E,0x00}, // 'o'
-  {0x00,0x00,0x3B,0x66,0x66,0x3E,0x06,0x0F}, // 'p'
-  {0x00,0x00,0x6E,0x33,0x33,0x3E,0x30,0x78}, // 'q'
-  {0x00,0x00,0x3B,0x6E,0x66,0x06,0x0F,0x00}, // 'r'
-  {0x00,0x00,0x3E,0x03,0x1E,0x30,0x1F,0x00}, // 's'
-  {0x08,0x0C,0x3E,0x0C,0x0C,0x2C,0x18,0x00}, // 't'
-  {0x00,0x00,0x33,0x33,0x33,0x33,0x6E,0x00}, // 'u'
-  {0x00,0x00,0x33,0x33,0x33,0x1E,0x0C,0x00}, // 'v'
-  {0x00,0x00,0x63,0x6B,0x7F,0x7F,0x36,0x00}, // 'w'
-  {0x00,0x00,0x63,0x36,0x1C,0x36,0x63,0x00}, // 'x'
-  {0x00,0x00,0x33,0x33,0x33,0x3E,0x30,0x1F}, // 'y'
-  {0x00,0x00,0x3F,0x19,0x0C,0x26,0x3F,0x00}, // 'z'
-  {0x38,0x0C,0x0C,0x07,0x0C,0x0C,0x38,0x00}, // '{'
-  {0x18,0x18,0x18,0x00,0x18,0x18,0x18,0x00}, // '|'
-  {0x07,0x0C,0x0C,0x38,0x0C,0x0C,0x07,0x00}, // '}'
-  {0x6E,0x3B,0x00,0x00,0x00,0x00,0x00,0x00}, // '~'
-  {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}  // DEL
+// Each character is 8 rows x 8 columns
+static const uint32_t font8x8[96][8] = {
+  G8(0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00), // ' '
+  G8(0x18,0x3C,0x3C,0x18,0x18,0x00,0x18,0x00), // '!'
+  G8(0x36,0x36,0x00,0x00,0x00,0x00,0x00,0x00), // '"'
+  G8(0x36,0x36,0x7F,0x36,0x7F,0x36,0x36,0x00), // '#'
+  G8(0x0C,0x3E,0x03,0x1E,0x30,0x1F,0x0C,0x00), // '$'
+  G8(0x00,0x63,0x33,0x18,0x0C,0x66,0x63,0x00), // '%'
+  G8(0x1C,0x36,0x1C,0x6E,0x3B,0x33,0x6E,0x00), // '&'
+  G8(0x06,0x06,0x03,0x00,0x00,0x00,0x00,0x00), // '''
+  G8(0x18,0x0C,0x06,0x06,0x06,0x0C,0x18,0x00), // '('
+  G8(0x06,0x0C,0x18,0x18,0x18,0x0C,0x06,0x00), // ')'
+  G8(0x00,0x66,0x3C,0xFF,0x3C,0x66,0x00,0x00), // '*'
+  G8(0x00,0x0C,0x0C,0x3F,0x0C,0x0C,0x00,0x00), // '+'
+  G8(0x00,0x00,0x00,0x00,0x00,0x0C,0x0C,0x06), // ','
+  G8(0x00,0x00,0x00,0x3F,0x00,0x00,0x00,0x00), // '-'
+  G8(0x00,0x00,0x00,0x00,0x00,0x0C,0x0C,0x00), // '.'
+  G8(0x60,0x30,0x18,0x0C,0x06,0x03,0x01,0x00), // '/'
+  G8(0x3E,0x63,0x73,0x7B,0x6F,0x67,0x3E,0x00), // '0'
+  G8(0x0C,0x0E,0x0C,0x0C,0x0C,0x0C,0x3F,0x00), // '1'
+  G8(0x1E,0x33,0x30,0x1C,0x06,0x33,0x3F,0x00), // '2'
+  G8(0x1E,0x33,0x30,0x1C,0x30,0x33,0x1E,0x00), // '3'
+  G8(0x38,0x3C,0x36,0x33,0x7F,0x30,0x78,0x00), // '4'
+  G8(0x3F,0x03,0x1F,0x30,0x30,0x33,0x1E,0x00), // '5'
+  G8(0x1C,0x06,0x03,0x1F,0x33,0x33,0x1E,0x00), // '6'
+  G8(0x3F,0x33,0x30,0x18,0x0C,0x0C,0x0C,0x00), // '7'
+  G8(0x1E,0x33,0x33,0x1E,0x33,0x33,0x1E,0x00), // '8'
+  G8(0x1E,0x33,0x33,0x3E,0x30,0x18,0x0E,0x00), // '9'
+  G8(0x00,0x0C,0x0C,0x00,0x00,0x0C,0x0C,0x00), // ':'
+  G8(0x00,0x0C,0x0C,0x00,0x00,0x0C,0x0C,0x06), // ';'
+  G8(0x18,0x0C,0x06,0x03,0x06,0x0C,0x18,0x00), // '<'
+  G8(0x00,0x00,0x3F,0x00,0x00,0x3F,0x00,0x00), // '='
+  G8(0x06,0x0C,0x18,0x30,0x18,0x0C,0x06,0x00), // '>'
+  G8(0x1E,0x33,0x30,0x18,0x0C,0x00,0x0C,0x00), // '?'
+  G8(0x3E,0x63,0x7B,0x7B,0x7B,0x03,0x1E,0x00), // '@'
+  G8(0x0C,0x1E,0x33,0x33,0x3F,0x33,0x33,0x00), // 'A'
+  G8(0x3F,0x66,0x66,0x3E,0x66,0x66,0x3F,0x00), // 'B'
+  G8(0x3C,0x66,0x03,0x03,0x03,0x66,0x3C,0x00), // 'C'
+  G8(0x1F,0x36,0x66,0x66,0x66,0x36,0x1F,0x00), // 'D'
+  G8(0x7F,0x46,0x16,0x1E,0x16,0x46,0x7F,0x00), // 'E'
+  G8(0x7F,0x46,0x16,0x1E,0x16,0x06,0x0F,0x00), // 'F'
+  G8(0x3C,0x66,0x03,0x03,0x73,0x66,0x7C,0x00), // 'G'
+  G8(0x33,0x33,0x33,0x3F,0x33,0x33,0x33,0x00), // 'H'
+  G8(0x1E,0x0C,0x0C,0x0C,0x0C,0x0C,0x1E,0x00), // 'I'
+  G8(0x78,0x30,0x30,0x30,0x33,0x33,0x1E,0x00), // 'J'
+  G8(0x67,0x66,0x36,0x1E,0x36,0x66,0x67,0x00), // 'K'
+  G8(0x0F,0x06,0x06,0x06,0x46,0x66,0x7F,0x00), // 'L'
+  G8(0x63,0x77,0x7F,0x7F,0x6B,0x63,0x63,0x00), // 'M'
+  G8(0x63,0x67,0x6F,0x7B,0x73,0x63,0x63,0x00), // 'N'
+  G8(0x1C,0x36,0x63,0x63,0x63,0x36,0x1C,0x00), // 'O'
+  G8(0x3F,0x66,0x66,0x3E,0x06,0x06,0x0F,0x00), // 'P'
+  G8(0x1E,0x33,0x33,0x33,0x3B,0x1E,0x38,0x00), // 'Q'
+  G8(0x3F,0x66,0x66,0x3E,0x36,0x66,0x67,0x00), // 'R'
+  G8(0x1E,0x33,0x07,0x0E,0x38,0x33,0x1E,0x00), // 'S'
+  G8(0x3F,0x2D,0x0C,0x0C,0x0C,0x0C,0x1E,0x00), // 'T'
+  G8(0x33,0x33,0x33,0x33,0x33,0x33,0x3F,0x00), // 'U'
+  G8(0x33,0x33,0x33,0x33,0x33,0x1E,0x0C,0x00), // 'V'
+  G8(0x63,0x63,0x63,0x6B,0x7F,0x77,0x63,0x00), // 'W'
+  G8(0x63,0x63,0x36,0x1C,0x1C,0x36,0x63,0x00), // 'X'
+  G8(0x33,0x33,0x33,0x1E,0x0C,0x0C,0x1E,0x00), // 'Y'
+  G8(0x7F,0x63,0x31,0x18,0x4C,0x66,0x7F,0x00), // 'Z'
+  G8(0x1E,0x06,0x06,0x06,0x06,0x06,0x1E,0x00), // '['
+  G8(0x03,0x06,0x0C,0x18,0x30,0x60,0x40,0x00), // '\'
+  G8(0x1E,0x18,0x18,0x18,0x18,0x18,0x1E,0x00), // ']'
+  G8(0x08,0x1C,0x36,0x63,0x00,0x00,0x00,0x00), // '^'
+  G8(0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF), // '_'
+  G8(0x0C,0x0C,0x18,0x00,0x00,0x00,0x00,0x00), // '`'
+  G8(0x00,0x00,0x1E,0x30,0x3E,0x33,0x6E,0x00), // 'a'
+  G8(0x07,0x06,0x06,0x3E,0x66,0x66,0x3B,0x00), // 'b'
+  G8(0x00,0x00,0x1E,0x33,0x03,0x33,0x1E,0x00), // 'c'
+  G8(0x38,0x30,0x30,0x3e,0x33,0x33,0x6E,0x00), // 'd'
+  G8(0x00,0x00,0x1E,0x33,0x3f,0x03,0x1E,0x00), // 'e'
+  G8(0x1C,0x36,0x06,0x0f,0x06,0x06,0x0F,0x00), // 'f'
+  G8(0x00,0x00,0x6E,0x33,0x33,0x3E,0x30,0x1F), // 'g'
+  G8(0x07,0x06,0x36,0x6E,0x66,0x66,0x67,0x00), // 'h'
+  G8(0x0C,0x00,0x0E,0x0C,0x0C,0x0C,0x1E,0x00), // 'i'
+  G8(0x30,0x00,0x30,0x30,0x30,0x33,0x33,0x1E), // 'j'
+  G8(0x07,0x06,0x66,0x36,0x1E,0x36,0x67,0x00), // 'k'
+  G8(0x0E,0x0C,0x0C,0x0C,0x0C,0x0C,0x1E,0x00), // 'l'
+  G8(0x00,0x00,0x33,0x7F,0x7F,0x6B,0x63,0x00), // 'm'
+  G8(0x00,0x00,0x1F,0x33,0x33,0x33,0x33,0x00), // 'n'
+  G8(0x00,0x00,0x1E,0x33,0x33,0x33,0x1E,0x00), // 'o'
+  G8(0x00,0x00,0x3B,0x66,0x66,0x3E,0x06,0x0F), // 'p'
+  G8(0x00,0x00,0x6E,0x33,0x33,0x3E,0x30,0x78), // 'q'
+  G8(0x00,0x00,0x3B,0x6E,0x66,0x06,0x0F,0x00), // 'r'
+  G8(0x00,0x00,0x3E,0x03,0x1E,0x30,0x1F,0x00), // 's'
+  G8(0x08,0x0C,0x3E,0x0C,0x0C,0x2C,0x18,0x00), // 't'
+  G8(0x00,0x00,0x33,0x33,0x33,0x33,0x6E,0x00), // 'u'
+  G8(0x00,0x00,0x33,0x33,0x33,0x1E,0x0C,0x00), // 'v'
+  G8(0x00,0x00,0x63,0x6B,0x7F,0x7F,0x36,0x00), // 'w'
+  G8(0x00,0x00,0x63,0x36,0x1C,0x36,0x63,0x00), // 'x'
+  G8(0x00,0x00,0x33,0x33,0x33,0x3E,0x30,0x1F), // 'y'
+  G8(0x00,0x00,0x3F,0x19,0x0C,0x26,0x3F,0x00), // 'z'
+  G8(0x38,0x0C,0x0C,0x07,0x0C,0x0C,0x38,0x00), // '{'
+  G8(0x18,0x18,0x18,0x00,0x18,0x18,0x18,0x00), // '|'
+  G8(0x07,0x0C,0x0C,0x38,0x0C,0x0C,0x07,0x00), // '}'
+  G8(0x6E,0x3B,0x00,0x00,0x00,0x00,0x00,0x00), // '~'
+  G8(0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00)  // DEL
 };
 
 void ui_gfx_set_fb(uint8_t* fb, uint16_t w, uint16_t h) { g_fb = fb; g_w = w; g_h = h; }
@@ -148,7 +181,20 @@ void ui_gfx_clear(uint8_t gray) {
   memset(g_fb, v, (g_w * g_h) / 2);
 }
 
+int ui_gfx_save_rows(int y, int h, uint8_t* dst) {
+  if (!g_fb || !dst || y < 0 || h <= 0 || y + h > (int)g_h) return -1;
+  memcpy(dst, &g_fb[(uint32_t)y * (g_w >> 1)], (size_t)h * (g_w >> 1));
+  return 0;
+}
+
+int ui_gfx_restore_rows(int y, int h, const uint8_t* src) {
+  if (!g_fb || !src || y < 0 || h <= 0 || y + h > (int)g_h) return -1;
+  memcpy(&g_fb[(uint32_t)y * (g_w >> 1)], src, (size_t)h * (g_w >> 1));
+  return 0;
+}
+
 void ui_gfx_pixel(int x, int y, uint8_t gray) {
+  GFX_STAT(pixel_calls);
   if (!g_fb) return;
   if (x < 0 || y < 0 || x >= (int)g_w || y >= (int)g_h) return;
   uint32_t idx = (uint32_t)y * (uint32_t)g_w + (uint32_t)x;
@@ -157,34 +203,102 @@ void ui_gfx_pixel(int x, int y, uint8_t gray) {
   else                g_fb[b] = (uint8_t)((g_fb[b] & 0xF0) |  (gray & 0x0F));
 }
 
+// ---- Span primitives ----
+// Everything below writes clipped horizontal spans: whole bytes (2 pixels)
+// with memset, plus at most one read-modify-write nibble at each end.
+// Even x = high nibble, odd x = low nibble.
+
+// Fill pixels [x0, x1) of row y; caller has clipped to the framebuffer
+static void span(int y, int x0, int x1, uint8_t gray) {
+  GFX_STAT(spans);
+  uint8_t* row = &g_fb[(uint32_t)y * (g_w >> 1)];
+  uint8_t g = gray & 0x0F;
+  if (x0 & 1) {
+    row[x0 >> 1] = (uint8_t)((row[x0 >> 1] & 0xF0) | g);
+    x0++;
+  }
+  if ((x1 & 1) && x1 > x0) {
+    x1--;
+    row[x1 >> 1] = (uint8_t)((row[x1 >> 1] & 0x0F) | (g << 4));
+  }
+  if (x1 > x0) memset(&row[x0 >> 1], (g << 4) | g, (size_t)(x1 - x0) >> 1);
+}
+
 void ui_gfx_rect(int x, int y, int w, int h, uint8_t gray) {
-  for (int yy=0; yy<h; yy++) for (int xx=0; xx<w; xx++) ui_gfx_pixel(x+xx, y+yy, gray);
+  if (!g_fb || w <= 0 || h <= 0) return;
+  int x0 = x < 0 ? 0 : x;
+  int y0 = y < 0 ? 0 : y;
+  int x1 = x + w > (int)g_w ? (int)g_w : x + w;
+  int y1 = y + h > (int)g_h ? (int)g_h : y + h;
+  if (x0 >= x1 || y0 >= y1) return;
+
+  if (x0 == 0 && x1 == (int)g_w) {
+    // Full-width band: rows are contiguous
+    uint8_t g = gray & 0x0F;
+    memset(&g_fb[(uint32_t)y0 * (g_w >> 1)], (g << 4) | g, (size_t)(y1 - y0) * (g_w >> 1));
+    return;
+  }
+  for (int yy = y0; yy < y1; yy++) span(yy, x0, x1, gray);
+}
+
+// Blit one glyph row mask at byte p. Odd x starts in the low nibble of the
+// first byte; after that both alignments copy whole bytes. Only set pixels
+// are written, so text over a filled bar (inverted text) keeps the background.
+static inline void blit_row(uint8_t* p, int odd, uint32_t m, uint8_t color) {
+  if (odd) {
+    uint8_t b = (uint8_t)(m >> 28);
+    if (b) *p = (uint8_t)((*p & ~b) | (color & b));
+    p++;
+    m <<= 4;
+  }
+  while (m) {
+    uint8_t b = (uint8_t)(m >> 24);
+    if (b) *p = (uint8_t)((*p & ~b) | (color & b));
+    p++;
+    m <<= 8;
+  }
 }
 
 static void draw_char(int x, int y, char c, uint8_t gray) {
-  if (c < 32 || c > 127) c = '?';
-  
-  if (g_current_font == 0) {
-    // 5x7 font
-    const uint8_t* col = font5x7[(int)c - 32];
-    for (int cx=0; cx<5; cx++) {
-      uint8_t bits = col[cx];
-      for (int cy=0; cy<7; cy++) if (bits & (1u<<cy)) ui_gfx_pixel(x+cx, y+cy, gray);
-    }
-  } else {
-    // 8x8 font
-    const uint8_t* rows = font8x8[(int)c - 32];
-    for (int cy=0; cy<8; cy++) {
-      uint8_t bits = rows[cy];
-      for (int cx=0; cx<8; cx++) {
-        if (bits & (0x80 >> cx)) ui_gfx_pixel(x+cx, y+cy, gray);
-      }
-    }
+  GFX_STAT(glyphs);
+  uint8_t uc = (uint8_t)c;
+  if (uc < 32 || uc > 127) uc = '?';
+
+  const uint32_t* rows;
+  int nrows;
+  if (g_current_font == 0) { rows = font5x7[uc - 32]; nrows = 7; }
+  else                     { rows = font8x8[uc - 32]; nrows = 8; }
+
+  // Vertical clip
+  int r0 = y < 0 ? -y : 0;
+  int r1 = y + nrows > (int)g_h ? (int)g_h - y : nrows;
+  if (r0 >= r1) return;
+
+  // Horizontal clip: shift off columns left of 0, mask columns past g_w
+  uint32_t keep = 0xFFFFFFFFu;
+  if (x < 0) {
+    if (x <= -8) return;
+    keep >>= 4 * -x;
+  }
+  if (x + 8 > (int)g_w) {
+    int vis = (int)g_w - x;
+    if (vis <= 0) return;
+    keep &= ~(0xFFFFFFFFu >> (4 * vis));
+  }
+  int shift = x < 0 ? 4 * -x : 0;
+  int px = x < 0 ? 0 : x;
+
+  uint8_t color = (uint8_t)((gray & 0x0F) * 0x11u);
+  uint32_t stride = g_w >> 1;
+  uint8_t* p = &g_fb[(uint32_t)(y + r0) * stride + ((uint32_t)px >> 1)];
+  for (int r = r0; r < r1; r++, p += stride) {
+    uint32_t m = rows[r] & keep;
+    if (m) blit_row(p, px & 1, m << shift, color);
   }
 }
 
 void ui_gfx_text(int x, int y, const char* s, uint8_t gray) {
-  if (!s) return;
+  if (!g_fb || !s) return;
   int cx = x;
   int char_width = (g_current_font == 0) ? 6 : 9;  // 5+1 or 8+1
   int line_height = (g_current_font == 0) ? 8 : 10; // 7+1 or 8+2
@@ -202,19 +316,36 @@ void ui_gfx_fill_rect(int x, int y, int w, int h, uint8_t gray) {
 }
 
 void ui_gfx_hline(int x, int y, int w, uint8_t gray) {
-  for (int xx = 0; xx < w; xx++) {
-    ui_gfx_pixel(x + xx, y, gray);
-  }
+  ui_gfx_rect(x, y, w, 1, gray);
 }
 
 void ui_gfx_vline(int x, int y, int h, uint8_t gray) {
-  for (int yy = 0; yy < h; yy++) {
-    ui_gfx_pixel(x, y + yy, gray);
-  }
+  if (!g_fb || h <= 0 || x < 0 || x >= (int)g_w) return;
+  int y0 = y < 0 ? 0 : y;
+  int y1 = y + h > (int)g_h ? (int)g_h : y + h;
+  if (y0 >= y1) return;
+  // Same nibble in every row: step down by one row stride
+  uint32_t stride = g_w >> 1;
+  uint8_t* p = &g_fb[(uint32_t)y0 * stride + ((uint32_t)x >> 1)];
+  uint8_t keep = (x & 1) ? 0xF0 : 0x0F;
+  uint8_t val = (x & 1) ? (gray & 0x0F) : (uint8_t)((gray & 0x0F) << 4);
+  for (int yy = y0; yy < y1; yy++, p += stride) *p = (uint8_t)((*p & keep) | val);
 }
 
-// Bresenham's line algorithm
+// Bresenham's line algorithm; horizontal and vertical lines, and the
+// horizontal runs of shallow lines, are drawn as spans
 void ui_gfx_line(int x0, int y0, int x1, int y1, uint8_t gray) {
+  if (y0 == y1) {
+    if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+    ui_gfx_hline(x0, y0, x1 - x0 + 1, gray);
+    return;
+  }
+  if (x0 == x1) {
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+    ui_gfx_vline(x0, y0, y1 - y0 + 1, gray);
+    return;
+  }
+
   int dx = x1 - x0;
   int dy = y1 - y0;
   
@@ -225,22 +356,32 @@ void ui_gfx_line(int x0, int y0, int x1, int y1, uint8_t gray) {
   dy = abs(dy);
   
   int err = dx - dy;
+  int run_x = x0;  // first pixel of the current horizontal run
   
   while (1) {
-    ui_gfx_pixel(x0, y0, gray);
-    
     if (x0 == x1 && y0 == y1) break;
     
     int e2 = 2 * err;
+    int step_y = 0;
     if (e2 > -dy) {
       err -= dy;
       x0 += sx;
     }
     if (e2 < dx) {
       err += dx;
+      step_y = 1;
+    }
+    if (step_y) {
+      // Row finished: emit the run up to the pixel before the x step
+      int end = (e2 > -dy) ? x0 - sx : x0;
+      if (run_x <= end) ui_gfx_hline(run_x, y0, end - run_x + 1, gray);
+      else              ui_gfx_hline(end, y0, run_x - end + 1, gray);
       y0 += sy;
+      run_x = x0;
     }
   }
+  if (run_x <= x0) ui_gfx_hline(run_x, y0, x0 - run_x + 1, gray);
+  else             ui_gfx_hline(x0, y0, run_x - x0 + 1, gray);
 }
 
 // Midpoint circle algorithm
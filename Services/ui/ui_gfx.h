@@ -36,6 +36,25 @@ void ui_gfx_triangle(int x0, int y0, int x1, int y1, int x2, int y2, uint8_t gra
 void ui_gfx_filled_triangle(int x0, int y0, int x1, int y1, int x2, int y2, uint8_t gray);
 void ui_gfx_arc(int cx, int cy, int radius, int start_angle, int end_angle, uint8_t gray);
 
+// Raster caching: copy full framebuffer rows [y, y+h) out to / back from a
+// caller buffer of h * (width / 2) bytes. Return 0 on success, -1 if the
+// rows are outside the framebuffer.
+int ui_gfx_save_rows(int y, int h, uint8_t* dst);
+int ui_gfx_restore_rows(int y, int h, const uint8_t* src);
+
+#ifdef UI_GFX_STATS
+// Draw-call counters, compiled in only for host profiling builds
+// (Tests/ui_host) so the firmware primitives stay counter-free.
+typedef struct {
+  uint32_t pixel_calls;  // ui_gfx_pixel() calls, direct or from other primitives
+  uint32_t spans;        // horizontal span fills
+  uint32_t glyphs;       // characters drawn
+} ui_gfx_stats_t;
+
+void ui_gfx_get_stats(ui_gfx_stats_t* out);
+void ui_gfx_reset_stats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,18 +39,8 @@ static uint32_t xorshift32(void) {
   return x;
 }
 
-#define MAX_EVT 768
-#define MAX_NOTES 256
-
-typedef struct {
-  uint32_t on_idx;
-  uint32_t off_idx;     // 0xFFFFFFFF if implicit
-  uint32_t start;
-  uint32_t end;
-  uint8_t  ch;
-  uint8_t  note;
-  uint8_t  vel;
-} note_span_t;
+// Note spans come pre-paired from the looper snapshot (read-only)
+typedef looper_note_span_t note_span_t;
 
 static uint8_t g_track = 0;
 static uint32_t g_cursor = 0;
@@ -62,87 +52,76 @@ static uint32_t g_sel = 0;
 static uint8_t g_edit = 0;
 static uint8_t g_field = 0; // 0 start, 1 len, 2 note, 3 vel
 
-static looper_event_view_t ev[MAX_EVT];
-static uint32_t ev_n = 0;
-
-static note_span_t notes[MAX_NOTES];
+// Read-only view published by the looper; only rebuilt when the track changes
+static const looper_snapshot_t* g_snap = NULL;
+static const note_span_t* notes = NULL;
 static uint32_t notes_n = 0;
 
-// simple active map for pairing within one loop
-typedef struct { uint32_t on_idx; uint32_t start; uint8_t vel; uint8_t valid; } active_t;
-// Large array (24KB) - placed in CCMRAM to save regular RAM for other systems
-// This is similar to looper g_tr placement - high-performance lookup table
-static active_t active[16][128] __attribute__((section(".ccmram")));
+// Working copy of the selected note while in edit mode (applied on B4)
+static note_span_t g_edit_note;
 
-static uint8_t is_note_on(const looper_event_view_t* e) {
-  return (e->len==3) && ((e->b0 & 0xF0)==0x90) && e->b2!=0;
-}
-static uint8_t is_note_off(const looper_event_view_t* e) {
-  return (e->len==3) && ( ((e->b0 & 0xF0)==0x80) || (((e->b0 & 0xF0)==0x90) && e->b2==0) );
-}
+// Start-tick index over the snapshot spans: span numbers ordered by
+// (start % loop length). Rebuilt only when the track, generation or loop
+// length changes, so scrolling, zooming and selecting just binary-search it.
+static uint16_t idx_span[LOOPER_SNAPSHOT_MAX_SPANS];
+static uint32_t idx_start[LOOPER_SNAPSHOT_MAX_SPANS];
+static uint32_t idx_gen = 0;
+static uint32_t idx_len = 0;
+static uint8_t idx_track = 0xFF;
 
 static uint32_t loop_len(void) {
-  uint32_t L = looper_get_loop_len_ticks(g_track);
+  uint32_t L = g_snap ? g_snap->loop_len_ticks : looper_get_loop_len_ticks(g_track);
   if (L == 0) L = 96u * 4u;
   return L;
 }
 
-static void refresh_snapshot(void) {
-  ev_n = looper_export_events(g_track, ev, MAX_EVT);
-
-  memset(active, 0, sizeof(active));
-  notes_n = 0;
-
+static void index_rebuild(void) {
   uint32_t L = loop_len();
-
-  for (uint32_t i=0; i<ev_n && notes_n<MAX_NOTES; i++) {
-    looper_event_view_t* e = &ev[i];
-    if (e->len != 3) continue;
-    uint8_t ch = e->b0 & 0x0F;
-    uint8_t note = e->b1;
-
-    if (is_note_on(e)) {
-      active[ch][note].on_idx = e->idx;
-      active[ch][note].start = e->tick;
-      active[ch][note].vel = e->b2;
-      active[ch][note].valid = 1;
-    } else if (is_note_off(e)) {
-      if (active[ch][note].valid) {
-        note_span_t* n = &notes[notes_n++];
-        n->on_idx = active[ch][note].on_idx;
-        n->off_idx = e->idx;
-        n->start = active[ch][note].start;
-        n->end = e->tick;
-        n->ch = ch;
-        n->note = note;
-        n->vel = active[ch][note].vel;
-        active[ch][note].valid = 0;
-
-        // handle wrap: if end < start, assume wrap to next loop
-        if (n->end <= n->start) n->end += L;
-      }
+  idx_track = g_track;
+  idx_gen = g_snap ? g_snap->gen : 0;
+  idx_len = L;
+  // Spans come sorted by start, so this insertion sort is a single pass
+  // unless the loop got shorter than some recorded ticks.
+  for (uint32_t i=0; i<notes_n; i++) {
+    uint32_t st = notes[i].start % L;
+    uint32_t j = i;
+    while (j > 0 && idx_start[j-1] > st) {
+      idx_start[j] = idx_start[j-1];
+      idx_span[j] = idx_span[j-1];
+      j--;
     }
+    idx_start[j] = st;
+    idx_span[j] = (uint16_t)i;
   }
+}
 
-  // Any notes still active: implicit end at loop end
-  for (uint8_t ch=0; ch<16 && notes_n<MAX_NOTES; ch++) {
-    for (uint16_t note=0; note<128 && notes_n<MAX_NOTES; note++) {
-      if (active[ch][note].valid) {
-        note_span_t* n = &notes[notes_n++];
-        n->on_idx = active[ch][note].on_idx;
-        n->off_idx = 0xFFFFFFFFu;
-        n->start = active[ch][note].start;
-        n->end = L;
-        n->ch = ch;
-        n->note = (uint8_t)note;
-        n->vel = active[ch][note].vel;
-        if (n->end <= n->start) n->end = n->start + 1;
-      }
-    }
+// First index position with start >= tick (notes_n if none)
+static uint32_t index_lower_bound(uint32_t tick) {
+  uint32_t lo = 0, hi = notes_n;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) >> 1;
+    if (idx_start[mid] < tick) lo = mid + 1u;
+    else hi = mid;
   }
+  return lo;
+}
+
+static void refresh_snapshot(void) {
+  g_snap = looper_snapshot_get(g_track);
+  notes = g_snap ? g_snap->spans : NULL;
+  notes_n = g_snap ? g_snap->span_count : 0;
 
   if (notes_n == 0) g_sel = 0;
   else if (g_sel >= notes_n) g_sel = notes_n-1;
+
+  uint32_t gen = g_snap ? g_snap->gen : 0;
+  if (idx_track != g_track || idx_gen != gen || idx_len != loop_len()) index_rebuild();
+}
+
+// Selected note as shown: the edit copy while editing, the snapshot otherwise
+static const note_span_t* selected_note(void) {
+  if (!notes_n) return NULL;
+  return g_edit ? &g_edit_note : &notes[g_sel];
 }
 
 static uint32_t tick_to_x(uint32_t tick, uint32_t base, uint32_t span) {
@@ -210,40 +189,61 @@ static void draw_cursor(uint32_t base, uint32_t span) {
   }
 }
 
+static void draw_note(const note_span_t* n, uint8_t selected, uint32_t base, uint32_t span) {
+  uint32_t L = loop_len();
+  uint32_t s = n->start;
+  uint32_t e = n->end;
+  // map end possibly beyond L (wrap) by modulo for display near start
+  uint32_t sx = tick_to_x(s % L, base, span);
+  if (sx == 0xFFFFFFFFu) return;
+  uint32_t ex = tick_to_x((e % L), base, span);
+  if (ex == 0xFFFFFFFFu) ex = 255;
+  int y = note_to_y(n->note);
+  int w = (int)ex - (int)sx;
+  if (w < 2) w = 2;
+  
+  // LoopA-style: Use velocity for brightness (more visual feedback)
+  // Selected notes get max brightness, others scale with velocity
+  uint8_t g;
+  if (selected) {
+    g = 15; // Selected note is always brightest
+  } else {
+    // Map velocity (0-127) to grayscale (6-13) for better contrast
+    g = 6 + ((uint32_t)n->vel * 7) / 127;
+  }
+  
+  // LoopA-style: Taller note bars (4px instead of 3px)
+  ui_gfx_fill_rect((int)sx, y, w, 4, g);
+  
+  // Draw note border for better definition (selected notes only)
+  if (selected) {
+    ui_gfx_hline((int)sx, y, w, 15);
+    ui_gfx_hline((int)sx, y+3, w, 15);
+  }
+}
+
+static void draw_index_range(uint32_t from, uint32_t to, uint32_t base, uint32_t span) {
+  for (uint32_t k=from; k<to; k++) {
+    uint32_t i = idx_span[k];
+    if (i != g_sel) draw_note(&notes[i], 0, base, span);
+  }
+}
+
+// Only notes starting inside the window [base, base+span) are drawn. The
+// window may wrap past the loop end; the wrapped part is drawn first so the
+// order matches start-tick order.
 static void draw_notes(uint32_t base, uint32_t span) {
+  if (!notes_n) return;
   uint32_t L = loop_len();
-  for (uint32_t i=0;i<notes_n;i++) {
-    note_span_t* n = &notes[i];
-    uint32_t s = n->start;
-    uint32_t e = n->end;
-    // map end possibly beyond L (wrap) by modulo for display near start
-    uint32_t sx = tick_to_x(s % L, base, span);
-    if (sx == 0xFFFFFFFFu) continue;
-    uint32_t ex = tick_to_x((e % L), base, span);
-    if (ex == 0xFFFFFFFFu) ex = 255;
-    int y = note_to_y(n->note);
-    int w = (int)ex - (int)sx;
-    if (w < 2) w = 2;
-    
-    // LoopA-style: Use velocity for brightness (more visual feedback)
-    // Selected notes get max brightness, others scale with velocity
-    uint8_t g;
-    if (i == g_sel) {
-      g = 15; // Selected note is always brightest
-    } else {
-      // Map velocity (0-127) to grayscale (6-13) for better contrast
-      g = 6 + ((uint32_t)n->vel * 7) / 127;
-    }
-    
-    // LoopA-style: Taller note bars (4px instead of 3px)
-    ui_gfx_fill_rect((int)sx, y, w, 4, g);
-    
-    // Draw note border for better definition (selected notes only)
-    if (i == g_sel) {
-      ui_gfx_hline((int)sx, y, w, 15);
-      ui_gfx_hline((int)sx, y+3, w, 15);
-    }
+  uint32_t end = base + span;
+  if (end > L) {
+    draw_index_range(0, index_lower_bound(end - L), base, span);
+    end = L;
   }
+  draw_index_range(index_lower_bound(base), index_lower_bound(end), base, span);
+
+  // Selected note last (on top); in edit mode it may have moved
+  draw_note(selected_note(), 1, base, span);
 }
 
 static void apply_zoom(void) {
@@ -257,19 +257,14 @@ static void draw_footer(void) {
   else         ui_gfx_text(0, 56, "ENC:chg B3:field B4:apply B2:cancel B1:del", 10);
 }
 
+// Nearest note starting at or after the cursor, wrapping to the loop start
 static void select_nearest(void) {
   if (!notes_n) return;
-  uint32_t L = loop_len();
-  uint32_t best = 0;
-  uint32_t best_dt = 0xFFFFFFFFu;
-  for (uint32_t i=0;i<notes_n;i++) {
-    uint32_t dt = (notes[i].start + L - g_cursor) % L;
-    if (dt < best_dt) { best_dt = dt; best = i; }
-  }
-  g_sel = best;
+  uint32_t k = index_lower_bound(g_cursor % loop_len());
+  g_sel = idx_span[(k < notes_n) ? k : 0];
 }
 
-static void apply_edit(note_span_t* n) {
+static void apply_edit(const note_span_t* n) {
   uint32_t L = loop_len();
   looper_quant_t q = looper_get_quant(g_track);
   uint32_t step = quant_step_ticks(q);
@@ -288,16 +283,16 @@ static void apply_edit(note_span_t* n) {
 
   // edit or create NOTE OFF
   uint8_t off_status = 0x80 | (n->ch & 0x0F);
-  if (n->off_idx != 0xFFFFFFFFu) {
+  if (n->off_idx != LOOPER_SPAN_NO_OFF) {
     (void)looper_edit_event(g_track, n->off_idx, end_tick, 3, off_status, n->note, 0);
   } else {
     (void)looper_add_event(g_track, end_tick, 3, off_status, n->note, 0);
   }
 }
 
-static void delete_note(note_span_t* n) {
+static void delete_note(const note_span_t* n) {
   // delete note off first (if exists), then note on
-  if (n->off_idx != 0xFFFFFFFFu) (void)looper_delete_event(g_track, n->off_idx);
+  if (n->off_idx != LOOPER_SPAN_NO_OFF) (void)looper_delete_event(g_track, n->off_idx);
   (void)looper_delete_event(g_track, n->on_idx);
 }
 
@@ -318,7 +313,7 @@ void ui_page_looper_pianoroll_render(uint32_t now_ms) {
 
   if (notes_n) {
     char inf[64];
-    note_span_t* n = &notes[g_sel];
+    const note_span_t* n = selected_note();
     uint32_t L = loop_len();
     uint32_t dur = (n->end > n->start) ? (n->end - n->start) : 1;
     snprintf(inf, sizeof(inf), "idx:%lu st:%lu dur:%lu n:%u v:%u",
@@ -344,7 +339,10 @@ void ui_page_looper_pianoroll_on_button(uint8_t id, uint8_t pressed) {
       case 1: g_track = (uint8_t)((g_track + 1) % LOOPER_TRACKS); g_cursor = 0; g_sel = 0; break;
       case 2: g_zoom = (uint8_t)((g_zoom + 1) % (sizeof(zoom_ticks)/sizeof(zoom_ticks[0]))); break;
       case 3: select_nearest(); break;
-      case 4: g_edit = 1; g_field = 0; break;
+      case 4:
+        if (notes_n) g_edit_note = notes[g_sel];
+        g_edit = 1; g_field = 0;
+        break;
       case 6: { // duplicate selected note forward by 1 quant step (or 1/16)
         if (!notes_n) break;
         uint32_t L = loop_len();
@@ -398,7 +396,7 @@ void ui_page_looper_pianoroll_on_button(uint8_t id, uint8_t pressed) {
       case 2: g_edit = 0; break; // cancel
       case 3: g_field = (uint8_t)((g_field + 1) % 4); break;
       case 4:
-        if (notes_n) apply_edit(&notes[g_sel]);
+        if (notes_n) apply_edit(&g_edit_note);
         g_edit = 0;
         break;
       default: break;
@@ -419,7 +417,7 @@ void ui_page_looper_pianoroll_on_encoder(int8_t delta) {
     g_cursor = wrap_tick_i32(g_cursor, dt, L);
   } else {
     if (!notes_n) return;
-    note_span_t* n = &notes[g_sel];
+    note_span_t* n = &g_edit_note;
     uint32_t qstep = quant_step_ticks(looper_get_quant(g_track));
     if (g_field == 0) {
       int32_t dt = (int32_t)delta * 4;
@@ -12,8 +12,6 @@ static inline uint32_t wrap_tick_i32(uint32_t cur, int32_t d, uint32_t L){
   return (uint32_t)x;
 }
 
-#define MAX_SNAP 320  // Event snapshot buffer for timeline display (minimum acceptable value, cannot go below 320)
-
 // shared state (kept simple)
 static uint8_t g_track = 0;
 static uint32_t g_cursor_tick = 0;
@@ -25,25 +23,53 @@ static uint32_t g_sel_idx = 0;
 static uint8_t g_in_edit = 0;
 static uint8_t g_edit_field = 0; // 0 tick, 1 note, 2 vel
 
-static looper_event_view_t snap[MAX_SNAP];
+// Read-only view published by the looper; only rebuilt when the track changes
+static const looper_snapshot_t* g_snap = NULL;
+static const looper_event_view_t* snap = NULL;
 static uint32_t snap_n = 0;
 
+// Working copy of the selected event while in edit mode (applied on B4)
+static looper_event_view_t g_edit_ev;
+
+// Cached lane raster (rows TL_CACHE_Y..63): grid, loop markers and every
+// event except the selected one. Only the playhead, edit cursor, selection
+// and text are drawn per frame; the lanes are re-rasterized when the track,
+// looper generation, zoom, scroll position or selection changes.
+#define TL_CACHE_Y  8
+#define TL_CACHE_H  (64 - TL_CACHE_Y)
+static uint8_t g_lane_cache[TL_CACHE_H * (256 / 2)];
+static uint8_t g_lane_valid = 0;
+static uint8_t g_lane_track;
+static uint8_t g_lane_zoom;
+static uint32_t g_lane_gen;
+static uint32_t g_lane_base;
+static uint32_t g_lane_sel;
+static uint32_t g_lane_len;
+
 static uint8_t is_note_on(const looper_event_view_t* e) {
   return (e->len == 3) && ((e->b0 & 0xF0) == 0x90) && (e->b2 != 0);
 }
 
 static void refresh_snapshot(void) {
-  snap_n = looper_export_events(g_track, snap, MAX_SNAP);
+  g_snap = looper_snapshot_get(g_track);
+  snap = g_snap ? g_snap->events : NULL;
+  snap_n = g_snap ? g_snap->event_count : 0;
   if (snap_n == 0) g_sel_idx = 0;
   else if (g_sel_idx >= snap_n) g_sel_idx = snap_n - 1;
 }
 
 static uint32_t loop_len(void) {
-  uint32_t L = looper_get_loop_len_ticks(g_track);
+  uint32_t L = g_snap ? g_snap->loop_len_ticks : looper_get_loop_len_ticks(g_track);
   if (L == 0) L = 96u * 4u;
   return L;
 }
 
+// Selected event as shown: the edit copy while editing, the snapshot otherwise
+static const looper_event_view_t* selected_event(void) {
+  if (snap_n == 0) return NULL;
+  return g_in_edit ? &g_edit_ev : &snap[g_sel_idx];
+}
+
 static uint32_t tick_to_x(uint32_t tick, uint32_t base, uint32_t span) {
   uint32_t dt = (tick + loop_len() - base) % loop_len();
   if (dt >= span) return 0xFFFFFFFFu;
@@ -120,30 +146,35 @@ static void draw_playhead(uint32_t base, uint32_t span) {
   }
 }
 
+static void draw_event(const looper_event_view_t* e, uint8_t selected, uint32_t base, uint32_t span) {
+  if (!is_note_on(e)) return;
+  uint32_t x = tick_to_x(e->tick, base, span);
+  if (x == 0xFFFFFFFFu) return;
+  int y = note_to_y(e->b1);
+  
+  // LoopA-style: Show velocity through brightness
+  uint8_t vel = e->b2;
+  uint8_t g;
+  if (selected) {
+    g = 15; // Selected event is brightest
+  } else {
+    // Map velocity to brightness (6-12 range)
+    g = 6 + ((uint32_t)vel * 6) / 127;
+  }
+  
+  // LoopA-style: Larger event markers (3x3 instead of 2x2)
+  ui_gfx_fill_rect((int)x-1, y-1, 3, 3, g);
+  
+  // Add border to selected events
+  if (selected) {
+    ui_gfx_rect((int)x-1, y-1, 3, 3, 15);
+  }
+}
+
+// All events except the selected one (drawn on top by the render loop)
 static void draw_events(uint32_t base, uint32_t span) {
   for (uint32_t i=0; i<snap_n; i++) {
-    if (!is_note_on(&snap[i])) continue;
-    uint32_t x = tick_to_x(snap[i].tick, base, span);
-    if (x == 0xFFFFFFFFu) continue;
-    int y = note_to_y(snap[i].b1);
-    
-    // LoopA-style: Show velocity through brightness
-    uint8_t vel = snap[i].b2;
-    uint8_t g;
-    if (i == g_sel_idx) {
-      g = 15; // Selected event is brightest
-    } else {
-      // Map velocity to brightness (6-12 range)
-      g = 6 + ((uint32_t)vel * 6) / 127;
-    }
-    
-    // LoopA-style: Larger event markers (3x3 instead of 2x2)
-    ui_gfx_fill_rect((int)x-1, y-1, 3, 3, g);
-    
-    // Add border to selected events
-    if (i == g_sel_idx) {
-      ui_gfx_rect((int)x-1, y-1, 3, 3, 15);
-    }
+    if (i != g_sel_idx) draw_event(&snap[i], 0, base, span);
   }
 }
 
@@ -165,7 +196,6 @@ static void draw_header(void) {
            (unsigned)(g_track+1), (unsigned)tp.bpm, (unsigned)g_zoom,
            (unsigned)loop_bars, state_str);
   ui_gfx_text(0, 0, line, 15);
-  ui_gfx_hline(0, 11, 256, 8);
 }
 
 static void apply_zoom(void) {
@@ -208,22 +238,41 @@ void ui_page_looper_timeline_render(uint32_t now_ms) {
 
   uint32_t span = zoom_ticks[g_zoom];
   uint32_t base = g_cursor_tick;
+  uint32_t gen = g_snap ? g_snap->gen : 0;
+
+  if (g_lane_valid && g_lane_track == g_track && g_lane_gen == gen &&
+      g_lane_zoom == g_zoom && g_lane_base == base &&
+      g_lane_sel == g_sel_idx && g_lane_len == loop_len()) {
+    ui_gfx_restore_rows(TL_CACHE_Y, TL_CACHE_H, g_lane_cache);
+  } else {
+    ui_gfx_hline(0, 11, 256, 8);  // header separator
+
+    // simple grid: 4 vertical lines
+    for (int i=0;i<4;i++) {
+      int x = i * 64;
+      ui_gfx_rect(x, 10, 1, 54, 2);
+    }
+
+    draw_loop_region(base, span);  // Draw loop bounds first
+    draw_events(base, span);
 
-  // simple grid: 4 vertical lines
-  for (int i=0;i<4;i++) {
-    int x = i * 64;
-    ui_gfx_rect(x, 10, 1, 54, 2);
+    g_lane_valid = (ui_gfx_save_rows(TL_CACHE_Y, TL_CACHE_H, g_lane_cache) == 0);
+    g_lane_track = g_track;
+    g_lane_gen = gen;
+    g_lane_zoom = g_zoom;
+    g_lane_base = base;
+    g_lane_sel = g_sel_idx;
+    g_lane_len = loop_len();
   }
 
-  draw_loop_region(base, span);  // Draw loop bounds first
-  draw_events(base, span);
+  if (snap_n) draw_event(selected_event(), 1, base, span);
   draw_playhead(base, span);     // Draw playhead on top
   draw_cursor(base, span);       // Draw edit cursor last
 
   // selected event info
   if (snap_n) {
     char inf[64];
-    looper_event_view_t* e = &snap[g_sel_idx];
+    const looper_event_view_t* e = selected_event();
     snprintf(inf, sizeof(inf), "idx:%lu tick:%lu note:%u vel:%u",
              (unsigned long)g_sel_idx, (unsigned long)e->tick, (unsigned)e->b1, (unsigned)e->b2);
     ui_gfx_text(0, 46, inf, 10);
@@ -245,7 +294,11 @@ void ui_page_looper_timeline_on_button(uint8_t id, uint8_t pressed) {
       case 1: g_track = (uint8_t)((g_track + 1) % LOOPER_TRACKS); g_cursor_tick = 0; g_sel_idx = 0; break;
       case 2: g_zoom = (uint8_t)((g_zoom + 1) % (sizeof(zoom_ticks)/sizeof(zoom_ticks[0]))); break;
       case 3: select_nearest(); break;
-      case 4: g_in_edit = 1; g_edit_field = 0; break;
+      case 4:
+        refresh_snapshot();
+        if (snap_n) g_edit_ev = snap[g_sel_idx];
+        g_in_edit = 1; g_edit_field = 0;
+        break;
       default: break;
     }
   } else {
@@ -254,7 +307,7 @@ void ui_page_looper_timeline_on_button(uint8_t id, uint8_t pressed) {
       case 3: g_edit_field = (uint8_t)((g_edit_field + 1) % 3); break;
       case 4: {
         if (snap_n == 0) { g_in_edit = 0; break; }
-        looper_event_view_t* e = &snap[g_sel_idx];
+        const looper_event_view_t* e = &g_edit_ev;
         (void)looper_edit_event(g_track, e->idx, e->tick, e->len, e->b0, e->b1, e->b2);
         g_in_edit = 0;
       } break;
@@ -276,7 +329,7 @@ void ui_page_looper_timeline_on_encoder(int8_t delta) {
     g_cursor_tick = wrap_tick_i32(g_cursor_tick, dt, L);
   } else {
     if (snap_n == 0) return;
-    looper_event_view_t* e = &snap[g_sel_idx];
+    looper_event_view_t* e = &g_edit_ev;
     if (g_edit_field == 0) {
       // tick fine adjust
       int32_t dt = (int32_t)delta * 4;
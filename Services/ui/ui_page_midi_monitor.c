@@ -14,6 +14,7 @@
 #include "Services/midi_monitor/midi_monitor.h"
 #include "Config/module_config.h"
 #include "stm32f4xx_hal.h"
+#include "cmsis_os2.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
@@ -55,12 +56,38 @@ static uint8_t event_count = 0;
 static uint8_t scroll_offset = 0;
 static uint32_t last_update_time = 0;
 
+// Redraw tracking for ui.c invalidation: bumped on every captured message
+// (single writer: the router/main task), compared against the value the
+// last drawn frame showed.
+static volatile uint32_t capture_gen = 0;
+static uint32_t drawn_gen = 0;
+static uint8_t redraw_pending = 1;  // a render was throttled, or never drawn
+
+// The buffer is written by the router (main task) and read by the renderer
+// (UiTask in task mode): both sides hold this mutex, the renderer only while
+// it copies the events out
+static osMutexId_t g_event_mutex;
+
+static void event_lock(void) {
+  if (osKernelGetState() != osKernelRunning) return;
+  if (g_event_mutex == NULL) {
+    const osMutexAttr_t attr = { .name = "ui_midimon", .attr_bits = osMutexPrioInherit };
+    g_event_mutex = osMutexNew(&attr);
+  }
+  if (g_event_mutex) osMutexAcquire(g_event_mutex, osWaitForever);
+}
+
+static void event_unlock(void) {
+  if (osKernelGetState() == osKernelRunning && g_event_mutex) osMutexRelease(g_event_mutex);
+}
+
 /**
  * @brief Add a MIDI event to the monitor (called by MIDI monitor service or router hooks)
  */
 void ui_midi_monitor_capture(uint8_t node, const uint8_t* data, uint8_t len, uint32_t timestamp_ms, uint8_t is_routed) {
   if (config.paused || len == 0 || len > 3) return;
   
+  event_lock();
   // Add to circular buffer
   event_buffer[event_write_idx].timestamp_ms = timestamp_ms;
   event_buffer[event_write_idx].node = node;
@@ -79,6 +106,8 @@ void ui_midi_monitor_capture(uint8_t node, const uint8_t* data, uint8_t len, uin
   if (config.auto_scroll) {
     scroll_offset = 0;
   }
+  capture_gen++;
+  event_unlock();
 }
 
 /**
@@ -87,9 +116,22 @@ void ui_midi_monitor_capture(uint8_t node, const uint8_t* data, uint8_t len, uin
 void ui_page_midi_monitor_render(uint32_t now_ms) {
   // Throttle updates
   if (now_ms - last_update_time < config.update_rate_ms) {
+    redraw_pending = 1;
     return;
   }
   last_update_time = now_ms;
+  redraw_pending = 0;
+  
+  // Copy the events out (newest first) and format them unlocked
+  midi_event_t shown[MONITOR_BUFFER_SIZE];
+  event_lock();
+  drawn_gen = capture_gen;
+  uint8_t count = event_count;
+  uint8_t visible_count = (count < MONITOR_BUFFER_SIZE) ? count : MONITOR_BUFFER_SIZE;
+  for (uint8_t i = 0; i < visible_count; i++) {
+    shown[i] = event_buffer[(event_write_idx - 1 - i + MONITOR_BUFFER_SIZE) % MONITOR_BUFFER_SIZE];
+  }
+  event_unlock();
   
   ui_gfx_clear(0);
   
@@ -98,19 +140,13 @@ void ui_page_midi_monitor_render(uint32_t now_ms) {
   char header[64];
   
   const char* status = config.paused ? "PAUSED" : "LIVE";
-  snprintf(header, sizeof(header), "MIDI MON [%s] Msgs:%u", status, event_count);
+  snprintf(header, sizeof(header), "MIDI MON [%s] Msgs:%u", status, count);
   ui_gfx_text(0, 0, header, 15);
   ui_gfx_hline(0, 11, 256, 8);
   
   // Display events
-  uint8_t visible_count = (event_count < MONITOR_BUFFER_SIZE) ? event_count : MONITOR_BUFFER_SIZE;
-  
   for (uint8_t i = 0; i < visible_count; i++) {
-    // Calculate buffer index (newest first)
-    uint8_t buf_idx = (event_write_idx - 1 - i + MONITOR_BUFFER_SIZE) % MONITOR_BUFFER_SIZE;
-    if (buf_idx >= MONITOR_BUFFER_SIZE) continue;
-    
-    midi_event_t* ev = &event_buffer[buf_idx];
+    midi_event_t* ev = &shown[i];
     
     char line[80];
     char decoded[40];
@@ -172,6 +208,14 @@ void ui_page_midi_monitor_render(uint32_t now_ms) {
   ui_gfx_text(0, 56, footer, 10);
 }
 
+/**
+ * @brief Check whether the page has something new to show
+ */
+uint8_t ui_page_midi_monitor_needs_redraw(uint32_t now_ms) {
+  if (!redraw_pending && capture_gen == drawn_gen) return 0;
+  return (now_ms - last_update_time >= config.update_rate_ms) ? 1u : 0u;
+}
+
 /**
  * @brief Handle button press in MIDI monitor
  */
@@ -184,9 +228,11 @@ void ui_page_midi_monitor_on_button(uint8_t id, uint8_t pressed) {
       break;
       
     case 2:  // CLEAR buffer
+      event_lock();
       event_count = 0;
       event_write_idx = 0;
       memset(event_buffer, 0, sizeof(event_buffer));
+      event_unlock();
       midi_monitor_clear();  // Also clear MIDI monitor service buffer
       break;
       
@@ -208,6 +254,7 @@ void ui_page_midi_monitor_on_button(uint8_t id, uint8_t pressed) {
  */
 void ui_page_midi_monitor_on_encoder(int8_t delta) {
   // Scroll through event history
+  event_lock();
   if (delta > 0 && scroll_offset > 0) {
     scroll_offset--;
     config.auto_scroll = 0;
@@ -215,6 +262,7 @@ void ui_page_midi_monitor_on_encoder(int8_t delta) {
     scroll_offset++;
     config.auto_scroll = 0;
   }
+  event_unlock();
 }
 
 // ============================================================================
@@ -285,6 +333,7 @@ void ui_page_midi_monitor_print(const char* text) {
   
   // Create a dummy MIDI event to hold the text
   // We'll use node 0xFF to indicate it's a debug message
+  event_lock();
   midi_event_t* ev = &event_buffer[event_write_idx];
   ev->timestamp_ms = timestamp;
   ev->node = 0xFF;  // Special: debug message
@@ -298,6 +347,8 @@ void ui_page_midi_monitor_print(const char* text) {
   if (event_count < MONITOR_BUFFER_SIZE) {
     event_count++;
   }
+  capture_gen++;
+  event_unlock();
 }
 
 /**
@@ -26,6 +26,14 @@ extern "C" {
  */
 void ui_page_midi_monitor_render(uint32_t now_ms);
 
+/**
+ * @brief Check whether a redraw would show anything new
+ * @param now_ms Current time in milliseconds
+ * @return 1 if messages were captured (or a render was throttled) since the
+ *         last drawn frame and the update rate allows a redraw, else 0
+ */
+uint8_t ui_page_midi_monitor_needs_redraw(uint32_t now_ms);
+
 /**
  * @brief Handle button press
  * @param id Button ID (1-4)
@@ -1,4 +1,5 @@
 #include "Services/zones/zones_cfg.h"
+#include "Services/ain/ain.h"  // AIN_NUM_KEYS
 #include <string.h>
 #include <ctype.h>
 #include <stdlib.h>
@@ -108,8 +109,10 @@ int zones_cfg_load_sd(zones_cfg_t* z, const char* path) {
 
   for(int i=0;i<ZONES_MAX;i++){
     zone_t* zn=&z->zone[i];
-    if(zn->key_min>63) zn->key_min=63;
-    if(zn->key_max>63) zn->key_max=63;
+#if AIN_NUM_KEYS < 256u
+    if(zn->key_min>AIN_NUM_KEYS-1u) zn->key_min=(uint8_t)(AIN_NUM_KEYS-1u);
+    if(zn->key_max>AIN_NUM_KEYS-1u) zn->key_max=(uint8_t)(AIN_NUM_KEYS-1u);
+#endif
     if(zn->key_min>zn->key_max){ uint8_t t=zn->key_min; zn->key_min=zn->key_max; zn->key_max=t; }
     if(zn->vel_mul_q7==0) zn->vel_mul_q7=1;
     if(zn->l2_enable>1) zn->l2_enable=1;
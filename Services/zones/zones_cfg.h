@@ -10,8 +10,8 @@ extern "C" {
 
 typedef struct {
   uint8_t enable;
-  uint8_t key_min;
-  uint8_t key_max;
+  uint8_t key_min;       // physical AIN keys (0..AIN_NUM_KEYS-1); the input
+  uint8_t key_max;       // note is the key's note in its 128-key bank
   uint8_t ch[ZONE_LAYERS_MAX];
   uint8_t l2_enable;     // explicit enable for layer2
   uint8_t stack;         // if 1, both layers always active when zone matches
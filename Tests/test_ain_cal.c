@@ -0,0 +1,129 @@
+/**
+ * @file test_ain_cal.c
+ * @brief Host test for the AIN key calibration lifecycle
+ *
+ * Builds Services/ain/ain.c against a fake clock and feeds samples straight
+ * into process_key(): one key is pressed through part of its travel while
+ * calibration LEARNs, another only rests (with ADC noise). Checks that
+ * learning narrows the range to the travel seen, that freezing turns it into
+ * the offset/gain table (the resting key falls back to the full range), that
+ * the frozen scaling matches the learned one, and that entering LEARN again
+ * starts from an empty range.
+ *
+ * To compile and run (from repository root):
+ *   gcc -I. -isystem Middlewares/Third_Party/FreeRTOS/Source/CMSIS_RTOS_V2 \
+ *       -o Tests/test_ain_cal Tests/test_ain_cal.c -lm && ./Tests/test_ain_cal
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "Services/ain/ain.c"
+
+#define REST     600u
+#define BOTTOM   2600u  // partial travel: well short of the 4095 full scale
+#define KEY_PLAY 3u
+#define KEY_REST 12u
+
+static uint32_t g_now;
+
+uint32_t osKernelGetTickCount(void) { return g_now; }
+void hal_ainser64_set_next_step(uint8_t module, uint8_t step) { (void)module; (void)step; }
+int32_t hal_ainser64_read_step_all(uint8_t step, uint16_t (*out)[8]) {
+  (void)step; (void)out; return -1;
+}
+
+// Run a key at a constant raw value long enough for the EMA to settle
+static void hold(uint8_t key, uint16_t raw, uint32_t ms) {
+  for (uint32_t t = 0; t < ms; t++) {
+    g_now++;
+    (void)process_key(key, raw);
+  }
+}
+
+static void press(uint8_t key, uint16_t from, uint16_t to) {
+  for (uint32_t i = 0; i <= 20u; i++) {
+    g_now++;
+    (void)process_key(key, (uint16_t)(from + ((int32_t)to - (int32_t)from) * (int32_t)i / 20));
+  }
+}
+
+static uint32_t count_events(ain_ev_type_t type, uint8_t key) {
+  uint32_t n = 0;
+  ain_event_t e;
+  while (ain_pop_event(&e)) n += (e.type == type && e.key == key);
+  return n;
+}
+
+int main(void) {
+  ain_init();
+  assert(ain_cal_get_mode() == AIN_CAL_LEARN);
+  assert(g_keys[KEY_PLAY].cal_min == 4095u && g_keys[KEY_PLAY].cal_max == 0u);
+
+  // A resting key with a few counts of noise stays at 0: no range learned
+  for (uint32_t i = 0; i < 400u; i++) {
+    g_now++;
+    (void)process_key(KEY_REST, (uint16_t)(REST + (i % 7u)));
+  }
+  assert(g_keys[KEY_REST].pos == 0u);
+  assert(count_events(AIN_EV_NOTE_ON, KEY_REST) == 0u);
+
+  // Partial travel, three presses
+  hold(KEY_PLAY, REST, 50);
+  for (int k = 0; k < 3; k++) {
+    press(KEY_PLAY, REST, BOTTOM);
+    hold(KEY_PLAY, BOTTOM, 30);
+    press(KEY_PLAY, BOTTOM, REST);
+    hold(KEY_PLAY, REST, 30);
+  }
+  assert(g_keys[KEY_PLAY].cal_min == REST);
+  assert(g_keys[KEY_PLAY].cal_max == BOTTOM);
+  assert(count_events(AIN_EV_NOTE_ON, KEY_PLAY) == 3u);
+  uint16_t learned_mid;
+  hold(KEY_PLAY, (REST + BOTTOM) / 2u, 40);
+  learned_mid = g_keys[KEY_PLAY].pos;
+  hold(KEY_PLAY, REST, 40);
+
+  // Freeze: the learned bounds become the table
+  ain_cal_set_mode(AIN_CAL_FROZEN);
+  const key_ctx_t* k = &g_keys[KEY_PLAY];
+  printf("frozen key %u: min %u max %u gain %u\n", KEY_PLAY, k->cal_min, k->cal_max, k->cal_gain);
+  assert(k->cal_min == REST && k->cal_max == BOTTOM);
+  assert(k->base_min == REST && k->base_max == BOTTOM);
+  assert(k->cal_gain == (16383u << 16) / (BOTTOM - REST));
+  // Not enough travel: full range
+  assert(g_keys[KEY_REST].cal_min == 0u && g_keys[KEY_REST].cal_max == 4095u);
+  assert(g_keys[KEY_REST].cal_gain == (16383u << 16) / 4095u);
+
+  // Frozen scaling reaches full scale over the learned travel and agrees
+  // with the LEARN path
+  hold(KEY_PLAY, (REST + BOTTOM) / 2u, 40);
+  printf("mid travel: learn %u, frozen %u\n", learned_mid, k->pos);
+  assert(k->pos + 1u >= learned_mid && k->pos <= learned_mid + 1u);
+  assert(k->pos > 8000u && k->pos < 8400u);
+  hold(KEY_PLAY, BOTTOM, 40);
+  assert(k->pos >= 16300u);
+  hold(KEY_PLAY, REST, 40);
+  assert(k->pos <= 100u);
+  (void)count_events(AIN_EV_NOTE_ON, KEY_PLAY);
+  press(KEY_PLAY, REST, BOTTOM);
+  hold(KEY_PLAY, BOTTOM, 30);
+  assert(count_events(AIN_EV_NOTE_ON, KEY_PLAY) == 1u);
+  press(KEY_PLAY, BOTTOM, REST);
+  hold(KEY_PLAY, REST, 30);
+
+  // DRIFT keeps the frozen table
+  ain_cal_set_mode(AIN_CAL_DRIFT);
+  assert(k->cal_min == REST && k->cal_max == BOTTOM);
+
+  // Back to LEARN: start over from an empty range
+  ain_cal_set_mode(AIN_CAL_LEARN);
+  assert(k->cal_min == 4095u && k->cal_max == 0u && k->cal_gain == 0u);
+  hold(KEY_PLAY, REST, 10);
+  assert(k->cal_min == REST && k->cal_max == REST && k->pos == 0u);
+
+  printf("ain calibration: ok\n");
+  return 0;
+}
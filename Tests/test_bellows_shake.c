@@ -0,0 +1,235 @@
+/**
+ * @file test_bellows_shake.c
+ * @brief Host test for the bellows shake detector and tremolo outputs
+ *
+ * Feeds Services/bellows_shake/bellows_shake.c the band-passed pressure it
+ * gets from the pressure pipe: synthetic sines sampled at 1 kHz, optionally
+ * with timestamp jitter (each sample is the sine at its own time), and
+ * checks:
+ *   - frequency: bellows_shake_get_frequency_chz() within 0.05 Hz over the
+ *     detection range, nothing detected outside it or below the threshold
+ *   - timeout: detection holds through a pause shorter than
+ *     BELLOWS_SHAKE_TIMEOUT_US and ends after it, outputs back to neutral
+ *   - reset: disabling sends the neutral values at once, re-enabling needs
+ *     two fresh periods
+ *   - outputs: CC11, CC74 and pitchbend are each sent only when their value
+ *     changes, at most once per BELLOWS_SHAKE_OUT_MIN_US, on track 0 and
+ *     the given channel
+ *
+ * To compile and run (from repository root):
+ *   gcc -I. -o Tests/test_bellows_shake Tests/test_bellows_shake.c \
+ *       Services/bellows_shake/bellows_shake.c -lm && ./Tests/test_bellows_shake
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#include "Services/bellows_shake/bellows_shake.h"
+
+#define TRACK    0u
+#define CHANNEL  3u
+#define AMP_PA   200.0
+#define T0_US    987654u  // not on a sample boundary
+
+enum { SLOT_CC11 = 0, SLOT_CC74, SLOT_PB, SLOT_COUNT };
+
+static uint32_t g_t_us;  // time of the sample being processed
+
+static struct {
+  uint32_t n;
+  int16_t last;
+  uint32_t last_us;
+  uint32_t dup;          // sent with the value it already had
+  uint32_t too_fast;     // sent within BELLOWS_SHAKE_OUT_MIN_US of the previous
+  uint32_t bad_route;    // wrong track or channel
+} g_out[SLOT_COUNT];
+
+static const int16_t k_neutral[SLOT_COUNT] = { 64, 64, 0 };
+
+static void out_reset(void) {
+  memset(g_out, 0, sizeof(g_out));
+  for (int s = 0; s < SLOT_COUNT; s++) {
+    g_out[s].last = k_neutral[s];
+    g_out[s].last_us = g_t_us - BELLOWS_SHAKE_OUT_MIN_US;
+  }
+}
+
+static void out_record(int slot, uint8_t track, int16_t value, uint8_t channel) {
+  if (track != TRACK || channel != CHANNEL) g_out[slot].bad_route++;
+  if (value == g_out[slot].last) g_out[slot].dup++;
+  if (g_out[slot].n && g_t_us - g_out[slot].last_us < BELLOWS_SHAKE_OUT_MIN_US) g_out[slot].too_fast++;
+  g_out[slot].n++;
+  g_out[slot].last = value;
+  g_out[slot].last_us = g_t_us;
+}
+
+static void cc_cb(uint8_t track, uint8_t cc_num, uint8_t value, uint8_t channel) {
+  assert(cc_num == 11 || cc_num == 74);
+  out_record(cc_num == 11 ? SLOT_CC11 : SLOT_CC74, track, value, channel);
+}
+
+static void pb_cb(uint8_t track, int16_t pitchbend, uint8_t channel) {
+  assert(pitchbend >= -8192 && pitchbend <= 8191);
+  out_record(SLOT_PB, track, pitchbend, channel);
+}
+
+static void setup(shake_target_t target) {
+  bellows_shake_init();
+  bellows_shake_set_cc_callback(cc_cb);
+  bellows_shake_set_pb_callback(pb_cb);
+  bellows_shake_set_sensitivity(TRACK, 80);  // arms at 64 Pa
+  bellows_shake_set_depth(TRACK, 100);
+  bellows_shake_set_target(TRACK, target);
+  bellows_shake_set_enabled(TRACK, 1);
+  g_t_us = T0_US;
+  out_reset();
+}
+
+// Cheap deterministic jitter in [-j, +j] us
+static int32_t jitter(uint32_t i, int32_t j) {
+  if (!j) return 0;
+  uint32_t h = i * 2654435761u;
+  return (int32_t)(h >> 16) % (2 * j + 1) - j;
+}
+
+// ms of a sine at hz (amplitude amp), then g_t_us is the next sample time
+static void feed_sine(double hz, double amp, uint32_t ms, int32_t jit) {
+  uint32_t base = g_t_us;
+  for (uint32_t i = 0; i < ms; i++) {
+    g_t_us = base + i * 1000u + (uint32_t)jitter(i, jit);
+    double t = (double)(g_t_us - T0_US) * 1e-6;
+    bellows_shake_process_pressure_us(TRACK, (int32_t)lround(amp * sin(2.0 * M_PI * hz * t)), g_t_us, CHANNEL);
+  }
+  g_t_us = base + ms * 1000u;
+}
+
+static void feed_flat(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++, g_t_us += 1000u) {
+    bellows_shake_process_pressure_us(TRACK, 0, g_t_us, CHANNEL);
+  }
+}
+
+static void test_frequency(void) {
+  static const double k_hz[] = { 4.5, 6.0, 7.3, 8.25, 10.0, 11.5 };
+  for (int jit = 0; jit <= 300; jit += 300) {
+    for (size_t i = 0; i < sizeof(k_hz) / sizeof(k_hz[0]); i++) {
+      setup(SHAKE_TARGET_VOLUME);
+      feed_sine(k_hz[i], AMP_PA, 2000, jit);
+      uint16_t chz = bellows_shake_get_frequency_chz(TRACK);
+      int32_t err = (int32_t)chz - (int32_t)lround(k_hz[i] * 100.0);
+      printf("%5.2f Hz, jitter +-%3d us: detected %u, %u.%02u Hz (err %ld chz)\n",
+             k_hz[i], jit, bellows_shake_is_detected(TRACK), chz / 100u, chz % 100u, (long)err);
+      assert(bellows_shake_is_detected(TRACK));
+      assert(err >= -5 && err <= 5);
+      assert(bellows_shake_get_frequency(TRACK) == (uint8_t)((chz + 50u) / 100u));
+    }
+  }
+
+  // Outside the 4..12 Hz default range
+  setup(SHAKE_TARGET_VOLUME);
+  feed_sine(2.5, AMP_PA, 2000, 0);
+  assert(!bellows_shake_is_detected(TRACK) && bellows_shake_get_frequency_chz(TRACK) == 0);
+  setup(SHAKE_TARGET_VOLUME);
+  feed_sine(16.0, AMP_PA, 2000, 0);
+  assert(!bellows_shake_is_detected(TRACK));
+
+  // In range, but the swing never reaches the threshold
+  setup(SHAKE_TARGET_VOLUME);
+  feed_sine(6.0, 50.0, 2000, 0);
+  assert(!bellows_shake_is_detected(TRACK));
+  assert(g_out[SLOT_CC11].n == 0 && g_out[SLOT_PB].n == 0);
+
+  // Disabled tracks see nothing
+  setup(SHAKE_TARGET_VOLUME);
+  bellows_shake_set_enabled(TRACK, 0);
+  feed_sine(6.0, AMP_PA, 2000, 0);
+  assert(!bellows_shake_is_detected(TRACK) && g_out[SLOT_CC11].n == 0);
+}
+
+static void test_timeout_reset(void) {
+  setup(SHAKE_TARGET_VOLUME);
+  feed_sine(6.0, AMP_PA, 1000, 0);
+  assert(bellows_shake_is_detected(TRACK));
+
+  // The shake holds through a short pause (last crossing up to a half
+  // period before the pause), then times out
+  const uint32_t half_ms = 1000u / 12u;
+  feed_flat(BELLOWS_SHAKE_TIMEOUT_US / 1000u - half_ms - 10u);
+  assert(bellows_shake_is_detected(TRACK));
+  feed_flat(half_ms + 20u);
+  printf("timeout: detected %u after %u ms flat, CC11 %d\n", bellows_shake_is_detected(TRACK),
+         BELLOWS_SHAKE_TIMEOUT_US / 1000u + 10u, g_out[SLOT_CC11].last);
+  assert(!bellows_shake_is_detected(TRACK));
+  assert(bellows_shake_get_frequency_chz(TRACK) == 0);
+  assert(bellows_shake_get_modulation(TRACK) == 64);
+  assert(g_out[SLOT_CC11].last == 64);
+
+  // Shaking again: detected after two fresh periods, not on the first
+  feed_sine(6.0, AMP_PA, 200, 0);
+  assert(!bellows_shake_is_detected(TRACK));
+  feed_sine(6.0, AMP_PA, 600, 0);
+  assert(bellows_shake_is_detected(TRACK));
+
+  // Disable mid-shake: neutral at once, even inside the rate limit
+  feed_sine(6.0, AMP_PA, 41, 0);
+  uint32_t n = g_out[SLOT_CC11].n;
+  bellows_shake_set_enabled(TRACK, 0);
+  assert(!bellows_shake_is_detected(TRACK));
+  assert(g_out[SLOT_CC11].last == 64 && g_out[SLOT_CC11].n <= n + 1u);
+
+  // Re-enable: starts from scratch
+  bellows_shake_set_enabled(TRACK, 1);
+  feed_sine(6.0, AMP_PA, 200, 0);
+  assert(!bellows_shake_is_detected(TRACK));
+  feed_sine(6.0, AMP_PA, 600, 0);
+  assert(bellows_shake_is_detected(TRACK));
+}
+
+static void check_outputs(const char* name, uint32_t ms) {
+  uint32_t max_n = ms * 1000u / BELLOWS_SHAKE_OUT_MIN_US + 1u;
+  printf("%s: CC11 %u, CC74 %u, PB %u messages in %u ms (limit %u each)\n",
+         name, g_out[SLOT_CC11].n, g_out[SLOT_CC74].n, g_out[SLOT_PB].n, ms, max_n);
+  for (int s = 0; s < SLOT_COUNT; s++) {
+    assert(g_out[s].dup == 0);
+    assert(g_out[s].too_fast == 0);
+    assert(g_out[s].bad_route == 0);
+    assert(g_out[s].n <= max_n);
+  }
+}
+
+static void test_outputs(void) {
+  const uint32_t ms = 3000;
+
+  setup(SHAKE_TARGET_VOLUME);
+  feed_sine(8.0, AMP_PA, ms, 200);
+  check_outputs("volume", ms);
+  assert(g_out[SLOT_CC11].n > 100u && g_out[SLOT_CC74].n == 0 && g_out[SLOT_PB].n == 0);
+
+  setup(SHAKE_TARGET_BOTH);
+  feed_sine(8.0, AMP_PA, ms, 200);
+  check_outputs("both", ms);
+  assert(g_out[SLOT_CC11].n > 100u && g_out[SLOT_PB].n > 100u && g_out[SLOT_CC74].n == 0);
+
+  // Target change mid-shake: the outputs left behind return to neutral once
+  bellows_shake_set_target(TRACK, SHAKE_TARGET_FILTER);
+  feed_sine(8.0, AMP_PA, 1000, 200);
+  check_outputs("both -> filter", ms + 1000u);
+  assert(g_out[SLOT_CC11].last == 64 && g_out[SLOT_PB].last == 0);
+  assert(g_out[SLOT_CC74].n > 50u);
+
+  // Held modulation (no shake) sends nothing at all
+  setup(SHAKE_TARGET_PITCH);
+  feed_flat(ms);
+  assert(g_out[SLOT_CC11].n == 0 && g_out[SLOT_CC74].n == 0 && g_out[SLOT_PB].n == 0);
+}
+
+int main(void) {
+  test_frequency();
+  test_timeout_reset();
+  test_outputs();
+  printf("All bellows shake tests passed\n");
+  return 0;
+}
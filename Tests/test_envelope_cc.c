@@ -0,0 +1,119 @@
+/**
+ * @file test_envelope_cc.c
+ * @brief Host test for envelope stages with a zero attack or decay time
+ *
+ * Drives Services/envelope_cc/envelope_cc.c through its tick_sched handler
+ * (envelope_cc_service) once per ms and checks:
+ *   - attack 0: the CC jumps to max on the first tick and the decay ramp
+ *     follows, reaching sustain after decay_ms
+ *   - attack 0 and decay 0: max for one tick, then sustain
+ *   - decay 0: the attack ramp goes straight on to sustain
+ *   - sustain is idle for the scheduler (TICK_SCHED_IDLE) and release
+ *     still ramps down to min
+ *
+ * To compile and run (from repository root):
+ *   gcc -I. -o Tests/test_envelope_cc Tests/test_envelope_cc.c \
+ *       Services/envelope_cc/envelope_cc.c Services/tick_sched/tick_sched.c \
+ *       && ./Tests/test_envelope_cc
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "Services/envelope_cc/envelope_cc.h"
+#include "Services/tick_sched/tick_sched.h"
+
+#define TRACK    0u
+#define SUSTAIN  80u
+#define T0_MS    1000u
+
+static uint32_t g_now;
+static uint32_t g_sent;      // CCs sent
+static int g_last = -1;      // last CC value sent
+static uint32_t g_next;      // last delay the handler asked for
+
+static void cc_out(uint8_t track, uint8_t cc, uint8_t value, uint8_t channel) {
+  (void)cc; (void)channel;
+  assert(track == TRACK);
+  g_sent++;
+  g_last = value;
+}
+
+static void run_ms(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) g_next = envelope_cc_service(++g_now);
+}
+
+static void setup(uint16_t attack_ms, uint16_t decay_ms) {
+  envelope_cc_init();
+  envelope_cc_set_callback(cc_out);
+  envelope_cc_set_attack(TRACK, attack_ms);
+  envelope_cc_set_decay(TRACK, decay_ms);
+  envelope_cc_set_sustain(TRACK, SUSTAIN);
+  envelope_cc_set_release(TRACK, 50);
+  envelope_cc_set_enabled(TRACK, 1);
+  g_now = T0_MS;
+  g_sent = 0;
+  g_last = -1;
+  envelope_cc_trigger(TRACK);
+}
+
+static void test_zero_attack(void) {
+  setup(0, 100);
+  run_ms(1);
+  printf("attack 0: first tick %d, stage %s\n", g_last,
+         envelope_cc_get_stage_name(envelope_cc_get_stage(TRACK)));
+  assert(g_last == 127);
+  assert(envelope_cc_get_stage(TRACK) == ENVELOPE_STAGE_DECAY);
+
+  run_ms(50);  // half way down the decay
+  assert(g_last > (int)SUSTAIN && g_last < 127);
+  run_ms(50);
+  printf("attack 0: after decay %d, stage %s\n", g_last,
+         envelope_cc_get_stage_name(envelope_cc_get_stage(TRACK)));
+  assert(g_last == (int)SUSTAIN);
+  assert(envelope_cc_get_stage(TRACK) == ENVELOPE_STAGE_SUSTAIN);
+  assert(g_next == TICK_SCHED_IDLE);
+
+  // Release still ramps down
+  envelope_cc_release(TRACK);
+  run_ms(60);
+  assert(g_last == 0);
+  assert(envelope_cc_get_stage(TRACK) == ENVELOPE_STAGE_IDLE);
+  assert(g_next == TICK_SCHED_IDLE);
+}
+
+static void test_zero_attack_decay(void) {
+  setup(0, 0);
+  run_ms(1);
+  assert(g_last == 127);
+  run_ms(1);
+  printf("attack 0, decay 0: %d after 2 ticks (%u CCs), stage %s\n", g_last, g_sent,
+         envelope_cc_get_stage_name(envelope_cc_get_stage(TRACK)));
+  assert(g_last == (int)SUSTAIN && g_sent == 2);
+  assert(envelope_cc_get_stage(TRACK) == ENVELOPE_STAGE_SUSTAIN);
+  assert(g_next == TICK_SCHED_IDLE);
+  run_ms(100);
+  assert(g_sent == 2);
+}
+
+static void test_zero_decay(void) {
+  setup(40, 0);
+  run_ms(20);
+  assert(g_last > 0 && g_last < 127);
+  assert(envelope_cc_get_stage(TRACK) == ENVELOPE_STAGE_ATTACK);
+  run_ms(22);
+  printf("decay 0: %d after the attack, stage %s\n", g_last,
+         envelope_cc_get_stage_name(envelope_cc_get_stage(TRACK)));
+  assert(g_last == (int)SUSTAIN);
+  assert(envelope_cc_get_stage(TRACK) == ENVELOPE_STAGE_SUSTAIN);
+  assert(g_next == TICK_SCHED_IDLE);
+}
+
+int main(void) {
+  test_zero_attack();
+  test_zero_attack_decay();
+  test_zero_decay();
+  printf("All envelope CC tests passed\n");
+  return 0;
+}
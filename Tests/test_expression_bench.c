@@ -0,0 +1,264 @@
+/**
+ * @file test_expression_bench.c
+ * @brief Host benchmark and check for the table-driven expression curves
+ *
+ * Runs expression_tick_1ms() (Services/expression/expression.c) and
+ * bellows_process_pressure() (Services/bellows_expression) on a pressure
+ * sweep and reports the cost per tick next to the code they replaced
+ * (ref_* below: powf()/float EMA per tick, 127-step log curve search).
+ *
+ * Checks, per curve:
+ *   - expression: with smoothing off, every CC value within 1 of the float
+ *     reference over all 4096 raw values (table interpolation + rounding)
+ *   - expression: a smoothed step settles on the same value as the float EMA
+ *   - bellows: table equals the old code for linear/expo/S; the log curve is
+ *     y = round(sqrt(127 x)) as documented (the old search returned 127 for
+ *     every input, its loop stopped before reaching the root)
+ *   - user curve points evaluate to the given outputs
+ *
+ * Times are TSC cycles on x86 hosts (nanoseconds elsewhere); the M4F has no
+ * powf() in hardware either, so the ratio is the useful number.
+ *
+ * To compile and run (from repository root):
+ *   gcc -O2 -I. -o Tests/test_expression_bench Tests/test_expression_bench.c \
+ *       Services/expression/expression.c Services/expression/expr_curve.c \
+ *       Services/bellows_expression/bellows_expression.c \
+ *       Services/tick_sched/tick_sched.c -lm \
+ *       && ./Tests/test_expression_bench
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "Services/expression/expression.h"
+#include "Services/expression/expr_curve.h"
+#include "Services/bellows_expression/bellows_expression.h"
+#include "Services/router/router.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cyc"
+static inline uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static inline uint64_t bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+static int g_last_cc = -1;
+static uint32_t g_sent;
+
+void router_process(uint8_t in_node, const router_msg_t* msg) {
+  (void)in_node;
+  g_last_cc = msg->b2;
+  g_sent++;
+}
+
+// ---- Reference: previous per-tick float path of expression.c ----
+static expr_cfg_t r_cfg;
+static float r_filt;
+
+static float ref_curve(float t) {
+  if (t < 0.0f) t = 0.0f;
+  if (t > 1.0f) t = 1.0f;
+  switch (r_cfg.curve) {
+    default:
+    case EXPR_CURVE_LINEAR: return t;
+    case EXPR_CURVE_EXPO: {
+      float gamma = (r_cfg.curve_param > 0) ? ((float)r_cfg.curve_param / 100.0f) : 1.8f;
+      if (gamma < 0.2f) gamma = 0.2f;
+      if (gamma > 5.0f) gamma = 5.0f;
+      return powf(t, gamma);
+    }
+    case EXPR_CURVE_S: return t * t * (3.0f - 2.0f * t);
+  }
+}
+
+static int ref_clamp8(int v) { return v < 0 ? 0 : (v > 127 ? 127 : v); }
+
+static int ref_map_linear(uint16_t r) {
+  if (r_cfg.raw_max == r_cfg.raw_min) return r_cfg.out_min;
+  float t = (float)((int32_t)r - r_cfg.raw_min) / (float)(r_cfg.raw_max - r_cfg.raw_min);
+  t = ref_curve(t);
+  float y = (float)r_cfg.out_min + t * (float)((int)r_cfg.out_max - (int)r_cfg.out_min);
+  return ref_clamp8((int)(y + 0.5f));
+}
+
+static int ref_tick(uint16_t raw) {
+  int target = ref_map_linear(raw);
+  float a = 1.0f - ((float)r_cfg.smoothing / 255.0f);
+  if (a < 0.02f) a = 0.02f;
+  if (a > 1.0f) a = 1.0f;
+  r_filt = r_filt + a * ((float)target - r_filt);
+  return ref_clamp8((int)(r_filt + 0.5f));
+}
+
+// ---- Reference: previous bellows curve + EMA ----
+static uint8_t ref_bellows_curve(uint8_t c, uint8_t x) {
+  uint16_t value = x;
+  switch (c) {
+    case BELLOWS_CURVE_LINEAR: return x;
+    case BELLOWS_CURVE_EXPONENTIAL: value = (x * x) / 127; break;
+    case BELLOWS_CURVE_LOGARITHMIC:
+      value = 127;
+      for (uint8_t i = 0; i < x; i++) {
+        if ((i * i) / 127 > x) { value = i; break; }
+      }
+      break;
+    case BELLOWS_CURVE_S_CURVE:
+      if (x < 32) value = x / 2;
+      else if (x < 96) value = 16 + ((x - 32) * 3) / 2;
+      else value = 112 + (x - 96) / 2;
+      break;
+    default: return x;
+  }
+  return value > 127 ? 127 : (uint8_t)value;
+}
+
+static uint8_t rb_cur;
+static uint8_t ref_bellows_process(int32_t pa) {
+  int32_t n = ((pa + 500) * 127) / 1000;
+  if (n < 0) n = 0;
+  if (n > 127) n = 127;
+  uint8_t v = ref_bellows_curve(BELLOWS_CURVE_LOGARITHMIC, (uint8_t)n);
+  v = (uint8_t)(((uint16_t)rb_cur * 30 + (uint16_t)v * 70) / 100);
+  rb_cur = v;
+  return v;
+}
+
+// ---- Setup ----
+static expr_cfg_t base_cfg(uint8_t curve, uint8_t smoothing) {
+  expr_cfg_t c;
+  memset(&c, 0, sizeof(c));
+  c.enable = 1;
+  c.cc_num = 11;
+  c.raw_min = 200;
+  c.raw_max = 3900;
+  c.out_min = 0;
+  c.out_max = 127;
+  c.rate_ms = 1;
+  c.smoothing = smoothing;
+  c.deadband_cc = 1;
+  c.curve = curve;
+  c.curve_param = 180;
+  return c;
+}
+
+static void set_both(const expr_cfg_t* c) {
+  expression_init();
+  expression_set_cfg(c);
+  r_cfg = *c;
+  r_filt = 0.0f;
+  g_last_cc = -1;
+}
+
+static void check_expression(void) {
+  static const char* k_names[] = { "linear", "expo", "s" };
+  for (uint8_t curve = 0; curve <= EXPR_CURVE_S; curve++) {
+    expr_cfg_t c = base_cfg(curve, 0);
+    set_both(&c);
+    int maxd = 0, diffs = 0;
+    for (uint32_t r = 0; r < 4096u; r++) {
+      expression_set_raw((uint16_t)r);
+      expression_tick_1ms();
+      int ref = ref_tick((uint16_t)r);
+      int d = abs(g_last_cc - ref);
+      if (d > maxd) maxd = d;
+      if (d) diffs++;
+    }
+    printf("expression %-6s: %4d of 4096 raw values differ, max %d CC\n", k_names[curve], diffs, maxd);
+    assert(maxd <= 1);
+
+    // Smoothed step: both EMAs settle on the target
+    c = base_cfg(curve, 200);
+    set_both(&c);
+    int ref = 0;
+    for (int i = 0; i < 2000; i++) {
+      expression_set_raw(3000);
+      expression_tick_1ms();
+      ref = ref_tick(3000);
+    }
+    assert(abs(g_last_cc - ref) <= 1);
+  }
+}
+
+static void check_bellows(void) {
+  bellows_init();
+  bellows_set_smoothing(0, 0);
+  static int32_t s_out;
+  for (uint8_t curve = 0; curve < BELLOWS_CURVE_USER; curve++) {
+    bellows_set_curve(0, (bellows_curve_t)curve);
+    uint32_t diffs = 0;
+    for (int32_t x = 0; x < 128; x++) {
+      // pressure that normalizes to exactly x (range -500..500)
+      int32_t pa = -500 + (x * 1000 + 126) / 127;
+      bellows_process_pressure(0, pa, 0);
+      s_out = bellows_get_expression_value(0);
+      int want = ref_bellows_curve(curve, (uint8_t)x);
+      if (curve == BELLOWS_CURVE_LOGARITHMIC) want = (int)lround(sqrt(127.0 * x));
+      assert(s_out == want);
+      if (s_out != ref_bellows_curve(curve, (uint8_t)x)) diffs++;
+    }
+    printf("bellows curve %d: %u of 128 inputs differ from the old code\n", curve, diffs);
+    if (curve != BELLOWS_CURVE_LOGARITHMIC) assert(diffs == 0);
+  }
+}
+
+static void check_user_curve(void) {
+  expr_curve_points_t p = { 3, { 0, 64, 127 }, { 0, 100, 127 } };
+  assert(expr_curve_eval(&p, 0) == 0);
+  assert(expr_curve_eval(&p, (uint16_t)((64u * 65535u + 63u) / 127u)) == (100u * 65535u + 63u) / 127u);
+  assert(expr_curve_eval(&p, 65535) == 65535);
+  expr_curve_points_t q = { 2, { 20, 100 }, { 10, 90 } };  // flat outside the points
+  assert(expr_curve_eval(&q, 0) == expr_curve_eval(&q, (uint16_t)(20u * 65535u / 127u)));
+  printf("user curve: ok\n");
+}
+
+static void bench(void) {
+  enum { N = 200000 };
+  uint64_t t0, t_new, t_ref, tb_new, tb_ref;
+  expr_cfg_t c = base_cfg(EXPR_CURVE_EXPO, 200);
+  set_both(&c);
+  uint32_t acc = 0;
+
+  t0 = bench_now();
+  for (uint32_t i = 0; i < N; i++) {
+    expression_set_raw((uint16_t)((i * 7u) & 4095u));
+    expression_tick_1ms();
+  }
+  t_new = bench_now() - t0;
+  t0 = bench_now();
+  for (uint32_t i = 0; i < N; i++) acc += (uint32_t)ref_tick((uint16_t)((i * 7u) & 4095u));
+  t_ref = bench_now() - t0;
+
+  bellows_init();
+  bellows_set_curve(0, BELLOWS_CURVE_LOGARITHMIC);
+  t0 = bench_now();
+  for (uint32_t i = 0; i < N; i++) bellows_process_pressure(0, (int32_t)(i % 1000u) - 500, 0);
+  tb_new = bench_now() - t0;
+  t0 = bench_now();
+  for (uint32_t i = 0; i < N; i++) acc += ref_bellows_process((int32_t)(i % 1000u) - 500);
+  tb_ref = bench_now() - t0;
+
+  printf("per tick: expression (expo)  table %6.1f " BENCH_UNIT ", float/powf %6.1f " BENCH_UNIT "\n",
+         (double)t_new / N, (double)t_ref / N);
+  printf("per tick: bellows (log)      table %6.1f " BENCH_UNIT ", search     %6.1f " BENCH_UNIT
+         "  (%u)\n", (double)tb_new / N, (double)tb_ref / N, acc & 1u);
+}
+
+int main(void) {
+  check_expression();
+  check_bellows();
+  check_user_curve();
+  bench();
+  printf("All expression curve checks passed\n");
+  return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file test_lfo_rate.c
+ * @brief Host test for the LFO rate, free-running and BPM synced
+ *
+ * Runs Services/lfo/lfo.c on the legacy 1 ms tick and on tick_sched (where
+ * the phase is only integrated when a value is read) and checks:
+ *   - free-running: a 1 Hz sine peaks at 250 ms, crosses at 500 ms and
+ *     bottoms at 750 ms; a 2 Hz saw wraps 20 times in 10 s
+ *   - BPM sync: at 120 BPM one bar per cycle lasts 2000 ms, and a tempo
+ *     change takes effect from then on
+ *
+ * Values are read through the velocity target (base 64, depth 50), so the
+ * sine maps to 14..114.
+ *
+ * To compile and run (from repository root):
+ *   gcc -I. -o Tests/test_lfo_rate Tests/test_lfo_rate.c Services/lfo/lfo.c \
+ *       Services/tick_sched/tick_sched.c -lm && ./Tests/test_lfo_rate
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "Services/lfo/lfo.h"
+#include "Services/tick_sched/tick_sched.h"
+
+#define TRACK  0u
+#define BASE   64u
+#define DEPTH  50u
+#define T0_MS  5000u  // scheduler start: not 0
+
+static uint8_t g_sched;  // advance time through tick_sched instead of lfo_tick_1ms
+static uint32_t g_now;
+
+static void run_ms(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    if (g_sched) tick_sched_run(++g_now);
+    else lfo_tick_1ms();
+  }
+}
+
+static int value(void) { return lfo_get_velocity_value(TRACK, BASE); }
+
+static void setup(lfo_waveform_t wf, uint16_t rate_hundredths) {
+  lfo_init();
+  lfo_set_waveform(TRACK, wf);
+  lfo_set_target(TRACK, LFO_TARGET_VELOCITY);
+  lfo_set_depth(TRACK, DEPTH);
+  lfo_set_rate(TRACK, rate_hundredths);
+  lfo_set_enabled(TRACK, 1);
+  lfo_reset_phase(TRACK);
+}
+
+static void expect_near(const char* what, int got, int want) {
+  printf("  %-22s %3d (want %3d)\n", what, got, want);
+  assert(abs(got - want) <= 2);
+}
+
+static void test_free_sine(void) {
+  setup(LFO_WAVEFORM_SINE, 100);  // 1 Hz
+  expect_near("sine 0 ms", value(), BASE);
+  run_ms(250);
+  expect_near("sine 250 ms", value(), BASE + DEPTH);
+  run_ms(250);
+  expect_near("sine 500 ms", value(), BASE);
+  run_ms(250);
+  expect_near("sine 750 ms", value(), BASE - DEPTH);
+  run_ms(250);
+  expect_near("sine 1000 ms", value(), BASE);
+}
+
+// Saw wraps (value drops by more than the depth) within ms
+static uint32_t count_wraps(uint32_t ms) {
+  uint32_t wraps = 0;
+  int last = value();
+  for (uint32_t i = 0; i < ms; i++) {
+    run_ms(1);
+    int v = value();
+    if (last - v > (int)DEPTH) wraps++;
+    last = v;
+  }
+  return wraps;
+}
+
+static void test_free_saw(void) {
+  setup(LFO_WAVEFORM_SAW, 200);  // 2 Hz
+  uint32_t wraps = count_wraps(10001);
+  printf("  saw 2 Hz: %u wraps in 10 s\n", wraps);
+  assert(wraps == 20);
+}
+
+static void test_bpm_sync(void) {
+  lfo_set_tempo(120);
+  setup(LFO_WAVEFORM_SINE, 100);
+  lfo_set_bpm_divisor(TRACK, 1);
+  lfo_set_bpm_sync(TRACK, 1);  // one bar at 120 BPM: 2000 ms
+  lfo_reset_phase(TRACK);
+  run_ms(500);
+  expect_near("120 BPM, 500 ms", value(), BASE + DEPTH);
+  run_ms(1000);
+  expect_near("120 BPM, 1500 ms", value(), BASE - DEPTH);
+  run_ms(500);
+  expect_near("120 BPM, 2000 ms", value(), BASE);
+
+  // Twice the tempo: the next quarter cycle takes 250 ms
+  lfo_set_tempo(240);
+  run_ms(250);
+  expect_near("240 BPM, +250 ms", value(), BASE + DEPTH);
+  lfo_set_tempo(120);
+}
+
+int main(void) {
+  printf("legacy 1 ms tick:\n");
+  test_free_sine();
+  test_free_saw();
+  test_bpm_sync();
+
+  // tick_sched: the LFO is never dispatched between reads, its phase is
+  // integrated from the scheduler clock when a value is read
+  printf("tick_sched:\n");
+  g_sched = 1;
+  g_now = T0_MS;
+  tick_sched_init(g_now);
+  tick_sched_register(TICK_SVC_LFO, "lfo", lfo_service);
+  tick_sched_wake(TICK_SVC_LFO, 0);
+  tick_sched_run(g_now);
+  test_free_sine();
+  test_free_saw();
+  test_bpm_sync();
+
+  printf("All LFO rate tests passed\n");
+  return 0;
+}
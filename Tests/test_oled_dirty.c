@@ -0,0 +1,98 @@
+/**
+ * @file test_oled_dirty.c
+ * @brief Host test for the SSD1322 dirty-window planner
+ *
+ * Renders typical UI updates with ui_gfx into a 256x64 framebuffer and
+ * checks how many bytes oled_flush() would send compared to the old
+ * full-frame flush (64 rows x 128 bytes = 8192 bytes).
+ *
+ * To compile and run (from repository root):
+ *   gcc -I. -o Tests/test_oled_dirty Tests/test_oled_dirty.c \
+ *       Hal/oled_ssd1322/oled_dirty.c Services/ui/ui_gfx.c && ./Tests/test_oled_dirty
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "Hal/oled_ssd1322/oled_dirty.h"
+#include "Services/ui/ui_gfx.h"
+
+#define FB_SIZE   (OLED_DIRTY_ROWS * OLED_DIRTY_ROW_BYTES)
+#define FULL_COST (FB_SIZE + OLED_DIRTY_WINDOW_CMD_BYTES)
+
+static uint8_t fb[FB_SIZE];
+static uint8_t shadow[FB_SIZE];
+static uint8_t panel[FB_SIZE];  // Simulated GDDRAM, written through the windows only
+static oled_window_t win[OLED_DIRTY_ROWS];
+
+// Draw a page similar to the looper/status pages: header, body, footer
+static void render_page(const char* clock, int value, int cursor_x) {
+  ui_gfx_clear(0);
+  ui_gfx_text(0, 0, "LOOPER", 15);
+  ui_gfx_text(200, 0, clock, 15);
+  ui_gfx_hline(0, 10, 256, 4);
+  ui_gfx_rect(10, 20, 100, 30, 8);
+  char buf[16];
+  snprintf(buf, sizeof(buf), "BPM %d", value);
+  ui_gfx_text(130, 28, buf, 12);
+  ui_gfx_vline(cursor_x, 14, 40, 15);
+  ui_gfx_text(0, 56, "REC PLAY STOP", 10);
+}
+
+// Plan a flush, apply it to the simulated panel and return bytes sent
+static uint32_t flush(uint8_t full, const char* label) {
+  uint8_t n = oled_dirty_scan(fb, shadow, full, win);
+  uint32_t data = oled_dirty_data_bytes(win, n);
+  for (uint8_t w = 0; w < n; w++) {
+    for (uint8_t row = win[w].row0; row <= win[w].row1; row++) {
+      uint32_t off = (uint32_t)row * OLED_DIRTY_ROW_BYTES + win[w].col0 * 2u;
+      memcpy(&panel[off], &fb[off], (win[w].col1 - win[w].col0 + 1u) * 2u);
+    }
+  }
+  uint32_t total = data + n * OLED_DIRTY_WINDOW_CMD_BYTES;
+  printf("  %-22s windows=%2u data=%5u total=%5u (%5.1f%% of full)\n",
+         label, n, (unsigned)data, (unsigned)total, 100.0 * total / FULL_COST);
+  assert(memcmp(panel, fb, FB_SIZE) == 0);
+  assert(memcmp(shadow, fb, FB_SIZE) == 0);
+  return total;
+}
+
+int main(void) {
+  printf("OLED dirty-window flush test\n");
+  ui_gfx_set_fb(fb, 256, 64);
+  memset(panel, 0xAA, sizeof(panel));  // Unknown panel contents before first flush
+
+  render_page("12:00", 120, 40);
+  uint32_t first = flush(1, "first frame (full)");
+  assert(first == FULL_COST);
+
+  render_page("12:00", 120, 40);
+  uint32_t idle = flush(0, "no change");
+  assert(idle == 0);
+
+  render_page("12:01", 120, 40);
+  uint32_t clock = flush(0, "header clock digit");
+  assert(clock > 0 && clock < FULL_COST / 20);
+
+  render_page("12:01", 121, 40);
+  uint32_t value = flush(0, "body value change");
+  assert(value > 0 && value < FULL_COST / 20);
+
+  render_page("12:01", 121, 41);
+  uint32_t cursor = flush(0, "cursor moved 1 px");
+  assert(cursor > 0 && cursor < FULL_COST / 10);
+
+  render_page("12:02", 122, 42);
+  uint32_t multi = flush(0, "clock+value+cursor");
+  assert(multi > 0 && multi < FULL_COST / 4);
+
+  // Full-screen change: merging must keep the cost close to a full flush
+  ui_gfx_clear(15);
+  uint32_t all = flush(0, "full-screen change");
+  assert(all <= FULL_COST + OLED_DIRTY_WINDOW_CMD_BYTES * 4u);
+
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file test_pressure_async.c
+ * @brief Host test for the non-blocking pressure driver
+ *
+ * Replaces Hal/i2c_hal.c with a simulated I2C bus carrying an XGZP6847D-like
+ * device (0x58): a CMD register write starts a conversion that takes
+ * SIM_CONV_MS, the data registers hold the 24-bit reading. Transfers finish
+ * SIM_XFER_POLLS polls after they start, like an interrupt transfer that
+ * completes between two main task ticks (its interrupt SIM_DONE_AGO_US before
+ * the poll that sees it). Faults can be injected: NACKs,
+ * a hung transfer (never completes until bus recovery), and a read issued
+ * before the conversion finished is flagged as a driver error.
+ *
+ * To compile and run (from repository root):
+ *   gcc -I. -o Tests/test_pressure_async Tests/test_pressure_async.c \
+ *       Services/pressure/pressure_i2c.c -lm && ./Tests/test_pressure_async
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "Hal/i2c_hal.h"
+#include "Services/pressure/pressure_i2c.h"
+
+// Driver built with the host clock instead of the DWT cycle counter
+uint32_t SystemCoreClock = 168000000u;
+uint32_t host_cycles(void);
+#define PRESSURE_ASYNC_CYCLES() host_cycles()
+#define PRESSURE_ASYNC_CYCLES_ENABLE() do { } while (0)
+#include "Services/pressure/pressure_async.c"
+
+#define SIM_ADDR       0x58
+#define SIM_CONV_MS    2
+#define SIM_XFER_POLLS 1
+#define SIM_DONE_AGO_US 400u
+
+static uint32_t g_now;  // ms
+
+uint32_t host_cycles(void) { return g_now * (SystemCoreClock / 1000u); }
+
+// ---- Simulated bus + device ----
+static struct {
+  uint8_t regs[256];
+  uint32_t conv_done_ms;   // conversion result valid from here
+  uint8_t converting;
+  int busy;                // polls left for the running transfer
+  int hung;                // running transfer never finishes
+  int failed;
+  uint8_t* rx; uint8_t rx_reg; uint16_t rx_len;
+  int nack_next;           // fail this many transfers
+  int hang_next;           // hang this many transfers
+  uint32_t done_cyc;       // completion interrupt
+  uint32_t early_reads;    // data read during a conversion
+  uint32_t cmd_writes, reads, recovers;
+} sim;
+
+static int sim_start(uint8_t addr7) {
+  if (sim.busy || sim.hung) return -2;  // HAL_BUSY
+  if (addr7 != SIM_ADDR || sim.nack_next > 0) {
+    if (sim.nack_next > 0) sim.nack_next--;
+    sim.failed = 1;  // NACK reported by the error interrupt
+    sim.busy = 0;
+    return 0;
+  }
+  sim.failed = 0;
+  if (sim.hang_next > 0) { sim.hang_next--; sim.hung = 1; return 0; }
+  sim.busy = SIM_XFER_POLLS;
+  return 0;
+}
+
+int i2c_hal_read_it(uint8_t bus, uint8_t addr7, uint8_t reg, uint8_t* data, uint16_t len) {
+  (void)bus;
+  if (!data || !len) return -1;
+  int r = sim_start(addr7);
+  if (r != 0 || sim.failed || sim.hung) return r;
+  sim.rx = data; sim.rx_reg = reg; sim.rx_len = len;
+  sim.reads++;
+  if (sim.converting && g_now < sim.conv_done_ms) sim.early_reads++;
+  return 0;
+}
+
+int i2c_hal_write_it(uint8_t bus, uint8_t addr7, uint8_t reg, const uint8_t* data, uint16_t len) {
+  (void)bus;
+  if (!data || !len) return -1;
+  int r = sim_start(addr7);
+  if (r != 0 || sim.failed || sim.hung) return r;
+  sim.regs[reg] = data[0];
+  if (reg == PRESSURE_XGZP_REG_CMD && data[0] == PRESSURE_XGZP_CMD_CONV) {
+    sim.cmd_writes++;
+    sim.converting = 1;
+    sim.conv_done_ms = g_now + SIM_CONV_MS;
+  }
+  sim.rx = NULL;
+  return 0;
+}
+
+int i2c_hal_poll(uint8_t bus) {
+  (void)bus;
+  if (sim.hung) return 1;
+  if (sim.failed) return -2;
+  if (sim.busy > 0 && --sim.busy > 0) return 1;
+  sim.done_cyc = host_cycles() - SIM_DONE_AGO_US * (SystemCoreClock / 1000000u);
+  if (sim.rx) {
+    memcpy(sim.rx, &sim.regs[sim.rx_reg], sim.rx_len);
+    sim.rx = NULL;
+  }
+  return 0;
+}
+
+uint32_t i2c_hal_done_cycles(uint8_t bus) {
+  (void)bus;
+  return sim.done_cyc;
+}
+
+int i2c_hal_recover(uint8_t bus) {
+  (void)bus;
+  sim.recovers++;
+  sim.hung = 0; sim.busy = 0; sim.failed = 0; sim.rx = NULL;
+  return 0;
+}
+
+// Blocking path of pressure_i2c.c, reads the same registers
+int i2c_hal_read(uint8_t bus, uint8_t addr7, uint8_t reg, uint8_t* data, uint16_t len, uint32_t timeout_ms) {
+  (void)bus; (void)timeout_ms;
+  if (addr7 != SIM_ADDR) return -2;
+  memcpy(data, &sim.regs[reg], len);
+  return 0;
+}
+
+static void sim_set_reading(int32_t code24) {
+  uint32_t u = (uint32_t)code24 & 0xFFFFFFu;
+  sim.regs[0x04] = (uint8_t)(u >> 16);
+  sim.regs[0x05] = (uint8_t)(u >> 8);
+  sim.regs[0x06] = (uint8_t)u;
+}
+
+static void reset(uint8_t type) {
+  memset(&sim, 0, sizeof(sim));
+  pressure_cfg_t c;
+  pressure_defaults(&c);
+  c.enable = 1;
+  c.type = type;
+  c.interval_ms = 5;
+  c.atm0_pa = 100;
+  pressure_set_cfg(&c);
+  g_now = 0;
+  pressure_async_init();
+}
+
+// Runs 1 ms ticks, returns the number of published samples
+static uint32_t run(uint32_t ms) {
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < ms; i++, g_now++) n += (uint32_t)pressure_async_tick(g_now);
+  return n;
+}
+
+static void test_steady(void) {
+  reset(PRESS_TYPE_XGZP6847D_24B);
+  sim_set_reading(-300000);
+  int32_t blocking = 0;
+  assert(pressure_read_once(&blocking) == 0);
+
+  uint32_t n = run(100);
+  pressure_async_stats_t st;
+  pressure_async_get_stats(&st);
+  pressure_sample_t s;
+  assert(pressure_async_get(&s) == 0);
+
+  printf("steady: %u samples in 100 ms, value %ld Pa (blocking %ld), lat %u/%u us\n",
+         n, (long)s.value, (long)blocking, st.lat_avg_us, st.lat_max_us);
+  assert(n == 20);
+  assert(s.value == blocking);
+  assert(s.seq == 20 && s.t_ms >= 95);
+  // Stamped at the completion interrupt, not at the tick that saw it
+  assert(s.t_us == s.t_ms * 1000u - SIM_DONE_AGO_US);
+  assert(sim.cmd_writes == 20 && sim.reads == 20);
+  assert(sim.early_reads == 0);  // waited for every conversion
+  assert(st.errors == 0 && st.timeouts == 0 && st.recoveries == 0);
+  // command (1 tick) + conversion + read (1 tick), well inside the interval
+  assert(st.lat_max_us >= (SIM_CONV_MS + 1) * 1000u && st.lat_max_us < 5000u);
+}
+
+static void test_nack_retry(void) {
+  reset(PRESS_TYPE_XGZP6847D_24B);
+  sim_set_reading(1000);
+  sim.nack_next = 1;
+  uint32_t n = run(50);
+  pressure_async_stats_t st;
+  pressure_async_get_stats(&st);
+  printf("nack: %u samples, errors %u, retries %u, dropped %u\n",
+         n, st.errors, st.retries, st.dropped);
+  // The retry delays the following samples by two ticks: one fewer in the window
+  assert(n == 9);
+  assert(st.errors == 1 && st.retries == 1 && st.dropped == 0 && st.recoveries == 0);
+}
+
+static void test_nack_recover(void) {
+  reset(PRESS_TYPE_XGZP6847D_24B);
+  sim.nack_next = PRESSURE_ASYNC_RETRIES + 1;  // every attempt of the first sample
+  uint32_t n = run(50);
+  pressure_async_stats_t st;
+  pressure_async_get_stats(&st);
+  printf("nack x%d: %u samples, errors %u, dropped %u, recoveries %u\n",
+         PRESSURE_ASYNC_RETRIES + 1, n, st.errors, st.dropped, st.recoveries);
+  assert(n == 8);  // first sample dropped, the next one starts late
+  assert(st.errors == PRESSURE_ASYNC_RETRIES + 1u);
+  assert(st.dropped == 1 && st.recoveries == 1 && sim.recovers == 1);
+}
+
+static void test_hung_bus(void) {
+  reset(PRESS_TYPE_XGZP6847D_24B);
+  sim.hang_next = 1;
+  uint32_t n = run(50);
+  pressure_async_stats_t st;
+  pressure_async_get_stats(&st);
+  printf("hung: %u samples, timeouts %u, recoveries %u, retries %u\n",
+         n, st.timeouts, st.recoveries, st.retries);
+  assert(st.timeouts == 1 && st.recoveries == 1 && st.retries == 1 && st.dropped == 0);
+  assert(n == 9);  // the retry after the recovery still delivered the first sample
+}
+
+static void test_generic(void) {
+  reset(PRESS_TYPE_GENERIC_S16BE);
+  pressure_cfg_t c = *pressure_get_cfg();
+  c.reg = 0x10;
+  pressure_set_cfg(&c);
+  sim.regs[0x10] = 0xFF;
+  sim.regs[0x11] = 0x38;  // -200
+  uint32_t n = run(20);
+  pressure_sample_t s;
+  assert(pressure_async_get(&s) == 0);
+  printf("generic: %u samples, value %ld\n", n, (long)s.value);
+  assert(n == 4 && s.value == -200 && sim.cmd_writes == 0);
+}
+
+static void test_disabled(void) {
+  reset(PRESS_TYPE_XGZP6847D_24B);
+  pressure_cfg_t c = *pressure_get_cfg();
+  c.enable = 0;
+  pressure_set_cfg(&c);
+  pressure_sample_t s;
+  assert(run(20) == 0);
+  assert(pressure_async_get(&s) == -1 && sim.reads == 0);
+}
+
+int main(void) {
+  test_steady();
+  test_nack_retry();
+  test_nack_recover();
+  test_hung_bus();
+  test_generic();
+  test_disabled();
+  printf("All pressure async tests passed\n");
+  return 0;
+}
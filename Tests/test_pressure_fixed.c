@@ -0,0 +1,232 @@
+/**
+ * @file test_pressure_fixed.c
+ * @brief Host test for the fixed-point pressure conversion
+ *
+ * Compares Services/pressure/pressure_i2c.c against the double precision
+ * conversion it replaced (ref_* below, copied from the previous version)
+ * over the full input range of each transfer function:
+ *   - XGZP6847D decode: every 24-bit code, several PMIN/PMAX/ATM0 configs
+ *   - 12-bit center map: every Pa value from 2 spans below to 2 above range
+ *   - generic scale (pressure_to_12b, pressure_read_pa): every 16-bit raw
+ *     value, several offsets and scales
+ *
+ * Tolerance: decode and generic scale must match bit for bit. The center map
+ * is exactly rounded while the reference rounds twice (t, then t * 4095), so
+ * it is allowed 1 LSB where that double rounding lands on the other side of
+ * a tie; the test reports how often and fails on anything larger.
+ *
+ * It also reports the cost per sample (decode + 12-bit map) of both versions.
+ * Times are TSC cycles on x86 hosts (nanoseconds elsewhere); on the M4F the
+ * gap is larger, as double arithmetic there is a software library.
+ *
+ * To compile and run (from repository root):
+ *   gcc -O2 -I. -o Tests/test_pressure_fixed Tests/test_pressure_fixed.c \
+ *       Services/pressure/pressure_i2c.c -lm && ./Tests/test_pressure_fixed
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "Hal/i2c_hal.h"
+#include "Services/pressure/pressure_i2c.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cyc"
+static inline uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static inline uint64_t bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+// Sensor registers seen by pressure_read_once()/pressure_read_pa()
+static uint8_t g_regs[256];
+
+int i2c_hal_read(uint8_t bus, uint8_t addr7, uint8_t reg, uint8_t* data, uint16_t len, uint32_t timeout_ms) {
+  (void)bus; (void)addr7; (void)timeout_ms;
+  memcpy(data, &g_regs[reg], len);
+  return 0;
+}
+
+// ---- Reference: previous double precision conversion ----
+static uint16_t ref_clamp_u12(int32_t y, uint16_t mn, uint16_t mx) {
+  if (y < (int32_t)mn) y = mn;
+  if (y > (int32_t)mx) y = mx;
+  if (y < 0) y = 0;
+  if (y > 4095) y = 4095;
+  return (uint16_t)y;
+}
+
+static int32_t ref_decode(const pressure_cfg_t* c, const uint8_t* b) {
+  uint32_t sum = ((uint32_t)b[0] << 16) | ((uint32_t)b[1] << 8) | (uint32_t)b[2];
+  int32_t ssum = (sum < 8388608UL) ? (int32_t)sum : (int32_t)(sum - 16777216UL);
+  const int32_t span = (c->pmax_pa - c->pmin_pa);
+  double p = ((double)ssum / (double)(1 << 21)) * (double)span + (double)c->pmin_pa;
+  return (int32_t)llround(p) - c->atm0_pa;
+}
+
+static uint16_t ref_mid_raw(const pressure_cfg_t* c) {
+  double pmin = (double)c->pmin_pa;
+  double pmax = (double)c->pmax_pa;
+  if (pmax == pmin) return 2048;
+  double t = (0.0 - pmin) / (pmax - pmin);
+  int32_t mid = (int32_t)llround(t * 4095.0);
+  if (mid < 0) mid = 0;
+  if (mid > 4095) mid = 4095;
+  return (uint16_t)mid;
+}
+
+static uint16_t ref_to_12b(const pressure_cfg_t* c, int32_t value) {
+  if (c->type == PRESS_TYPE_XGZP6847D_24B && c->map_mode == PRESS_MAP_CENTER_0PA) {
+    double p = (double)value;
+    double pmin = (double)c->pmin_pa;
+    double pmax = (double)c->pmax_pa;
+    if (pmax == pmin) pmax = pmin + 1.0;
+    double t = (p - pmin) / (pmax - pmin);
+    return ref_clamp_u12((int32_t)llround(t * 4095.0), 0, 4095);
+  }
+  double x = ((double)(value - c->offset)) * (double)c->scale;
+  return ref_clamp_u12((int32_t)llround(x), c->clamp_min, c->clamp_max);
+}
+
+static int32_t ref_read_pa_generic(const pressure_cfg_t* c, int32_t raw) {
+  double p = ((double)(raw - c->offset)) * (double)c->scale;
+  return (int32_t)llround(p);
+}
+
+// ---- Tests ----
+static pressure_cfg_t cfg_xgzp(int32_t pmin, int32_t pmax, int32_t atm0) {
+  pressure_cfg_t c;
+  pressure_defaults(&c);
+  c.enable = 1;
+  c.pmin_pa = pmin;
+  c.pmax_pa = pmax;
+  c.atm0_pa = atm0;
+  return c;
+}
+
+static void test_decode(void) {
+  static const int32_t k_cfg[][3] = {
+    { -40000, 40000, 0 }, { 0, 100000, 101325 }, { -1000, 1000, 7 },
+    { -500000, 700000, -3 }, { 40000, -40000, 0 },
+  };
+  for (size_t i = 0; i < sizeof(k_cfg) / sizeof(k_cfg[0]); i++) {
+    pressure_cfg_t c = cfg_xgzp(k_cfg[i][0], k_cfg[i][1], k_cfg[i][2]);
+    pressure_set_cfg(&c);
+    uint32_t bad = 0;
+    for (uint32_t code = 0; code < (1u << 24); code++) {
+      uint8_t b[3] = { (uint8_t)(code >> 16), (uint8_t)(code >> 8), (uint8_t)code };
+      int32_t v = 0;
+      assert(pressure_decode(b, &v) == 0);
+      if (v != ref_decode(&c, b)) bad++;
+    }
+    printf("decode  pmin %7ld pmax %7ld atm0 %6ld: %u mismatches / 16777216\n",
+           (long)c.pmin_pa, (long)c.pmax_pa, (long)c.atm0_pa, bad);
+    assert(bad == 0);
+  }
+
+  // Public path: register read + decode
+  pressure_cfg_t c = cfg_xgzp(-40000, 40000, 120);
+  pressure_set_cfg(&c);
+  g_regs[4] = 0xF1; g_regs[5] = 0x23; g_regs[6] = 0x45;
+  int32_t v = 0;
+  assert(pressure_read_once(&v) == 0 && v == ref_decode(&c, &g_regs[4]));
+}
+
+static void test_center_map(void) {
+  static const int32_t k_cfg[][2] = {
+    { -40000, 40000 }, { -1000, 3000 }, { 0, 4095 }, { -7, 13 }, { 5000, -5000 }, { 10, 10 },
+  };
+  for (size_t i = 0; i < sizeof(k_cfg) / sizeof(k_cfg[0]); i++) {
+    pressure_cfg_t c = cfg_xgzp(k_cfg[i][0], k_cfg[i][1], 0);
+    pressure_set_cfg(&c);
+    int64_t span = llabs((int64_t)c.pmax_pa - c.pmin_pa) + 1;
+    int64_t lo = (int64_t)(c.pmin_pa < c.pmax_pa ? c.pmin_pa : c.pmax_pa) - 2 * span;
+    int64_t hi = (int64_t)(c.pmin_pa < c.pmax_pa ? c.pmax_pa : c.pmin_pa) + 2 * span;
+    uint32_t n = 0, off1 = 0;
+    for (int64_t p = lo; p <= hi; p++, n++) {
+      int d = (int)pressure_to_12b((int32_t)p) - (int)ref_to_12b(&c, (int32_t)p);
+      assert(d >= -1 && d <= 1);
+      if (d) off1++;
+    }
+    assert(pressure_mid_raw() == ref_mid_raw(&c));
+    printf("center  pmin %7ld pmax %7ld: %u of %u values off by 1 LSB\n",
+           (long)c.pmin_pa, (long)c.pmax_pa, off1, n);
+  }
+}
+
+static void test_generic(void) {
+  static const float k_scale[] = { 1.0f, 0.0625f, 0.3f, 1.7f, -0.5f, 0.00001f, 3.14159f };
+  static const int32_t k_offset[] = { 0, 32768, 1234, -500 };
+  static const uint8_t k_type[] = { PRESS_TYPE_GENERIC_U16BE, PRESS_TYPE_GENERIC_S16BE };
+  uint32_t cases = 0;
+  for (size_t t = 0; t < sizeof(k_type); t++)
+    for (size_t s = 0; s < sizeof(k_scale) / sizeof(k_scale[0]); s++)
+      for (size_t o = 0; o < sizeof(k_offset) / sizeof(k_offset[0]); o++) {
+        pressure_cfg_t c;
+        pressure_defaults(&c);
+        c.enable = 1;
+        c.type = k_type[t];
+        c.reg = 0x10;
+        c.scale = k_scale[s];
+        c.offset = k_offset[o];
+        c.clamp_min = 100;
+        c.clamp_max = 4000;
+        pressure_set_cfg(&c);
+        for (uint32_t u = 0; u < 65536u; u++, cases++) {
+          g_regs[0x10] = (uint8_t)(u >> 8);
+          g_regs[0x11] = (uint8_t)u;
+          int32_t raw = 0, pa = 0;
+          assert(pressure_read_once(&raw) == 0);
+          assert(pressure_read_pa(&pa) == 0);
+          assert(pa == ref_read_pa_generic(&c, raw));
+          assert(pressure_to_12b(raw) == ref_to_12b(&c, raw));
+        }
+      }
+  printf("generic %u raw values x scale/offset: bit exact\n", cases);
+}
+
+static void bench(void) {
+  enum { N = 1 << 20 };
+  pressure_cfg_t c = cfg_xgzp(-40000, 40000, 300);
+  pressure_set_cfg(&c);
+  uint32_t acc_fix = 0, acc_ref = 0;
+
+  uint64_t t0 = bench_now();
+  for (uint32_t i = 0; i < N; i++) {
+    uint32_t code = i * 2654435761u;
+    uint8_t b[3] = { (uint8_t)(code >> 16), (uint8_t)(code >> 8), (uint8_t)code };
+    int32_t v = 0;
+    pressure_decode(b, &v);
+    acc_fix += pressure_to_12b(v);
+  }
+  uint64_t t1 = bench_now();
+  for (uint32_t i = 0; i < N; i++) {
+    uint32_t code = i * 2654435761u;
+    uint8_t b[3] = { (uint8_t)(code >> 16), (uint8_t)(code >> 8), (uint8_t)code };
+    acc_ref += ref_to_12b(&c, ref_decode(&c, b));
+  }
+  uint64_t t2 = bench_now();
+
+  printf("per sample (decode + 12-bit map): fixed %.1f " BENCH_UNIT ", double %.1f " BENCH_UNIT
+         " (checksums %08x %08x)\n",
+         (double)(t1 - t0) / N, (double)(t2 - t1) / N, acc_fix, acc_ref);
+}
+
+int main(void) {
+  test_decode();
+  test_center_map();
+  test_generic();
+  bench();
+  printf("All pressure fixed-point tests passed\n");
+  return 0;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file test_tick_sched.c
+ * @brief Host test for the 1 ms service deadline scheduler
+ *
+ * Plays the same scripted session (CCs into the smoother, note repeat,
+ * delay echoes, gate time notes, an envelope, a register change) twice:
+ * once with every legacy *_tick_1ms()/_tick() called each ms, once with
+ * only tick_sched_run() each ms. All MIDI the services emit is logged with
+ * its time; both logs must be identical. Then prints per-service dispatch
+ * counts and the cost of a tick_sched_run() on an idle system against
+ * calling all the legacy ticks.
+ *
+ * Times are TSC cycles on x86 hosts (nanoseconds elsewhere).
+ *
+ * To compile and run (from repository root):
+ *   gcc -O2 -I. -DMODULE_ENABLE_MIDI_DELAY_FX=1 -o Tests/test_tick_sched \
+ *       Tests/test_tick_sched.c Services/tick_sched/tick_sched.c \
+ *       Services/cc_smoother/cc_smoother.c Services/lfo/lfo.c \
+ *       Services/midi_delay/midi_delay.c Services/note_repeat/note_repeat.c \
+ *       Services/envelope_cc/envelope_cc.c Services/gate_time/gate_time.c \
+ *       Services/bellows_expression/bellows_expression.c \
+ *       Services/expression/expr_curve.c \
+ *       Services/register_coupling/register_coupling.c -lm \
+ *       && ./Tests/test_tick_sched
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cyc"
+static inline uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static inline uint64_t bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#include "Services/tick_sched/tick_sched.h"
+#include "Services/cc_smoother/cc_smoother.h"
+#include "Services/lfo/lfo.h"
+#include "Services/midi_delay/midi_delay.h"
+#include "Services/note_repeat/note_repeat.h"
+#include "Services/envelope_cc/envelope_cc.h"
+#include "Services/gate_time/gate_time.h"
+#include "Services/bellows_expression/bellows_expression.h"
+#include "Services/register_coupling/register_coupling.h"
+
+#define SESSION_MS 3000u
+#define MAX_LOG    4096
+
+typedef struct {
+  uint32_t t;
+  uint8_t src, a, b, c;
+} ev_t;
+
+static ev_t g_log[2][MAX_LOG];
+static uint32_t g_log_n[2];
+static int g_pass;
+static uint32_t g_t;
+
+static void log_ev(uint8_t src, uint8_t a, uint8_t b, uint8_t c) {
+  assert(g_log_n[g_pass] < MAX_LOG);
+  ev_t* e = &g_log[g_pass][g_log_n[g_pass]++];
+  e->t = g_t; e->src = src; e->a = a; e->b = b; e->c = c;
+}
+
+static void cc_out(uint8_t track, uint8_t cc, uint8_t v, uint8_t ch) { (void)track; log_ev(1, cc, v, ch); }
+static void delay_out(uint8_t track, uint8_t note, uint8_t vel, uint8_t ch, uint8_t on) {
+  (void)track; (void)ch; log_ev(2, note, vel, on);
+}
+static void repeat_out(uint8_t track, uint8_t note, uint8_t vel, uint8_t ch, uint8_t on) {
+  (void)track; (void)ch; log_ev(3, note, vel, on);
+}
+static void env_out(uint8_t track, uint8_t cc, uint8_t v, uint8_t ch) { (void)track; (void)ch; log_ev(4, cc, v, 0); }
+static void gate_out(uint8_t track, uint8_t note, uint8_t vel, uint8_t ch) { (void)track; (void)ch; log_ev(5, note, vel, 0); }
+
+static void setup(void) {
+  cc_smoother_init();
+  cc_smoother_set_output_callback(cc_out);
+  cc_smoother_set_enabled(0, 1);
+  cc_smoother_set_mode(0, CC_SMOOTH_MODE_HEAVY);
+
+  lfo_init();
+  midi_delay_init(120);
+  midi_delay_set_output_callback(delay_out);
+  midi_delay_set_enabled(0, 1);
+
+  note_repeat_init(120);
+  note_repeat_set_output_callback(repeat_out);
+  note_repeat_set_enabled(0, 1);
+
+  envelope_cc_init();
+  envelope_cc_set_callback(env_out);
+  envelope_cc_set_enabled(0, 1);
+  envelope_cc_set_attack(0, 120);
+  envelope_cc_set_decay(0, 80);
+  envelope_cc_set_release(0, 200);
+
+  gate_time_init();
+  gate_time_set_callback(gate_out);
+  gate_time_set_enabled(0, 1);
+
+  bellows_init();
+  reg_coupling_init();
+}
+
+// Input events at time t (ms)
+static void script(uint32_t t) {
+  switch (t) {
+    case 10:   (void)cc_smoother_process(0, 11, 100); break;
+    case 200:  (void)cc_smoother_process(0, 11, 20); break;
+    case 50:   note_repeat_trigger(0, 60, 100, 0); break;
+    case 900:  note_repeat_stop(0, 60, 0); break;
+    case 120:  midi_delay_process_note(0, 64, 90, 0); break;
+    case 140:  midi_delay_process_note(0, 67, 80, 0); break;
+    case 300:  envelope_cc_trigger(0); break;
+    case 1200: envelope_cc_release(0); break;
+    case 400:  (void)gate_time_process_note_on(0, 48, 100, 0, t); break;
+    case 433:  (void)gate_time_process_note_on(0, 50, 100, 0, t); break;
+    case 600:  reg_coupling_set_register(0, REG_MUSETTE); break;
+    default: break;
+  }
+}
+
+static void run_legacy(void) {
+  g_pass = 0;
+  setup();
+  for (g_t = 1; g_t <= SESSION_MS; g_t++) {
+    cc_smoother_tick_1ms();
+    lfo_tick_1ms();
+    midi_delay_tick_1ms();
+    note_repeat_tick_1ms();
+    envelope_cc_tick(g_t);
+    gate_time_tick(g_t);
+    bellows_tick_1ms();
+    reg_coupling_tick_1ms();
+    script(g_t);
+  }
+}
+
+static void sched_init(uint32_t now) {
+  tick_sched_init(now);
+  tick_sched_register(TICK_SVC_CC_SMOOTHER, "cc_smoother", cc_smoother_service);
+  tick_sched_register(TICK_SVC_LFO, "lfo", lfo_service);
+  tick_sched_register(TICK_SVC_MIDI_DELAY, "midi_delay", midi_delay_service);
+  tick_sched_register(TICK_SVC_NOTE_REPEAT, "note_repeat", note_repeat_service);
+  tick_sched_register(TICK_SVC_ENVELOPE_CC, "envelope_cc", envelope_cc_service);
+  tick_sched_register(TICK_SVC_GATE_TIME, "gate_time", gate_time_service);
+  tick_sched_register(TICK_SVC_BELLOWS, "bellows", bellows_service);
+  tick_sched_register(TICK_SVC_REG_COUPLING, "reg_coupling", reg_coupling_service);
+  for (uint8_t i = 0; i < TICK_SVC_COUNT; i++) tick_sched_wake((tick_svc_t)i, 0);
+}
+
+static void run_sched(void) {
+  g_pass = 1;
+  setup();
+  sched_init(0);
+  for (g_t = 1; g_t <= SESSION_MS; g_t++) {
+    tick_sched_run(g_t);
+    script(g_t);
+  }
+}
+
+// Heap order: each handler records when it ran
+static uint32_t g_fired[TICK_SVC_COUNT];
+#define H(n) static uint32_t h##n(uint32_t t) { g_fired[n] = t; return TICK_SCHED_IDLE; }
+H(0) H(1) H(2) H(3) H(4) H(5) H(6) H(7)
+#undef H
+
+static void test_heap_order(void) {
+  // Deadlines in shuffled order must dispatch in time order, earlier wakes win
+  static const tick_sched_fn_t fns[TICK_SVC_COUNT] = { h0, h1, h2, h3, h4, h5, h6, h7 };
+  static const uint32_t delay[TICK_SVC_COUNT] = { 40, 5, 17, 3, 90, 17, 60, 1 };
+
+  uint32_t now = 0xFFFFFFF0u;  // deadlines straddle the 32-bit wrap
+  tick_sched_init(now);
+  for (uint8_t i = 0; i < TICK_SVC_COUNT; i++) {
+    tick_sched_register((tick_svc_t)i, "h", fns[i]);
+    tick_sched_wake((tick_svc_t)i, delay[i] + 10u);
+    tick_sched_wake((tick_svc_t)i, delay[i]);        // earlier: replaces
+    tick_sched_wake((tick_svc_t)i, delay[i] + 50u);  // later: ignored
+  }
+  for (uint32_t k = 1; k <= 100; k++) tick_sched_run(now + k);
+  for (uint8_t i = 0; i < TICK_SVC_COUNT; i++) assert(g_fired[i] == now + delay[i]);
+  printf("heap order: ok\n");
+}
+
+int main(void) {
+  test_heap_order();
+
+  run_legacy();
+  run_sched();
+
+  printf("session %u ms: legacy %u events, tick_sched %u events\n",
+         SESSION_MS, g_log_n[0], g_log_n[1]);
+  assert(g_log_n[0] > 100);
+  assert(g_log_n[0] == g_log_n[1]);
+  for (uint32_t i = 0; i < g_log_n[0]; i++) {
+    const ev_t* a = &g_log[0][i];
+    const ev_t* b = &g_log[1][i];
+    if (memcmp(a, b, sizeof(*a)) != 0) {
+      printf("mismatch at %u: t %u/%u src %u/%u %u,%u,%u vs %u,%u,%u\n", i, a->t, b->t,
+             a->src, b->src, a->a, a->b, a->c, b->a, b->b, b->c);
+      return 1;
+    }
+  }
+  printf("outputs identical\n");
+
+  uint32_t runs, idle;
+  tick_sched_get_totals(&runs, &idle);
+  printf("  %-13s %10s %6s %8s\n", "service", "dispatches", "wakes", "late_max");
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < TICK_SVC_COUNT; i++) {
+    tick_sched_stats_t st;
+    assert(tick_sched_get_stats((tick_svc_t)i, &st) == 0);
+    printf("  %-13s %10u %6u %8u\n", st.name, st.dispatches, st.wakes, st.late_max_ms);
+    assert(st.late_max_ms <= 1);  // the start-up wakes are due at 0, first run is at 1
+    total += st.dispatches;
+  }
+  printf("  runs %u, idle %u, dispatches %u (legacy: %u calls)\n",
+         runs, idle, total, SESSION_MS * TICK_SVC_COUNT);
+  assert(total < SESSION_MS);  // well under one per ms, legacy makes 8 per ms
+
+  // Idle cost: everything settled, enable every track so the legacy ticks scan
+  for (uint8_t t = 0; t < 4; t++) {
+    cc_smoother_set_enabled(t, 1);
+    lfo_set_enabled(t, 1);
+    midi_delay_set_enabled(t, 1);
+    note_repeat_set_enabled(t, 1);
+    envelope_cc_set_enabled(t, 1);
+    gate_time_set_enabled(t, 1);
+  }
+  const uint32_t n = 200000;
+  uint32_t now = SESSION_MS;
+  tick_sched_run(++now);  // absorb the wakes from the enables above
+  for (int k = 0; k < 4; k++) tick_sched_run(++now);
+  uint64_t t0 = bench_now();
+  for (uint32_t k = 0; k < n; k++) tick_sched_run(++now);
+  uint64_t sched = (bench_now() - t0) / n;
+
+  t0 = bench_now();
+  for (uint32_t k = 0; k < n; k++) {
+    cc_smoother_tick_1ms();
+    lfo_tick_1ms();
+    midi_delay_tick_1ms();
+    note_repeat_tick_1ms();
+    envelope_cc_tick(k);
+    gate_time_tick(k);
+    bellows_tick_1ms();
+    reg_coupling_tick_1ms();
+  }
+  uint64_t legacy = (bench_now() - t0) / n;
+  printf("idle ms: tick_sched %llu " BENCH_UNIT ", legacy ticks %llu " BENCH_UNIT "\n",
+         (unsigned long long)sched, (unsigned long long)legacy);
+  return 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file host_oled.c
+ * @brief Fake oled_ssd1322 backend for the host UI renderer
+ *
+ * Same double-buffer contract as Hal/oled_ssd1322: the UI draws into the
+ * back buffer and oled_flush() publishes it to the front buffer, which is
+ * what the panel would show. No SPI, no DMA; flushes complete immediately.
+ */
+
+#include <string.h>
+
+#include "Hal/oled_ssd1322/oled_ssd1322.h"
+
+static uint8_t fb[OLED_W * OLED_H / 2];
+static uint8_t fb_front[OLED_W * OLED_H / 2];
+static oled_flush_stats_t s_stats;
+static void (*s_flush_cb)(void);
+
+uint8_t* oled_framebuffer(void) { return fb; }
+
+void oled_flush(void) {
+  s_stats.flushes++;
+  if (memcmp(fb_front, fb, sizeof(fb)) == 0) {
+    s_stats.idle_flushes++;
+    s_stats.last_data_bytes = 0;
+  } else {
+    memcpy(fb_front, fb, sizeof(fb));
+    s_stats.windows++;
+    s_stats.data_bytes += sizeof(fb);
+    s_stats.last_data_bytes = sizeof(fb);
+  }
+  if (s_flush_cb) s_flush_cb();
+}
+
+void oled_clear(void) { memset(fb, 0, sizeof(fb)); }
+void oled_invalidate(void) { memset(fb_front, 0xFF, sizeof(fb_front)); }
+uint8_t oled_flush_busy(void) { return 0; }
+void oled_wait_idle(void) {}
+void oled_set_flush_callback(void (*cb)(void)) { s_flush_cb = cb; }
+void oled_get_flush_stats(oled_flush_stats_t* out) { if (out) *out = s_stats; }
+
+/** Panel contents (front buffer) for dumps and checksums. */
+const uint8_t* host_oled_front(void) { return fb_front; }
@@ -0,0 +1,215 @@
+/**
+ * @file host_stubs.c
+ * @brief Host stand-ins for the firmware services the UI pages call
+ *
+ * Only what the pages need to render: a fixed 4-track looper session with
+ * note data, a config_io without SD card, and silent CLI/debug/RTOS calls.
+ * Values are deterministic so framebuffer checksums are reproducible.
+ *
+ * The SysEx and OLED test pages are stubbed too: the first saves to SD
+ * through FatFs (whose config pulls in the FreeRTOS/newlib headers), the
+ * second drives the panel directly.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "Services/looper/looper.h"
+#include "Services/config_io/config_io.h"
+#include "Services/ui/ui_gfx.h"
+#include "Services/ui/ui_page_sysex.h"
+#include "Services/ui/chord_cfg.h"
+#include "cmsis_os2.h"
+
+#define HOST_PPQN        96u
+#define HOST_LOOP_BEATS  16u
+#define HOST_LOOP_TICKS  (HOST_PPQN * HOST_LOOP_BEATS)
+#define HOST_NOTES       64u
+
+static uint32_t s_tick_ms;
+
+uint32_t HAL_GetTick(void) { return s_tick_ms; }
+
+/** Advance the fake millisecond clock (used by the bench between frames). */
+void host_advance_ms(uint32_t ms) { s_tick_ms += ms; }
+
+// ui.c converts cycle deltas with SystemCoreClock; host_cycles() is a
+// monotonic clock in the same units (see host_ui.h)
+uint32_t SystemCoreClock = 168000000u;
+
+uint32_t host_cycles(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+  return (uint32_t)(ns * (SystemCoreClock / 1000000u) / 1000u);
+}
+
+// ---- RTOS / console ----
+
+osKernelState_t osKernelGetState(void) { return osKernelRunning; }
+osMutexId_t osMutexNew(const osMutexAttr_t* attr) { (void)attr; return (osMutexId_t)1; }
+osStatus_t osMutexAcquire(osMutexId_t id, uint32_t timeout) { (void)id; (void)timeout; return osOK; }
+osStatus_t osMutexRelease(osMutexId_t id) { (void)id; return osOK; }
+
+// No queues: ui.c stays in cooperative mode
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t* attr) {
+  (void)msg_count; (void)msg_size; (void)attr; return NULL;
+}
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void* msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+  (void)mq_id; (void)msg_ptr; (void)msg_prio; (void)timeout; return osErrorResource;
+}
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void* msg_ptr, uint8_t* msg_prio, uint32_t timeout) {
+  (void)mq_id; (void)msg_ptr; (void)msg_prio; (void)timeout; return osErrorResource;
+}
+
+void cli_puts(const char* str) { (void)str; }
+void cli_newline(void) {}
+void cli_print_u32(uint32_t val) { (void)val; }
+void cli_error(const char* msg) { (void)msg; }
+
+void dbg_print(const char* str) { (void)str; }
+void dbg_putc(char c) { (void)c; }
+void dbg_print_hex8(uint8_t b) { (void)b; }
+void dbg_print_uint(uint32_t n) { (void)n; }
+
+// ---- config_io: no SD card ----
+
+void config_io_init(void) {}
+int config_io_load(config_data_t* cfg) { (void)cfg; return -1; }
+int config_io_save(const config_data_t* cfg) { (void)cfg; return -1; }
+void config_io_get_defaults(config_data_t* cfg) { if (cfg) memset(cfg, 0, sizeof(*cfg)); }
+uint8_t config_io_sd_available(void) { return 0; }
+const char* config_io_get_error(void) { return "no SD (host)"; }
+
+// ---- UI state / chord bank (ui.c) ----
+
+void ui_state_mark_dirty(void) {}
+void ui_state_tick_20ms(void) {}
+int chord_bank_load(chord_bank_t* b, const char* path) { (void)b; (void)path; return -1; }
+
+// ---- Stubbed pages ----
+
+void ui_page_sysex_render(uint32_t now_ms) {
+  (void)now_ms;
+  ui_gfx_clear(0);
+  ui_gfx_text(0, 0, "SYSEX (host stub)", 15);
+  ui_gfx_hline(0, 11, 256, 8);
+}
+void ui_page_sysex_on_button(uint8_t id, uint8_t pressed) { (void)id; (void)pressed; }
+void ui_page_sysex_on_encoder(int8_t delta) { (void)delta; }
+void ui_page_oled_test_on_encoder(int8_t delta) { (void)delta; }
+
+// ---- Looper: fixed session ----
+
+static looper_state_t s_state[LOOPER_TRACKS] = {
+  LOOPER_STATE_PLAY, LOOPER_STATE_OVERDUB, LOOPER_STATE_STOP, LOOPER_STATE_REC
+};
+static uint8_t s_muted[LOOPER_TRACKS];
+static looper_event_view_t s_events[HOST_NOTES * 2u];
+static looper_note_span_t s_spans[HOST_NOTES];
+static looper_snapshot_t s_snap;
+
+static void build_snapshot(void) {
+  if (s_snap.span_count) return;
+  // Two interleaved voices: a bass line on quarters and a melody on eighths
+  for (uint32_t i = 0; i < HOST_NOTES; i++) {
+    looper_note_span_t* n = &s_spans[i];
+    uint8_t melody = (uint8_t)(i & 1u);
+    n->start = (i / 2u) * (HOST_LOOP_TICKS / (HOST_NOTES / 2u)) + (melody ? HOST_PPQN / 4u : 0u);
+    n->end = n->start + (melody ? HOST_PPQN / 3u : HOST_PPQN / 2u);
+    n->ch = 0;
+    n->note = (uint8_t)(melody ? 60u + (i * 7u) % 24u : 36u + (i * 5u) % 12u);
+    n->vel = (uint8_t)(64u + (i * 13u) % 64u);
+    n->on_idx = (uint16_t)(i * 2u);
+    n->off_idx = (uint16_t)(i * 2u + 1u);
+  }
+  for (uint32_t i = 0; i < HOST_NOTES; i++) {
+    looper_event_view_t* on = &s_events[i * 2u];
+    looper_event_view_t* off = &s_events[i * 2u + 1u];
+    on->idx = i * 2u;      on->tick = s_spans[i].start; on->len = 3;
+    on->b0 = 0x90;         on->b1 = s_spans[i].note;    on->b2 = s_spans[i].vel;
+    off->idx = i * 2u + 1u; off->tick = s_spans[i].end; off->len = 3;
+    off->b0 = 0x80;        off->b1 = s_spans[i].note;   off->b2 = 0;
+  }
+  s_snap.gen = 1;
+  s_snap.loop_len_ticks = HOST_LOOP_TICKS;
+  s_snap.event_count = HOST_NOTES * 2u;
+  s_snap.events = s_events;
+  s_snap.span_count = HOST_NOTES;
+  s_snap.spans = s_spans;
+}
+
+const looper_snapshot_t* looper_snapshot_get(uint8_t track) {
+  if (track >= LOOPER_TRACKS) return NULL;
+  build_snapshot();
+  s_snap.track = track;
+  return &s_snap;
+}
+
+uint32_t looper_get_generation(uint8_t track) { (void)track; return s_snap.gen; }
+uint32_t looper_get_loop_len_ticks(uint8_t track) { (void)track; return HOST_LOOP_TICKS; }
+uint16_t looper_get_loop_beats(uint8_t track) { (void)track; return HOST_LOOP_BEATS; }
+uint32_t looper_get_cursor_position(uint8_t track) {
+  return (s_tick_ms * HOST_PPQN / 500u + track * 24u) % HOST_LOOP_TICKS;  // 120 BPM
+}
+looper_state_t looper_get_state(uint8_t track) { return track < LOOPER_TRACKS ? s_state[track] : LOOPER_STATE_STOP; }
+void looper_set_state(uint8_t track, looper_state_t st) { if (track < LOOPER_TRACKS) s_state[track] = st; }
+uint8_t looper_is_track_muted(uint8_t track) { return track < LOOPER_TRACKS ? s_muted[track] : 0; }
+void looper_set_track_muted(uint8_t track, uint8_t muted) { if (track < LOOPER_TRACKS) s_muted[track] = muted; }
+
+void looper_get_transport(looper_transport_t* out) {
+  if (!out) return;
+  out->bpm = 120; out->ts_num = 4; out->ts_den = 4; out->auto_loop = 1; out->reserved = 0;
+}
+looper_quant_t looper_get_quant(uint8_t track) { (void)track; return LOOPER_QUANT_1_16; }
+const char* looper_get_quant_name(looper_quant_t q) { return q == LOOPER_QUANT_OFF ? "OFF" : "1/16"; }
+uint32_t looper_get_quant_step_ticks(looper_quant_t q) { return q == LOOPER_QUANT_OFF ? 0u : HOST_PPQN / 4u; }
+
+int looper_add_event(uint8_t track, uint32_t tick, uint8_t len, uint8_t b0, uint8_t b1, uint8_t b2) {
+  (void)track; (void)tick; (void)len; (void)b0; (void)b1; (void)b2; return -1;
+}
+int looper_delete_event(uint8_t track, uint32_t idx) { (void)track; (void)idx; return -1; }
+int looper_edit_event(uint8_t track, uint32_t idx, uint32_t new_tick,
+                      uint8_t len, uint8_t b0, uint8_t b1, uint8_t b2) {
+  (void)track; (void)idx; (void)new_tick; (void)len; (void)b0; (void)b1; (void)b2; return -1;
+}
+
+uint8_t looper_get_current_scene(void) { return 1; }
+looper_scene_clip_t looper_get_scene_clip(uint8_t scene, uint8_t track) {
+  looper_scene_clip_t c;
+  c.has_clip = (uint8_t)(((scene + track) % 3u) != 0u);
+  c.loop_beats = c.has_clip ? (uint16_t)(4u << (scene & 1u)) : 0u;
+  return c;
+}
+void looper_trigger_scene(uint8_t scene) { (void)scene; }
+void looper_save_to_scene(uint8_t scene, uint8_t track) { (void)scene; (void)track; }
+void looper_load_from_scene(uint8_t scene, uint8_t track) { (void)scene; (void)track; }
+void looper_set_scene_chain(uint8_t scene, uint8_t next_scene, uint8_t enabled) {
+  (void)scene; (void)next_scene; (void)enabled;
+}
+
+uint8_t looper_is_humanizer_enabled(uint8_t track) { return (uint8_t)(track == 0u); }
+uint8_t looper_get_humanizer_velocity(uint8_t track) { (void)track; return 12; }
+uint8_t looper_get_humanizer_timing(uint8_t track) { (void)track; return 3; }
+uint8_t looper_get_humanizer_intensity(uint8_t track) { (void)track; return 50; }
+void looper_set_humanizer_enabled(uint8_t track, uint8_t enabled) { (void)track; (void)enabled; }
+void looper_set_humanizer_velocity(uint8_t track, uint8_t amount) { (void)track; (void)amount; }
+void looper_set_humanizer_timing(uint8_t track, uint8_t amount) { (void)track; (void)amount; }
+void looper_set_humanizer_intensity(uint8_t track, uint8_t intensity) { (void)track; (void)intensity; }
+
+uint8_t looper_is_lfo_enabled(uint8_t track) { return (uint8_t)(track == 0u); }
+uint8_t looper_is_lfo_bpm_synced(uint8_t track) { (void)track; return 1; }
+uint16_t looper_get_lfo_rate(uint8_t track) { (void)track; return 150; }
+uint8_t looper_get_lfo_depth(uint8_t track) { (void)track; return 40; }
+uint8_t looper_get_lfo_bpm_divisor(uint8_t track) { (void)track; return 4; }
+looper_lfo_waveform_t looper_get_lfo_waveform(uint8_t track) { (void)track; return LOOPER_LFO_WAVEFORM_SINE; }
+looper_lfo_target_t looper_get_lfo_target(uint8_t track) { (void)track; return LOOPER_LFO_TARGET_VELOCITY; }
+void looper_set_lfo_enabled(uint8_t track, uint8_t enabled) { (void)track; (void)enabled; }
+void looper_set_lfo_bpm_sync(uint8_t track, uint8_t bpm_sync) { (void)track; (void)bpm_sync; }
+void looper_set_lfo_rate(uint8_t track, uint16_t rate_hundredths) { (void)track; (void)rate_hundredths; }
+void looper_set_lfo_depth(uint8_t track, uint8_t depth) { (void)track; (void)depth; }
+void looper_set_lfo_bpm_divisor(uint8_t track, uint8_t divisor) { (void)track; (void)divisor; }
+void looper_set_lfo_waveform(uint8_t track, looper_lfo_waveform_t waveform) { (void)track; (void)waveform; }
+void looper_set_lfo_target(uint8_t track, looper_lfo_target_t target) { (void)track; (void)target; }
+void looper_reset_lfo_phase(uint8_t track) { (void)track; }
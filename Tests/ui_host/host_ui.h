@@ -0,0 +1,10 @@
+// Forced include (-include host_ui.h) for the host build of Services/ui/ui.c:
+// replaces the DWT cycle counter with a host clock scaled to SystemCoreClock,
+// so ui_get_page_stats() reports host microseconds.
+#pragma once
+#include <stdint.h>
+
+uint32_t host_cycles(void);
+
+#define UI_CYCLE_COUNTER() host_cycles()
+#define UI_CYCLE_COUNTER_ENABLE() ((void)0)
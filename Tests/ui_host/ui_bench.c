@@ -0,0 +1,183 @@
+/**
+ * @file ui_bench.c
+ * @brief Host benchmark for UI page rendering
+ *
+ * Renders every UI page into a 256x64 4-bit framebuffer for a number of
+ * frames and reports the average cost per frame, plus a checksum of the
+ * last framebuffer. The same source is linked twice:
+ *   ui_bench      -> Services/ui/ui_gfx.c (current primitives)
+ *   ui_bench_ref  -> ui_gfx_ref.c (original per-pixel primitives)
+ * so "make bench" prints before/after numbers side by side. Checksums must
+ * be identical between the two binaries: the optimized primitives have to
+ * produce the same pixels.
+ *
+ * The px/frame column counts ui_gfx_pixel() calls (UI_GFX_STATS build), the
+ * per-pixel work the span and glyph paths avoid.
+ *
+ * Times are TSC cycles on x86 hosts (nanoseconds elsewhere). Absolute values
+ * are not Cortex-M4 cycles, but the ratio between the two builds is a good
+ * guide for where the firmware spends its frame time.
+ *
+ * To compile and run (from Tests/ui_host):
+ *   make bench
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cyc"
+static inline uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static inline uint64_t bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#include "Services/ui/ui_gfx.h"
+#include "Services/ui/ui_page_looper.h"
+#include "Services/ui/ui_page_looper_timeline.h"
+#include "Services/ui/ui_page_looper_pianoroll.h"
+#include "Services/ui/ui_page_song.h"
+#include "Services/ui/ui_page_midi_monitor.h"
+#include "Services/ui/ui_page_config.h"
+#include "Services/ui/ui_page_livefx.h"
+#include "Services/ui/ui_page_rhythm.h"
+#include "Services/ui/ui_page_automation.h"
+#include "Services/ui/ui_page_humanizer.h"
+#include "Services/ui/ui_page_modules.h"
+#include "Services/module_registry/module_registry.h"
+#include "Services/rhythm_trainer/rhythm_trainer.h"
+
+#define W 256
+#define H 64
+#define FRAME_MS 250u  // > midi monitor refresh interval, so it redraws every frame
+
+void host_advance_ms(uint32_t ms);
+
+static uint8_t fb[W * H / 2];
+static uint32_t g_now;
+
+static void r_looper(void)     { ui_page_looper_render(g_now); }
+static void r_timeline(void)   { ui_page_looper_timeline_render(g_now); }
+static void r_pianoroll(void)  { ui_page_looper_pianoroll_render(g_now); }
+static void r_song(void)       { ui_page_song_render(g_now); }
+static void r_monitor(void)    { ui_page_midi_monitor_render(g_now); }
+static void r_config(void)     { ui_page_config_render(g_now); }
+static void r_livefx(void)     { ui_page_livefx_render(g_now); }
+static void r_rhythm(void)     { ui_page_rhythm_update(1); }
+static void r_automation(void) { ui_page_automation_render(g_now); }
+static void r_humanizer(void)  { ui_page_humanizer_render(g_now); }
+static void r_modules(void)    { ui_page_modules_render(fb, W, H); }
+
+// Worst case for the primitives: large fills, frames and text everywhere
+static void r_stress(void) {
+  ui_gfx_clear(0);
+  for (int i = 0; i < 8; i++) {
+    ui_gfx_fill_rect(i * 32 + (i & 1), 12, 29, 40, (uint8_t)(2 + i));
+    ui_gfx_rect(i * 32 + 1, 10, 30, 44, 15);
+  }
+  for (int y = 0; y < H; y += 8) ui_gfx_hline(0, y, W, 4);
+  for (int x = 0; x < W; x += 16) ui_gfx_vline(x, 0, H, 6);
+  ui_gfx_line(0, 0, W - 1, H - 1, 15);
+  ui_gfx_line(0, H - 1, W - 1, 0, 15);
+  ui_gfx_text(3, 2, "STRESS 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ", 13);
+  // Inverted (dark on bright bar) and clipped text at both edges
+  ui_gfx_fill_rect(0, 54, W, 10, 15);
+  ui_gfx_text(-3, 55, "INVERTED selection bar, clipped at both edges", 0);
+  ui_gfx_set_font(UI_FONT_8X8);
+  ui_gfx_text(W - 20, 40, "EDGE", 9);
+}
+
+typedef struct {
+  const char* name;
+  void (*render)(void);
+} bench_page_t;
+
+static const bench_page_t k_pages[] = {
+  { "looper",     r_looper },
+  { "timeline",   r_timeline },
+  { "pianoroll",  r_pianoroll },
+  { "song",       r_song },
+  { "midi_mon",   r_monitor },
+  { "config",     r_config },
+  { "livefx",     r_livefx },
+  { "rhythm",     r_rhythm },
+  { "automation", r_automation },
+  { "humanizer",  r_humanizer },
+  { "modules",    r_modules },
+  { "stress",     r_stress },
+};
+
+static uint32_t fb_checksum(void) {
+  uint32_t h = 2166136261u;  // FNV-1a
+  for (size_t i = 0; i < sizeof(fb); i++) h = (h ^ fb[i]) * 16777619u;
+  return h;
+}
+
+static int dummy_status(uint8_t track) { (void)track; return MODULE_STATUS_ENABLED; }
+
+static const module_descriptor_t k_mod_looper = {
+  .name = "looper", .description = "MIDI looper", .category = MODULE_CATEGORY_MIDI,
+  .get_status = dummy_status, .is_global = 1,
+};
+static const module_descriptor_t k_mod_ainser = {
+  .name = "ainser64", .description = "Analog inputs", .category = MODULE_CATEGORY_INPUT,
+  .get_status = dummy_status, .is_global = 1,
+};
+
+static void setup(void) {
+  module_registry_init();
+  module_registry_register(&k_mod_looper);
+  module_registry_register(&k_mod_ainser);
+  ui_page_modules_init();
+  rhythm_trainer_init();
+  rhythm_trainer_set_enabled(1);
+  ui_page_rhythm_init();
+
+  static const uint8_t msgs[][3] = {
+    {0x90, 60, 100}, {0x80, 60, 0}, {0xB0, 7, 90}, {0xE0, 0, 64}, {0x91, 48, 80},
+  };
+  for (uint32_t i = 0; i < 24u; i++) {
+    ui_midi_monitor_capture((uint8_t)(i & 3u), msgs[i % 5u], 3, i * 10u, (uint8_t)(i & 1u));
+  }
+}
+
+int main(int argc, char** argv) {
+  int frames = (argc > 1) ? atoi(argv[1]) : 2000;
+  if (frames < 1) frames = 1;
+
+  ui_gfx_set_fb(fb, W, H);
+  setup();
+
+  printf("UI render bench (%s), %d frames/page\n", UI_BENCH_VARIANT, frames);
+  printf("  %-11s %12s %10s  %s\n", "page", BENCH_UNIT "/frame", "px/frame", "fb checksum");
+
+  uint64_t total = 0;
+  for (size_t p = 0; p < sizeof(k_pages) / sizeof(k_pages[0]); p++) {
+    g_now = 0;
+    ui_gfx_stats_t gs;
+    ui_gfx_reset_stats();
+    uint64_t t0 = bench_now();
+    for (int f = 0; f < frames; f++) {
+      g_now += FRAME_MS;
+      host_advance_ms(FRAME_MS);
+      ui_gfx_set_font(UI_FONT_5X7);
+      k_pages[p].render();
+    }
+    uint64_t per = (bench_now() - t0) / (uint64_t)frames;
+    total += per;
+    ui_gfx_get_stats(&gs);
+    printf("  %-11s %12llu %10lu  %08x\n", k_pages[p].name, (unsigned long long)per,
+           (unsigned long)(gs.pixel_calls / (uint32_t)frames), fb_checksum());
+  }
+  printf("  %-11s %12llu\n", "sum", (unsigned long long)total);
+  return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file ui_render.c
+ * @brief Headless UI renderer: scripted navigation, PGM dumps, frame stats
+ *
+ * Runs the real Services/ui/ui.c (page switching, input handling, redraw
+ * invalidation, flush pacing) with every page it renders, on top of the
+ * fake OLED backend (host_oled.c) and the fixed looper session in
+ * host_stubs.c. A script drives it:
+ *
+ *   # comment
+ *   page <TAG|index>   switch page (TAG as in ui_get_page_tag: LOOP, TIME...)
+ *   button <id>        press and release button id
+ *   press <id>         press only (combos: press 5 / button 1 / release 5)
+ *   release <id>
+ *   enc <delta>        encoder step
+ *   wait <ms>          run ui_tick_20ms() for ms (20 ms frames)
+ *   dump <name>        flush and write <outdir>/<name>.pgm
+ *
+ * Every dump also appends "<name> <fnv32>" to <outdir>/checksums.txt;
+ * "make check" diffs that file against golden.txt. At exit the renderer
+ * prints per-page render statistics: ui_get_page_stats() timing plus
+ * ui_gfx_pixel()/span/glyph counts per render.
+ *
+ * To compile and run (from Tests/ui_host):
+ *   make render     (renders scripts/nav.txt into out/)
+ *   make check      (same, then compares against golden.txt)
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include "Services/ui/ui.h"
+#include "Services/ui/ui_gfx.h"
+#include "Services/ui/ui_page_midi_monitor.h"
+#include "Services/ui/ui_page_rhythm.h"
+#include "Services/rhythm_trainer/rhythm_trainer.h"
+#include "Hal/oled_ssd1322/oled_ssd1322.h"
+
+#define FRAME_MS 20u
+
+void host_advance_ms(uint32_t ms);
+const uint8_t* host_oled_front(void);
+
+static const char* g_outdir = "out";
+static FILE* g_sums;
+
+// Draw-call counters per page, attributed to the page active during the tick
+static ui_gfx_stats_t g_page_gfx[UI_PAGE_COUNT];
+
+static uint32_t fb_checksum(const uint8_t* fb) {
+  uint32_t h = 2166136261u;  // FNV-1a
+  for (size_t i = 0; i < OLED_W * OLED_H / 2; i++) h = (h ^ fb[i]) * 16777619u;
+  return h;
+}
+
+// 4-bit panel gray -> 8-bit PGM (P5)
+static int write_pgm(const char* path, const uint8_t* fb) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return -1;
+  fprintf(f, "P5\n%d %d\n255\n", OLED_W, OLED_H);
+  for (size_t i = 0; i < OLED_W * OLED_H / 2; i++) {
+    uint8_t px[2] = { (uint8_t)((fb[i] >> 4) * 17u), (uint8_t)((fb[i] & 0x0Fu) * 17u) };
+    fwrite(px, 1, 2, f);
+  }
+  fclose(f);
+  return 0;
+}
+
+static void run_ms(uint32_t ms) {
+  for (uint32_t t = 0; t < ms; t += FRAME_MS) {
+    ui_page_t p = ui_get_page();
+    ui_gfx_stats_t a, b;
+    ui_gfx_get_stats(&a);
+    host_advance_ms(FRAME_MS);
+    ui_tick_20ms();
+    ui_gfx_get_stats(&b);
+    g_page_gfx[p].pixel_calls += b.pixel_calls - a.pixel_calls;
+    g_page_gfx[p].spans += b.spans - a.spans;
+    g_page_gfx[p].glyphs += b.glyphs - a.glyphs;
+  }
+}
+
+static int parse_page(const char* arg, ui_page_t* out) {
+  char* end;
+  long v = strtol(arg, &end, 10);
+  if (*end == 0 && v >= 0 && v < UI_PAGE_COUNT) { *out = (ui_page_t)v; return 0; }
+  for (int p = 0; p < UI_PAGE_COUNT; p++) {
+    if (strcmp(arg, ui_get_page_tag((ui_page_t)p)) == 0) { *out = (ui_page_t)p; return 0; }
+  }
+  return -1;
+}
+
+static int dump(const char* name) {
+  char path[512];
+  oled_flush();  // panel shows what has been rendered so far
+  const uint8_t* fb = host_oled_front();
+  snprintf(path, sizeof(path), "%s/%s.pgm", g_outdir, name);
+  if (write_pgm(path, fb) != 0) {
+    fprintf(stderr, "cannot write %s\n", path);
+    return -1;
+  }
+  fprintf(g_sums, "%s %08x\n", name, fb_checksum(fb));
+  return 0;
+}
+
+// Returns 0 on success, -1 on the first bad line
+static int run_script(FILE* f, const char* name) {
+  char line[256];
+  unsigned lineno = 0;
+  while (fgets(line, sizeof(line), f)) {
+    lineno++;
+    char cmd[32], arg[200];
+    char* hash = strchr(line, '#');
+    if (hash) *hash = 0;
+    int n = sscanf(line, "%31s %199s", cmd, arg);
+    if (n <= 0) continue;
+    if (n < 2) goto bad;
+
+    if (strcmp(cmd, "page") == 0) {
+      ui_page_t p;
+      if (parse_page(arg, &p) != 0) goto bad;
+      ui_set_page(p);
+    } else if (strcmp(cmd, "button") == 0) {
+      ui_on_button((uint8_t)atoi(arg), 1);
+      ui_on_button((uint8_t)atoi(arg), 0);
+    } else if (strcmp(cmd, "press") == 0) {
+      ui_on_button((uint8_t)atoi(arg), 1);
+    } else if (strcmp(cmd, "release") == 0) {
+      ui_on_button((uint8_t)atoi(arg), 0);
+    } else if (strcmp(cmd, "enc") == 0) {
+      ui_on_encoder((int8_t)atoi(arg));
+    } else if (strcmp(cmd, "wait") == 0) {
+      run_ms((uint32_t)atoi(arg));
+    } else if (strcmp(cmd, "dump") == 0) {
+      if (dump(arg) != 0) return -1;
+    } else {
+      goto bad;
+    }
+  }
+  return 0;
+
+bad:
+  fprintf(stderr, "%s:%u: bad command: %s", name, lineno, line);
+  return -1;
+}
+
+static void setup(void) {
+  rhythm_trainer_init();
+  rhythm_trainer_set_enabled(1);
+  ui_page_rhythm_init();
+
+  static const uint8_t msgs[][3] = {
+    {0x90, 60, 100}, {0x80, 60, 0}, {0xB0, 7, 90}, {0xE0, 0, 64}, {0x91, 48, 80},
+  };
+  for (uint32_t i = 0; i < 24u; i++) {
+    ui_midi_monitor_capture((uint8_t)(i & 3u), msgs[i % 5u], 3, i * 10u, (uint8_t)(i & 1u));
+  }
+
+  ui_init();
+  ui_set_patch_status("Host", "Golden");
+}
+
+static void print_stats(void) {
+  uint32_t frames, skipped;
+  ui_get_frame_stats(&frames, &skipped);
+  printf("frames %lu, skipped %lu\n", (unsigned long)frames, (unsigned long)skipped);
+  printf("  %-6s %7s %8s %8s %10s %8s %8s\n",
+         "page", "renders", "avg_us", "max_us", "pixel/r", "span/r", "glyph/r");
+  for (int p = 0; p < UI_PAGE_COUNT; p++) {
+    ui_page_stats_t st;
+    if (ui_get_page_stats((ui_page_t)p, &st) != 0 || st.renders == 0) continue;
+    const ui_gfx_stats_t* g = &g_page_gfx[p];
+    printf("  %-6s %7lu %8lu %8lu %10lu %8lu %8lu\n", ui_get_page_tag((ui_page_t)p),
+           (unsigned long)st.renders, (unsigned long)(st.total_us / st.renders),
+           (unsigned long)st.max_us, (unsigned long)(g->pixel_calls / st.renders),
+           (unsigned long)(g->spans / st.renders), (unsigned long)(g->glyphs / st.renders));
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <script> [outdir]\n", argv[0]);
+    return 2;
+  }
+  if (argc > 2) g_outdir = argv[2];
+  mkdir(g_outdir, 0755);
+
+  FILE* f = fopen(argv[1], "r");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 2;
+  }
+  char path[512];
+  snprintf(path, sizeof(path), "%s/checksums.txt", g_outdir);
+  g_sums = fopen(path, "w");
+  if (!g_sums) {
+    fprintf(stderr, "cannot write %s\n", path);
+    fclose(f);
+    return 2;
+  }
+
+  setup();
+  int rc = run_script(f, argv[1]);
+  fclose(f);
+  fclose(g_sums);
+
+  print_stats();
+  return rc == 0 ? 0 : 1;
+}